@@ -0,0 +1,97 @@
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <benchmark/benchmark.h>
+
+extern "C" {
+    #include  "simdstr.h"
+}
+
+// Scaling of the parallel kernels: range(0) bytes of input on range(1)
+// threads, 0 threads is the serial dispatched kernel.
+
+static void bm_memcmpeq_parallel(benchmark::State& state) {
+  size_t len = state.range(0);
+  int nthreads = state.range(1);
+  std::string s1(len, 'x');
+  std::string s2 = s1;
+
+  for (auto _ : state) {
+    bool eq = nthreads == 0 ? simdstr_memcmpeq(s1.data(), s2.data(), len)
+                            : memcmpeq_parallel(s1.data(), s2.data(), len, nthreads);
+    benchmark::DoNotOptimize(eq);
+  }
+  state.SetBytesProcessed(state.iterations() * len * 2);
+}
+
+static void bm_sum_parallel(benchmark::State& state) {
+  size_t len = state.range(0) / sizeof(float);
+  int nthreads = state.range(1);
+  std::vector<float> vec(len, 1.0f);
+
+  for (auto _ : state) {
+    float sum = nthreads == 0 ? simdstr_sum(vec.data(), len)
+                              : sum_parallel(vec.data(), len, nthreads);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetBytesProcessed(state.iterations() * len * sizeof(float));
+}
+
+static void bm_count_byte_parallel(benchmark::State& state) {
+  size_t len = state.range(0);
+  int nthreads = state.range(1);
+  std::string s(len, 'x');
+  for (size_t i = 80; i < len; i += 81) s[i] = '\n';
+
+  for (auto _ : state) {
+    size_t n = nthreads == 0 ? simdstr_count_byte(s.data(), '\n', len)
+                             : count_byte_parallel(s.data(), '\n', len, nthreads);
+    benchmark::DoNotOptimize(n);
+  }
+  state.SetBytesProcessed(state.iterations() * len);
+}
+
+static size_t line_tolower(char *dst, const char *line, size_t len, void *) {
+  simdstr_tolower(dst, line, len);
+  return len;
+}
+
+// lines of 80 bytes, 1 thread is the serial memchr walk
+static void bm_map_lines_parallel(benchmark::State& state) {
+  size_t len = state.range(0);
+  int nthreads = state.range(1) == 0 ? 1 : state.range(1);
+  std::string s(len, 'X');
+  for (size_t i = 80; i < len; i += 81) s[i] = '\n';
+  std::vector<char> dst(len);
+
+  for (auto _ : state) {
+    int64_t n = map_lines_parallel(dst.data(), s.data(), len, line_tolower, nullptr, nthreads);
+    benchmark::DoNotOptimize(n);
+  }
+  state.SetBytesProcessed(state.iterations() * len);
+}
+
+int main(int argc, char **argv) {
+  benchmark::Initialize(&argc, argv);
+
+  std::vector<int64_t> threads = {0};
+  int max_threads = std::thread::hardware_concurrency();
+  for (int n = 1; n < max_threads; n *= 2) threads.push_back(n);
+  threads.push_back(max_threads > 0 ? max_threads : 1);
+  std::vector<int64_t> sizes = {1 << 20, 16 << 20, 256 << 20, 1 << 30};
+
+  benchmark::RegisterBenchmark("memcmpeq_parallel", bm_memcmpeq_parallel)
+    ->ArgsProduct({sizes, threads})->ArgNames({"bytes", "threads"})->UseRealTime();
+  benchmark::RegisterBenchmark("sum_parallel", bm_sum_parallel)
+    ->ArgsProduct({sizes, threads})->ArgNames({"bytes", "threads"})->UseRealTime();
+
+  benchmark::RegisterBenchmark("count_byte_parallel", bm_count_byte_parallel)
+    ->ArgsProduct({sizes, threads})->ArgNames({"bytes", "threads"})->UseRealTime();
+  benchmark::RegisterBenchmark("map_lines_parallel", bm_map_lines_parallel)
+    ->ArgsProduct({sizes, threads})->ArgNames({"bytes", "threads"})->UseRealTime();
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+}
@@ -1,7 +1,14 @@
+#include <algorithm>
+#include <cctype>
+#include <cinttypes>
+#include <cmath>
 #include <random>
 #include <cstring>
+#include <functional>
 // #include <limits>
 #include <iostream>
+#include <memory>
+#include <vector>
 #include <benchmark/benchmark.h>
 
 extern "C" {
@@ -26,6 +33,21 @@ void fill_random(float *arr, int size, float range) {
     }
 }
 
+// ASCII without whitespace, with density percent of the bytes replaced by
+// one of the four JSON whitespaces.
+std::string gen_spaces(size_t len, int density) {
+  const char spaces[] = " \t\r\n";
+  std::string temp(len, '\0');
+  for (size_t i = 0; i < len; i++) {
+    if (std::rand() % 100 < density) {
+      temp[i] = spaces[std::rand() % 4];
+    } else {
+      temp[i] = (char)('!' + std::rand() % 94);
+    }
+  }
+  return temp;
+}
+
 std::string quote(const std::string& s) {
   std::string temp;
   temp += '"';
@@ -43,11 +65,42 @@ std::string quote(const std::string& s) {
 }
 
 using sum_t      = float (*)(const float *arr, size_t len);
+using dot_t      = float (*)(const float *a, const float *b, size_t len);
 using memcmpeq_t = bool  (*)(const char *s1, const char *s2, size_t len);
+using mismatch_t = size_t (*)(const char *s1, const char *s2, size_t len);
+using memcmp3_t  = int   (*)(const char *s1, const char *s2, size_t len);
 using tolower_t  = char* (*)(char *dst, const char *src, size_t len);
+using toupper_t  = char* (*)(char *dst, const char *src, size_t len);
+using inplace_t  = char* (*)(char *s, size_t len);
 using compact_t  = int   (*)(char *dst, const char *src, size_t len);
 using qstrlen_t  = int   (*)(const char *src, size_t len);
 using strstr_t   = char* (*)(const char *str, size_t n, const char *substr, size_t sn);
+using json_index_t = int64_t (*)(const char *json, size_t len, uint32_t *index);
+using u64toa_t   = size_t (*)(uint64_t val, char *out);
+using u64toa_batch_t = size_t (*)(const uint64_t *vals, size_t count, char *out, size_t *lens);
+using atou64_t   = size_t (*)(const char *str, size_t len, uint64_t *val);
+using atof_t     = size_t (*)(const char *str, size_t len, double *val);
+using utf8_validate_t = bool (*)(const char *s, size_t len);
+using utf8_count_t    = size_t (*)(const char *s, size_t len);
+using utf8_to_utf16_t = int64_t (*)(uint16_t *dst, const char *src, size_t len);
+using utf16_to_utf8_t = int64_t (*)(char *dst, const uint16_t *src, size_t len);
+using casefold_utf8_t = size_t (*)(char *dst, const char *src, size_t len);
+using find_of_t  = char* (*)(const simdstr_charset_t *cs, const char *s, size_t len);
+using count_of_t = size_t (*)(const simdstr_charset_t *cs, const char *s, size_t len);
+using unquote_t  = int64_t (*)(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+using quote_t    = size_t (*)(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+using crc32c_t   = uint32_t (*)(uint32_t crc, const char *s, size_t len);
+using hash64_t   = uint64_t (*)(const char *s, size_t len, uint64_t seed);
+using base64_encode_t = size_t (*)(char *dst, const char *src, size_t len, simdstr_base64_t alphabet);
+using base64_decode_t = int64_t (*)(char *dst, const char *src, size_t len, simdstr_base64_t alphabet,
+                                    size_t *error_at);
+using hex_encode_t = size_t (*)(char *dst, const char *src, size_t len);
+using hex_decode_t = int64_t (*)(char *dst, const char *src, size_t len, size_t *error_at);
+using memchr_t   = char* (*)(const char *s, int c, size_t len);
+using memchr2_t  = char* (*)(const char *s, int c1, int c2, size_t len);
+using memchr3_t  = char* (*)(const char *s, int c1, int c2, int c3, size_t len);
+using count_byte_t = size_t (*)(const char *s, int c, size_t len);
+using memcpy_t   = char* (*)(char *dst, const char *src, size_t len);
 
 static void test_memcmpeq(benchmark::State& state, memcmpeq_t memcmpeq, const char *s1, const char *s2, size_t len) {
   if (memcmpeq(s1, s2, len) != memcmpeq_naive(s1, s2, len)) {
@@ -98,6 +151,13 @@ static void test_strstr(benchmark::State& state, strstr_t strstr,
   }
 }
 
+static void test_strcasestr(benchmark::State& state, strstr_t strcasestr,
+  const char *str, size_t n, const char *substr, size_t sn) {
+  if (strcasestr(str, n, substr, sn) != strcasestr_naive(str, n, substr, sn)) {
+    state.SkipWithError("strcasestr test failed");
+  }
+}
+
 static void bm_sum(benchmark::State& state, sum_t fsum) {
   size_t len = 5120;
   float *arr = new float[len];
@@ -105,15 +165,92 @@ static void bm_sum(benchmark::State& state, sum_t fsum) {
   float sum = 0.0;
   for (auto _ : state) {
     sum = fsum(arr, len);
+    benchmark::DoNotOptimize(sum);
   }
+  state.SetBytesProcessed(state.iterations() * len * sizeof(float));
 
-  float diff = sum - sum_naive(arr, len);
-  if (diff >= 1e-6) {
-    // state.SkipWithError("sum test failed");
+  // any order of the additions is within n*u*sum|x| of the exact sum
+  double exact = 0.0, abs_sum = 0.0;
+  for (size_t i = 0; i < len; i++) {
+    exact += arr[i];
+    abs_sum += std::fabs(arr[i]);
+  }
+  if (std::fabs(sum - exact) > len * std::ldexp(1.0, -24) * abs_sum) {
+    state.SkipWithError("sum test failed");
   }
   delete[] arr;
 }
 
+static void bm_dot(benchmark::State& state, dot_t fdot) {
+  size_t len = 5120;
+  std::vector<float> a(len), b(len);
+  fill_random(a.data(), len, 1.0);
+  fill_random(b.data(), len, 1.0);
+  float dot = 0.0;
+  for (auto _ : state) {
+    dot = fdot(a.data(), b.data(), len);
+    benchmark::DoNotOptimize(dot);
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * len * sizeof(float));
+
+  double exact = 0.0, abs_sum = 0.0;
+  for (size_t i = 0; i < len; i++) {
+    exact += (double)a[i] * b[i];
+    abs_sum += std::fabs((double)a[i] * b[i]);
+  }
+  if (std::fabs(dot - exact) > (len + 1) * std::ldexp(1.0, -24) * abs_sum) {
+    state.SkipWithError("dot test failed");
+  }
+}
+
+static void bm_min(benchmark::State& state, sum_t fmin) {
+  size_t len = 5120;
+  std::vector<float> vec(len);
+  fill_random(vec.data(), len, 1.0);
+  if (fmin(vec.data(), len) != min_naive(vec.data(), len)) {
+    state.SkipWithError("min test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fmin(vec.data(), len));
+  }
+  state.SetBytesProcessed(state.iterations() * len * sizeof(float));
+}
+
+static void bm_max(benchmark::State& state, sum_t fmax) {
+  size_t len = 5120;
+  std::vector<float> vec(len);
+  fill_random(vec.data(), len, 1.0);
+  if (fmax(vec.data(), len) != max_naive(vec.data(), len)) {
+    state.SkipWithError("max test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fmax(vec.data(), len));
+  }
+  state.SetBytesProcessed(state.iterations() * len * sizeof(float));
+}
+
+// the dispatched reductions in one mode, over range(0) floats
+static void bm_reduce_sum(benchmark::State& state, simdstr_reduce_t mode) {
+  size_t len = state.range(0);
+  std::vector<float> vec(len);
+  fill_random(vec.data(), len, 1.0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(simdstr_reduce_sum(vec.data(), len, mode));
+  }
+  state.SetBytesProcessed(state.iterations() * len * sizeof(float));
+}
+
+static void bm_reduce_dot(benchmark::State& state, simdstr_reduce_t mode) {
+  size_t len = state.range(0);
+  std::vector<float> a(len), b(len);
+  fill_random(a.data(), len, 1.0);
+  fill_random(b.data(), len, 1.0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(simdstr_reduce_dot(a.data(), b.data(), len, mode));
+  }
+  state.SetBytesProcessed(state.iterations() * 2 * len * sizeof(float));
+}
+
 static void bm_memcmpeq(benchmark::State& state, memcmpeq_t memcmpeq) {
   std::string data1 = gen_ascii(10000);
   std::string data2 = data1;
@@ -128,6 +265,100 @@ static void bm_memcmpeq(benchmark::State& state, memcmpeq_t memcmpeq) {
   }
 }
 
+// the strings differ in their last byte
+static void bm_mismatch(benchmark::State& state, mismatch_t mismatch) {
+  std::string data1 = gen_ascii(10000);
+  std::string data2 = data1;
+  data2.back() ^= 1;
+  if (mismatch(data1.data(), data2.data(), data1.size()) != data1.size() - 1) {
+    state.SkipWithError("mismatch test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mismatch(data1.data(), data2.data(), data1.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * data1.size());
+}
+
+static void bm_memcmp3(benchmark::State& state, memcmp3_t memcmp3) {
+  std::string data1 = gen_ascii(10000);
+  std::string data2 = data1;
+  data2.back() ^= 1;
+  if ((memcmp3(data1.data(), data2.data(), data1.size()) < 0)
+      != (memcmp3_naive(data1.data(), data2.data(), data1.size()) < 0)) {
+    state.SkipWithError("memcmp3 test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(memcmp3(data1.data(), data2.data(), data1.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * data1.size());
+}
+
+// range(0) equal bytes, the tail is compared on every call
+static void bm_memcmpeq_size(benchmark::State& state, memcmpeq_t memcmpeq) {
+  size_t len = state.range(0);
+  std::string data1 = gen_ascii(len);
+  std::string data2 = data1;
+  test_memcmpeq(state, memcmpeq, data1.data(), data2.data(), len);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(memcmpeq(data1.data(), data2.data(), len));
+  }
+  state.SetBytesProcessed(state.iterations() * len);
+}
+
+// the ASCII letters of s in the other case
+static std::string swap_case(std::string s) {
+  for (auto& c : s) {
+    if (std::isalpha((unsigned char)c)) c ^= 0x20;
+  }
+  return s;
+}
+
+// the baseline of memcaseeq: both sides lowered to buffers, then compared
+static bool memcaseeq_lower_avx2(const char *s1, const char *s2, size_t len) {
+  static char buf1[4096], buf2[4096];
+  tolower_naive(buf1, s1, len);
+  tolower_naive(buf2, s2, len);
+  return memcmpeq_avx2(buf1, buf2, len);
+}
+
+// range(0) bytes equal in the other case, header names and short keys
+static void bm_memcaseeq_size(benchmark::State& state, memcmpeq_t memcaseeq) {
+  size_t len = state.range(0);
+  std::string data1 = gen_ascii(len);
+  std::string data2 = swap_case(data1);
+  if (!memcaseeq(data1.data(), data2.data(), len)) {
+    state.SkipWithError("memcaseeq test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(memcaseeq(data1.data(), data2.data(), len));
+  }
+  state.SetBytesProcessed(state.iterations() * len);
+}
+
+// keys of range(0) bytes that differ in their last byte, shows the tails
+static void bm_mismatch_size(benchmark::State& state, mismatch_t mismatch) {
+  size_t len = state.range(0);
+  std::string data1 = gen_ascii(len);
+  std::string data2 = data1;
+  if (len > 0) data2[len - 1] ^= 1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(mismatch(data1.data(), data2.data(), len));
+  }
+  state.SetBytesProcessed(state.iterations() * len);
+}
+
+// keys of range(0) bytes that differ in their last byte, shows the tails
+static void bm_memcmp3_size(benchmark::State& state, memcmp3_t memcmp3) {
+  size_t len = state.range(0);
+  std::string data1 = gen_ascii(len);
+  std::string data2 = data1;
+  if (len > 0) data2[len - 1] ^= 1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(memcmp3(data1.data(), data2.data(), len));
+  }
+  state.SetBytesProcessed(state.iterations() * len);
+}
+
 static void bm_tolower(benchmark::State& state, tolower_t tolower) {
   std::string data = gen_ascii(10000);
   const char *s = data.c_str();
@@ -143,6 +374,50 @@ static void bm_tolower(benchmark::State& state, tolower_t tolower) {
   delete[] buf;
 }
 
+static void bm_toupper(benchmark::State& state, toupper_t toupper) {
+  std::string data = gen_ascii(10000);
+  const char *s = data.c_str();
+  size_t len = data.size();
+
+  char *buf = new char[len];
+  for (auto _ : state) {
+    toupper(buf, s, len);
+  }
+
+  delete[] buf;
+}
+
+// tolower over range(0) bytes, shows the small-string crossover.
+static void bm_tolower_size(benchmark::State& state, tolower_t tolower) {
+  std::string data = gen_ascii(state.range(0));
+  const char *s = data.c_str();
+  size_t len = data.size();
+
+  test_tolower(state, tolower, s, len);
+
+  char *buf = new char[len];
+  for (auto _ : state) {
+    tolower(buf, s, len);
+    benchmark::DoNotOptimize(buf);
+  }
+  state.SetBytesProcessed(state.iterations() * len);
+
+  delete[] buf;
+}
+
+// in place over range(0) bytes, the buffer stays lower case after the first
+// iteration so this measures the scan without stores.
+static void bm_tolower_inplace_size(benchmark::State& state, inplace_t tolower_inplace) {
+  std::string data = gen_ascii(state.range(0));
+  size_t len = data.size();
+
+  for (auto _ : state) {
+    tolower_inplace(&data[0], len);
+    benchmark::DoNotOptimize(data.data());
+  }
+  state.SetBytesProcessed(state.iterations() * len);
+}
+
 static void bm_compact(benchmark::State& state, compact_t compact) {
   std::string data = gen_ascii(10000);
   const char *s = data.c_str();
@@ -158,6 +433,54 @@ static void bm_compact(benchmark::State& state, compact_t compact) {
   delete[] buf;
 }
 
+// compact over whitespace density range(0) percent.
+static void bm_compact_density(benchmark::State& state, compact_t compact) {
+  std::string data = gen_spaces(10000, state.range(0));
+  const char *s = data.c_str();
+  size_t len = data.size();
+
+  test_compact(state, compact, s, len);
+
+  char *buf = new char[len];
+  for (auto _ : state) {
+    compact(buf, s, len);
+    benchmark::DoNotOptimize(buf);
+  }
+  state.SetBytesProcessed(state.iterations() * len);
+
+  delete[] buf;
+}
+
+// compact over range(0) bytes with 5% whitespace
+static void bm_compact_size(benchmark::State& state, compact_t compact) {
+  std::string data = gen_spaces(state.range(0), 5);
+  const char *s = data.c_str();
+  size_t len = data.size();
+
+  test_compact(state, compact, s, len);
+
+  std::vector<char> buf(len);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(compact(buf.data(), s, len));
+  }
+  state.SetBytesProcessed(state.iterations() * len);
+}
+
+// a quoted string of range(0) bytes, the closing quote is in the tail
+static void bm_qstrlen_size(benchmark::State& state, qstrlen_t qstrlen) {
+  size_t len = state.range(0);
+  std::string data(len, 'a');
+  if (len > 0) data[0] = '"';
+  if (len > 1) data[len - 1] = '"';
+
+  test_qstrlen(state, qstrlen, data.data(), len);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(qstrlen(data.data(), len));
+  }
+  state.SetBytesProcessed(state.iterations() * len);
+}
+
 static void bm_qstrlen(benchmark::State& state, qstrlen_t qstrlen) {
   std::string data = quote(gen_ascii(10000));
   const char *s = data.c_str();
@@ -170,6 +493,690 @@ static void bm_qstrlen(benchmark::State& state, qstrlen_t qstrlen) {
   }
 }
 
+// A twitter.json-like document of about 630 KB: an array of statuses with a
+// nested user, mostly short strings with some escapes and UTF-8, numbers and
+// indentation.
+static std::string gen_twitter_json() {
+  std::mt19937 gen(42);
+  auto text = [&gen](size_t len) {
+    const char *words[] = {"the", "simd", "\\n", "caf\xc3\xa9", "\\\"quoted\\\"", "http:\\/\\/t.co",
+                           "\xe6\x97\xa5\xe6\x9c\xac", "#json", "@user", "ok,", "{x}"};
+    std::string s;
+    while (s.size() < len) {
+      s += words[gen() % (sizeof(words) / sizeof(words[0]))];
+      s += ' ';
+    }
+    return s;
+  };
+  std::string json = "{\n  \"statuses\": [\n";
+  while (json.size() < 630000) {
+    json += "    {\n      \"created_at\": \"Sun Aug 31 00:29:15 +0000 2014\",\n";
+    json += "      \"id\": " + std::to_string(gen()) + std::to_string(gen() % 1000) + ",\n";
+    json += "      \"text\": \"" + text(40 + gen() % 100) + "\",\n";
+    json += "      \"entities\": {\"hashtags\": [], \"urls\": [], \"user_mentions\": []},\n";
+    json += "      \"user\": {\n        \"id\": " + std::to_string(gen()) + ",\n";
+    json += "        \"name\": \"" + text(8) + "\",\n";
+    json += "        \"description\": \"" + text(gen() % 120) + "\",\n";
+    json += "        \"followers_count\": " + std::to_string(gen() % 100000) + ",\n";
+    json += "        \"verified\": false\n      },\n";
+    json += "      \"retweet_count\": " + std::to_string(gen() % 100) + ",\n";
+    json += "      \"favorited\": false\n    },\n";
+  }
+  json.resize(json.size() - 2);
+  json += "\n  ]\n}\n";
+  return json;
+}
+
+static void bm_json_index(benchmark::State& state, json_index_t json_index) {
+  static const std::string json = gen_twitter_json();
+  std::vector<uint32_t> index(json.size()), expected(json.size());
+  int64_t n = json_index(json.data(), json.size(), index.data());
+  if (n != json_index_naive(json.data(), json.size(), expected.data())
+      || !std::equal(index.begin(), index.begin() + n, expected.begin())) {
+    state.SkipWithError("json_index test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(json_index(json.data(), json.size(), index.data()));
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+
+// 4096 values of the given number of digits, of 1 to 20 digits for 0
+static std::vector<uint64_t> gen_digits(int digits) {
+  std::mt19937_64 gen(42);
+  std::vector<uint64_t> vals(4096);
+  for (auto& v : vals) {
+    int d = digits ? digits : 1 + gen() % 20;
+    uint64_t lo = 1;
+    for (int i = 1; i < d; i++) lo *= 10;
+    uint64_t span = d == 20 ? UINT64_MAX - lo : 9 * lo;
+    v = (d == 1 ? 0 : lo) + gen() % span;
+  }
+  return vals;
+}
+
+static size_t u64toa_snprintf(uint64_t val, char *out) {
+  return snprintf(out, SIMDSTR_ITOA_BUF, "%" PRIu64, val);
+}
+
+static void bm_u64toa(benchmark::State& state, u64toa_t u64toa) {
+  std::vector<uint64_t> vals = gen_digits(state.range(0));
+  std::vector<char> out(20 * vals.size() + SIMDSTR_ITOA_BUF);
+  char buf[SIMDSTR_ITOA_BUF];
+  for (uint64_t v : vals) {
+    size_t n = u64toa(v, buf);
+    if (std::string(buf, n) != std::to_string(v)) {
+      state.SkipWithError("u64toa test failed");
+      break;
+    }
+  }
+  for (auto _ : state) {
+    char *p = out.data();
+    for (uint64_t v : vals) {
+      p += u64toa(v, p);
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * vals.size());
+}
+
+static void bm_u64toa_batch(benchmark::State& state, u64toa_batch_t u64toa_batch) {
+  std::vector<uint64_t> vals = gen_digits(state.range(0));
+  std::vector<char> out(20 * vals.size() + SIMDSTR_ITOA_BUF);
+  std::vector<size_t> lens(vals.size());
+  std::string expected;
+  for (uint64_t v : vals) expected += std::to_string(v);
+  size_t n = u64toa_batch(vals.data(), vals.size(), out.data(), lens.data());
+  if (std::string(out.data(), n) != expected) {
+    state.SkipWithError("u64toa_batch test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(u64toa_batch(vals.data(), vals.size(), out.data(), lens.data()));
+  }
+  state.SetItemsProcessed(state.iterations() * vals.size());
+}
+
+// A CSV column: one number per line. Integers of range(0) digits as in
+// u64toa, doubles as prices with 2 decimals for 0 and of 17 digits for 1.
+static std::string gen_int_column(int digits) {
+  std::string col;
+  for (uint64_t v : gen_digits(digits)) col += std::to_string(v) + "\n";
+  return col;
+}
+
+static std::string gen_float_column(int kind) {
+  std::mt19937_64 gen(42);
+  std::uniform_real_distribution<double> price(0, 10000);
+  std::string col;
+  char buf[64];
+  for (int i = 0; i < 4096; i++) {
+    if (kind == 0) {
+      snprintf(buf, sizeof(buf), "%.2f\n", price(gen));
+    } else {
+      snprintf(buf, sizeof(buf), "%.17g\n", std::ldexp(price(gen), (int)(gen() % 200) - 100));
+    }
+    col += buf;
+  }
+  return col;
+}
+
+static size_t atou64_strtoull(const char *str, size_t, uint64_t *val) {
+  char *end;
+  *val = strtoull(str, &end, 10);
+  return end - str;
+}
+
+static size_t atof_strtod(const char *str, size_t, double *val) {
+  char *end;
+  *val = strtod(str, &end);
+  return end - str;
+}
+
+static void bm_atou64(benchmark::State& state, atou64_t atou64) {
+  std::string col = gen_int_column(state.range(0));
+  uint64_t sum = 0, want = 0;
+  for (uint64_t v : gen_digits(state.range(0))) want += v;
+  for (auto _ : state) {
+    sum = 0;
+    for (const char *p = col.data(), *end = p + col.size(); p < end; ) {
+      uint64_t v;
+      p += atou64(p, end - p, &v) + 1;
+      sum += v;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  if (sum != want) {
+    state.SkipWithError("atou64 test failed");
+  }
+  state.SetItemsProcessed(state.iterations() * 4096);
+}
+
+static void bm_atof(benchmark::State& state, atof_t atof) {
+  std::string col = gen_float_column(state.range(0));
+  double sum = 0, want = 0;
+  for (const char *p = col.c_str(); *p; p++) {
+    char *end;
+    want += strtod(p, &end);
+    p = end;
+  }
+  for (auto _ : state) {
+    sum = 0;
+    for (const char *p = col.data(), *end = p + col.size(); p < end; ) {
+      double v;
+      p += atof(p, end - p, &v) + 1;
+      sum += v;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  if (sum != want) {
+    state.SkipWithError("atof test failed");
+  }
+  state.SetItemsProcessed(state.iterations() * 4096);
+}
+
+// 64 KiB of UTF-8 text: 0 ASCII, 1 Latin with a tenth of accented letters,
+// 2 CJK with ASCII spaces and punctuation, 3 ASCII words and emoji
+static std::string gen_utf8_text(int kind) {
+  static const char *const latin[] = {"\xC3\xA9", "\xC3\xA8", "\xC3\xA0", "\xC3\xA7", "\xC3\xBC"};
+  std::mt19937 gen(42);
+  std::string s;
+  while (s.size() < (64 << 10)) {
+    int r = gen() % 10;
+    switch (kind) {
+    case 0: s += (char)('a' + gen() % 26); break;
+    case 1: s += r == 0 ? latin[gen() % 5] : std::string(1, (char)('a' + gen() % 26)); break;
+    case 2: {
+      uint32_t cp = 0x4E00 + gen() % 0x5000;
+      s += r == 0 ? std::string(1, ' ') : std::string{(char)(0xE0 | cp >> 12), (char)(0x80 | (cp >> 6 & 0x3F)),
+                                                     (char)(0x80 | (cp & 0x3F))};
+      break;
+    }
+    default: {
+      uint32_t cp = 0x1F600 + gen() % 0x50;
+      s += r < 5 ? std::string{(char)(0xF0 | cp >> 18), (char)(0x80 | (cp >> 12 & 0x3F)),
+                               (char)(0x80 | (cp >> 6 & 0x3F)), (char)(0x80 | (cp & 0x3F))}
+                 : std::string(1, (char)('a' + gen() % 26));
+    }
+    }
+  }
+  return s;
+}
+
+static void bm_utf8_validate(benchmark::State& state, utf8_validate_t validate) {
+  std::string text = gen_utf8_text(state.range(0));
+  if (!validate(text.data(), text.size())) {
+    state.SkipWithError("utf8_validate test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(validate(text.data(), text.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+static void bm_utf8_count(benchmark::State& state, utf8_count_t count) {
+  std::string text = gen_utf8_text(state.range(0));
+  if (count(text.data(), text.size()) != utf8_count_naive(text.data(), text.size())) {
+    state.SkipWithError("utf8_count test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(count(text.data(), text.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+static void bm_utf8_to_utf16(benchmark::State& state, utf8_to_utf16_t to_utf16) {
+  std::string text = gen_utf8_text(state.range(0));
+  std::vector<uint16_t> out(text.size()), want(text.size());
+  int64_t n = to_utf16(out.data(), text.data(), text.size());
+  if (n != utf8_to_utf16_naive(want.data(), text.data(), text.size())
+      || !std::equal(out.begin(), out.begin() + n, want.begin())) {
+    state.SkipWithError("utf8_to_utf16 test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(to_utf16(out.data(), text.data(), text.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+static void bm_utf16_to_utf8(benchmark::State& state, utf16_to_utf8_t to_utf8) {
+  std::string text = gen_utf8_text(state.range(0));
+  std::vector<uint16_t> units(text.size());
+  units.resize(utf8_to_utf16_naive(units.data(), text.data(), text.size()));
+  std::vector<char> out(3 * units.size());
+  int64_t n = to_utf8(out.data(), units.data(), units.size());
+  if (std::string(out.data(), n < 0 ? 0 : n) != text) {
+    state.SkipWithError("utf16_to_utf8 test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(to_utf8(out.data(), units.data(), units.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+// 64 KiB of capitalized words, range(0) percent of them Cyrillic and the
+// rest ASCII
+static std::string gen_mixed_text(int cyrillic) {
+  std::mt19937 gen(42);
+  std::string s;
+  while (s.size() < (64 << 10)) {
+    bool cyr = (int)(gen() % 100) < cyrillic;
+    size_t len = 2 + gen() % 8;
+    for (size_t i = 0; i < len; i++) {
+      if (cyr) {
+        uint32_t cp = (i == 0 ? 0x410 : 0x430) + gen() % 32;
+        s += (char)(0xC0 | cp >> 6);
+        s += (char)(0x80 | (cp & 0x3F));
+      } else {
+        s += (char)((i == 0 ? 'A' : 'a') + gen() % 26);
+      }
+    }
+    s += ' ';
+  }
+  return s;
+}
+
+static void bm_casefold_utf8(benchmark::State& state, casefold_utf8_t casefold) {
+  std::string text = gen_mixed_text(state.range(0));
+  std::vector<char> out(3 * text.size()), want(3 * text.size());
+  size_t n = casefold(out.data(), text.data(), text.size());
+  if (n != casefold_utf8_naive(want.data(), text.data(), text.size())
+      || memcmp(out.data(), want.data(), n) != 0) {
+    state.SkipWithError("casefold_utf8 test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(casefold(out.data(), text.data(), text.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+// a set of range(0) random bytes and 64 KiB of the bytes out of it
+struct charset_text {
+  simdstr_charset_t cs;
+  std::string text;
+  explicit charset_text(size_t count) {
+    std::mt19937 gen(42);
+    std::string set, rest;
+    std::vector<bool> in(256);
+    for (size_t i = 0; i < count; i++) in[gen() % 256] = true;
+    for (int c = 0; c < 256; c++) (in[c] ? set : rest) += (char)c;
+    simdstr_charset_init(&cs, set.data(), set.size());
+    text.resize(64 << 10);
+    for (auto& c : text) c = rest[gen() % rest.size()];
+    text.back() = set[0];
+  }
+};
+
+// the only byte of the set is the last one
+static void bm_find_first_of(benchmark::State& state, find_of_t find) {
+  charset_text t(state.range(0));
+  if (find(&t.cs, t.text.data(), t.text.size()) != &t.text.back()) {
+    state.SkipWithError("find_first_of test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(find(&t.cs, t.text.data(), t.text.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * t.text.size());
+}
+
+// half of the bytes are in the set
+static void bm_count_of(benchmark::State& state, count_of_t count) {
+  charset_text t(state.range(0));
+  for (size_t i = 0; i < t.text.size(); i += 2) t.text[i] = t.text.back();
+  if (count(&t.cs, t.text.data(), t.text.size()) != count_of_naive(&t.cs, t.text.data(), t.text.size())) {
+    state.SkipWithError("count_of test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(count(&t.cs, t.text.data(), t.text.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * t.text.size());
+}
+
+// 64 KiB of ASCII with range(0) quotes or backslashes per 1000 bytes
+static std::string gen_escaped(size_t per_mille) {
+  std::string s = gen_ascii(64 << 10);
+  for (auto& c : s) {
+    if (c == '"' || c == '\\') c = 'x';
+  }
+  for (size_t i = 0; per_mille > 0 && i < s.size(); i += 1000 / per_mille) {
+    s[i] = rand() % 2 ? '"' : '\\';
+  }
+  return s;
+}
+
+static void bm_quote(benchmark::State& state, quote_t q) {
+  std::string text = gen_escaped(state.range(0));
+  std::string want = quote(text);
+  std::vector<char> out(2 * text.size() + 2);
+  if (std::string(out.data(), q(out.data(), text.data(), text.size(), SIMDSTR_ESCAPE_QUOTES)) != want) {
+    state.SkipWithError("quote test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(q(out.data(), text.data(), text.size(), SIMDSTR_ESCAPE_QUOTES));
+  }
+  state.SetBytesProcessed(state.iterations() * text.size());
+}
+
+static void bm_unquote(benchmark::State& state, unquote_t uq) {
+  std::string text = gen_escaped(state.range(0));
+  std::string data = quote(text);
+  std::vector<char> out(data.size());
+  if (uq(out.data(), data.data(), data.size(), SIMDSTR_ESCAPE_QUOTES) != (int64_t)text.size()
+      || std::string(out.data(), text.size()) != text) {
+    state.SkipWithError("unquote test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(uq(out.data(), data.data(), data.size(), SIMDSTR_ESCAPE_QUOTES));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+static void bm_crc32c_size(benchmark::State& state, crc32c_t crc32c) {
+  std::string data = gen_ascii(state.range(0));
+  if (crc32c(0, data.data(), data.size()) != crc32c_naive(0, data.data(), data.size())) {
+    state.SkipWithError("crc32c test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(crc32c(0, data.data(), data.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// the murmur hash of std::hash<std::string> in libstdc++, a scalar baseline
+static uint64_t hash64_std(const char *s, size_t len, uint64_t seed) {
+  return std::_Hash_bytes(s, len, seed);
+}
+
+static void bm_hash64_size(benchmark::State& state, hash64_t hash64) {
+  std::string data = gen_ascii(state.range(0));
+  if (hash64 != hash64_std && hash64(data.data(), data.size(), 1) != hash64_naive(data.data(), data.size(), 1)) {
+    state.SkipWithError("hash64 test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(hash64(data.data(), data.size(), 1));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// the bytes per second are the ones of the binary side
+static void bm_base64_encode_size(benchmark::State& state, base64_encode_t enc) {
+  std::string data = gen_ascii(state.range(0));
+  std::vector<char> out(4 * ((data.size() + 2) / 3)), want(out.size());
+  if (enc(out.data(), data.data(), data.size(), SIMDSTR_BASE64_STD) != out.size() ||
+      (base64_encode_naive(want.data(), data.data(), data.size(), SIMDSTR_BASE64_STD), out != want)) {
+    state.SkipWithError("base64_encode test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(enc(out.data(), data.data(), data.size(), SIMDSTR_BASE64_STD));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+static void bm_base64_decode_size(benchmark::State& state, base64_decode_t dec) {
+  std::string data = gen_ascii(state.range(0));
+  std::vector<char> enc(4 * ((data.size() + 2) / 3)), out(data.size() + 3);
+  base64_encode_naive(enc.data(), data.data(), data.size(), SIMDSTR_BASE64_STD);
+  if (dec(out.data(), enc.data(), enc.size(), SIMDSTR_BASE64_STD, nullptr) != (int64_t)data.size() ||
+      memcmp(out.data(), data.data(), data.size()) != 0) {
+    state.SkipWithError("base64_decode test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dec(out.data(), enc.data(), enc.size(), SIMDSTR_BASE64_STD, nullptr));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+static void bm_hex_encode_size(benchmark::State& state, hex_encode_t enc) {
+  std::string data = gen_ascii(state.range(0));
+  std::vector<char> out(2 * data.size()), want(out.size());
+  hex_encode_naive(want.data(), data.data(), data.size());
+  if (enc(out.data(), data.data(), data.size()) != out.size() || out != want) {
+    state.SkipWithError("hex_encode test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(enc(out.data(), data.data(), data.size()));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+static void bm_hex_decode_size(benchmark::State& state, hex_decode_t dec) {
+  std::string data = gen_ascii(state.range(0));
+  std::vector<char> enc(2 * data.size()), out(data.size());
+  hex_encode_naive(enc.data(), data.data(), data.size());
+  if (dec(out.data(), enc.data(), enc.size(), nullptr) != (int64_t)data.size() ||
+      memcmp(out.data(), data.data(), data.size()) != 0) {
+    state.SkipWithError("hex_decode test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(dec(out.data(), enc.data(), enc.size(), nullptr));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+static char* memchr_glibc(const char *s, int c, size_t len) {
+  return (char *)memchr(s, c, len);
+}
+
+static char* memrchr_glibc(const char *s, int c, size_t len) {
+  return (char *)memrchr(s, c, len);
+}
+
+static size_t count_byte_std(const char *s, int c, size_t len) {
+  return std::count(s, s + len, (char)c);
+}
+
+static char* memcpy_glibc(char *dst, const char *src, size_t len) {
+  return (char *)memcpy(dst, src, len);
+}
+
+// range(0) bytes from range(1) bytes past a cache line to range(2) bytes past one
+static void bm_memcpy_size(benchmark::State& state, memcpy_t f) {
+  size_t len = state.range(0);
+  char *src = (char *)aligned_alloc(64, len + 64);
+  char *dst = (char *)aligned_alloc(64, len + 64);
+  for (size_t i = 0; i < len + 64; i++) src[i] = (char)i;
+  memset(dst, 0, len + 64);
+  f(dst + state.range(2), src + state.range(1), len);
+  if (memcmp(dst + state.range(2), src + state.range(1), len) != 0) {
+    state.SkipWithError("memcpy test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(f(dst + state.range(2), src + state.range(1), len));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * len);
+  free(src);
+  free(dst);
+}
+
+// the byte at range(0) bytes from the start (from the end for memrchr) of a
+// buffer 64 bytes longer
+static void bm_memchr_dist(benchmark::State& state, memchr_t f, bool reverse) {
+  size_t dist = state.range(0);
+  std::string data(dist + 64, 'a');
+  const char *want = reverse ? &data[63] : &data[dist];
+  data[want - data.data()] = '\n';
+  if (f(data.data(), '\n', data.size()) != want) {
+    state.SkipWithError("memchr test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(f(data.data(), '\n', data.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * (dist + 1));
+}
+
+// as bm_memchr_dist, the other bytes looked for are not in the buffer
+static void bm_memchr2_dist(benchmark::State& state, memchr2_t f) {
+  size_t dist = state.range(0);
+  std::string data(dist + 64, 'a');
+  data[dist] = '\n';
+  if (f(data.data(), '\r', '\n', data.size()) != &data[dist]) {
+    state.SkipWithError("memchr2 test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(f(data.data(), '\r', '\n', data.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * (dist + 1));
+}
+
+static void bm_memchr3_dist(benchmark::State& state, memchr3_t f) {
+  size_t dist = state.range(0);
+  std::string data(dist + 64, 'a');
+  data[dist] = '\n';
+  if (f(data.data(), '"', '\\', '\n', data.size()) != &data[dist]) {
+    state.SkipWithError("memchr3 test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(f(data.data(), '"', '\\', '\n', data.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * (dist + 1));
+}
+
+// the newlines of text lines of 64 bytes on average
+static void bm_count_byte_size(benchmark::State& state, count_byte_t f) {
+  std::string data = gen_ascii(state.range(0));
+  std::mt19937 gen(1);
+  for (auto& c : data) {
+    if (gen() % 64 == 0) c = '\n';
+  }
+  if (f(data.data(), '\n', data.size()) != count_byte_naive(data.data(), '\n', data.size())) {
+    state.SkipWithError("count_byte test failed");
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(f(data.data(), '\n', data.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// a 1 MiB quoted string received in chunks of range(0) bytes: fed to the
+// streaming qstrlen, or appended to a growing buffer scanned at the end
+static void bm_qstrlen_stream(benchmark::State& state, bool stream) {
+  std::string data = quote(gen_spaces(1 << 20, 5));
+  size_t chunk = state.range(0);
+  std::string buf;
+  for (auto _ : state) {
+    int n;
+    if (stream) {
+      simdstr_qstrlen_state_t st;
+      simdstr_qstrlen_init(&st);
+      for (size_t off = 0; off < data.size(); off += chunk) {
+        simdstr_qstrlen_update(&st, data.data() + off, std::min(chunk, data.size() - off));
+      }
+      n = simdstr_qstrlen_final(&st);
+    } else {
+      buf.clear();
+      for (size_t off = 0; off < data.size(); off += chunk) {
+        buf.append(data, off, chunk);
+      }
+      n = simdstr_qstrlen(buf.data(), buf.size());
+    }
+    benchmark::DoNotOptimize(n);
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// 4096 strings of range(0) to range(1) bytes, uniformly, in one buffer. Half
+// of them are quoted for qstrlen.
+struct Batch {
+  std::string buf;
+  std::vector<simdstr_slice_t> src;
+  std::vector<char *> dst;
+  std::string out;
+
+  Batch(size_t lo, size_t hi) {
+    std::mt19937 gen(42);
+    std::vector<size_t> lens(4096);
+    for (auto& len : lens) len = lo + gen() % (hi - lo + 1);
+    for (size_t i = 0; i < lens.size(); i++) {
+      std::string s = gen_spaces(lens[i], 0);
+      if (i % 2 == 0 && lens[i] >= 2) {
+        s.front() = s.back() = '"';
+      }
+      buf += s;
+    }
+    out.resize(buf.size());
+    size_t off = 0;
+    for (size_t len : lens) {
+      src.push_back(simdstr_slice_t{buf.data() + off, len});
+      dst.push_back(&out[off]);
+      off += len;
+    }
+  }
+};
+
+static void bm_tolower_batch(benchmark::State& state, bool batch) {
+  Batch b(state.range(0), state.range(1));
+  for (auto _ : state) {
+    if (batch) {
+      simdstr_tolower_batch(b.dst.data(), b.src.data(), b.src.size());
+    } else {
+      for (size_t i = 0; i < b.src.size(); i++) {
+        simdstr_tolower(b.dst[i], b.src[i].ptr, b.src[i].len);
+      }
+    }
+    benchmark::DoNotOptimize(b.out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * b.src.size());
+}
+
+// equal keys at different addresses, the worst case of a hash table probe
+static void bm_memcmpeq_batch(benchmark::State& state, bool batch) {
+  Batch b(state.range(0), state.range(1));
+  std::string copy = b.buf;
+  std::vector<simdstr_slice_t> other;
+  for (const auto& s : b.src) {
+    other.push_back(simdstr_slice_t{copy.data() + (s.ptr - b.buf.data()), s.len});
+  }
+  std::unique_ptr<bool[]> out(new bool[b.src.size()]);
+  for (auto _ : state) {
+    if (batch) {
+      simdstr_memcmpeq_batch(b.src.data(), other.data(), b.src.size(), out.get());
+    } else {
+      for (size_t i = 0; i < b.src.size(); i++) {
+        out[i] = b.src[i].len == other[i].len
+          && simdstr_memcmpeq(b.src[i].ptr, other[i].ptr, b.src[i].len);
+      }
+    }
+    benchmark::DoNotOptimize(out.get());
+  }
+  state.SetItemsProcessed(state.iterations() * b.src.size());
+}
+
+static void bm_hash64_batch(benchmark::State& state, bool batch) {
+  Batch b(state.range(0), state.range(1));
+  std::vector<uint64_t> out(b.src.size());
+  for (auto _ : state) {
+    if (batch) {
+      simdstr_hash64_batch(b.src.data(), b.src.size(), 1, out.data());
+    } else {
+      for (size_t i = 0; i < b.src.size(); i++) {
+        out[i] = simdstr_hash64(b.src[i].ptr, b.src[i].len, 1);
+      }
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * b.src.size());
+}
+
+static void bm_qstrlen_batch(benchmark::State& state, bool batch) {
+  Batch b(state.range(0), state.range(1));
+  std::vector<int> out(b.src.size());
+  for (auto _ : state) {
+    if (batch) {
+      simdstr_qstrlen_batch(b.src.data(), b.src.size(), out.data());
+    } else {
+      for (size_t i = 0; i < b.src.size(); i++) {
+        out[i] = simdstr_qstrlen(b.src[i].ptr, b.src[i].len);
+      }
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * b.src.size());
+}
+
 static void bm_strstr(benchmark::State& state, strstr_t strstr) {
   size_t len = 10000;
   std::string substr = "hello";
@@ -185,6 +1192,126 @@ static void bm_strstr(benchmark::State& state, strstr_t strstr) {
   delete[] buf;
 }
 
+// needle of range(0) bytes at the end of a 64 KB random haystack.
+static void bm_strstr_needle(benchmark::State& state, strstr_t strstr) {
+  size_t len = 64 * 1024;
+  std::string substr = gen_ascii(state.range(0));
+  std::string data = gen_ascii(len) + substr;
+
+  test_strstr(state, strstr, data.c_str(), data.size(), substr.c_str(), substr.size());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(strstr(data.c_str(), data.size(), substr.c_str(), substr.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// every other position of the "abab..." haystack is a candidate of the
+// "abab...b" needle of range(0) bytes, and none of them matches.
+static void bm_strstr_adversarial(benchmark::State& state, strstr_t strstr) {
+  size_t sn = state.range(0);
+  std::string substr = std::string(sn - 1, 'a') + "b";
+  for (size_t i = 1; i + 1 < sn; i += 2) substr[i] = 'b';
+  std::string data(64 * 1024, 'a');
+  for (size_t i = 1; i < data.size(); i += 2) data[i] = 'b';
+  if (sn % 2 == 0) substr[sn - 2] = 'a', substr[sn - 1] = 'a';
+
+  test_strstr(state, strstr, data.c_str(), data.size(), substr.c_str(), substr.size());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(strstr(data.c_str(), data.size(), substr.c_str(), substr.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// needle of range(0) bytes in the other case at the end of a 64 KB random haystack
+static void bm_strcasestr_needle(benchmark::State& state, strstr_t strcasestr) {
+  size_t len = 64 * 1024;
+  std::string substr = gen_ascii(state.range(0));
+  std::string data = gen_ascii(len) + swap_case(substr);
+
+  test_strcasestr(state, strcasestr, data.c_str(), data.size(), substr.c_str(), substr.size());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(strcasestr(data.c_str(), data.size(), substr.c_str(), substr.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// bm_strstr_adversarial with the haystack in upper case
+static void bm_strcasestr_adversarial(benchmark::State& state, strstr_t strcasestr) {
+  size_t sn = state.range(0);
+  std::string substr = std::string(sn - 1, 'a') + "b";
+  for (size_t i = 1; i + 1 < sn; i += 2) substr[i] = 'b';
+  std::string data(64 * 1024, 'A');
+  for (size_t i = 1; i < data.size(); i += 2) data[i] = 'B';
+  if (sn % 2 == 0) substr[sn - 2] = 'a', substr[sn - 1] = 'a';
+
+  test_strcasestr(state, strcasestr, data.c_str(), data.size(), substr.c_str(), substr.size());
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(strcasestr(data.c_str(), data.size(), substr.c_str(), substr.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * data.size());
+}
+
+// range(0) keywords of 5..10 lowercase letters, a few of them occur in a
+// 64 KB log of lowercase words.
+static void gen_keywords(size_t count, std::vector<std::string>& keywords, std::string& log) {
+  auto word = [] {
+    std::string w(5 + std::rand() % 6, 'a');
+    for (auto& c : w) c = 'a' + std::rand() % 26;
+    return w;
+  };
+  keywords.clear();
+  for (size_t i = 0; i < count; i++) keywords.push_back(word());
+  log.clear();
+  while (log.size() < 64 * 1024) {
+    log += std::rand() % 64 == 0 ? keywords[std::rand() % count] : word();
+    log += std::rand() % 16 == 0 ? '\n' : ' ';
+  }
+}
+
+static bool count_match(size_t, size_t, void *ctx) {
+  ++*static_cast<size_t*>(ctx);
+  return true;
+}
+
+static void bm_strstr_multi(benchmark::State& state) {
+  std::vector<std::string> keywords;
+  std::string log;
+  gen_keywords(state.range(0), keywords, log);
+  std::vector<const char*> ptrs;
+  std::vector<size_t> lens;
+  for (const auto& k : keywords) {
+    ptrs.push_back(k.data());
+    lens.push_back(k.size());
+  }
+  strstr_multi_t *m = strstr_multi_new(ptrs.data(), lens.data(), keywords.size());
+
+  for (auto _ : state) {
+    size_t count = 0;
+    strstr_multi_scan(m, log.data(), log.size(), count_match, &count);
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetBytesProcessed(state.iterations() * log.size());
+  strstr_multi_free(m);
+}
+
+// one strstr_naive per keyword, the baseline of bm_strstr_multi
+static void bm_strstr_multi_naive(benchmark::State& state) {
+  std::vector<std::string> keywords;
+  std::string log;
+  gen_keywords(state.range(0), keywords, log);
+
+  for (auto _ : state) {
+    for (const auto& k : keywords) {
+      benchmark::DoNotOptimize(strstr_naive(log.data(), log.size(), k.data(), k.size()));
+    }
+  }
+  state.SetBytesProcessed(state.iterations() * log.size());
+}
+
 int main(int argc, char **argv) {
   using benchmark::RegisterBenchmark;
   benchmark::Initialize(&argc, argv);
@@ -195,26 +1322,487 @@ int main(int argc, char **argv) {
     bm_##func, func##_##arch);                  \
   } while(0)
 
+// only register the kernels the running cpu can execute
+#define ADD_ISA_BM(func, arch, isa)  do {       \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) { \
+    ADD_BM(func, arch);                         \
+  }                                             \
+  } while(0)
+
+// sizes from 16 B to 1 MiB
+#define ADD_SIZE_BM(func, arch, isa)  do {               \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      (std::string(#func) + "_" + #arch + "/size").c_str(), \
+      bm_##func##_size, func##_##arch)                   \
+      ->RangeMultiplier(4)->Range(16, 1 << 20);          \
+  }                                                      \
+  } while(0)
+
+// whitespace densities of 0%, 5%, 50% and 100%
+#define ADD_DENSITY_BM(func, arch, isa)  do {            \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      (std::string(#func) + "_" + #arch + "/density").c_str(), \
+      bm_##func##_density, func##_##arch)                \
+      ->Arg(0)->Arg(5)->Arg(50)->Arg(100);               \
+  }                                                      \
+  } while(0)
+
+// needle lengths from 1 to 256 on random and adversarial haystacks
+#define ADD_NEEDLE_BM(func, arch, isa)  do {             \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      (std::string(#func) + "_" + #arch + "/needle").c_str(), \
+      bm_##func##_needle, func##_##arch)                 \
+      ->RangeMultiplier(2)->Range(1, 256);               \
+    benchmark::RegisterBenchmark(                        \
+      (std::string(#func) + "_" + #arch + "/adversarial").c_str(), \
+      bm_##func##_adversarial, func##_##arch)            \
+      ->RangeMultiplier(2)->Range(2, 256);               \
+  }                                                      \
+  } while(0)
+
+// the dispatched entry points, SIMDSTR_ISA selects the level
+#define ADD_DISPATCH_BM(func)  do {             \
+  benchmark::RegisterBenchmark(                 \
+    (std::string("simdstr_") + #func + "_" +    \
+      simdstr_isa_name(simdstr_isa())).c_str(), \
+    bm_##func, simdstr_##func);                 \
+  } while(0)
+
+// every length from 0 to 256 B, the dispatched entry point. The tails show
+// as a saw tooth when they fall back to scalar code.
+#define ADD_TAIL_BM(func)  do {                 \
+  benchmark::RegisterBenchmark(                 \
+    (std::string("simdstr_") + #func + "_" +    \
+      simdstr_isa_name(simdstr_isa()) + "/tail").c_str(), \
+    bm_##func##_size, simdstr_##func)           \
+    ->DenseRange(0, 256, 1);                    \
+  } while(0)
+
   ADD_BM(sum, naive);
-  ADD_BM(sum, simd);
-  ADD_BM(sum, simd_fast);
+  ADD_BM(sum, sse);
+  ADD_ISA_BM(sum, simd, AVX2);
+  ADD_ISA_BM(sum, simd_fast, AVX2);
+  ADD_ISA_BM(sum, avx512, AVX512);
+  ADD_BM(sum, fast_sse);
+  ADD_ISA_BM(sum, fast_avx2, AVX2);
+  ADD_ISA_BM(sum, fast_avx512, AVX512);
+  ADD_BM(sum, kahan_naive);
+  ADD_BM(sum, kahan_sse);
+  ADD_ISA_BM(sum, kahan_avx2, AVX2);
+  ADD_ISA_BM(sum, kahan_avx512, AVX512);
+  ADD_BM(sum, repro_naive);
+  ADD_BM(sum, repro_sse);
+  ADD_ISA_BM(sum, repro_avx2, AVX2);
+  ADD_ISA_BM(sum, repro_avx512, AVX512);
+  ADD_BM(dot, naive);
+  ADD_BM(dot, fast_sse);
+  ADD_ISA_BM(dot, fast_avx2, AVX2);
+  ADD_ISA_BM(dot, fast_avx512, AVX512);
+  ADD_BM(dot, kahan_naive);
+  ADD_BM(dot, kahan_sse);
+  ADD_ISA_BM(dot, kahan_avx2, AVX2);
+  ADD_ISA_BM(dot, kahan_avx512, AVX512);
+  ADD_BM(dot, repro_naive);
+  ADD_BM(dot, repro_sse);
+  ADD_ISA_BM(dot, repro_avx2, AVX2);
+  ADD_ISA_BM(dot, repro_avx512, AVX512);
+  ADD_BM(min, naive);
+  ADD_BM(min, sse);
+  ADD_ISA_BM(min, avx2, AVX2);
+  ADD_ISA_BM(min, avx512, AVX512);
+  ADD_BM(max, naive);
+  ADD_BM(max, sse);
+  ADD_ISA_BM(max, avx2, AVX2);
+  ADD_ISA_BM(max, avx512, AVX512);
   ADD_BM(memcmpeq, naive);
   ADD_BM(memcmpeq, sse);
-  ADD_BM(memcmpeq, sse4_2);
-  ADD_BM(memcmpeq, sse4_2_fast);
-  ADD_BM(memcmpeq, avx2);
-#if __AVX512F__ &&  __AVX512BW__
-  ADD_BM(memcmpeq, avx512);
-#endif
+  ADD_ISA_BM(memcmpeq, sse4_2, SSE4_2);
+  ADD_ISA_BM(memcmpeq, sse4_2_fast, SSE4_2);
+  ADD_ISA_BM(memcmpeq, avx2, AVX2);
+  ADD_ISA_BM(memcmpeq, avx512, AVX512);
   ADD_BM(memcmpeq, autovec);
+  ADD_BM(mismatch, naive);
+  ADD_BM(mismatch, sse);
+  ADD_ISA_BM(mismatch, avx2, AVX2);
+  ADD_ISA_BM(mismatch, avx512, AVX512);
+  ADD_BM(memcmp3, naive);
+  ADD_BM(memcmp3, sse);
+  ADD_ISA_BM(memcmp3, avx2, AVX2);
+  ADD_ISA_BM(memcmp3, avx512, AVX512);
 
   ADD_BM(tolower, naive);
+  ADD_BM(tolower, sse);
+  ADD_ISA_BM(tolower, avx2, AVX2);
+  ADD_ISA_BM(tolower, avx512, AVX512);
+  ADD_BM(toupper, naive);
+  ADD_BM(toupper, sse);
+  ADD_ISA_BM(toupper, avx2, AVX2);
+  ADD_ISA_BM(toupper, avx512, AVX512);
   ADD_BM(compact, naive);
+  ADD_ISA_BM(compact, sse, SSE4_2);
+  ADD_ISA_BM(compact, avx2, AVX2);
+  if (simdstr_cpu_features() & SIMDSTR_CPU_AVX512VBMI2) {
+    ADD_ISA_BM(compact, avx512, AVX512);
+  }
   ADD_BM(qstrlen, naive);
+  ADD_ISA_BM(qstrlen, sse, SSE4_2);
+  ADD_ISA_BM(qstrlen, avx2, AVX2);
+  ADD_ISA_BM(qstrlen, avx512, AVX512);
   ADD_BM(strstr, naive);
+  ADD_ISA_BM(strstr, sse, SSE4_2);
+  ADD_ISA_BM(strstr, avx2, AVX2);
+  ADD_ISA_BM(strstr, avx512, AVX512);
+
+  // the byte scan of json_index_naive against the bitmask kernels
+  ADD_BM(json_index, naive);
+  ADD_ISA_BM(json_index, sse, SSE4_2);
+  ADD_ISA_BM(json_index, avx2, AVX2);
+  ADD_ISA_BM(json_index, avx512, AVX512);
+
+  // values of 1, 4, 8, 12, 16 and 20 digits, and of mixed lengths
+#define ADD_DIGITS_BM(func, arch, isa)  do {              \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      (std::string(#func) + "_" + #arch + "/digits").c_str(), \
+      bm_##func, func##_##arch)                          \
+      ->Arg(1)->Arg(4)->Arg(8)->Arg(12)->Arg(16)->Arg(20)->Arg(0); \
+  }                                                      \
+  } while(0)
+  ADD_DIGITS_BM(u64toa, snprintf, NAIVE);
+  ADD_DIGITS_BM(u64toa, naive, NAIVE);
+  ADD_DIGITS_BM(u64toa, sse, SSE4_2);
+  ADD_DIGITS_BM(u64toa_batch, naive, NAIVE);
+  ADD_DIGITS_BM(u64toa_batch, sse, SSE4_2);
+  ADD_DIGITS_BM(u64toa_batch, avx2, AVX2);
+  ADD_DIGITS_BM(atou64, strtoull, NAIVE);
+  ADD_DIGITS_BM(atou64, naive, NAIVE);
+  ADD_DIGITS_BM(atou64, sse, SSE4_2);
+#undef ADD_DIGITS_BM
+
+  // ASCII, Latin, CJK and emoji text
+#define ADD_UTF8_BM(func, arch, isa)  do {                \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      (std::string(#func) + "_" + #arch + "/text").c_str(), \
+      bm_##func, func##_##arch)                          \
+      ->Arg(0)->Arg(1)->Arg(2)->Arg(3);                  \
+  }                                                      \
+  } while(0)
+  const unsigned vbmi = SIMDSTR_CPU_AVX512VBMI | SIMDSTR_CPU_AVX512VBMI2;
+  ADD_UTF8_BM(utf8_validate, naive, NAIVE);
+  ADD_UTF8_BM(utf8_validate, sse, SSE4_2);
+  ADD_UTF8_BM(utf8_validate, avx2, AVX2);
+  ADD_UTF8_BM(utf8_validate, avx512, AVX512);
+  ADD_UTF8_BM(utf8_count, naive, NAIVE);
+  ADD_UTF8_BM(utf8_count, sse, SSE4_2);
+  ADD_UTF8_BM(utf8_count, avx2, AVX2);
+  ADD_UTF8_BM(utf8_count, avx512, AVX512);
+  ADD_UTF8_BM(utf8_to_utf16, naive, NAIVE);
+  ADD_UTF8_BM(utf8_to_utf16, sse, SSE4_2);
+  ADD_UTF8_BM(utf8_to_utf16, avx2, AVX2);
+  if ((simdstr_cpu_features() & vbmi) == vbmi) {
+    ADD_UTF8_BM(utf8_to_utf16, avx512, AVX512);
+  }
+  ADD_UTF8_BM(utf16_to_utf8, naive, NAIVE);
+  ADD_UTF8_BM(utf16_to_utf8, sse, SSE4_2);
+  ADD_UTF8_BM(utf16_to_utf8, avx2, AVX2);
+  if (simdstr_cpu_features() & SIMDSTR_CPU_AVX512VBMI2) {
+    ADD_UTF8_BM(utf16_to_utf8, avx512, AVX512);
+  }
+#undef ADD_UTF8_BM
+
+#define ADD_CASEFOLD_BM(arch, isa)  do {                  \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      "casefold_utf8_" #arch "/cyrillic_pct",            \
+      bm_casefold_utf8, casefold_utf8_##arch)            \
+      ->Arg(0)->Arg(10)->Arg(50)->Arg(100);              \
+  }                                                      \
+  } while(0)
+  ADD_CASEFOLD_BM(naive, NAIVE);
+  ADD_CASEFOLD_BM(sse, SSE4_2);
+  ADD_CASEFOLD_BM(avx2, AVX2);
+  ADD_CASEFOLD_BM(avx512, AVX512);
+#undef ADD_CASEFOLD_BM
+
+// sets of 1 to 200 random bytes, from 16 they take both table pairs
+#define ADD_CHARSET_BM(func, arch, isa)  do {            \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      (std::string(#func) + "_" + #arch + "/set").c_str(), \
+      bm_##func, func##_##arch)                          \
+      ->Arg(1)->Arg(4)->Arg(16)->Arg(64)->Arg(200);      \
+  }                                                      \
+  } while(0)
+  ADD_CHARSET_BM(find_first_of, naive, NAIVE);
+  ADD_CHARSET_BM(find_first_of, sse, SSE4_2);
+  ADD_CHARSET_BM(find_first_of, avx2, AVX2);
+  ADD_CHARSET_BM(find_first_of, avx512, AVX512);
+  ADD_CHARSET_BM(count_of, naive, NAIVE);
+  ADD_CHARSET_BM(count_of, sse, SSE4_2);
+  ADD_CHARSET_BM(count_of, avx2, AVX2);
+  ADD_CHARSET_BM(count_of, avx512, AVX512);
+#undef ADD_CHARSET_BM
+
+// from no escape sites to one every 10 bytes
+#define ADD_QUOTE_BM(func, arch, isa)  do {              \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      (std::string(#func) + "_" + #arch + "/per_mille").c_str(), \
+      bm_##func, func##_##arch)                          \
+      ->Arg(0)->Arg(1)->Arg(10)->Arg(100);               \
+  }                                                      \
+  } while(0)
+  ADD_QUOTE_BM(quote, naive, NAIVE);
+  ADD_QUOTE_BM(quote, sse, SSE4_2);
+  ADD_QUOTE_BM(quote, avx2, AVX2);
+  ADD_QUOTE_BM(quote, avx512, AVX512);
+  ADD_QUOTE_BM(unquote, naive, NAIVE);
+  ADD_QUOTE_BM(unquote, sse, SSE4_2);
+  ADD_QUOTE_BM(unquote, avx2, AVX2);
+  ADD_QUOTE_BM(unquote, avx512, AVX512);
+#undef ADD_QUOTE_BM
+
+// 8 B to 64 KiB
+#define ADD_HASH_BM(func, arch, isa)  do {               \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      (std::string(#func) + "_" + #arch + "/size").c_str(), \
+      bm_##func##_size, func##_##arch)                   \
+      ->RangeMultiplier(8)->Range(8, 64 << 10);          \
+  }                                                      \
+  } while(0)
+  ADD_HASH_BM(crc32c, naive, NAIVE);
+  ADD_HASH_BM(crc32c, sse, SSE4_2);
+  ADD_HASH_BM(hash64, std, NAIVE);
+  ADD_HASH_BM(hash64, naive, NAIVE);
+  ADD_HASH_BM(hash64, sse, SSE4_2);
+  ADD_HASH_BM(hash64, avx2, AVX2);
+  ADD_HASH_BM(hash64, avx512, AVX512);
+#undef ADD_HASH_BM
+
+// 64 B to 256 KiB, the AVX-512 base64 kernels need VBMI
+#define ADD_CODEC_BM(func, arch, isa, features)  do {   \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa &&          \
+      (simdstr_cpu_features() & (features)) == (features)) { \
+    benchmark::RegisterBenchmark(                        \
+      (std::string(#func) + "_" + #arch + "/size").c_str(), \
+      bm_##func##_size, func##_##arch)                   \
+      ->RangeMultiplier(16)->Range(64, 256 << 10);       \
+  }                                                      \
+  } while(0)
+  ADD_CODEC_BM(base64_encode, naive, NAIVE, 0);
+  ADD_CODEC_BM(base64_encode, sse, SSE4_2, 0);
+  ADD_CODEC_BM(base64_encode, avx2, AVX2, 0);
+  ADD_CODEC_BM(base64_encode, avx512, AVX512, SIMDSTR_CPU_AVX512VBMI);
+  ADD_CODEC_BM(base64_decode, naive, NAIVE, 0);
+  ADD_CODEC_BM(base64_decode, sse, SSE4_2, 0);
+  ADD_CODEC_BM(base64_decode, avx2, AVX2, 0);
+  ADD_CODEC_BM(base64_decode, avx512, AVX512, SIMDSTR_CPU_AVX512VBMI);
+  ADD_CODEC_BM(hex_encode, naive, NAIVE, 0);
+  ADD_CODEC_BM(hex_encode, sse, SSE4_2, 0);
+  ADD_CODEC_BM(hex_encode, avx2, AVX2, 0);
+  ADD_CODEC_BM(hex_encode, avx512, AVX512, 0);
+  ADD_CODEC_BM(hex_decode, naive, NAIVE, 0);
+  ADD_CODEC_BM(hex_decode, sse, SSE4_2, 0);
+  ADD_CODEC_BM(hex_decode, avx2, AVX2, 0);
+  ADD_CODEC_BM(hex_decode, avx512, AVX512, 0);
+#undef ADD_CODEC_BM
+
+// hit distances from 0 to 1 MiB
+#define ADD_MEMCHR_BM(func, arch, isa, reverse)  do {    \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      (std::string(#func) + "_" + #arch + "/dist").c_str(), \
+      bm_memchr_dist, func##_##arch, reverse)            \
+      ->Arg(0)->RangeMultiplier(8)->Range(8, 1 << 20);   \
+  }                                                      \
+  } while(0)
+  ADD_MEMCHR_BM(memchr, glibc, NAIVE, false);
+  ADD_MEMCHR_BM(memchr, naive, NAIVE, false);
+  ADD_MEMCHR_BM(memchr, sse, SSE4_2, false);
+  ADD_MEMCHR_BM(memchr, avx2, AVX2, false);
+  ADD_MEMCHR_BM(memchr, avx512, AVX512, false);
+  ADD_MEMCHR_BM(memrchr, glibc, NAIVE, true);
+  ADD_MEMCHR_BM(memrchr, sse, SSE4_2, true);
+  ADD_MEMCHR_BM(memrchr, avx2, AVX2, true);
+  ADD_MEMCHR_BM(memrchr, avx512, AVX512, true);
+#undef ADD_MEMCHR_BM
+
+// hit distances from 0 to 1 MiB
+#define ADD_MEMCHRN_BM(func, arch, isa)  do {            \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      (std::string(#func) + "_" + #arch + "/dist").c_str(), \
+      bm_##func##_dist, func##_##arch)                   \
+      ->Arg(0)->RangeMultiplier(8)->Range(8, 1 << 20);   \
+  }                                                      \
+  } while(0)
+  ADD_MEMCHRN_BM(memchr2, naive, NAIVE);
+  ADD_MEMCHRN_BM(memchr2, sse, SSE4_2);
+  ADD_MEMCHRN_BM(memchr2, avx2, AVX2);
+  ADD_MEMCHRN_BM(memchr2, avx512, AVX512);
+  ADD_MEMCHRN_BM(memchr3, naive, NAIVE);
+  ADD_MEMCHRN_BM(memchr3, sse, SSE4_2);
+  ADD_MEMCHRN_BM(memchr3, avx2, AVX2);
+  ADD_MEMCHRN_BM(memchr3, avx512, AVX512);
+#undef ADD_MEMCHRN_BM
+
+// 1 B to 256 MiB, from and to an aligned and a misaligned address
+#define ADD_MEMCPY_BM(arch, isa)  do {                   \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      (std::string("memcpy_") + #arch).c_str(),          \
+      bm_memcpy_size, memcpy_##arch)                     \
+      ->ArgsProduct({benchmark::CreateRange(1, 256 << 20, 8), {0, 1}, {0, 3}}) \
+      ->ArgNames({"bytes", "src_off", "dst_off"});       \
+  }                                                      \
+  } while(0)
+  ADD_MEMCPY_BM(glibc, NAIVE);
+  ADD_MEMCPY_BM(naive, NAIVE);
+  ADD_MEMCPY_BM(sse, SSE4_2);
+  ADD_MEMCPY_BM(avx2, AVX2);
+  ADD_MEMCPY_BM(avx512, AVX512);
+#undef ADD_MEMCPY_BM
+
+
+// 64 B to 1 MiB
+#define ADD_COUNT_BM(arch, isa)  do {                    \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      (std::string("count_byte_") + #arch + "/size").c_str(), \
+      bm_count_byte_size, count_byte_##arch)             \
+      ->RangeMultiplier(16)->Range(64, 1 << 20);         \
+  }                                                      \
+  } while(0)
+  ADD_COUNT_BM(std, NAIVE);
+  ADD_COUNT_BM(naive, NAIVE);
+  ADD_COUNT_BM(sse, SSE4_2);
+  ADD_COUNT_BM(avx2, AVX2);
+  ADD_COUNT_BM(avx512, AVX512);
+#undef ADD_COUNT_BM
+
+  // columns of prices and of 17-digit doubles
+  for (const auto& atof : {std::make_pair("strtod", atof_strtod), std::make_pair("naive", atof_naive),
+                           std::make_pair("sse", atof_sse)}) {
+    benchmark::RegisterBenchmark((std::string("atof_") + atof.first + "/column").c_str(),
+                                 bm_atof, atof.second)->Arg(0)->Arg(1);
+  }
+
+  ADD_DISPATCH_BM(sum);
+  ADD_DISPATCH_BM(memcmpeq);
+  ADD_DISPATCH_BM(mismatch);
+  ADD_DISPATCH_BM(memcmp3);
+  ADD_DISPATCH_BM(tolower);
+  ADD_DISPATCH_BM(toupper);
+  ADD_DISPATCH_BM(compact);
+  ADD_DISPATCH_BM(qstrlen);
+  ADD_DISPATCH_BM(strstr);
+
+  ADD_SIZE_BM(tolower, naive, NAIVE);
+  ADD_SIZE_BM(tolower, sse, NAIVE);
+  ADD_SIZE_BM(tolower, avx2, AVX2);
+  ADD_SIZE_BM(tolower, avx512, AVX512);
+  ADD_SIZE_BM(tolower_inplace, sse, NAIVE);
+  ADD_SIZE_BM(tolower_inplace, avx2, AVX2);
+  ADD_SIZE_BM(tolower_inplace, avx512, AVX512);
+  ADD_SIZE_BM(memcmp3, naive, NAIVE);
+  ADD_SIZE_BM(memcmp3, sse, NAIVE);
+  ADD_SIZE_BM(memcmp3, avx2, AVX2);
+  ADD_SIZE_BM(memcmp3, avx512, AVX512);
+
+// sizes from 8 to 256 B, against lowering both sides and memcmpeq
+#define ADD_CASEEQ_BM(arch, isa)  do {                   \
+  if (simdstr_cpu_isa() >= SIMDSTR_ISA_##isa) {          \
+    benchmark::RegisterBenchmark(                        \
+      "memcaseeq_" #arch "/size",                        \
+      bm_memcaseeq_size, memcaseeq_##arch)               \
+      ->RangeMultiplier(2)->Range(8, 256);               \
+  }                                                      \
+  } while(0)
+  ADD_CASEEQ_BM(lower_avx2, AVX2);
+  ADD_CASEEQ_BM(naive, NAIVE);
+  ADD_CASEEQ_BM(sse, NAIVE);
+  ADD_CASEEQ_BM(avx2, AVX2);
+  ADD_CASEEQ_BM(avx512, AVX512);
+#undef ADD_CASEEQ_BM
+
+  ADD_TAIL_BM(memcmpeq);
+  ADD_TAIL_BM(mismatch);
+  ADD_TAIL_BM(memcmp3);
+  ADD_TAIL_BM(tolower);
+  ADD_TAIL_BM(compact);
+  ADD_TAIL_BM(qstrlen);
+
+  // the batch entry points against one dispatched call per string, on short
+  // keys, identifiers and mixed lengths
+  for (const char *mode : {"batch", "percall"}) {
+    bool batch = std::string(mode) == "batch";
+    std::string suffix = std::string("_") + mode + "_" + simdstr_isa_name(simdstr_isa());
+    benchmark::RegisterBenchmark(("simdstr_tolower" + suffix).c_str(), bm_tolower_batch, batch)
+      ->Args({10, 40})->Args({1, 16})->Args({1, 128});
+    benchmark::RegisterBenchmark(("simdstr_memcmpeq" + suffix).c_str(), bm_memcmpeq_batch, batch)
+      ->Args({10, 40})->Args({1, 16})->Args({1, 128});
+    benchmark::RegisterBenchmark(("simdstr_qstrlen" + suffix).c_str(), bm_qstrlen_batch, batch)
+      ->Args({10, 40})->Args({1, 16})->Args({1, 128});
+    benchmark::RegisterBenchmark(("simdstr_hash64" + suffix).c_str(), bm_hash64_batch, batch)
+      ->Args({10, 40})->Args({1, 16})->Args({1, 128});
+  }
+
+  for (const char *mode : {"stream", "reassemble"}) {
+    benchmark::RegisterBenchmark(
+      (std::string("simdstr_qstrlen_") + mode + "_" + simdstr_isa_name(simdstr_isa())).c_str(),
+      bm_qstrlen_stream, std::string(mode) == "stream")
+      ->Arg(4 << 10)->Arg(64 << 10);
+  }
+
+  ADD_DENSITY_BM(compact, naive, NAIVE);
+  ADD_DENSITY_BM(compact, sse, SSE4_2);
+  ADD_DENSITY_BM(compact, avx2, AVX2);
+  if (simdstr_cpu_features() & SIMDSTR_CPU_AVX512VBMI2) {
+    ADD_DENSITY_BM(compact, avx512, AVX512);
+  }
+
+  ADD_NEEDLE_BM(strstr, naive, NAIVE);
+  ADD_NEEDLE_BM(strstr, sse, SSE4_2);
+  ADD_NEEDLE_BM(strstr, avx2, AVX2);
+  ADD_NEEDLE_BM(strstr, avx512, AVX512);
+  ADD_NEEDLE_BM(strcasestr, naive, NAIVE);
+  ADD_NEEDLE_BM(strcasestr, sse, SSE4_2);
+  ADD_NEEDLE_BM(strcasestr, avx2, AVX2);
+  ADD_NEEDLE_BM(strcasestr, avx512, AVX512);
+
+  // the modes of simdstr_reduce_t from L1 to memory sized inputs
+  const std::pair<const char*, simdstr_reduce_t> modes[] = {
+    {"fast", SIMDSTR_REDUCE_FAST},
+    {"compensated", SIMDSTR_REDUCE_COMPENSATED},
+    {"reproducible", SIMDSTR_REDUCE_REPRODUCIBLE},
+  };
+  for (const auto& mode : modes) {
+    std::string suffix = std::string(mode.first) + "_" + simdstr_isa_name(simdstr_isa());
+    benchmark::RegisterBenchmark(("simdstr_reduce_sum_" + suffix).c_str(), bm_reduce_sum, mode.second)
+      ->RangeMultiplier(16)->Range(256, 1 << 24);
+    benchmark::RegisterBenchmark(("simdstr_reduce_dot_" + suffix).c_str(), bm_reduce_dot, mode.second)
+      ->RangeMultiplier(16)->Range(256, 1 << 24);
+  }
+
+  benchmark::RegisterBenchmark(
+    (std::string("strstr_multi_") + simdstr_isa_name(simdstr_isa())).c_str(), bm_strstr_multi)
+    ->RangeMultiplier(4)->Range(1, 256);
+  benchmark::RegisterBenchmark("strstr_naive_per_pattern", bm_strstr_multi_naive)
+    ->RangeMultiplier(4)->Range(1, 256);
 
   // TODO: add more benchmarks
   
+#undef ADD_DISPATCH_BM
+#undef ADD_TAIL_BM
+#undef ADD_SIZE_BM
+#undef ADD_DENSITY_BM
+#undef ADD_NEEDLE_BM
+#undef ADD_ISA_BM
 #undef ADD_BM
   benchmark::RunSpecifiedBenchmarks();
   benchmark::Shutdown();
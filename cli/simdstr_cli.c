@@ -0,0 +1,145 @@
+// simdstr_cli: the line kernels over a file, end to end, for comparisons
+// with tr and wc.
+//
+//   simdstr_cli [-j threads] tolower|toupper|compact IN OUT
+//   simdstr_cli [-j threads] count IN
+//
+// count prints the lines of IN like wc -l. The throughput over the input
+// goes to stderr.
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "simdstr.h"
+
+static size_t line_tolower(char *dst, const char *line, size_t len, void *ctx) {
+    (void)ctx;
+    simdstr_tolower(dst, line, len);
+    return len;
+}
+
+static size_t line_toupper(char *dst, const char *line, size_t len, void *ctx) {
+    (void)ctx;
+    simdstr_toupper(dst, line, len);
+    return len;
+}
+
+static size_t line_compact(char *dst, const char *line, size_t len, void *ctx) {
+    (void)ctx;
+    return simdstr_compact(dst, line, len);
+}
+
+static const struct {
+    const char     *name;
+    simdstr_line_fn fn;
+} modes[] = {
+    {"tolower", line_tolower},
+    {"toupper", line_toupper},
+    {"compact", line_compact},
+};
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int usage(void) {
+    fprintf(stderr, "usage: simdstr_cli [-j threads] tolower|toupper|compact IN OUT\n"
+                    "       simdstr_cli [-j threads] count IN\n");
+    return 2;
+}
+
+// the newlines of the mapped file, -1 on an I/O error
+static int64_t count_lines(const char *path, int nthreads, size_t *len) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return -1;
+    }
+    *len = (size_t)st.st_size;
+    size_t n = 0;
+    if (*len > 0) {
+        char *s = mmap(NULL, *len, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (s == MAP_FAILED) {
+            close(fd);
+            return -1;
+        }
+        madvise(s, *len, MADV_SEQUENTIAL);
+        n = count_byte_parallel(s, '\n', *len, nthreads);
+        munmap(s, *len);
+    }
+    close(fd);
+    return (int64_t)n;
+}
+
+int main(int argc, char **argv) {
+    int nthreads = 0;
+    int opt;
+    while ((opt = getopt(argc, argv, "j:")) != -1) {
+        if (opt != 'j') {
+            return usage();
+        }
+        char *end;
+        errno = 0;
+        long n = strtol(optarg, &end, 10);
+        if (end == optarg || *end != '\0' || errno != 0 || n < 0 || n > INT_MAX) {
+            return usage();
+        }
+        nthreads = (int)n;
+    }
+    argc -= optind;
+    argv += optind;
+    if (argc < 2) {
+        return usage();
+    }
+    double start = now();
+    size_t in_bytes = 0;
+    if (strcmp(argv[0], "count") == 0) {
+        if (argc != 2) {
+            return usage();
+        }
+        int64_t lines = count_lines(argv[1], nthreads, &in_bytes);
+        if (lines < 0) {
+            fprintf(stderr, "simdstr_cli: %s: %s\n", argv[1], strerror(errno));
+            return 1;
+        }
+        printf("%lld %s\n", (long long)lines, argv[1]);
+    } else {
+        simdstr_line_fn fn = NULL;
+        for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++) {
+            if (strcmp(argv[0], modes[i].name) == 0) {
+                fn = modes[i].fn;
+            }
+        }
+        if (fn == NULL || argc != 3) {
+            return usage();
+        }
+        // the input alone first, a failure of map_lines_file may be either file
+        struct stat st;
+        if (stat(argv[1], &st) != 0) {
+            fprintf(stderr, "simdstr_cli: %s: %s\n", argv[1], strerror(errno));
+            return 1;
+        }
+        in_bytes = (size_t)st.st_size;
+        if (map_lines_file(argv[1], argv[2], fn, NULL, nthreads) < 0) {
+            fprintf(stderr, "simdstr_cli: %s -> %s: %s\n", argv[1], argv[2], strerror(errno));
+            return 1;
+        }
+    }
+    double secs = now() - start;
+    fprintf(stderr, "%s: %zu bytes in %.3f s, %.2f GB/s (%s)\n", argv[0], in_bytes, secs,
+            secs > 0 ? in_bytes / secs / 1e9 : 0.0, simdstr_isa_name(simdstr_isa()));
+    return 0;
+}
@@ -5,8 +5,16 @@
 
 // native functions
 float sum_naive(const float *vec, size_t len);
+float dot_naive(const float *a, const float *b, size_t len);
+float min_naive(const float *vec, size_t len);
+float max_naive(const float *vec, size_t len);
 bool  memcmpeq_naive(const char *s1, const char *s2, size_t len);
+size_t mismatch_naive(const char *s1, const char *s2, size_t len);
+int   memcmp3_naive(const char *s1, const char *s2, size_t len);
+bool  memcaseeq_naive(const char *s1, const char *s2, size_t len);
 char* tolower_naive(char *dst, const char *src, size_t len);
+char* toupper_naive(char *dst, const char *src, size_t len);
 int   compact_naive(char *dst, const char *src, size_t len);
 int   qstrlen_naive(const char *src, size_t len);
-char* strstr_naive(const char *str, size_t n, const char *subtr, size_t sn);
\ No newline at end of file
+char* strstr_naive(const char *str, size_t n, const char *subtr, size_t sn);
+char* strcasestr_naive(const char *str, size_t n, const char *substr, size_t sn);
\ No newline at end of file
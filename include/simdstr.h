@@ -1,18 +1,505 @@
-
 #pragma once
 
 #include <stddef.h>
 #include <stdbool.h>
+#include <stdint.h>
+
+// ISA levels the kernels are compiled for, ordered from the weakest.
+typedef enum {
+    SIMDSTR_ISA_NAIVE  = 0,
+    SIMDSTR_ISA_SSE4_2 = 1,
+    SIMDSTR_ISA_AVX2   = 2,
+    SIMDSTR_ISA_AVX512 = 3,  // AVX512F + AVX512BW
+} simdstr_isa_t;
+
+// Runtime dispatch. The best level supported by the cpu is picked when the
+// library is loaded, the environment variable SIMDSTR_ISA=naive|sse4_2|avx2|avx512
+// forces a lower one. An unknown value or a level above the cpu one keeps the
+// cpu level, with a warning on stderr. simdstr_set_isa is not thread-safe, it
+// is meant for tests and benchmarks that walk every level in one process.
+simdstr_isa_t simdstr_cpu_isa(void);
+simdstr_isa_t simdstr_isa(void);
+bool          simdstr_set_isa(simdstr_isa_t isa);
+const char*   simdstr_isa_name(simdstr_isa_t isa);
+// return -1 if name is not a known ISA level.
+int           simdstr_isa_from_name(const char *name);
+
+// Extensions beyond the ISA level that some kernels need, the dispatch falls
+// back to the kernel of the level below when one is missing.
+enum {
+    SIMDSTR_CPU_AVX512VBMI2 = 1 << 0,
+    SIMDSTR_CPU_AVX512VBMI  = 1 << 1,
+    SIMDSTR_CPU_ERMS        = 1 << 2,  // fast rep movsb
+};
+unsigned      simdstr_cpu_features(void);
+
+// dispatched entry points, resolved to the kernels of simdstr_isa().
+float simdstr_sum(const float *vec, size_t len);
+bool  simdstr_memcmpeq(const char *s1, const char *s2, size_t len);
+// the index of the first differing byte, len if s1 equals s2.
+size_t simdstr_mismatch(const char *s1, const char *s2, size_t len);
+// memcmp of the unsigned bytes, return <0, 0 or >0.
+int   simdstr_memcmp3(const char *s1, const char *s2, size_t len);
+// memcmpeq and strstr with the ASCII case ignored, no lower case copy is made.
+bool  simdstr_memcaseeq(const char *s1, const char *s2, size_t len);
+// tolower/toupper convert in place when dst == src.
+char* simdstr_tolower(char *dst, const char *src, size_t len);
+char* simdstr_toupper(char *dst, const char *src, size_t len);
+int   simdstr_compact(char *dst, const char *src, size_t len);
+int   simdstr_qstrlen(const char *src, size_t len);
+char* simdstr_strstr(const char *str, size_t n, const char *substr, size_t sn);
+char* simdstr_strcasestr(const char *str, size_t n, const char *substr, size_t sn);
+// memchr and memrchr of glibc, memchr2/3 find the first of any of 2 or 3
+// bytes. Return NULL if none.
+char*  simdstr_memchr(const char *s, int c, size_t len);
+char*  simdstr_memrchr(const char *s, int c, size_t len);
+char*  simdstr_memchr2(const char *s, int c1, int c2, size_t len);
+char*  simdstr_memchr3(const char *s, int c1, int c2, int c3, size_t len);
+size_t simdstr_count_byte(const char *s, int c, size_t len);
+// base plus the offset of each '\n' of s, in order. offsets holds
+// simdstr_count_byte(s, '\n', len) entries. Return their number.
+size_t simdstr_newline_index(const char *s, size_t len, uint64_t base, uint64_t *offsets);
+// memcpy and memmove of libc. The copies go by size: vectors from both ends
+// up to a few of them, an unrolled vector loop above, rep movsb from the
+// movsb threshold and stores that bypass the cache from the non-temporal one.
+char*  simdstr_memcpy(char *dst, const char *src, size_t len);
+char*  simdstr_memmove(char *dst, const char *src, size_t len);
+// The thresholds in bytes, set from the cpu when the library is loaded and by
+// simdstr_set_isa: rep movsb from 2, 4 or 8 KiB by the vector width of
+// simdstr_isa() with SIMDSTR_CPU_ERMS, SIZE_MAX without, and non-temporal
+// stores from 3/4 of the last level cache. simdstr_set_copy_thresholds is not
+// thread-safe, it is meant for tests and benchmarks.
+void   simdstr_copy_thresholds(size_t *movsb, size_t *nontemporal);
+void   simdstr_set_copy_thresholds(size_t movsb, size_t nontemporal);
+
+// Streaming qstrlen and compact: the input is fed in chunks as it arrives,
+// with the same results as one call on the concatenated chunks. The chunks
+// are scanned in place, nothing is reassembled.
+typedef struct {
+    uint64_t prev_escaped;  // the next byte is escaped
+    int      count;         // the unquoted bytes so far
+    int      phase;         // before the start quote, in the string or done
+} simdstr_qstrlen_state_t;
+
+void  simdstr_qstrlen_init(simdstr_qstrlen_state_t *st);
+// return true once the result is known, the next chunks are then ignored.
+bool  simdstr_qstrlen_update(simdstr_qstrlen_state_t *st, const char *chunk, size_t len);
+// the result of simdstr_qstrlen on the chunks so far, -1 without the ending quote.
+int   simdstr_qstrlen_final(const simdstr_qstrlen_state_t *st);
+
+// compact appends the chunks to dst, len is the output cursor.
+typedef struct {
+    char  *dst;
+    size_t len;
+} simdstr_compact_state_t;
+
+void  simdstr_compact_init(simdstr_compact_state_t *st, char *dst);
+// return the bytes appended for this chunk.
+size_t simdstr_compact_update(simdstr_compact_state_t *st, const char *chunk, size_t len);
+
+// JSON structural index: the offsets of the structural characters {}[]:,
+// outside the strings and of the quotes around the strings, in order. index
+// holds up to len offsets. Return the number of offsets, or -1 for a string
+// left open at the end or a json of 4 GiB or more.
+int64_t simdstr_json_index(const char *json, size_t len, uint32_t *index);
+
+// Integers to decimal strings, without leading zeros and without a NUL.
+// Return the length. The kernels store whole vectors, out holds
+// SIMDSTR_ITOA_BUF bytes and the bytes past the length are scratch.
+#define SIMDSTR_ITOA_BUF 32
+size_t simdstr_u64toa(uint64_t val, char *out);
+size_t simdstr_i64toa(int64_t val, char *out);
+size_t simdstr_u32toa(uint32_t val, char *out);
+// A column of integers back to back, out holds 20 bytes per value and
+// SIMDSTR_ITOA_BUF more. lens[i] is the length of vals[i] when lens is not
+// NULL. Return the bytes written.
+size_t simdstr_u64toa_batch(const uint64_t *vals, size_t count, char *out, size_t *lens);
+size_t simdstr_i64toa_batch(const int64_t *vals, size_t count, char *out, size_t *lens);
+
+// Decimal text to numbers, without the leading whitespace of strtoull and
+// strtod. Return the bytes consumed, 0 when str does not start with a
+// number or the integer does not fit. atou64 takes digits only, atoi64 an
+// optional sign before them, atof a decimal double with an optional sign,
+// fraction and exponent, correctly rounded (no hex, inf or nan).
+size_t simdstr_atou64(const char *str, size_t len, uint64_t *val);
+size_t simdstr_atoi64(const char *str, size_t len, int64_t *val);
+size_t simdstr_atof(const char *str, size_t len, double *val);
+
+// UTF-8 validation and transcoding. Valid UTF-8 has no overlong forms, no
+// surrogates and no code points past U+10FFFF.
+bool    simdstr_utf8_validate(const char *s, size_t len);
+// the code points of valid UTF-8, the bytes other than continuations.
+size_t  simdstr_utf8_count(const char *s, size_t len);
+// dst holds len units. Return the units written, or -1 for invalid UTF-8.
+int64_t simdstr_utf8_to_utf16(uint16_t *dst, const char *src, size_t len);
+// dst holds 3 * len bytes. Return the bytes written, or -1 for an unpaired
+// surrogate.
+int64_t simdstr_utf16_to_utf8(char *dst, const uint16_t *src, size_t len);
+// Unicode full case folding of UTF-8, the C and F mappings of CaseFolding.txt:
+// 'A' to 'a', 'Σ' to 'σ', 'ß' to "ss". Invalid bytes are copied as they are.
+// dst holds 3 * len bytes. Return the bytes written.
+size_t  simdstr_casefold_utf8(char *dst, const char *src, size_t len);
+
+// Sets of bytes for the scanning kernels, built at runtime from any bytes:
+// CSV delimiters, URL reserved characters, HTML escapes. The set is a bitmap
+// and the nibble lookup tables of the SIMD kernels, it can live on the stack.
+typedef struct {
+    uint64_t bits[4];
+    uint8_t  lo[2][16];     // the tables of the low and high nibbles
+    uint8_t  hi[2][16];
+    int      ntables;       // 2 when the set needs more than 8 classes
+} simdstr_charset_t;
 
+void   simdstr_charset_init(simdstr_charset_t *cs, const char *chars, size_t n);
+// the first byte of s in (not in) the set, NULL if none.
+char*  simdstr_find_first_of(const simdstr_charset_t *cs, const char *s, size_t len);
+char*  simdstr_find_first_not_of(const simdstr_charset_t *cs, const char *s, size_t len);
+size_t simdstr_count_of(const simdstr_charset_t *cs, const char *s, size_t len);
+// the length of the prefix of s in the set, like strspn.
+size_t simdstr_span(const simdstr_charset_t *cs, const char *s, size_t len);
+
+// Quoted strings. QUOTES escapes only the quote and the backslash, the
+// grammar of qstrlen. JSON adds the escapes of RFC 8259: \/ \b \f \n \r \t
+// and \uXXXX, surrogate pairs included, and quote escapes the control bytes.
+typedef enum {
+    SIMDSTR_ESCAPE_QUOTES = 0,
+    SIMDSTR_ESCAPE_JSON   = 1,
+} simdstr_escape_t;
+
+// src starts with the opening quote, the bytes after the closing one are
+// ignored. dst holds len bytes, the bytes past the result are scratch.
+// Return the unquoted length, or -1 for an invalid escape or no closing quote.
+int64_t simdstr_unquote(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+// The quotes around the escaped src. dst holds 2 * len + 2 bytes, 6 * len + 2
+// with JSON. Return the bytes written.
+size_t  simdstr_quote(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+
+// Hashing. crc32c is the CRC-32C (Castagnoli) of iSCSI, ext4 and SSE4.2, crc
+// the result of the bytes before s, 0 to start. hash64 is a non-cryptographic
+// 64-bit hash with the same value on every ISA level, for hash tables and
+// checksums, not for keys chosen to collide.
+uint32_t simdstr_crc32c(uint32_t crc, const char *s, size_t len);
+uint64_t simdstr_hash64(const char *s, size_t len, uint64_t seed);
+
+// Base64 of RFC 4648. STD is the alphabet with + and / and pads the output
+// with '=', URL the one with - and _ and does not pad.
+typedef enum {
+    SIMDSTR_BASE64_STD = 0,
+    SIMDSTR_BASE64_URL = 1,
+} simdstr_base64_t;
+
+// dst holds 4 * ((len + 2) / 3) bytes. Return the encoded length.
+size_t  simdstr_base64_encode(char *dst, const char *src, size_t len, simdstr_base64_t alphabet);
+// dst holds (len + 3) / 4 * 3 bytes. Only the canonical encoding decodes:
+// the standard alphabet takes quanta of 4 with one or two '=' padding the
+// last one, the URL alphabet has no padding, and the bits past the last byte
+// are 0. Return the decoded length, or -1 with the offset of the first
+// invalid byte, of the last byte with bits past the data, or of the start of
+// an incomplete quantum in *error_at (when not NULL).
+int64_t simdstr_base64_decode(char *dst, const char *src, size_t len, simdstr_base64_t alphabet,
+                              size_t *error_at);
+
+// Hex, encoded in lowercase and decoded in either case. dst holds 2 * len
+// bytes to encode, len / 2 to decode. Return the decoded length, or -1 with
+// the offset of the first invalid byte, or of the odd one last, in *error_at.
+size_t  simdstr_hex_encode(char *dst, const char *src, size_t len);
+int64_t simdstr_hex_decode(char *dst, const char *src, size_t len, size_t *error_at);
+
+// Batches of strings: one call runs a kernel over count strings and writes
+// the results to the caller arrays, without the per-call overhead when the
+// strings are short. The strings run in groups of 4 with the loads of a group
+// first when they are at most 32 bytes, 64 on AVX-512, one at a time
+// otherwise. dst[i] may be src[i].ptr, the strings must not overlap otherwise.
+typedef struct {
+    const char *ptr;
+    size_t      len;
+} simdstr_slice_t;
+
+void  simdstr_tolower_batch(char *const *dst, const simdstr_slice_t *src, size_t count);
+// out[i] is true when s1[i] and s2[i] have the same length and bytes.
+void  simdstr_memcmpeq_batch(const simdstr_slice_t *s1, const simdstr_slice_t *s2, size_t count,
+                             bool *out);
+void  simdstr_qstrlen_batch(const simdstr_slice_t *src, size_t count, int *out);
+// out[i] is simdstr_hash64 of src[i].
+void  simdstr_hash64_batch(const simdstr_slice_t *src, size_t count, uint64_t seed, uint64_t *out);
+
+// Parallel variants for multi-megabyte buffers: the input is split in
+// cache-sized chunks over a persistent pool of nthreads threads, 0 for all of
+// them. Inputs below SIMDSTR_PARALLEL_MIN bytes stay on the calling thread,
+// and memcmpeq_parallel skips the chunks left once one mismatches.
+#define SIMDSTR_PARALLEL_MIN (1 << 20)
+bool  memcmpeq_parallel(const char *s1, const char *s2, size_t len, int nthreads);
+float sum_parallel(const float *vec, size_t len, int nthreads);
+size_t count_byte_parallel(const char *s, int c, size_t len, int nthreads);
+
+// Line-oriented processing of multi-gigabyte text. A line is the bytes up to
+// and without its '\n', and the last line the bytes after the last '\n' when
+// there are some. fn writes at most len bytes for a line to dst and returns
+// their number, ctx is passed through.
+typedef size_t (*simdstr_line_fn)(char *dst, const char *line, size_t len, void *ctx);
+// The results of fn for the lines of src, each followed by the '\n' of its
+// line, in order. The lines are split at their newline index over nthreads
+// threads, each writes its own buffer and the buffers are copied to dst,
+// which holds len bytes. Return the bytes written, -1 when out of memory.
+int64_t map_lines_parallel(char *dst, const char *src, size_t len, simdstr_line_fn fn, void *ctx,
+                           int nthreads);
+// map_lines_parallel from the file at in_path, memory-mapped, to the file at
+// out_path, created or truncated. Return the bytes written, -1 with errno set
+// on failure.
+int64_t map_lines_file(const char *in_path, const char *out_path, simdstr_line_fn fn, void *ctx,
+                       int nthreads);
+
+// Float reductions, the mode trades speed for accuracy per call site. u is
+// 2^-24 and S the exact result:
+//   FAST          4 independent accumulators per lane and FMA, the addition
+//                 order depends on the ISA level. |err| <= n*u*sum|x|.
+//   COMPENSATED   TwoSum-compensated lanes (Neumaier without the branch),
+//                 |err| <= 2u|S| + (n*u)^2 * sum|x|.
+//   REPRODUCIBLE  the floats go to 16 double lanes (element i to lane i % 16)
+//                 in blocks of SIMDSTR_REDUCE_BLOCK, each block is reduced by
+//                 a fixed pairwise tree of its lanes and the blocks are added
+//                 in order. The same bits on every ISA level and thread count,
+//                 |err| <= u|S| + n*2^-53*sum|x|.
+// NaNs and infinities propagate as in IEEE sums.
+typedef enum {
+    SIMDSTR_REDUCE_FAST         = 0,
+    SIMDSTR_REDUCE_COMPENSATED  = 1,
+    SIMDSTR_REDUCE_REPRODUCIBLE = 2,
+} simdstr_reduce_t;
+
+#define SIMDSTR_REDUCE_BLOCK (1 << 16)
+float simdstr_reduce_sum(const float *vec, size_t len, simdstr_reduce_t mode);
+// return NaN for an empty vec.
+float simdstr_reduce_mean(const float *vec, size_t len, simdstr_reduce_t mode);
+float simdstr_reduce_dot(const float *a, const float *b, size_t len, simdstr_reduce_t mode);
+// min and max skip the NaNs, the sign of a zero result is unspecified. Return
+// INFINITY and -INFINITY for an empty vec.
+float simdstr_reduce_min(const float *vec, size_t len);
+float simdstr_reduce_max(const float *vec, size_t len);
+// Over the chunks of sum_parallel, the result does not depend on nthreads.
+float reduce_sum_parallel(const float *vec, size_t len, simdstr_reduce_t mode, int nthreads);
+
+// per-ISA kernels, callers MUST check simdstr_cpu_isa() before using them.
+float sum_sse(const float *vec, size_t len);
 float sum_simd(const float *vec, size_t len);
 float sum_simd_fast(const float *vec, size_t len);
+float sum_avx512(const float *vec, size_t len);
+// the reduction kernels, the naive ones are the scalar kernels of the modes.
+float sum_fast_sse(const float *vec, size_t len);
+float sum_fast_avx2(const float *vec, size_t len);
+float sum_fast_avx512(const float *vec, size_t len);
+float sum_kahan_naive(const float *vec, size_t len);
+float sum_kahan_sse(const float *vec, size_t len);
+float sum_kahan_avx2(const float *vec, size_t len);
+float sum_kahan_avx512(const float *vec, size_t len);
+float sum_repro_naive(const float *vec, size_t len);
+float sum_repro_sse(const float *vec, size_t len);
+float sum_repro_avx2(const float *vec, size_t len);
+float sum_repro_avx512(const float *vec, size_t len);
+float dot_fast_sse(const float *a, const float *b, size_t len);
+float dot_fast_avx2(const float *a, const float *b, size_t len);
+float dot_fast_avx512(const float *a, const float *b, size_t len);
+float dot_kahan_naive(const float *a, const float *b, size_t len);
+float dot_kahan_sse(const float *a, const float *b, size_t len);
+float dot_kahan_avx2(const float *a, const float *b, size_t len);
+float dot_kahan_avx512(const float *a, const float *b, size_t len);
+float dot_repro_naive(const float *a, const float *b, size_t len);
+float dot_repro_sse(const float *a, const float *b, size_t len);
+float dot_repro_avx2(const float *a, const float *b, size_t len);
+float dot_repro_avx512(const float *a, const float *b, size_t len);
+float min_sse(const float *vec, size_t len);
+float min_avx2(const float *vec, size_t len);
+float min_avx512(const float *vec, size_t len);
+float max_sse(const float *vec, size_t len);
+float max_avx2(const float *vec, size_t len);
+float max_avx512(const float *vec, size_t len);
 bool  memcmpeq_autovec(const char *s1, const char *s2, size_t len);
 bool  memcmpeq_avx2(const char *s1, const char *s2, size_t len);
 bool  memcmpeq_sse(const char *s1, const char *s2, size_t len);
 bool  memcmpeq_sse4_2(const char *s1, const char *s2, size_t len);
 bool  memcmpeq_sse4_2_fast(const char *s1, const char *s2, size_t len);
 bool  memcmpeq_avx512(const char *s1, const char *s2, size_t len);
-char* tolower_simd(char *dst, const char *src, size_t len);
-int   compact_simd(char *dst, const char *src, size_t len);
-int   qstrlen_simd(const char *src, size_t len);
-char* strstr_simd(const char *str, size_t n, const char *substr, size_t sn);
\ No newline at end of file
+size_t mismatch_sse(const char *s1, const char *s2, size_t len);
+size_t mismatch_avx2(const char *s1, const char *s2, size_t len);
+size_t mismatch_avx512(const char *s1, const char *s2, size_t len);
+int   memcmp3_sse(const char *s1, const char *s2, size_t len);
+int   memcmp3_avx2(const char *s1, const char *s2, size_t len);
+int   memcmp3_avx512(const char *s1, const char *s2, size_t len);
+bool  memcaseeq_sse(const char *s1, const char *s2, size_t len);
+bool  memcaseeq_avx2(const char *s1, const char *s2, size_t len);
+bool  memcaseeq_avx512(const char *s1, const char *s2, size_t len);
+char* tolower_sse(char *dst, const char *src, size_t len);
+char* tolower_avx2(char *dst, const char *src, size_t len);
+char* tolower_avx512(char *dst, const char *src, size_t len);
+char* tolower_inplace_sse(char *s, size_t len);
+char* tolower_inplace_avx2(char *s, size_t len);
+char* tolower_inplace_avx512(char *s, size_t len);
+char* toupper_sse(char *dst, const char *src, size_t len);
+char* toupper_avx2(char *dst, const char *src, size_t len);
+char* toupper_avx512(char *dst, const char *src, size_t len);
+char* toupper_inplace_sse(char *s, size_t len);
+char* toupper_inplace_avx2(char *s, size_t len);
+char* toupper_inplace_avx512(char *s, size_t len);
+int   compact_sse(char *dst, const char *src, size_t len);
+int   compact_avx2(char *dst, const char *src, size_t len);
+// needs SIMDSTR_CPU_AVX512VBMI2 besides SIMDSTR_ISA_AVX512.
+int   compact_avx512(char *dst, const char *src, size_t len);
+int   qstrlen_sse(const char *src, size_t len);
+int   qstrlen_avx2(const char *src, size_t len);
+int   qstrlen_avx512(const char *src, size_t len);
+bool  qstrlen_update_naive(simdstr_qstrlen_state_t *st, const char *src, size_t len);
+bool  qstrlen_update_sse(simdstr_qstrlen_state_t *st, const char *src, size_t len);
+bool  qstrlen_update_avx2(simdstr_qstrlen_state_t *st, const char *src, size_t len);
+bool  qstrlen_update_avx512(simdstr_qstrlen_state_t *st, const char *src, size_t len);
+int64_t json_index_naive(const char *json, size_t len, uint32_t *index);
+int64_t json_index_sse(const char *json, size_t len, uint32_t *index);
+int64_t json_index_avx2(const char *json, size_t len, uint32_t *index);
+int64_t json_index_avx512(const char *json, size_t len, uint32_t *index);
+bool    utf8_validate_naive(const char *s, size_t len);
+bool    utf8_validate_sse(const char *s, size_t len);
+bool    utf8_validate_avx2(const char *s, size_t len);
+bool    utf8_validate_avx512(const char *s, size_t len);
+size_t  utf8_count_naive(const char *s, size_t len);
+size_t  utf8_count_sse(const char *s, size_t len);
+size_t  utf8_count_avx2(const char *s, size_t len);
+size_t  utf8_count_avx512(const char *s, size_t len);
+int64_t utf8_to_utf16_naive(uint16_t *dst, const char *src, size_t len);
+int64_t utf8_to_utf16_sse(uint16_t *dst, const char *src, size_t len);
+int64_t utf8_to_utf16_avx2(uint16_t *dst, const char *src, size_t len);
+// needs SIMDSTR_CPU_AVX512VBMI and SIMDSTR_CPU_AVX512VBMI2 besides SIMDSTR_ISA_AVX512.
+int64_t utf8_to_utf16_avx512(uint16_t *dst, const char *src, size_t len);
+int64_t utf16_to_utf8_naive(char *dst, const uint16_t *src, size_t len);
+int64_t utf16_to_utf8_sse(char *dst, const uint16_t *src, size_t len);
+int64_t utf16_to_utf8_avx2(char *dst, const uint16_t *src, size_t len);
+// needs SIMDSTR_CPU_AVX512VBMI2 besides SIMDSTR_ISA_AVX512.
+int64_t utf16_to_utf8_avx512(char *dst, const uint16_t *src, size_t len);
+size_t  casefold_utf8_naive(char *dst, const char *src, size_t len);
+size_t  casefold_utf8_sse(char *dst, const char *src, size_t len);
+size_t  casefold_utf8_avx2(char *dst, const char *src, size_t len);
+size_t  casefold_utf8_avx512(char *dst, const char *src, size_t len);
+char*  find_first_of_naive(const simdstr_charset_t *cs, const char *s, size_t len);
+char*  find_first_of_sse(const simdstr_charset_t *cs, const char *s, size_t len);
+char*  find_first_of_avx2(const simdstr_charset_t *cs, const char *s, size_t len);
+char*  find_first_of_avx512(const simdstr_charset_t *cs, const char *s, size_t len);
+char*  find_first_not_of_naive(const simdstr_charset_t *cs, const char *s, size_t len);
+char*  find_first_not_of_sse(const simdstr_charset_t *cs, const char *s, size_t len);
+char*  find_first_not_of_avx2(const simdstr_charset_t *cs, const char *s, size_t len);
+char*  find_first_not_of_avx512(const simdstr_charset_t *cs, const char *s, size_t len);
+size_t count_of_naive(const simdstr_charset_t *cs, const char *s, size_t len);
+size_t count_of_sse(const simdstr_charset_t *cs, const char *s, size_t len);
+size_t count_of_avx2(const simdstr_charset_t *cs, const char *s, size_t len);
+size_t count_of_avx512(const simdstr_charset_t *cs, const char *s, size_t len);
+int64_t unquote_naive(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+int64_t unquote_sse(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+int64_t unquote_avx2(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+int64_t unquote_avx512(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+size_t  quote_naive(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+size_t  quote_sse(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+size_t  quote_avx2(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+size_t  quote_avx512(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+uint32_t crc32c_naive(uint32_t crc, const char *s, size_t len);
+uint32_t crc32c_sse(uint32_t crc, const char *s, size_t len);
+uint64_t hash64_naive(const char *s, size_t len, uint64_t seed);
+uint64_t hash64_sse(const char *s, size_t len, uint64_t seed);
+uint64_t hash64_avx2(const char *s, size_t len, uint64_t seed);
+uint64_t hash64_avx512(const char *s, size_t len, uint64_t seed);
+size_t  base64_encode_naive(char *dst, const char *src, size_t len, simdstr_base64_t alphabet);
+size_t  base64_encode_sse(char *dst, const char *src, size_t len, simdstr_base64_t alphabet);
+size_t  base64_encode_avx2(char *dst, const char *src, size_t len, simdstr_base64_t alphabet);
+size_t  base64_encode_avx512(char *dst, const char *src, size_t len, simdstr_base64_t alphabet);
+int64_t base64_decode_naive(char *dst, const char *src, size_t len, simdstr_base64_t alphabet, size_t *error_at);
+int64_t base64_decode_sse(char *dst, const char *src, size_t len, simdstr_base64_t alphabet, size_t *error_at);
+int64_t base64_decode_avx2(char *dst, const char *src, size_t len, simdstr_base64_t alphabet, size_t *error_at);
+int64_t base64_decode_avx512(char *dst, const char *src, size_t len, simdstr_base64_t alphabet, size_t *error_at);
+size_t  hex_encode_naive(char *dst, const char *src, size_t len);
+size_t  hex_encode_sse(char *dst, const char *src, size_t len);
+size_t  hex_encode_avx2(char *dst, const char *src, size_t len);
+size_t  hex_encode_avx512(char *dst, const char *src, size_t len);
+int64_t hex_decode_naive(char *dst, const char *src, size_t len, size_t *error_at);
+int64_t hex_decode_sse(char *dst, const char *src, size_t len, size_t *error_at);
+int64_t hex_decode_avx2(char *dst, const char *src, size_t len, size_t *error_at);
+int64_t hex_decode_avx512(char *dst, const char *src, size_t len, size_t *error_at);
+char*  memchr_naive(const char *s, int c, size_t len);
+char*  memchr_sse(const char *s, int c, size_t len);
+char*  memchr_avx2(const char *s, int c, size_t len);
+char*  memchr_avx512(const char *s, int c, size_t len);
+char*  memrchr_naive(const char *s, int c, size_t len);
+char*  memrchr_sse(const char *s, int c, size_t len);
+char*  memrchr_avx2(const char *s, int c, size_t len);
+char*  memrchr_avx512(const char *s, int c, size_t len);
+char*  memchr2_naive(const char *s, int c1, int c2, size_t len);
+char*  memchr2_sse(const char *s, int c1, int c2, size_t len);
+char*  memchr2_avx2(const char *s, int c1, int c2, size_t len);
+char*  memchr2_avx512(const char *s, int c1, int c2, size_t len);
+char*  memchr3_naive(const char *s, int c1, int c2, int c3, size_t len);
+char*  memchr3_sse(const char *s, int c1, int c2, int c3, size_t len);
+char*  memchr3_avx2(const char *s, int c1, int c2, int c3, size_t len);
+char*  memchr3_avx512(const char *s, int c1, int c2, int c3, size_t len);
+size_t count_byte_naive(const char *s, int c, size_t len);
+size_t count_byte_sse(const char *s, int c, size_t len);
+size_t count_byte_avx2(const char *s, int c, size_t len);
+size_t count_byte_avx512(const char *s, int c, size_t len);
+size_t newline_index_naive(const char *s, size_t len, uint64_t base, uint64_t *offsets);
+size_t newline_index_sse(const char *s, size_t len, uint64_t base, uint64_t *offsets);
+size_t newline_index_avx2(const char *s, size_t len, uint64_t base, uint64_t *offsets);
+size_t newline_index_avx512(const char *s, size_t len, uint64_t base, uint64_t *offsets);
+char*  memcpy_naive(char *dst, const char *src, size_t len);
+char*  memcpy_sse(char *dst, const char *src, size_t len);
+char*  memcpy_avx2(char *dst, const char *src, size_t len);
+char*  memcpy_avx512(char *dst, const char *src, size_t len);
+char*  memmove_naive(char *dst, const char *src, size_t len);
+char*  memmove_sse(char *dst, const char *src, size_t len);
+char*  memmove_avx2(char *dst, const char *src, size_t len);
+char*  memmove_avx512(char *dst, const char *src, size_t len);
+size_t atou64_naive(const char *str, size_t len, uint64_t *val);
+size_t atou64_sse(const char *str, size_t len, uint64_t *val);
+size_t atoi64_naive(const char *str, size_t len, int64_t *val);
+size_t atoi64_sse(const char *str, size_t len, int64_t *val);
+size_t atof_naive(const char *str, size_t len, double *val);
+size_t atof_sse(const char *str, size_t len, double *val);
+size_t u64toa_naive(uint64_t val, char *out);
+size_t u64toa_sse(uint64_t val, char *out);
+size_t u64toa_batch_naive(const uint64_t *vals, size_t count, char *out, size_t *lens);
+size_t u64toa_batch_sse(const uint64_t *vals, size_t count, char *out, size_t *lens);
+size_t u64toa_batch_avx2(const uint64_t *vals, size_t count, char *out, size_t *lens);
+size_t i64toa_batch_naive(const int64_t *vals, size_t count, char *out, size_t *lens);
+size_t i64toa_batch_sse(const int64_t *vals, size_t count, char *out, size_t *lens);
+size_t i64toa_batch_avx2(const int64_t *vals, size_t count, char *out, size_t *lens);
+void  tolower_batch_naive(char *const *dst, const simdstr_slice_t *src, size_t count);
+void  tolower_batch_sse(char *const *dst, const simdstr_slice_t *src, size_t count);
+void  tolower_batch_avx2(char *const *dst, const simdstr_slice_t *src, size_t count);
+void  tolower_batch_avx512(char *const *dst, const simdstr_slice_t *src, size_t count);
+void  memcmpeq_batch_naive(const simdstr_slice_t *s1, const simdstr_slice_t *s2, size_t count, bool *out);
+void  memcmpeq_batch_sse(const simdstr_slice_t *s1, const simdstr_slice_t *s2, size_t count, bool *out);
+void  memcmpeq_batch_avx2(const simdstr_slice_t *s1, const simdstr_slice_t *s2, size_t count, bool *out);
+void  memcmpeq_batch_avx512(const simdstr_slice_t *s1, const simdstr_slice_t *s2, size_t count, bool *out);
+void  qstrlen_batch_naive(const simdstr_slice_t *src, size_t count, int *out);
+void  qstrlen_batch_sse(const simdstr_slice_t *src, size_t count, int *out);
+void  qstrlen_batch_avx2(const simdstr_slice_t *src, size_t count, int *out);
+void  qstrlen_batch_avx512(const simdstr_slice_t *src, size_t count, int *out);
+void  hash64_batch_naive(const simdstr_slice_t *src, size_t count, uint64_t seed, uint64_t *out);
+void  hash64_batch_sse(const simdstr_slice_t *src, size_t count, uint64_t seed, uint64_t *out);
+void  hash64_batch_avx2(const simdstr_slice_t *src, size_t count, uint64_t seed, uint64_t *out);
+void  hash64_batch_avx512(const simdstr_slice_t *src, size_t count, uint64_t seed, uint64_t *out);
+char* strstr_sse(const char *str, size_t n, const char *substr, size_t sn);
+char* strstr_avx2(const char *str, size_t n, const char *substr, size_t sn);
+char* strstr_avx512(const char *str, size_t n, const char *substr, size_t sn);
+char* strcasestr_sse(const char *str, size_t n, const char *substr, size_t sn);
+char* strcasestr_avx2(const char *str, size_t n, const char *substr, size_t sn);
+char* strcasestr_avx512(const char *str, size_t n, const char *substr, size_t sn);
+
+// Multi-pattern search: compile a set of patterns once, then report every
+// occurrence of each of them in one pass. Sets up to 32 patterns are scanned
+// with Teddy (pshufb lookups of nibble bucket masks), larger sets and the
+// naive level with Aho-Corasick. The order of the matches is unspecified
+// across patterns, increasing for each pattern.
+typedef struct strstr_multi strstr_multi_t;
+// called with the pattern id and the offset of the match in str, return
+// false to stop the scan.
+typedef bool (*strstr_multi_fn)(size_t id, size_t offset, void *ctx);
+// return NULL if there is no pattern, an empty one, or out of memory.
+strstr_multi_t* strstr_multi_new(const char *const *patterns, const size_t *lens, size_t count);
+void            strstr_multi_free(strstr_multi_t *m);
+// return the number of matches reported.
+size_t          strstr_multi_scan(const strstr_multi_t *m, const char *str, size_t n,
+                                  strstr_multi_fn on_match, void *ctx);
@@ -0,0 +1,379 @@
+// strtod_l
+#define _GNU_SOURCE
+
+#include <inttypes.h>
+#include <locale.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "isa.h"
+#include "pow5_table.h"
+#include "simdstr.h"
+#include "tail.h"
+
+// Decimal text to integers and doubles. The kernels of each ISA level differ
+// in how they take a run of digits, up to 16 at a time: the SSE one loads 16
+// bytes, finds the digits with one compare, aligns them to the end of the
+// vector with pshufb and sums them with the multiply-adds of pmaddubsw and
+// pmaddwd, 2 then 4 then 8 digits per lane.
+
+// the count of leading digits in p[0, min(len, 16)) and their value
+typedef size_t (*digits16_t)(const char *p, size_t len, uint64_t *val);
+
+static const uint64_t pow10_u64[17] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+    100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+    10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+};
+
+static inline bool is_digit(char c) {
+    return (unsigned char)(c - '0') <= 9;
+}
+
+static inline size_t digits16_naive(const char *p, size_t len, uint64_t *val) {
+    size_t end = len < 16 ? len : 16;
+    uint64_t v = 0;
+    size_t i = 0;
+    for (; i < end && is_digit(p[i]); i++) {
+        v = v * 10 + (uint64_t)(p[i] - '0');
+    }
+    *val = v;
+    return i;
+}
+
+// pshufb indices from a sliding window: at align_window + n, the first n of
+// 16 bytes move to the end and zeros come in front of them.
+static const uint8_t align_window[32] = {
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+};
+
+TARGET_SSE4_2
+static inline size_t digits16_sse(const char *p, size_t len, uint64_t *val) {
+    // the bytes past len are NULs, which are not digits
+    __m128i x = _mm_sub_epi8(load_tail_si128(p, len, 0), _mm_set1_epi8('0'));
+    __m128i digit = _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8(9)), x);
+    size_t n = __builtin_ctz(~(uint32_t)_mm_movemask_epi8(digit));
+    x = _mm_shuffle_epi8(x, _mm_loadu_si128((const __m128i *)(align_window + n)));
+    x = _mm_maddubs_epi16(x, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1));
+    x = _mm_madd_epi16(x, _mm_setr_epi16(100, 1, 100, 1, 100, 1, 100, 1));
+    x = _mm_packus_epi32(x, x);
+    x = _mm_madd_epi16(x, _mm_setr_epi16(10000, 1, 10000, 1, 10000, 1, 10000, 1));
+    uint64_t halves = (uint64_t)_mm_cvtsi128_si64(x);
+    *val = (halves & 0xFFFFFFFF) * 100000000 + (halves >> 32);
+    return n;
+}
+
+// Integers: the digits of p, 16 at a time. Return the count of digits, 0
+// with *overflow set when the value does not fit in 64 bits.
+static inline size_t parse_u64(const char *p, size_t len, uint64_t *val, bool *overflow,
+                               digits16_t digits16) {
+    uint64_t v = 0, chunk;
+    size_t i = 0, n;
+    *overflow = false;
+    do {
+        n = digits16(p + i, len - i, &chunk);
+        *overflow |= __builtin_mul_overflow(v, pow10_u64[n], &v);
+        *overflow |= __builtin_add_overflow(v, chunk, &v);
+        i += n;
+    } while (n == 16);
+    *val = v;
+    return i;
+}
+
+static inline size_t atou64_digits(const char *str, size_t len, uint64_t *val,
+                                   digits16_t digits16) {
+    uint64_t v;
+    bool overflow;
+    size_t n = parse_u64(str, len, &v, &overflow, digits16);
+    if (n == 0 || overflow) {
+        return 0;
+    }
+    *val = v;
+    return n;
+}
+
+static inline size_t atoi64_digits(const char *str, size_t len, int64_t *val,
+                                   digits16_t digits16) {
+    bool neg = len > 0 && str[0] == '-';
+    size_t sign = len > 0 && (str[0] == '-' || str[0] == '+');
+    uint64_t v;
+    bool overflow;
+    size_t n = parse_u64(str + sign, len - sign, &v, &overflow, digits16);
+    if (n == 0 || overflow || v > (uint64_t)INT64_MAX + neg) {
+        return 0;
+    }
+    *val = neg ? (int64_t)(0 - v) : (int64_t)v;
+    return sign + n;
+}
+
+size_t atou64_naive(const char *str, size_t len, uint64_t *val) {
+    return atou64_digits(str, len, val, digits16_naive);
+}
+
+size_t atoi64_naive(const char *str, size_t len, int64_t *val) {
+    return atoi64_digits(str, len, val, digits16_naive);
+}
+
+TARGET_SSE4_2
+size_t atou64_sse(const char *str, size_t len, uint64_t *val) {
+    return atou64_digits(str, len, val, digits16_sse);
+}
+
+TARGET_SSE4_2
+size_t atoi64_sse(const char *str, size_t len, int64_t *val) {
+    return atoi64_digits(str, len, val, digits16_sse);
+}
+
+// Doubles: the first 19 significant digits make the mantissa w, the value is
+// w * 10^q. Clinger's fast path covers the exact w and 10^q, the others go
+// through Eisel-Lemire, and the cases it cannot round, a mantissa cut at 19
+// digits or the last bits of the product all ones, through strtod.
+#define MAX_SIG 19
+
+struct decimal {
+    uint64_t w;
+    int64_t  q;
+    int      nsig;          // significant digits in w
+    bool     truncated;     // digits after the 19th were dropped
+};
+
+// Append a run of digits to d, fraction runs lower q by the digits taken.
+// Return the length of the run.
+static inline size_t take_digits(const char *p, size_t len, struct decimal *d, bool fraction,
+                                 digits16_t digits16) {
+    size_t i = 0, n;
+    uint64_t chunk;
+    if (d->nsig == 0) {
+        // the leading zeros are not significant
+        for (; i < len && p[i] == '0'; i++) {
+            d->q -= fraction;
+        }
+    }
+    do {
+        n = digits16(p + i, len - i, &chunk);
+        if (d->nsig + (int)n <= MAX_SIG) {
+            d->w = d->w * pow10_u64[n] + chunk;
+            d->nsig += (int)n;
+            d->q -= fraction ? (int64_t)n : 0;
+        } else {
+            size_t k = MAX_SIG - d->nsig;
+            for (size_t j = 0; j < k; j++) {
+                d->w = d->w * 10 + (uint64_t)(p[i + j] - '0');
+            }
+            d->nsig = MAX_SIG;
+            d->q += fraction ? -(int64_t)k : (int64_t)(n - k);
+            d->truncated |= n > k;
+        }
+        i += n;
+    } while (n == 16);
+    return i;
+}
+
+// the exponent after 'e', saturated far out of the range of doubles
+static inline size_t parse_exponent(const char *p, size_t len, int64_t *exp) {
+    if (len < 2 || (p[0] != 'e' && p[0] != 'E')) {
+        return 0;
+    }
+    size_t i = 1;
+    bool neg = p[i] == '-';
+    i += p[i] == '-' || p[i] == '+';
+    if (i >= len || !is_digit(p[i])) {
+        return 0;
+    }
+    int64_t e = 0;
+    for (; i < len && is_digit(p[i]); i++) {
+        if (e < 100000) {
+            e = e * 10 + (p[i] - '0');
+        }
+    }
+    *exp = neg ? -e : e;
+    return i;
+}
+
+// the 64-bit halves of a * b
+static inline uint64_t mul_128(uint64_t a, uint64_t b, uint64_t *lo) {
+    unsigned __int128 r = (unsigned __int128)a * b;
+    *lo = (uint64_t)r;
+    return (uint64_t)(r >> 64);
+}
+
+// Eisel-Lemire: the top bits of w * 5^q from the 128-bit table give the
+// mantissa, one bit more than a double to round to nearest even. Return
+// false when it cannot tell the rounding. *bits gets the double without sign.
+static bool eisel_lemire(uint64_t w, int64_t q, uint64_t *bits) {
+    if (w == 0 || q < POW5_MIN) {
+        *bits = 0;
+        return true;
+    }
+    if (q > POW5_MAX) {
+        *bits = 0x7FFull << 52;
+        return true;
+    }
+    int lz = __builtin_clzll(w);
+    w <<= lz;
+    size_t idx = 2 * (size_t)(q - POW5_MIN);
+    uint64_t lo, hi = mul_128(w, pow5_128[idx], &lo);
+    // 55 bits are needed, refine with the low half of 5^q when the bits
+    // below them are all ones
+    const uint64_t precision_mask = UINT64_MAX >> 55;
+    if ((hi & precision_mask) == precision_mask) {
+        uint64_t lo2, hi2 = mul_128(w, pow5_128[idx + 1], &lo2);
+        lo += hi2;
+        hi += lo < hi2;
+    }
+    // the truncated product may be just below a rounding boundary, it is
+    // exact enough only for these q
+    if (lo == UINT64_MAX && (q < -27 || q > 55)) {
+        return false;
+    }
+    int upper = (int)(hi >> 63);
+    uint64_t mantissa = hi >> (upper + 64 - 52 - 3);
+    // floor(log2(10^q)) + 63 for the power of 2 of the product
+    int64_t power2 = (((152170 + 65536) * q) >> 16) + 63 + upper - lz + 1023;
+    if (power2 <= 0) {
+        // subnormal: shift to the fixed exponent, then round
+        if (-power2 + 1 >= 64) {
+            *bits = 0;
+            return true;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        power2 = mantissa < (1ull << 52) ? 0 : 1;
+        *bits = (mantissa & ((1ull << 52) - 1)) | ((uint64_t)power2 << 52);
+        return true;
+    }
+    // exactly halfway between two doubles: the product is exact only for
+    // these q, round to even
+    if (lo <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1
+        && (mantissa << (upper + 64 - 52 - 3)) == hi) {
+        mantissa &= ~1ull;
+    }
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (2ull << 52)) {
+        mantissa = 1ull << 52;
+        power2++;
+    }
+    mantissa &= ~(1ull << 52);
+    if (power2 >= 0x7FF) {
+        *bits = 0x7FFull << 52;
+        return true;
+    }
+    *bits = mantissa | ((uint64_t)power2 << 52);
+    return true;
+}
+
+static const double pow10_exact[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// strtod of the C locale, the decimal point of LC_NUMERIC may not be '.'
+static locale_t c_locale;
+
+__attribute__((constructor))
+static void init_c_locale(void) {
+    c_locale = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+}
+
+// 767 significant digits tell any two doubles apart, the 768th stands for all
+// the dropped ones when any of them is not 0
+#define STRTOD_DIGITS 768
+
+// strtod of the digits, the fraction and the exponent at str, rewritten as
+// significant digits and an exponent so that no copy grows with n
+static double strtod_copy(const char *str, size_t n) {
+    char    buf[STRTOD_DIGITS + 32];
+    size_t  i = str[0] == '+', k = 0;
+    int64_t shift = 0;
+    bool    sticky = false;
+    for (; i < n && is_digit(str[i]); i++) {
+        if (k == 0 && str[i] == '0') {
+            continue;
+        }
+        if (k < STRTOD_DIGITS - 1) {
+            buf[k++] = str[i];
+        } else {
+            shift++;
+            sticky |= str[i] != '0';
+        }
+    }
+    if (i < n && str[i] == '.') {
+        for (i++; i < n && is_digit(str[i]); i++) {
+            if (k == 0 && str[i] == '0') {
+                shift--;
+            } else if (k < STRTOD_DIGITS - 1) {
+                buf[k++] = str[i];
+                shift--;
+            } else {
+                sticky |= str[i] != '0';
+            }
+        }
+    }
+    if (k == 0) {
+        return 0;
+    }
+    if (sticky) {
+        buf[k++] = '1';
+        shift--;
+    }
+    int64_t exp = 0;
+    parse_exponent(str + i, n - i, &exp);
+    snprintf(buf + k, sizeof(buf) - k, "e%" PRId64, exp + shift);
+    return c_locale != (locale_t)0 ? strtod_l(buf, NULL, c_locale) : strtod(buf, NULL);
+}
+
+static inline size_t atof_digits(const char *str, size_t len, double *val, digits16_t digits16) {
+    struct decimal d = {0, 0, 0, false};
+    size_t i = len > 0 && (str[0] == '-' || str[0] == '+');
+    bool neg = i > 0 && str[0] == '-';
+    size_t nint = take_digits(str + i, len - i, &d, false, digits16);
+    i += nint;
+    size_t nfrac = 0;
+    if (i < len && str[i] == '.') {
+        nfrac = take_digits(str + i + 1, len - i - 1, &d, true, digits16);
+        if (nint + nfrac > 0) {
+            i += 1 + nfrac;
+        }
+    }
+    if (nint + nfrac == 0) {
+        return 0;
+    }
+    int64_t exp = 0;
+    i += parse_exponent(str + i, len - i, &exp);
+    int64_t q = d.q + exp;
+
+    double v;
+    uint64_t bits;
+    if (!d.truncated && q >= -22 && q <= 22 && d.w <= 1ull << 53) {
+        v = q < 0 ? (double)d.w / pow10_exact[-q] : (double)d.w * pow10_exact[q];
+    } else if (eisel_lemire(d.w, q, &bits)) {
+        uint64_t up;
+        if (d.truncated && (!eisel_lemire(d.w + 1, q, &up) || up != bits)) {
+            v = strtod_copy(str + neg, i - neg);
+        } else {
+            memcpy(&v, &bits, sizeof(v));
+        }
+    } else {
+        v = strtod_copy(str + neg, i - neg);
+    }
+    *val = neg ? -v : v;
+    return i;
+}
+
+size_t atof_naive(const char *str, size_t len, double *val) {
+    return atof_digits(str, len, val, digits16_naive);
+}
+
+TARGET_SSE4_2
+size_t atof_sse(const char *str, size_t len, double *val) {
+    return atof_digits(str, len, val, digits16_sse);
+}
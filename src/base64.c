@@ -0,0 +1,357 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "isa.h"
+#include "simdstr.h"
+
+// Base64 of RFC 4648, the standard alphabet and the URL one. The SSE and
+// AVX2 kernels are the pshufb kernels of Muła and Lemire: the encoder
+// splits 3 bytes into 4 indexes with two multiplies and maps them to ASCII
+// with a table of the offsets of the 5 ranges of the alphabet, the decoder
+// classifies the bytes with two nibble tables, invalid when the classes of
+// both nibbles meet, and adds the offset of the range of the high nibble.
+// The AVX-512 kernels need VBMI: vpmultishiftqb splits, vpermb looks the
+// alphabet up and vpermi2b decodes with a table of 128 bytes.
+typedef struct {
+    char    chars[64];
+    int8_t  values[128];    // of the ASCII bytes, -1 when invalid
+    int8_t  shift[16];      // encoder: ASCII - index by range
+    uint8_t lo[16];         // decoder: invalid when lo[c & 15] & hi[c >> 4]
+    uint8_t hi[16];
+    int8_t  roll[16];       // decoder: value - c by high nibble, + 8 for special
+    char    special;        // the one byte of its high nibble with another offset
+    bool    pad;
+} b64_alphabet_t;
+
+static const b64_alphabet_t b64_alphabets[] = {
+    [SIMDSTR_BASE64_STD] = {
+        .chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+        .values = {
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+            52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+            -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+            15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+            -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+            41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+        },
+        .shift = {'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                  '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0},
+        .lo = {0x0B, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+               0x03, 0x03, 0x07, 0x15, 0x17, 0x17, 0x17, 0x15},
+        .hi = {0x01, 0x01, 0x02, 0x04, 0x08, 0x10, 0x08, 0x10,
+               0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01},
+        .roll = {0, 0, 62 - '+', 52 - '0', -'A', -'A', 26 - 'a', 26 - 'a', 0, 0, 63 - '/', 0, 0, 0, 0, 0},
+        .special = '/',
+        .pad = true,
+    },
+    [SIMDSTR_BASE64_URL] = {
+        .chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_",
+        .values = {
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+            -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1,
+            52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+            -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+            15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, 63,
+            -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+            41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+        },
+        .shift = {'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                  '0' - 52, '0' - 52, '0' - 52, '-' - 62, '_' - 63, 'A', 0, 0},
+        .lo = {0x0B, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
+               0x03, 0x03, 0x07, 0x37, 0x37, 0x35, 0x37, 0x27},
+        .hi = {0x01, 0x01, 0x02, 0x04, 0x08, 0x10, 0x08, 0x20,
+               0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01},
+        .roll = {0, 0, 62 - '-', 52 - '0', -'A', -'A', 26 - 'a', 26 - 'a', 0, 0, 0, 0, 0, 63 - '_', 0, 0},
+        .special = '_',
+        .pad = false,
+    },
+};
+
+size_t base64_encode_naive(char *dst, const char *src, size_t len, simdstr_base64_t alphabet) {
+    const b64_alphabet_t *a = &b64_alphabets[alphabet];
+    const uint8_t *s = (const uint8_t *)src;
+    char *out = dst;
+    size_t i = 0;
+    for (; i + 3 <= len; i += 3) {
+        uint32_t v = (uint32_t)s[i] << 16 | s[i + 1] << 8 | s[i + 2];
+        out[0] = a->chars[v >> 18];
+        out[1] = a->chars[v >> 12 & 63];
+        out[2] = a->chars[v >> 6 & 63];
+        out[3] = a->chars[v & 63];
+        out += 4;
+    }
+    if (i < len) {
+        uint32_t v = (uint32_t)s[i] << 16 | (i + 1 < len ? s[i + 1] << 8 : 0);
+        *out++ = a->chars[v >> 18];
+        *out++ = a->chars[v >> 12 & 63];
+        if (i + 1 < len) {
+            *out++ = a->chars[v >> 6 & 63];
+        } else if (a->pad) {
+            *out++ = '=';
+        }
+        if (a->pad) {
+            *out++ = '=';
+        }
+    }
+    return out - dst;
+}
+
+static inline void set_error(size_t *error_at, size_t pos) {
+    if (error_at != NULL) {
+        *error_at = pos;
+    }
+}
+
+static inline int b64_value(const b64_alphabet_t *a, char c) {
+    return (uint8_t)c < 128 ? a->values[(uint8_t)c] : -1;
+}
+
+// The length without the padding: one or two '=' that end a multiple of 4,
+// with the padded alphabet only.
+static inline size_t b64_unpadded(const b64_alphabet_t *a, const char *src, size_t len) {
+    if (a->pad && len % 4 == 0 && len > 0 && src[len - 1] == '=') {
+        len -= src[len - 2] == '=' ? 2 : 1;
+    }
+    return len;
+}
+
+// Only the canonical encoding decodes: the padded alphabet takes whole
+// quanta of 4, and the bits of the last quantum past its last byte are 0.
+int64_t base64_decode_naive(char *dst, const char *src, size_t len, simdstr_base64_t alphabet,
+                            size_t *error_at) {
+    const b64_alphabet_t *a = &b64_alphabets[alphabet];
+    size_t n = b64_unpadded(a, src, len);
+    char *out = dst;
+    size_t i = 0;
+    for (; i < n; i += 4) {
+        size_t  k = n - i < 4 ? n - i : 4;
+        uint32_t v = 0;
+        for (size_t j = 0; j < k; j++) {
+            int d = b64_value(a, src[i + j]);
+            if (d < 0) {
+                set_error(error_at, i + j);
+                return -1;
+            }
+            v |= (uint32_t)d << (18 - 6 * j);
+        }
+        if (k == 1 || (a->pad && len % 4 != 0 && k < 4)) {
+            // 6 bits are not a byte, or the padding is missing
+            set_error(error_at, i);
+            return -1;
+        }
+        if ((v & 0xFFFFFFu >> 8 * (k - 1)) != 0) {
+            // set bits past the last byte
+            set_error(error_at, i + k - 1);
+            return -1;
+        }
+        for (size_t j = 0; j + 1 < k; j++) {
+            *out++ = (char)(v >> (16 - 8 * j));
+        }
+    }
+    return out - dst;
+}
+
+// The decoding of the blocks before the tail, then of the tail by the kernel
+// below: the blocks are quanta of 4 bytes, the two parts decode on their own.
+static inline int64_t b64_decode_rest(int64_t (*decode)(char *, const char *, size_t, simdstr_base64_t, size_t *),
+                                      char *dst, char *out, const char *src, const char *p, size_t len,
+                                      simdstr_base64_t alphabet, size_t *error_at) {
+    size_t  err;
+    int64_t n = decode(out, p, src + len - p, alphabet, &err);
+    if (n < 0) {
+        set_error(error_at, p - src + err);
+        return -1;
+    }
+    return out - dst + n;
+}
+
+TARGET_SSE4_2
+static inline __m128i b64_indexes_sse(__m128i in) {
+    // the 3 bytes a b c of each word as b a c b, then the 4 fields of 6 bits
+    in = _mm_shuffle_epi8(in, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    return _mm_or_si128(t0, t1);
+}
+
+// the range of the index: 13 for A-Z, 0 for a-z, 1 to 12 for the rest
+TARGET_SSE4_2
+static inline __m128i b64_ascii_sse(__m128i idx, __m128i shift) {
+    __m128i range = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+    range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(shift, range), idx);
+}
+
+TARGET_SSE4_2
+size_t base64_encode_sse(char *dst, const char *src, size_t len, simdstr_base64_t alphabet) {
+    const __m128i shift = _mm_loadu_si128((const __m128i *)b64_alphabets[alphabet].shift);
+    const char *p = src, *end = src + len;
+    char *out = dst;
+    for (; end - p >= 16; p += 12, out += 16) {
+        __m128i idx = b64_indexes_sse(_mm_loadu_si128((const __m128i *)p));
+        _mm_storeu_si128((__m128i *)out, b64_ascii_sse(idx, shift));
+    }
+    return out - dst + base64_encode_naive(out, p, end - p, alphabet);
+}
+
+// the values of 16 bytes, false if one is invalid
+TARGET_SSE4_2
+static inline bool b64_values_sse(__m128i x, const b64_alphabet_t *a, __m128i *values) {
+    __m128i hi  = _mm_and_si128(_mm_srli_epi32(x, 4), _mm_set1_epi8(0x0F));
+    __m128i bad = _mm_and_si128(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)a->lo), _mm_and_si128(x, _mm_set1_epi8(0x0F))),
+                                _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)a->hi), hi));
+    if (!_mm_testz_si128(bad, bad)) {
+        return false;
+    }
+    __m128i special = _mm_and_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(a->special)), _mm_set1_epi8(8));
+    __m128i roll = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)a->roll), _mm_add_epi8(hi, special));
+    *values = _mm_add_epi8(x, roll);
+    return true;
+}
+
+// the 4 values of 6 bits of each word as 3 bytes, in the 12 low bytes
+TARGET_SSE4_2
+static inline __m128i b64_pack_sse(__m128i values) {
+    __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+
+// The blocks store 16 bytes for 12: they stop 24 bytes before the end, past
+// the padding, dst has room for the 4 bytes more.
+TARGET_SSE4_2
+int64_t base64_decode_sse(char *dst, const char *src, size_t len, simdstr_base64_t alphabet,
+                          size_t *error_at) {
+    const b64_alphabet_t *a = &b64_alphabets[alphabet];
+    const char *p = src, *end = src + b64_unpadded(a, src, len);
+    char *out = dst;
+    for (; end - p >= 24; p += 16, out += 12) {
+        __m128i values;
+        if (!b64_values_sse(_mm_loadu_si128((const __m128i *)p), a, &values)) {
+            break;
+        }
+        _mm_storeu_si128((__m128i *)out, b64_pack_sse(values));
+    }
+    return b64_decode_rest(base64_decode_naive, dst, out, src, p, len, alphabet, error_at);
+}
+
+TARGET_AVX2
+static inline __m256i b64_indexes_avx2(__m256i in) {
+    const __m256i shuf = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10,
+                                          1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    in = _mm256_shuffle_epi8(in, shuf);
+    __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+    __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+    return _mm256_or_si256(t0, t1);
+}
+
+TARGET_AVX2
+static inline __m256i b64_ascii_avx2(__m256i idx, __m256i shift) {
+    __m256i range = _mm256_subs_epu8(idx, _mm256_set1_epi8(51));
+    range = _mm256_or_si256(range, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), idx), _mm256_set1_epi8(13)));
+    return _mm256_add_epi8(_mm256_shuffle_epi8(shift, range), idx);
+}
+
+// 12 bytes per lane, loaded from p and p + 12
+TARGET_AVX2
+size_t base64_encode_avx2(char *dst, const char *src, size_t len, simdstr_base64_t alphabet) {
+    const __m256i shift = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)b64_alphabets[alphabet].shift));
+    const char *p = src, *end = src + len;
+    char *out = dst;
+    for (; end - p >= 28; p += 24, out += 32) {
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)p)),
+                                             _mm_loadu_si128((const __m128i *)(p + 12)), 1);
+        _mm256_storeu_si256((__m256i *)out, b64_ascii_avx2(b64_indexes_avx2(in), shift));
+    }
+    return out - dst + base64_encode_sse(out, p, end - p, alphabet);
+}
+
+TARGET_AVX2
+static inline bool b64_values_avx2(__m256i x, const b64_alphabet_t *a, __m256i *values) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i hi  = _mm256_and_si256(_mm256_srli_epi32(x, 4), nibble);
+    __m256i bad = _mm256_and_si256(
+        _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)a->lo)), _mm256_and_si256(x, nibble)),
+        _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)a->hi)), hi));
+    if (!_mm256_testz_si256(bad, bad)) {
+        return false;
+    }
+    __m256i special = _mm256_and_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8(a->special)), _mm256_set1_epi8(8));
+    __m256i roll = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)a->roll)),
+                                       _mm256_add_epi8(hi, special));
+    *values = _mm256_add_epi8(x, roll);
+    return true;
+}
+
+// 32 bytes to 24, stored as 32: the blocks stop 44 bytes before the end
+TARGET_AVX2
+int64_t base64_decode_avx2(char *dst, const char *src, size_t len, simdstr_base64_t alphabet,
+                           size_t *error_at) {
+    const b64_alphabet_t *a = &b64_alphabets[alphabet];
+    const char *p = src, *end = src + b64_unpadded(a, src, len);
+    char *out = dst;
+    for (; end - p >= 44; p += 32, out += 24) {
+        __m256i values;
+        if (!b64_values_avx2(_mm256_loadu_si256((const __m256i *)p), a, &values)) {
+            break;
+        }
+        __m256i merged = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        merged = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+        merged = _mm256_shuffle_epi8(merged, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+                                                              2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        merged = _mm256_permutevar8x32_epi32(merged, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+        _mm256_storeu_si256((__m256i *)out, merged);
+    }
+    return b64_decode_rest(base64_decode_sse, dst, out, src, p, len, alphabet, error_at);
+}
+
+TARGET_AVX512_VBMI
+size_t base64_encode_avx512(char *dst, const char *src, size_t len, simdstr_base64_t alphabet) {
+    // the 3 bytes a b c of each word as b a c b, as in the SSE kernel
+    const __m512i shuf = _mm512_setr_epi32(
+        0x01020001, 0x04050304, 0x07080607, 0x0A0B090A, 0x0D0E0C0D, 0x10110F10, 0x13141213, 0x16171516,
+        0x191A1819, 0x1C1D1B1C, 0x1F201E1F, 0x22232122, 0x25262425, 0x28292728, 0x2B2C2A2B, 0x2E2F2D2E);
+    // the bit offsets of the 4 fields in the 8 bytes of 2 words
+    const __m512i shifts = _mm512_set1_epi64(0x3036242A1016040Aull);
+    const __m512i chars  = _mm512_loadu_si512(b64_alphabets[alphabet].chars);
+    const char *p = src, *end = src + len;
+    char *out = dst;
+    for (; end - p >= 48; p += 48, out += 64) {
+        __m512i in  = _mm512_permutexvar_epi8(shuf, _mm512_maskz_loadu_epi8(0xFFFFFFFFFFFFull, p));
+        __m512i idx = _mm512_multishift_epi64_epi8(shifts, in);
+        _mm512_storeu_si512(out, _mm512_permutexvar_epi8(idx, chars));
+    }
+    return out - dst + base64_encode_avx2(out, p, end - p, alphabet);
+}
+
+// 64 bytes to 48: a value of the table is negative when invalid, and the
+// bytes past 0x7F are caught by the sign bit of the input
+TARGET_AVX512_VBMI
+int64_t base64_decode_avx512(char *dst, const char *src, size_t len, simdstr_base64_t alphabet,
+                             size_t *error_at) {
+    const b64_alphabet_t *a = &b64_alphabets[alphabet];
+    const __m512i values_lo = _mm512_loadu_si512(a->values);
+    const __m512i values_hi = _mm512_loadu_si512(a->values + 64);
+    const __m512i pack = _mm512_setr_epi32(
+        0x06000102, 0x090A0405, 0x0C0D0E08, 0x16101112, 0x191A1415, 0x1C1D1E18, 0x26202122, 0x292A2425,
+        0x2C2D2E28, 0x36303132, 0x393A3435, 0x3C3D3E38, 0, 0, 0, 0);
+    const char *p = src, *end = src + b64_unpadded(a, src, len);
+    char *out = dst;
+    for (; end - p >= 64; p += 64, out += 48) {
+        __m512i x = _mm512_loadu_si512(p);
+        __m512i values = _mm512_permutex2var_epi8(values_lo, x, values_hi);
+        if (_mm512_movepi8_mask(_mm512_or_si512(values, x)) != 0) {
+            break;
+        }
+        __m512i merged = _mm512_maddubs_epi16(values, _mm512_set1_epi32(0x01400140));
+        merged = _mm512_madd_epi16(merged, _mm512_set1_epi32(0x00011000));
+        _mm512_mask_storeu_epi8(out, 0xFFFFFFFFFFFFull, _mm512_permutexvar_epi8(pack, merged));
+    }
+    return b64_decode_rest(base64_decode_avx2, dst, out, src, p, len, alphabet, error_at);
+}
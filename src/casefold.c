@@ -0,0 +1,163 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "casefold_table.h"
+#include "isa.h"
+#include "simdstr.h"
+#include "utf8.h"
+
+// Unicode case folding of UTF-8. The ASCII bytes fold A-Z with the range
+// compare of tolower a block at a time, the runs of multibyte sequences are
+// folded one code point at a time from the tables of casefold_table.h.
+// Bytes that are not valid UTF-8 are copied as they are.
+
+static inline const fold_t* fold_of(uint32_t cp) {
+    if (cp < 0x800) {
+        return fold_2byte[cp - 0x80].len ? &fold_2byte[cp - 0x80] : NULL;
+    }
+    if (!(fold_pages[cp >> 12] >> (cp >> 6 & 63) & 1)) {
+        return NULL;
+    }
+    size_t lo = 0, hi = sizeof(fold_wide) / sizeof(fold_wide[0]);
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (fold_wide[mid].cp < cp) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo < sizeof(fold_wide) / sizeof(fold_wide[0]) && fold_wide[lo].cp == cp ? &fold_wide[lo].to : NULL;
+}
+
+// Fold the sequence at p >= 0x80, an invalid byte is copied.
+static inline const uint8_t* casefold_seq(char **out, const uint8_t *p, const uint8_t *end) {
+    char *o = *out;
+    uint8_t c = *p;
+    // Latin, Greek and Cyrillic: two bytes that mostly fold to two bytes
+    if (c >= 0xC2 && c < 0xE0 && end - p >= 2 && (p[1] & 0xC0) == 0x80) {
+        const fold_t *f = &fold_2byte[((c & 0x1F) << 6 | (p[1] & 0x3F)) - 0x80];
+        if ((f->len | 2) == 2) {
+            memcpy(o, f->len ? f->utf8 : (const char *)p, 2);
+            *out = o + 2;
+        } else {
+            memcpy(o, f->utf8, f->len);
+            *out = o + f->len;
+        }
+        return p + 2;
+    }
+    uint32_t cp;
+    size_t n = decode_utf8(p, end, &cp);
+    if (n == 0) {
+        *o = (char)c;
+        *out = o + 1;
+        return p + 1;
+    }
+    const fold_t *f = fold_of(cp);
+    if (f != NULL) {
+        memcpy(o, f->utf8, f->len);
+        *out = o + f->len;
+    } else {
+        memcpy(o, p, n);
+        *out = o + n;
+    }
+    return p + n;
+}
+
+// the run of non-ASCII bytes at p
+static inline const uint8_t* casefold_run(char **out, const uint8_t *p, const uint8_t *end) {
+    while (p < end && *p >= 0x80) {
+        p = casefold_seq(out, p, end);
+    }
+    return p;
+}
+
+size_t casefold_utf8_naive(char *dst, const char *src, size_t len) {
+    const uint8_t *p = (const uint8_t *)src, *end = p + len;
+    char *out = dst;
+    while (p < end) {
+        uint8_t c = *p;
+        if (c < 0x80) {
+            *out++ = (char)(c + ((uint8_t)(c - 'A') < 26) * 0x20);
+            p++;
+        } else {
+            p = casefold_seq(&out, p, end);
+        }
+    }
+    return out - dst;
+}
+
+// A block is folded as ASCII and stored whole, the output advances by its
+// ASCII prefix and the run of non-ASCII bytes after it is folded in scalar.
+// The store stays in dst: out - dst <= 3 * (p - src) and the block has 16
+// bytes or more left.
+TARGET_SSE4_2
+size_t casefold_utf8_sse(char *dst, const char *src, size_t len) {
+    const uint8_t *p = (const uint8_t *)src, *end = p + len;
+    char *out = dst;
+    while (end - p >= 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)p);
+        __m128i upper = _mm_cmplt_epi8(_mm_sub_epi8(x, _mm_set1_epi8((char)('A' + 0x80))),
+                                       _mm_set1_epi8((char)(0x80 + 26)));
+        _mm_storeu_si128((__m128i *)out, _mm_xor_si128(x, _mm_and_si128(upper, _mm_set1_epi8(0x20))));
+        uint32_t high = (uint32_t)_mm_movemask_epi8(x);
+        if (high == 0) {
+            out += 16;
+            p += 16;
+        } else {
+            out += __builtin_ctz(high);
+            p = casefold_run(&out, p + __builtin_ctz(high), end);
+        }
+    }
+    return out - dst + casefold_utf8_naive(out, (const char *)p, end - p);
+}
+
+TARGET_AVX2
+size_t casefold_utf8_avx2(char *dst, const char *src, size_t len) {
+    const uint8_t *p = (const uint8_t *)src, *end = p + len;
+    char *out = dst;
+    while (end - p >= 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)p);
+        __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)),
+                                          _mm256_sub_epi8(x, _mm256_set1_epi8((char)('A' + 0x80))));
+        _mm256_storeu_si256((__m256i *)out, _mm256_xor_si256(x, _mm256_and_si256(upper, _mm256_set1_epi8(0x20))));
+        uint32_t high = (uint32_t)_mm256_movemask_epi8(x);
+        if (high == 0) {
+            out += 32;
+            p += 32;
+        } else {
+            out += __builtin_ctz(high);
+            p = casefold_run(&out, p + __builtin_ctz(high), end);
+        }
+    }
+    return out - dst + casefold_utf8_sse(out, (const char *)p, end - p);
+}
+
+// the store is masked to the ASCII prefix, so the tail is a block too
+TARGET_AVX512
+size_t casefold_utf8_avx512(char *dst, const char *src, size_t len) {
+    const uint8_t *p = (const uint8_t *)src, *end = p + len;
+    char *out = dst;
+    while (p < end) {
+        __mmask64 k = end - p >= 64 ? ~0ull : _bzhi_u64(~0ull, end - p);
+        __m512i x = _mm512_maskz_loadu_epi8(k, p);
+        __mmask64 upper = _mm512_cmplt_epu8_mask(_mm512_sub_epi8(x, _mm512_set1_epi8('A')),
+                                                _mm512_set1_epi8(26));
+        __m512i lower = _mm512_mask_add_epi8(x, upper, x, _mm512_set1_epi8(0x20));
+        __mmask64 high = _mm512_movepi8_mask(x);
+        if (high == 0 && k == ~0ull) {
+            _mm512_storeu_si512(out, lower);
+            out += 64;
+            p += 64;
+        } else {
+            size_t n = _tzcnt_u64(high | ~k);
+            _mm512_mask_storeu_epi8(out, _bzhi_u64(~0ull, n), lower);
+            out += n;
+            p = casefold_run(&out, p + n, end);
+        }
+    }
+    return out - dst;
+}
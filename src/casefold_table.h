@@ -0,0 +1,1599 @@
+#pragma once
+
+#include <stdint.h>
+
+// Full case folding, the C and F mappings of CaseFolding.txt (Unicode 14.0.0),
+// generated from Python str.casefold. A code point folds to up to 6 bytes of
+// UTF-8, at most 3 times its own length.
+typedef struct {
+    uint8_t len;
+    char    utf8[7];
+} fold_t;
+
+// U+0080..U+07FF by code point, len 0 when it folds to itself
+static const fold_t fold_2byte[0x800 - 0x80] = {
+    [0x00B5 - 0x80] = {2, "\xce\xbc"},
+    [0x00C0 - 0x80] = {2, "\xc3\xa0"},
+    [0x00C1 - 0x80] = {2, "\xc3\xa1"},
+    [0x00C2 - 0x80] = {2, "\xc3\xa2"},
+    [0x00C3 - 0x80] = {2, "\xc3\xa3"},
+    [0x00C4 - 0x80] = {2, "\xc3\xa4"},
+    [0x00C5 - 0x80] = {2, "\xc3\xa5"},
+    [0x00C6 - 0x80] = {2, "\xc3\xa6"},
+    [0x00C7 - 0x80] = {2, "\xc3\xa7"},
+    [0x00C8 - 0x80] = {2, "\xc3\xa8"},
+    [0x00C9 - 0x80] = {2, "\xc3\xa9"},
+    [0x00CA - 0x80] = {2, "\xc3\xaa"},
+    [0x00CB - 0x80] = {2, "\xc3\xab"},
+    [0x00CC - 0x80] = {2, "\xc3\xac"},
+    [0x00CD - 0x80] = {2, "\xc3\xad"},
+    [0x00CE - 0x80] = {2, "\xc3\xae"},
+    [0x00CF - 0x80] = {2, "\xc3\xaf"},
+    [0x00D0 - 0x80] = {2, "\xc3\xb0"},
+    [0x00D1 - 0x80] = {2, "\xc3\xb1"},
+    [0x00D2 - 0x80] = {2, "\xc3\xb2"},
+    [0x00D3 - 0x80] = {2, "\xc3\xb3"},
+    [0x00D4 - 0x80] = {2, "\xc3\xb4"},
+    [0x00D5 - 0x80] = {2, "\xc3\xb5"},
+    [0x00D6 - 0x80] = {2, "\xc3\xb6"},
+    [0x00D8 - 0x80] = {2, "\xc3\xb8"},
+    [0x00D9 - 0x80] = {2, "\xc3\xb9"},
+    [0x00DA - 0x80] = {2, "\xc3\xba"},
+    [0x00DB - 0x80] = {2, "\xc3\xbb"},
+    [0x00DC - 0x80] = {2, "\xc3\xbc"},
+    [0x00DD - 0x80] = {2, "\xc3\xbd"},
+    [0x00DE - 0x80] = {2, "\xc3\xbe"},
+    [0x00DF - 0x80] = {2, "\x73\x73"},
+    [0x0100 - 0x80] = {2, "\xc4\x81"},
+    [0x0102 - 0x80] = {2, "\xc4\x83"},
+    [0x0104 - 0x80] = {2, "\xc4\x85"},
+    [0x0106 - 0x80] = {2, "\xc4\x87"},
+    [0x0108 - 0x80] = {2, "\xc4\x89"},
+    [0x010A - 0x80] = {2, "\xc4\x8b"},
+    [0x010C - 0x80] = {2, "\xc4\x8d"},
+    [0x010E - 0x80] = {2, "\xc4\x8f"},
+    [0x0110 - 0x80] = {2, "\xc4\x91"},
+    [0x0112 - 0x80] = {2, "\xc4\x93"},
+    [0x0114 - 0x80] = {2, "\xc4\x95"},
+    [0x0116 - 0x80] = {2, "\xc4\x97"},
+    [0x0118 - 0x80] = {2, "\xc4\x99"},
+    [0x011A - 0x80] = {2, "\xc4\x9b"},
+    [0x011C - 0x80] = {2, "\xc4\x9d"},
+    [0x011E - 0x80] = {2, "\xc4\x9f"},
+    [0x0120 - 0x80] = {2, "\xc4\xa1"},
+    [0x0122 - 0x80] = {2, "\xc4\xa3"},
+    [0x0124 - 0x80] = {2, "\xc4\xa5"},
+    [0x0126 - 0x80] = {2, "\xc4\xa7"},
+    [0x0128 - 0x80] = {2, "\xc4\xa9"},
+    [0x012A - 0x80] = {2, "\xc4\xab"},
+    [0x012C - 0x80] = {2, "\xc4\xad"},
+    [0x012E - 0x80] = {2, "\xc4\xaf"},
+    [0x0130 - 0x80] = {3, "\x69\xcc\x87"},
+    [0x0132 - 0x80] = {2, "\xc4\xb3"},
+    [0x0134 - 0x80] = {2, "\xc4\xb5"},
+    [0x0136 - 0x80] = {2, "\xc4\xb7"},
+    [0x0139 - 0x80] = {2, "\xc4\xba"},
+    [0x013B - 0x80] = {2, "\xc4\xbc"},
+    [0x013D - 0x80] = {2, "\xc4\xbe"},
+    [0x013F - 0x80] = {2, "\xc5\x80"},
+    [0x0141 - 0x80] = {2, "\xc5\x82"},
+    [0x0143 - 0x80] = {2, "\xc5\x84"},
+    [0x0145 - 0x80] = {2, "\xc5\x86"},
+    [0x0147 - 0x80] = {2, "\xc5\x88"},
+    [0x0149 - 0x80] = {3, "\xca\xbc\x6e"},
+    [0x014A - 0x80] = {2, "\xc5\x8b"},
+    [0x014C - 0x80] = {2, "\xc5\x8d"},
+    [0x014E - 0x80] = {2, "\xc5\x8f"},
+    [0x0150 - 0x80] = {2, "\xc5\x91"},
+    [0x0152 - 0x80] = {2, "\xc5\x93"},
+    [0x0154 - 0x80] = {2, "\xc5\x95"},
+    [0x0156 - 0x80] = {2, "\xc5\x97"},
+    [0x0158 - 0x80] = {2, "\xc5\x99"},
+    [0x015A - 0x80] = {2, "\xc5\x9b"},
+    [0x015C - 0x80] = {2, "\xc5\x9d"},
+    [0x015E - 0x80] = {2, "\xc5\x9f"},
+    [0x0160 - 0x80] = {2, "\xc5\xa1"},
+    [0x0162 - 0x80] = {2, "\xc5\xa3"},
+    [0x0164 - 0x80] = {2, "\xc5\xa5"},
+    [0x0166 - 0x80] = {2, "\xc5\xa7"},
+    [0x0168 - 0x80] = {2, "\xc5\xa9"},
+    [0x016A - 0x80] = {2, "\xc5\xab"},
+    [0x016C - 0x80] = {2, "\xc5\xad"},
+    [0x016E - 0x80] = {2, "\xc5\xaf"},
+    [0x0170 - 0x80] = {2, "\xc5\xb1"},
+    [0x0172 - 0x80] = {2, "\xc5\xb3"},
+    [0x0174 - 0x80] = {2, "\xc5\xb5"},
+    [0x0176 - 0x80] = {2, "\xc5\xb7"},
+    [0x0178 - 0x80] = {2, "\xc3\xbf"},
+    [0x0179 - 0x80] = {2, "\xc5\xba"},
+    [0x017B - 0x80] = {2, "\xc5\xbc"},
+    [0x017D - 0x80] = {2, "\xc5\xbe"},
+    [0x017F - 0x80] = {1, "\x73"},
+    [0x0181 - 0x80] = {2, "\xc9\x93"},
+    [0x0182 - 0x80] = {2, "\xc6\x83"},
+    [0x0184 - 0x80] = {2, "\xc6\x85"},
+    [0x0186 - 0x80] = {2, "\xc9\x94"},
+    [0x0187 - 0x80] = {2, "\xc6\x88"},
+    [0x0189 - 0x80] = {2, "\xc9\x96"},
+    [0x018A - 0x80] = {2, "\xc9\x97"},
+    [0x018B - 0x80] = {2, "\xc6\x8c"},
+    [0x018E - 0x80] = {2, "\xc7\x9d"},
+    [0x018F - 0x80] = {2, "\xc9\x99"},
+    [0x0190 - 0x80] = {2, "\xc9\x9b"},
+    [0x0191 - 0x80] = {2, "\xc6\x92"},
+    [0x0193 - 0x80] = {2, "\xc9\xa0"},
+    [0x0194 - 0x80] = {2, "\xc9\xa3"},
+    [0x0196 - 0x80] = {2, "\xc9\xa9"},
+    [0x0197 - 0x80] = {2, "\xc9\xa8"},
+    [0x0198 - 0x80] = {2, "\xc6\x99"},
+    [0x019C - 0x80] = {2, "\xc9\xaf"},
+    [0x019D - 0x80] = {2, "\xc9\xb2"},
+    [0x019F - 0x80] = {2, "\xc9\xb5"},
+    [0x01A0 - 0x80] = {2, "\xc6\xa1"},
+    [0x01A2 - 0x80] = {2, "\xc6\xa3"},
+    [0x01A4 - 0x80] = {2, "\xc6\xa5"},
+    [0x01A6 - 0x80] = {2, "\xca\x80"},
+    [0x01A7 - 0x80] = {2, "\xc6\xa8"},
+    [0x01A9 - 0x80] = {2, "\xca\x83"},
+    [0x01AC - 0x80] = {2, "\xc6\xad"},
+    [0x01AE - 0x80] = {2, "\xca\x88"},
+    [0x01AF - 0x80] = {2, "\xc6\xb0"},
+    [0x01B1 - 0x80] = {2, "\xca\x8a"},
+    [0x01B2 - 0x80] = {2, "\xca\x8b"},
+    [0x01B3 - 0x80] = {2, "\xc6\xb4"},
+    [0x01B5 - 0x80] = {2, "\xc6\xb6"},
+    [0x01B7 - 0x80] = {2, "\xca\x92"},
+    [0x01B8 - 0x80] = {2, "\xc6\xb9"},
+    [0x01BC - 0x80] = {2, "\xc6\xbd"},
+    [0x01C4 - 0x80] = {2, "\xc7\x86"},
+    [0x01C5 - 0x80] = {2, "\xc7\x86"},
+    [0x01C7 - 0x80] = {2, "\xc7\x89"},
+    [0x01C8 - 0x80] = {2, "\xc7\x89"},
+    [0x01CA - 0x80] = {2, "\xc7\x8c"},
+    [0x01CB - 0x80] = {2, "\xc7\x8c"},
+    [0x01CD - 0x80] = {2, "\xc7\x8e"},
+    [0x01CF - 0x80] = {2, "\xc7\x90"},
+    [0x01D1 - 0x80] = {2, "\xc7\x92"},
+    [0x01D3 - 0x80] = {2, "\xc7\x94"},
+    [0x01D5 - 0x80] = {2, "\xc7\x96"},
+    [0x01D7 - 0x80] = {2, "\xc7\x98"},
+    [0x01D9 - 0x80] = {2, "\xc7\x9a"},
+    [0x01DB - 0x80] = {2, "\xc7\x9c"},
+    [0x01DE - 0x80] = {2, "\xc7\x9f"},
+    [0x01E0 - 0x80] = {2, "\xc7\xa1"},
+    [0x01E2 - 0x80] = {2, "\xc7\xa3"},
+    [0x01E4 - 0x80] = {2, "\xc7\xa5"},
+    [0x01E6 - 0x80] = {2, "\xc7\xa7"},
+    [0x01E8 - 0x80] = {2, "\xc7\xa9"},
+    [0x01EA - 0x80] = {2, "\xc7\xab"},
+    [0x01EC - 0x80] = {2, "\xc7\xad"},
+    [0x01EE - 0x80] = {2, "\xc7\xaf"},
+    [0x01F0 - 0x80] = {3, "\x6a\xcc\x8c"},
+    [0x01F1 - 0x80] = {2, "\xc7\xb3"},
+    [0x01F2 - 0x80] = {2, "\xc7\xb3"},
+    [0x01F4 - 0x80] = {2, "\xc7\xb5"},
+    [0x01F6 - 0x80] = {2, "\xc6\x95"},
+    [0x01F7 - 0x80] = {2, "\xc6\xbf"},
+    [0x01F8 - 0x80] = {2, "\xc7\xb9"},
+    [0x01FA - 0x80] = {2, "\xc7\xbb"},
+    [0x01FC - 0x80] = {2, "\xc7\xbd"},
+    [0x01FE - 0x80] = {2, "\xc7\xbf"},
+    [0x0200 - 0x80] = {2, "\xc8\x81"},
+    [0x0202 - 0x80] = {2, "\xc8\x83"},
+    [0x0204 - 0x80] = {2, "\xc8\x85"},
+    [0x0206 - 0x80] = {2, "\xc8\x87"},
+    [0x0208 - 0x80] = {2, "\xc8\x89"},
+    [0x020A - 0x80] = {2, "\xc8\x8b"},
+    [0x020C - 0x80] = {2, "\xc8\x8d"},
+    [0x020E - 0x80] = {2, "\xc8\x8f"},
+    [0x0210 - 0x80] = {2, "\xc8\x91"},
+    [0x0212 - 0x80] = {2, "\xc8\x93"},
+    [0x0214 - 0x80] = {2, "\xc8\x95"},
+    [0x0216 - 0x80] = {2, "\xc8\x97"},
+    [0x0218 - 0x80] = {2, "\xc8\x99"},
+    [0x021A - 0x80] = {2, "\xc8\x9b"},
+    [0x021C - 0x80] = {2, "\xc8\x9d"},
+    [0x021E - 0x80] = {2, "\xc8\x9f"},
+    [0x0220 - 0x80] = {2, "\xc6\x9e"},
+    [0x0222 - 0x80] = {2, "\xc8\xa3"},
+    [0x0224 - 0x80] = {2, "\xc8\xa5"},
+    [0x0226 - 0x80] = {2, "\xc8\xa7"},
+    [0x0228 - 0x80] = {2, "\xc8\xa9"},
+    [0x022A - 0x80] = {2, "\xc8\xab"},
+    [0x022C - 0x80] = {2, "\xc8\xad"},
+    [0x022E - 0x80] = {2, "\xc8\xaf"},
+    [0x0230 - 0x80] = {2, "\xc8\xb1"},
+    [0x0232 - 0x80] = {2, "\xc8\xb3"},
+    [0x023A - 0x80] = {3, "\xe2\xb1\xa5"},
+    [0x023B - 0x80] = {2, "\xc8\xbc"},
+    [0x023D - 0x80] = {2, "\xc6\x9a"},
+    [0x023E - 0x80] = {3, "\xe2\xb1\xa6"},
+    [0x0241 - 0x80] = {2, "\xc9\x82"},
+    [0x0243 - 0x80] = {2, "\xc6\x80"},
+    [0x0244 - 0x80] = {2, "\xca\x89"},
+    [0x0245 - 0x80] = {2, "\xca\x8c"},
+    [0x0246 - 0x80] = {2, "\xc9\x87"},
+    [0x0248 - 0x80] = {2, "\xc9\x89"},
+    [0x024A - 0x80] = {2, "\xc9\x8b"},
+    [0x024C - 0x80] = {2, "\xc9\x8d"},
+    [0x024E - 0x80] = {2, "\xc9\x8f"},
+    [0x0345 - 0x80] = {2, "\xce\xb9"},
+    [0x0370 - 0x80] = {2, "\xcd\xb1"},
+    [0x0372 - 0x80] = {2, "\xcd\xb3"},
+    [0x0376 - 0x80] = {2, "\xcd\xb7"},
+    [0x037F - 0x80] = {2, "\xcf\xb3"},
+    [0x0386 - 0x80] = {2, "\xce\xac"},
+    [0x0388 - 0x80] = {2, "\xce\xad"},
+    [0x0389 - 0x80] = {2, "\xce\xae"},
+    [0x038A - 0x80] = {2, "\xce\xaf"},
+    [0x038C - 0x80] = {2, "\xcf\x8c"},
+    [0x038E - 0x80] = {2, "\xcf\x8d"},
+    [0x038F - 0x80] = {2, "\xcf\x8e"},
+    [0x0390 - 0x80] = {6, "\xce\xb9\xcc\x88\xcc\x81"},
+    [0x0391 - 0x80] = {2, "\xce\xb1"},
+    [0x0392 - 0x80] = {2, "\xce\xb2"},
+    [0x0393 - 0x80] = {2, "\xce\xb3"},
+    [0x0394 - 0x80] = {2, "\xce\xb4"},
+    [0x0395 - 0x80] = {2, "\xce\xb5"},
+    [0x0396 - 0x80] = {2, "\xce\xb6"},
+    [0x0397 - 0x80] = {2, "\xce\xb7"},
+    [0x0398 - 0x80] = {2, "\xce\xb8"},
+    [0x0399 - 0x80] = {2, "\xce\xb9"},
+    [0x039A - 0x80] = {2, "\xce\xba"},
+    [0x039B - 0x80] = {2, "\xce\xbb"},
+    [0x039C - 0x80] = {2, "\xce\xbc"},
+    [0x039D - 0x80] = {2, "\xce\xbd"},
+    [0x039E - 0x80] = {2, "\xce\xbe"},
+    [0x039F - 0x80] = {2, "\xce\xbf"},
+    [0x03A0 - 0x80] = {2, "\xcf\x80"},
+    [0x03A1 - 0x80] = {2, "\xcf\x81"},
+    [0x03A3 - 0x80] = {2, "\xcf\x83"},
+    [0x03A4 - 0x80] = {2, "\xcf\x84"},
+    [0x03A5 - 0x80] = {2, "\xcf\x85"},
+    [0x03A6 - 0x80] = {2, "\xcf\x86"},
+    [0x03A7 - 0x80] = {2, "\xcf\x87"},
+    [0x03A8 - 0x80] = {2, "\xcf\x88"},
+    [0x03A9 - 0x80] = {2, "\xcf\x89"},
+    [0x03AA - 0x80] = {2, "\xcf\x8a"},
+    [0x03AB - 0x80] = {2, "\xcf\x8b"},
+    [0x03B0 - 0x80] = {6, "\xcf\x85\xcc\x88\xcc\x81"},
+    [0x03C2 - 0x80] = {2, "\xcf\x83"},
+    [0x03CF - 0x80] = {2, "\xcf\x97"},
+    [0x03D0 - 0x80] = {2, "\xce\xb2"},
+    [0x03D1 - 0x80] = {2, "\xce\xb8"},
+    [0x03D5 - 0x80] = {2, "\xcf\x86"},
+    [0x03D6 - 0x80] = {2, "\xcf\x80"},
+    [0x03D8 - 0x80] = {2, "\xcf\x99"},
+    [0x03DA - 0x80] = {2, "\xcf\x9b"},
+    [0x03DC - 0x80] = {2, "\xcf\x9d"},
+    [0x03DE - 0x80] = {2, "\xcf\x9f"},
+    [0x03E0 - 0x80] = {2, "\xcf\xa1"},
+    [0x03E2 - 0x80] = {2, "\xcf\xa3"},
+    [0x03E4 - 0x80] = {2, "\xcf\xa5"},
+    [0x03E6 - 0x80] = {2, "\xcf\xa7"},
+    [0x03E8 - 0x80] = {2, "\xcf\xa9"},
+    [0x03EA - 0x80] = {2, "\xcf\xab"},
+    [0x03EC - 0x80] = {2, "\xcf\xad"},
+    [0x03EE - 0x80] = {2, "\xcf\xaf"},
+    [0x03F0 - 0x80] = {2, "\xce\xba"},
+    [0x03F1 - 0x80] = {2, "\xcf\x81"},
+    [0x03F4 - 0x80] = {2, "\xce\xb8"},
+    [0x03F5 - 0x80] = {2, "\xce\xb5"},
+    [0x03F7 - 0x80] = {2, "\xcf\xb8"},
+    [0x03F9 - 0x80] = {2, "\xcf\xb2"},
+    [0x03FA - 0x80] = {2, "\xcf\xbb"},
+    [0x03FD - 0x80] = {2, "\xcd\xbb"},
+    [0x03FE - 0x80] = {2, "\xcd\xbc"},
+    [0x03FF - 0x80] = {2, "\xcd\xbd"},
+    [0x0400 - 0x80] = {2, "\xd1\x90"},
+    [0x0401 - 0x80] = {2, "\xd1\x91"},
+    [0x0402 - 0x80] = {2, "\xd1\x92"},
+    [0x0403 - 0x80] = {2, "\xd1\x93"},
+    [0x0404 - 0x80] = {2, "\xd1\x94"},
+    [0x0405 - 0x80] = {2, "\xd1\x95"},
+    [0x0406 - 0x80] = {2, "\xd1\x96"},
+    [0x0407 - 0x80] = {2, "\xd1\x97"},
+    [0x0408 - 0x80] = {2, "\xd1\x98"},
+    [0x0409 - 0x80] = {2, "\xd1\x99"},
+    [0x040A - 0x80] = {2, "\xd1\x9a"},
+    [0x040B - 0x80] = {2, "\xd1\x9b"},
+    [0x040C - 0x80] = {2, "\xd1\x9c"},
+    [0x040D - 0x80] = {2, "\xd1\x9d"},
+    [0x040E - 0x80] = {2, "\xd1\x9e"},
+    [0x040F - 0x80] = {2, "\xd1\x9f"},
+    [0x0410 - 0x80] = {2, "\xd0\xb0"},
+    [0x0411 - 0x80] = {2, "\xd0\xb1"},
+    [0x0412 - 0x80] = {2, "\xd0\xb2"},
+    [0x0413 - 0x80] = {2, "\xd0\xb3"},
+    [0x0414 - 0x80] = {2, "\xd0\xb4"},
+    [0x0415 - 0x80] = {2, "\xd0\xb5"},
+    [0x0416 - 0x80] = {2, "\xd0\xb6"},
+    [0x0417 - 0x80] = {2, "\xd0\xb7"},
+    [0x0418 - 0x80] = {2, "\xd0\xb8"},
+    [0x0419 - 0x80] = {2, "\xd0\xb9"},
+    [0x041A - 0x80] = {2, "\xd0\xba"},
+    [0x041B - 0x80] = {2, "\xd0\xbb"},
+    [0x041C - 0x80] = {2, "\xd0\xbc"},
+    [0x041D - 0x80] = {2, "\xd0\xbd"},
+    [0x041E - 0x80] = {2, "\xd0\xbe"},
+    [0x041F - 0x80] = {2, "\xd0\xbf"},
+    [0x0420 - 0x80] = {2, "\xd1\x80"},
+    [0x0421 - 0x80] = {2, "\xd1\x81"},
+    [0x0422 - 0x80] = {2, "\xd1\x82"},
+    [0x0423 - 0x80] = {2, "\xd1\x83"},
+    [0x0424 - 0x80] = {2, "\xd1\x84"},
+    [0x0425 - 0x80] = {2, "\xd1\x85"},
+    [0x0426 - 0x80] = {2, "\xd1\x86"},
+    [0x0427 - 0x80] = {2, "\xd1\x87"},
+    [0x0428 - 0x80] = {2, "\xd1\x88"},
+    [0x0429 - 0x80] = {2, "\xd1\x89"},
+    [0x042A - 0x80] = {2, "\xd1\x8a"},
+    [0x042B - 0x80] = {2, "\xd1\x8b"},
+    [0x042C - 0x80] = {2, "\xd1\x8c"},
+    [0x042D - 0x80] = {2, "\xd1\x8d"},
+    [0x042E - 0x80] = {2, "\xd1\x8e"},
+    [0x042F - 0x80] = {2, "\xd1\x8f"},
+    [0x0460 - 0x80] = {2, "\xd1\xa1"},
+    [0x0462 - 0x80] = {2, "\xd1\xa3"},
+    [0x0464 - 0x80] = {2, "\xd1\xa5"},
+    [0x0466 - 0x80] = {2, "\xd1\xa7"},
+    [0x0468 - 0x80] = {2, "\xd1\xa9"},
+    [0x046A - 0x80] = {2, "\xd1\xab"},
+    [0x046C - 0x80] = {2, "\xd1\xad"},
+    [0x046E - 0x80] = {2, "\xd1\xaf"},
+    [0x0470 - 0x80] = {2, "\xd1\xb1"},
+    [0x0472 - 0x80] = {2, "\xd1\xb3"},
+    [0x0474 - 0x80] = {2, "\xd1\xb5"},
+    [0x0476 - 0x80] = {2, "\xd1\xb7"},
+    [0x0478 - 0x80] = {2, "\xd1\xb9"},
+    [0x047A - 0x80] = {2, "\xd1\xbb"},
+    [0x047C - 0x80] = {2, "\xd1\xbd"},
+    [0x047E - 0x80] = {2, "\xd1\xbf"},
+    [0x0480 - 0x80] = {2, "\xd2\x81"},
+    [0x048A - 0x80] = {2, "\xd2\x8b"},
+    [0x048C - 0x80] = {2, "\xd2\x8d"},
+    [0x048E - 0x80] = {2, "\xd2\x8f"},
+    [0x0490 - 0x80] = {2, "\xd2\x91"},
+    [0x0492 - 0x80] = {2, "\xd2\x93"},
+    [0x0494 - 0x80] = {2, "\xd2\x95"},
+    [0x0496 - 0x80] = {2, "\xd2\x97"},
+    [0x0498 - 0x80] = {2, "\xd2\x99"},
+    [0x049A - 0x80] = {2, "\xd2\x9b"},
+    [0x049C - 0x80] = {2, "\xd2\x9d"},
+    [0x049E - 0x80] = {2, "\xd2\x9f"},
+    [0x04A0 - 0x80] = {2, "\xd2\xa1"},
+    [0x04A2 - 0x80] = {2, "\xd2\xa3"},
+    [0x04A4 - 0x80] = {2, "\xd2\xa5"},
+    [0x04A6 - 0x80] = {2, "\xd2\xa7"},
+    [0x04A8 - 0x80] = {2, "\xd2\xa9"},
+    [0x04AA - 0x80] = {2, "\xd2\xab"},
+    [0x04AC - 0x80] = {2, "\xd2\xad"},
+    [0x04AE - 0x80] = {2, "\xd2\xaf"},
+    [0x04B0 - 0x80] = {2, "\xd2\xb1"},
+    [0x04B2 - 0x80] = {2, "\xd2\xb3"},
+    [0x04B4 - 0x80] = {2, "\xd2\xb5"},
+    [0x04B6 - 0x80] = {2, "\xd2\xb7"},
+    [0x04B8 - 0x80] = {2, "\xd2\xb9"},
+    [0x04BA - 0x80] = {2, "\xd2\xbb"},
+    [0x04BC - 0x80] = {2, "\xd2\xbd"},
+    [0x04BE - 0x80] = {2, "\xd2\xbf"},
+    [0x04C0 - 0x80] = {2, "\xd3\x8f"},
+    [0x04C1 - 0x80] = {2, "\xd3\x82"},
+    [0x04C3 - 0x80] = {2, "\xd3\x84"},
+    [0x04C5 - 0x80] = {2, "\xd3\x86"},
+    [0x04C7 - 0x80] = {2, "\xd3\x88"},
+    [0x04C9 - 0x80] = {2, "\xd3\x8a"},
+    [0x04CB - 0x80] = {2, "\xd3\x8c"},
+    [0x04CD - 0x80] = {2, "\xd3\x8e"},
+    [0x04D0 - 0x80] = {2, "\xd3\x91"},
+    [0x04D2 - 0x80] = {2, "\xd3\x93"},
+    [0x04D4 - 0x80] = {2, "\xd3\x95"},
+    [0x04D6 - 0x80] = {2, "\xd3\x97"},
+    [0x04D8 - 0x80] = {2, "\xd3\x99"},
+    [0x04DA - 0x80] = {2, "\xd3\x9b"},
+    [0x04DC - 0x80] = {2, "\xd3\x9d"},
+    [0x04DE - 0x80] = {2, "\xd3\x9f"},
+    [0x04E0 - 0x80] = {2, "\xd3\xa1"},
+    [0x04E2 - 0x80] = {2, "\xd3\xa3"},
+    [0x04E4 - 0x80] = {2, "\xd3\xa5"},
+    [0x04E6 - 0x80] = {2, "\xd3\xa7"},
+    [0x04E8 - 0x80] = {2, "\xd3\xa9"},
+    [0x04EA - 0x80] = {2, "\xd3\xab"},
+    [0x04EC - 0x80] = {2, "\xd3\xad"},
+    [0x04EE - 0x80] = {2, "\xd3\xaf"},
+    [0x04F0 - 0x80] = {2, "\xd3\xb1"},
+    [0x04F2 - 0x80] = {2, "\xd3\xb3"},
+    [0x04F4 - 0x80] = {2, "\xd3\xb5"},
+    [0x04F6 - 0x80] = {2, "\xd3\xb7"},
+    [0x04F8 - 0x80] = {2, "\xd3\xb9"},
+    [0x04FA - 0x80] = {2, "\xd3\xbb"},
+    [0x04FC - 0x80] = {2, "\xd3\xbd"},
+    [0x04FE - 0x80] = {2, "\xd3\xbf"},
+    [0x0500 - 0x80] = {2, "\xd4\x81"},
+    [0x0502 - 0x80] = {2, "\xd4\x83"},
+    [0x0504 - 0x80] = {2, "\xd4\x85"},
+    [0x0506 - 0x80] = {2, "\xd4\x87"},
+    [0x0508 - 0x80] = {2, "\xd4\x89"},
+    [0x050A - 0x80] = {2, "\xd4\x8b"},
+    [0x050C - 0x80] = {2, "\xd4\x8d"},
+    [0x050E - 0x80] = {2, "\xd4\x8f"},
+    [0x0510 - 0x80] = {2, "\xd4\x91"},
+    [0x0512 - 0x80] = {2, "\xd4\x93"},
+    [0x0514 - 0x80] = {2, "\xd4\x95"},
+    [0x0516 - 0x80] = {2, "\xd4\x97"},
+    [0x0518 - 0x80] = {2, "\xd4\x99"},
+    [0x051A - 0x80] = {2, "\xd4\x9b"},
+    [0x051C - 0x80] = {2, "\xd4\x9d"},
+    [0x051E - 0x80] = {2, "\xd4\x9f"},
+    [0x0520 - 0x80] = {2, "\xd4\xa1"},
+    [0x0522 - 0x80] = {2, "\xd4\xa3"},
+    [0x0524 - 0x80] = {2, "\xd4\xa5"},
+    [0x0526 - 0x80] = {2, "\xd4\xa7"},
+    [0x0528 - 0x80] = {2, "\xd4\xa9"},
+    [0x052A - 0x80] = {2, "\xd4\xab"},
+    [0x052C - 0x80] = {2, "\xd4\xad"},
+    [0x052E - 0x80] = {2, "\xd4\xaf"},
+    [0x0531 - 0x80] = {2, "\xd5\xa1"},
+    [0x0532 - 0x80] = {2, "\xd5\xa2"},
+    [0x0533 - 0x80] = {2, "\xd5\xa3"},
+    [0x0534 - 0x80] = {2, "\xd5\xa4"},
+    [0x0535 - 0x80] = {2, "\xd5\xa5"},
+    [0x0536 - 0x80] = {2, "\xd5\xa6"},
+    [0x0537 - 0x80] = {2, "\xd5\xa7"},
+    [0x0538 - 0x80] = {2, "\xd5\xa8"},
+    [0x0539 - 0x80] = {2, "\xd5\xa9"},
+    [0x053A - 0x80] = {2, "\xd5\xaa"},
+    [0x053B - 0x80] = {2, "\xd5\xab"},
+    [0x053C - 0x80] = {2, "\xd5\xac"},
+    [0x053D - 0x80] = {2, "\xd5\xad"},
+    [0x053E - 0x80] = {2, "\xd5\xae"},
+    [0x053F - 0x80] = {2, "\xd5\xaf"},
+    [0x0540 - 0x80] = {2, "\xd5\xb0"},
+    [0x0541 - 0x80] = {2, "\xd5\xb1"},
+    [0x0542 - 0x80] = {2, "\xd5\xb2"},
+    [0x0543 - 0x80] = {2, "\xd5\xb3"},
+    [0x0544 - 0x80] = {2, "\xd5\xb4"},
+    [0x0545 - 0x80] = {2, "\xd5\xb5"},
+    [0x0546 - 0x80] = {2, "\xd5\xb6"},
+    [0x0547 - 0x80] = {2, "\xd5\xb7"},
+    [0x0548 - 0x80] = {2, "\xd5\xb8"},
+    [0x0549 - 0x80] = {2, "\xd5\xb9"},
+    [0x054A - 0x80] = {2, "\xd5\xba"},
+    [0x054B - 0x80] = {2, "\xd5\xbb"},
+    [0x054C - 0x80] = {2, "\xd5\xbc"},
+    [0x054D - 0x80] = {2, "\xd5\xbd"},
+    [0x054E - 0x80] = {2, "\xd5\xbe"},
+    [0x054F - 0x80] = {2, "\xd5\xbf"},
+    [0x0550 - 0x80] = {2, "\xd6\x80"},
+    [0x0551 - 0x80] = {2, "\xd6\x81"},
+    [0x0552 - 0x80] = {2, "\xd6\x82"},
+    [0x0553 - 0x80] = {2, "\xd6\x83"},
+    [0x0554 - 0x80] = {2, "\xd6\x84"},
+    [0x0555 - 0x80] = {2, "\xd6\x85"},
+    [0x0556 - 0x80] = {2, "\xd6\x86"},
+    [0x0587 - 0x80] = {4, "\xd5\xa5\xd6\x82"},
+};
+
+// U+0800 and up, sorted by code point
+static const struct {
+    uint32_t cp;
+    fold_t   to;
+} fold_wide[] = {
+    {0x010A0, {3, "\xe2\xb4\x80"}},
+    {0x010A1, {3, "\xe2\xb4\x81"}},
+    {0x010A2, {3, "\xe2\xb4\x82"}},
+    {0x010A3, {3, "\xe2\xb4\x83"}},
+    {0x010A4, {3, "\xe2\xb4\x84"}},
+    {0x010A5, {3, "\xe2\xb4\x85"}},
+    {0x010A6, {3, "\xe2\xb4\x86"}},
+    {0x010A7, {3, "\xe2\xb4\x87"}},
+    {0x010A8, {3, "\xe2\xb4\x88"}},
+    {0x010A9, {3, "\xe2\xb4\x89"}},
+    {0x010AA, {3, "\xe2\xb4\x8a"}},
+    {0x010AB, {3, "\xe2\xb4\x8b"}},
+    {0x010AC, {3, "\xe2\xb4\x8c"}},
+    {0x010AD, {3, "\xe2\xb4\x8d"}},
+    {0x010AE, {3, "\xe2\xb4\x8e"}},
+    {0x010AF, {3, "\xe2\xb4\x8f"}},
+    {0x010B0, {3, "\xe2\xb4\x90"}},
+    {0x010B1, {3, "\xe2\xb4\x91"}},
+    {0x010B2, {3, "\xe2\xb4\x92"}},
+    {0x010B3, {3, "\xe2\xb4\x93"}},
+    {0x010B4, {3, "\xe2\xb4\x94"}},
+    {0x010B5, {3, "\xe2\xb4\x95"}},
+    {0x010B6, {3, "\xe2\xb4\x96"}},
+    {0x010B7, {3, "\xe2\xb4\x97"}},
+    {0x010B8, {3, "\xe2\xb4\x98"}},
+    {0x010B9, {3, "\xe2\xb4\x99"}},
+    {0x010BA, {3, "\xe2\xb4\x9a"}},
+    {0x010BB, {3, "\xe2\xb4\x9b"}},
+    {0x010BC, {3, "\xe2\xb4\x9c"}},
+    {0x010BD, {3, "\xe2\xb4\x9d"}},
+    {0x010BE, {3, "\xe2\xb4\x9e"}},
+    {0x010BF, {3, "\xe2\xb4\x9f"}},
+    {0x010C0, {3, "\xe2\xb4\xa0"}},
+    {0x010C1, {3, "\xe2\xb4\xa1"}},
+    {0x010C2, {3, "\xe2\xb4\xa2"}},
+    {0x010C3, {3, "\xe2\xb4\xa3"}},
+    {0x010C4, {3, "\xe2\xb4\xa4"}},
+    {0x010C5, {3, "\xe2\xb4\xa5"}},
+    {0x010C7, {3, "\xe2\xb4\xa7"}},
+    {0x010CD, {3, "\xe2\xb4\xad"}},
+    {0x013F8, {3, "\xe1\x8f\xb0"}},
+    {0x013F9, {3, "\xe1\x8f\xb1"}},
+    {0x013FA, {3, "\xe1\x8f\xb2"}},
+    {0x013FB, {3, "\xe1\x8f\xb3"}},
+    {0x013FC, {3, "\xe1\x8f\xb4"}},
+    {0x013FD, {3, "\xe1\x8f\xb5"}},
+    {0x01C80, {2, "\xd0\xb2"}},
+    {0x01C81, {2, "\xd0\xb4"}},
+    {0x01C82, {2, "\xd0\xbe"}},
+    {0x01C83, {2, "\xd1\x81"}},
+    {0x01C84, {2, "\xd1\x82"}},
+    {0x01C85, {2, "\xd1\x82"}},
+    {0x01C86, {2, "\xd1\x8a"}},
+    {0x01C87, {2, "\xd1\xa3"}},
+    {0x01C88, {3, "\xea\x99\x8b"}},
+    {0x01C90, {3, "\xe1\x83\x90"}},
+    {0x01C91, {3, "\xe1\x83\x91"}},
+    {0x01C92, {3, "\xe1\x83\x92"}},
+    {0x01C93, {3, "\xe1\x83\x93"}},
+    {0x01C94, {3, "\xe1\x83\x94"}},
+    {0x01C95, {3, "\xe1\x83\x95"}},
+    {0x01C96, {3, "\xe1\x83\x96"}},
+    {0x01C97, {3, "\xe1\x83\x97"}},
+    {0x01C98, {3, "\xe1\x83\x98"}},
+    {0x01C99, {3, "\xe1\x83\x99"}},
+    {0x01C9A, {3, "\xe1\x83\x9a"}},
+    {0x01C9B, {3, "\xe1\x83\x9b"}},
+    {0x01C9C, {3, "\xe1\x83\x9c"}},
+    {0x01C9D, {3, "\xe1\x83\x9d"}},
+    {0x01C9E, {3, "\xe1\x83\x9e"}},
+    {0x01C9F, {3, "\xe1\x83\x9f"}},
+    {0x01CA0, {3, "\xe1\x83\xa0"}},
+    {0x01CA1, {3, "\xe1\x83\xa1"}},
+    {0x01CA2, {3, "\xe1\x83\xa2"}},
+    {0x01CA3, {3, "\xe1\x83\xa3"}},
+    {0x01CA4, {3, "\xe1\x83\xa4"}},
+    {0x01CA5, {3, "\xe1\x83\xa5"}},
+    {0x01CA6, {3, "\xe1\x83\xa6"}},
+    {0x01CA7, {3, "\xe1\x83\xa7"}},
+    {0x01CA8, {3, "\xe1\x83\xa8"}},
+    {0x01CA9, {3, "\xe1\x83\xa9"}},
+    {0x01CAA, {3, "\xe1\x83\xaa"}},
+    {0x01CAB, {3, "\xe1\x83\xab"}},
+    {0x01CAC, {3, "\xe1\x83\xac"}},
+    {0x01CAD, {3, "\xe1\x83\xad"}},
+    {0x01CAE, {3, "\xe1\x83\xae"}},
+    {0x01CAF, {3, "\xe1\x83\xaf"}},
+    {0x01CB0, {3, "\xe1\x83\xb0"}},
+    {0x01CB1, {3, "\xe1\x83\xb1"}},
+    {0x01CB2, {3, "\xe1\x83\xb2"}},
+    {0x01CB3, {3, "\xe1\x83\xb3"}},
+    {0x01CB4, {3, "\xe1\x83\xb4"}},
+    {0x01CB5, {3, "\xe1\x83\xb5"}},
+    {0x01CB6, {3, "\xe1\x83\xb6"}},
+    {0x01CB7, {3, "\xe1\x83\xb7"}},
+    {0x01CB8, {3, "\xe1\x83\xb8"}},
+    {0x01CB9, {3, "\xe1\x83\xb9"}},
+    {0x01CBA, {3, "\xe1\x83\xba"}},
+    {0x01CBD, {3, "\xe1\x83\xbd"}},
+    {0x01CBE, {3, "\xe1\x83\xbe"}},
+    {0x01CBF, {3, "\xe1\x83\xbf"}},
+    {0x01E00, {3, "\xe1\xb8\x81"}},
+    {0x01E02, {3, "\xe1\xb8\x83"}},
+    {0x01E04, {3, "\xe1\xb8\x85"}},
+    {0x01E06, {3, "\xe1\xb8\x87"}},
+    {0x01E08, {3, "\xe1\xb8\x89"}},
+    {0x01E0A, {3, "\xe1\xb8\x8b"}},
+    {0x01E0C, {3, "\xe1\xb8\x8d"}},
+    {0x01E0E, {3, "\xe1\xb8\x8f"}},
+    {0x01E10, {3, "\xe1\xb8\x91"}},
+    {0x01E12, {3, "\xe1\xb8\x93"}},
+    {0x01E14, {3, "\xe1\xb8\x95"}},
+    {0x01E16, {3, "\xe1\xb8\x97"}},
+    {0x01E18, {3, "\xe1\xb8\x99"}},
+    {0x01E1A, {3, "\xe1\xb8\x9b"}},
+    {0x01E1C, {3, "\xe1\xb8\x9d"}},
+    {0x01E1E, {3, "\xe1\xb8\x9f"}},
+    {0x01E20, {3, "\xe1\xb8\xa1"}},
+    {0x01E22, {3, "\xe1\xb8\xa3"}},
+    {0x01E24, {3, "\xe1\xb8\xa5"}},
+    {0x01E26, {3, "\xe1\xb8\xa7"}},
+    {0x01E28, {3, "\xe1\xb8\xa9"}},
+    {0x01E2A, {3, "\xe1\xb8\xab"}},
+    {0x01E2C, {3, "\xe1\xb8\xad"}},
+    {0x01E2E, {3, "\xe1\xb8\xaf"}},
+    {0x01E30, {3, "\xe1\xb8\xb1"}},
+    {0x01E32, {3, "\xe1\xb8\xb3"}},
+    {0x01E34, {3, "\xe1\xb8\xb5"}},
+    {0x01E36, {3, "\xe1\xb8\xb7"}},
+    {0x01E38, {3, "\xe1\xb8\xb9"}},
+    {0x01E3A, {3, "\xe1\xb8\xbb"}},
+    {0x01E3C, {3, "\xe1\xb8\xbd"}},
+    {0x01E3E, {3, "\xe1\xb8\xbf"}},
+    {0x01E40, {3, "\xe1\xb9\x81"}},
+    {0x01E42, {3, "\xe1\xb9\x83"}},
+    {0x01E44, {3, "\xe1\xb9\x85"}},
+    {0x01E46, {3, "\xe1\xb9\x87"}},
+    {0x01E48, {3, "\xe1\xb9\x89"}},
+    {0x01E4A, {3, "\xe1\xb9\x8b"}},
+    {0x01E4C, {3, "\xe1\xb9\x8d"}},
+    {0x01E4E, {3, "\xe1\xb9\x8f"}},
+    {0x01E50, {3, "\xe1\xb9\x91"}},
+    {0x01E52, {3, "\xe1\xb9\x93"}},
+    {0x01E54, {3, "\xe1\xb9\x95"}},
+    {0x01E56, {3, "\xe1\xb9\x97"}},
+    {0x01E58, {3, "\xe1\xb9\x99"}},
+    {0x01E5A, {3, "\xe1\xb9\x9b"}},
+    {0x01E5C, {3, "\xe1\xb9\x9d"}},
+    {0x01E5E, {3, "\xe1\xb9\x9f"}},
+    {0x01E60, {3, "\xe1\xb9\xa1"}},
+    {0x01E62, {3, "\xe1\xb9\xa3"}},
+    {0x01E64, {3, "\xe1\xb9\xa5"}},
+    {0x01E66, {3, "\xe1\xb9\xa7"}},
+    {0x01E68, {3, "\xe1\xb9\xa9"}},
+    {0x01E6A, {3, "\xe1\xb9\xab"}},
+    {0x01E6C, {3, "\xe1\xb9\xad"}},
+    {0x01E6E, {3, "\xe1\xb9\xaf"}},
+    {0x01E70, {3, "\xe1\xb9\xb1"}},
+    {0x01E72, {3, "\xe1\xb9\xb3"}},
+    {0x01E74, {3, "\xe1\xb9\xb5"}},
+    {0x01E76, {3, "\xe1\xb9\xb7"}},
+    {0x01E78, {3, "\xe1\xb9\xb9"}},
+    {0x01E7A, {3, "\xe1\xb9\xbb"}},
+    {0x01E7C, {3, "\xe1\xb9\xbd"}},
+    {0x01E7E, {3, "\xe1\xb9\xbf"}},
+    {0x01E80, {3, "\xe1\xba\x81"}},
+    {0x01E82, {3, "\xe1\xba\x83"}},
+    {0x01E84, {3, "\xe1\xba\x85"}},
+    {0x01E86, {3, "\xe1\xba\x87"}},
+    {0x01E88, {3, "\xe1\xba\x89"}},
+    {0x01E8A, {3, "\xe1\xba\x8b"}},
+    {0x01E8C, {3, "\xe1\xba\x8d"}},
+    {0x01E8E, {3, "\xe1\xba\x8f"}},
+    {0x01E90, {3, "\xe1\xba\x91"}},
+    {0x01E92, {3, "\xe1\xba\x93"}},
+    {0x01E94, {3, "\xe1\xba\x95"}},
+    {0x01E96, {3, "\x68\xcc\xb1"}},
+    {0x01E97, {3, "\x74\xcc\x88"}},
+    {0x01E98, {3, "\x77\xcc\x8a"}},
+    {0x01E99, {3, "\x79\xcc\x8a"}},
+    {0x01E9A, {3, "\x61\xca\xbe"}},
+    {0x01E9B, {3, "\xe1\xb9\xa1"}},
+    {0x01E9E, {2, "\x73\x73"}},
+    {0x01EA0, {3, "\xe1\xba\xa1"}},
+    {0x01EA2, {3, "\xe1\xba\xa3"}},
+    {0x01EA4, {3, "\xe1\xba\xa5"}},
+    {0x01EA6, {3, "\xe1\xba\xa7"}},
+    {0x01EA8, {3, "\xe1\xba\xa9"}},
+    {0x01EAA, {3, "\xe1\xba\xab"}},
+    {0x01EAC, {3, "\xe1\xba\xad"}},
+    {0x01EAE, {3, "\xe1\xba\xaf"}},
+    {0x01EB0, {3, "\xe1\xba\xb1"}},
+    {0x01EB2, {3, "\xe1\xba\xb3"}},
+    {0x01EB4, {3, "\xe1\xba\xb5"}},
+    {0x01EB6, {3, "\xe1\xba\xb7"}},
+    {0x01EB8, {3, "\xe1\xba\xb9"}},
+    {0x01EBA, {3, "\xe1\xba\xbb"}},
+    {0x01EBC, {3, "\xe1\xba\xbd"}},
+    {0x01EBE, {3, "\xe1\xba\xbf"}},
+    {0x01EC0, {3, "\xe1\xbb\x81"}},
+    {0x01EC2, {3, "\xe1\xbb\x83"}},
+    {0x01EC4, {3, "\xe1\xbb\x85"}},
+    {0x01EC6, {3, "\xe1\xbb\x87"}},
+    {0x01EC8, {3, "\xe1\xbb\x89"}},
+    {0x01ECA, {3, "\xe1\xbb\x8b"}},
+    {0x01ECC, {3, "\xe1\xbb\x8d"}},
+    {0x01ECE, {3, "\xe1\xbb\x8f"}},
+    {0x01ED0, {3, "\xe1\xbb\x91"}},
+    {0x01ED2, {3, "\xe1\xbb\x93"}},
+    {0x01ED4, {3, "\xe1\xbb\x95"}},
+    {0x01ED6, {3, "\xe1\xbb\x97"}},
+    {0x01ED8, {3, "\xe1\xbb\x99"}},
+    {0x01EDA, {3, "\xe1\xbb\x9b"}},
+    {0x01EDC, {3, "\xe1\xbb\x9d"}},
+    {0x01EDE, {3, "\xe1\xbb\x9f"}},
+    {0x01EE0, {3, "\xe1\xbb\xa1"}},
+    {0x01EE2, {3, "\xe1\xbb\xa3"}},
+    {0x01EE4, {3, "\xe1\xbb\xa5"}},
+    {0x01EE6, {3, "\xe1\xbb\xa7"}},
+    {0x01EE8, {3, "\xe1\xbb\xa9"}},
+    {0x01EEA, {3, "\xe1\xbb\xab"}},
+    {0x01EEC, {3, "\xe1\xbb\xad"}},
+    {0x01EEE, {3, "\xe1\xbb\xaf"}},
+    {0x01EF0, {3, "\xe1\xbb\xb1"}},
+    {0x01EF2, {3, "\xe1\xbb\xb3"}},
+    {0x01EF4, {3, "\xe1\xbb\xb5"}},
+    {0x01EF6, {3, "\xe1\xbb\xb7"}},
+    {0x01EF8, {3, "\xe1\xbb\xb9"}},
+    {0x01EFA, {3, "\xe1\xbb\xbb"}},
+    {0x01EFC, {3, "\xe1\xbb\xbd"}},
+    {0x01EFE, {3, "\xe1\xbb\xbf"}},
+    {0x01F08, {3, "\xe1\xbc\x80"}},
+    {0x01F09, {3, "\xe1\xbc\x81"}},
+    {0x01F0A, {3, "\xe1\xbc\x82"}},
+    {0x01F0B, {3, "\xe1\xbc\x83"}},
+    {0x01F0C, {3, "\xe1\xbc\x84"}},
+    {0x01F0D, {3, "\xe1\xbc\x85"}},
+    {0x01F0E, {3, "\xe1\xbc\x86"}},
+    {0x01F0F, {3, "\xe1\xbc\x87"}},
+    {0x01F18, {3, "\xe1\xbc\x90"}},
+    {0x01F19, {3, "\xe1\xbc\x91"}},
+    {0x01F1A, {3, "\xe1\xbc\x92"}},
+    {0x01F1B, {3, "\xe1\xbc\x93"}},
+    {0x01F1C, {3, "\xe1\xbc\x94"}},
+    {0x01F1D, {3, "\xe1\xbc\x95"}},
+    {0x01F28, {3, "\xe1\xbc\xa0"}},
+    {0x01F29, {3, "\xe1\xbc\xa1"}},
+    {0x01F2A, {3, "\xe1\xbc\xa2"}},
+    {0x01F2B, {3, "\xe1\xbc\xa3"}},
+    {0x01F2C, {3, "\xe1\xbc\xa4"}},
+    {0x01F2D, {3, "\xe1\xbc\xa5"}},
+    {0x01F2E, {3, "\xe1\xbc\xa6"}},
+    {0x01F2F, {3, "\xe1\xbc\xa7"}},
+    {0x01F38, {3, "\xe1\xbc\xb0"}},
+    {0x01F39, {3, "\xe1\xbc\xb1"}},
+    {0x01F3A, {3, "\xe1\xbc\xb2"}},
+    {0x01F3B, {3, "\xe1\xbc\xb3"}},
+    {0x01F3C, {3, "\xe1\xbc\xb4"}},
+    {0x01F3D, {3, "\xe1\xbc\xb5"}},
+    {0x01F3E, {3, "\xe1\xbc\xb6"}},
+    {0x01F3F, {3, "\xe1\xbc\xb7"}},
+    {0x01F48, {3, "\xe1\xbd\x80"}},
+    {0x01F49, {3, "\xe1\xbd\x81"}},
+    {0x01F4A, {3, "\xe1\xbd\x82"}},
+    {0x01F4B, {3, "\xe1\xbd\x83"}},
+    {0x01F4C, {3, "\xe1\xbd\x84"}},
+    {0x01F4D, {3, "\xe1\xbd\x85"}},
+    {0x01F50, {4, "\xcf\x85\xcc\x93"}},
+    {0x01F52, {6, "\xcf\x85\xcc\x93\xcc\x80"}},
+    {0x01F54, {6, "\xcf\x85\xcc\x93\xcc\x81"}},
+    {0x01F56, {6, "\xcf\x85\xcc\x93\xcd\x82"}},
+    {0x01F59, {3, "\xe1\xbd\x91"}},
+    {0x01F5B, {3, "\xe1\xbd\x93"}},
+    {0x01F5D, {3, "\xe1\xbd\x95"}},
+    {0x01F5F, {3, "\xe1\xbd\x97"}},
+    {0x01F68, {3, "\xe1\xbd\xa0"}},
+    {0x01F69, {3, "\xe1\xbd\xa1"}},
+    {0x01F6A, {3, "\xe1\xbd\xa2"}},
+    {0x01F6B, {3, "\xe1\xbd\xa3"}},
+    {0x01F6C, {3, "\xe1\xbd\xa4"}},
+    {0x01F6D, {3, "\xe1\xbd\xa5"}},
+    {0x01F6E, {3, "\xe1\xbd\xa6"}},
+    {0x01F6F, {3, "\xe1\xbd\xa7"}},
+    {0x01F80, {5, "\xe1\xbc\x80\xce\xb9"}},
+    {0x01F81, {5, "\xe1\xbc\x81\xce\xb9"}},
+    {0x01F82, {5, "\xe1\xbc\x82\xce\xb9"}},
+    {0x01F83, {5, "\xe1\xbc\x83\xce\xb9"}},
+    {0x01F84, {5, "\xe1\xbc\x84\xce\xb9"}},
+    {0x01F85, {5, "\xe1\xbc\x85\xce\xb9"}},
+    {0x01F86, {5, "\xe1\xbc\x86\xce\xb9"}},
+    {0x01F87, {5, "\xe1\xbc\x87\xce\xb9"}},
+    {0x01F88, {5, "\xe1\xbc\x80\xce\xb9"}},
+    {0x01F89, {5, "\xe1\xbc\x81\xce\xb9"}},
+    {0x01F8A, {5, "\xe1\xbc\x82\xce\xb9"}},
+    {0x01F8B, {5, "\xe1\xbc\x83\xce\xb9"}},
+    {0x01F8C, {5, "\xe1\xbc\x84\xce\xb9"}},
+    {0x01F8D, {5, "\xe1\xbc\x85\xce\xb9"}},
+    {0x01F8E, {5, "\xe1\xbc\x86\xce\xb9"}},
+    {0x01F8F, {5, "\xe1\xbc\x87\xce\xb9"}},
+    {0x01F90, {5, "\xe1\xbc\xa0\xce\xb9"}},
+    {0x01F91, {5, "\xe1\xbc\xa1\xce\xb9"}},
+    {0x01F92, {5, "\xe1\xbc\xa2\xce\xb9"}},
+    {0x01F93, {5, "\xe1\xbc\xa3\xce\xb9"}},
+    {0x01F94, {5, "\xe1\xbc\xa4\xce\xb9"}},
+    {0x01F95, {5, "\xe1\xbc\xa5\xce\xb9"}},
+    {0x01F96, {5, "\xe1\xbc\xa6\xce\xb9"}},
+    {0x01F97, {5, "\xe1\xbc\xa7\xce\xb9"}},
+    {0x01F98, {5, "\xe1\xbc\xa0\xce\xb9"}},
+    {0x01F99, {5, "\xe1\xbc\xa1\xce\xb9"}},
+    {0x01F9A, {5, "\xe1\xbc\xa2\xce\xb9"}},
+    {0x01F9B, {5, "\xe1\xbc\xa3\xce\xb9"}},
+    {0x01F9C, {5, "\xe1\xbc\xa4\xce\xb9"}},
+    {0x01F9D, {5, "\xe1\xbc\xa5\xce\xb9"}},
+    {0x01F9E, {5, "\xe1\xbc\xa6\xce\xb9"}},
+    {0x01F9F, {5, "\xe1\xbc\xa7\xce\xb9"}},
+    {0x01FA0, {5, "\xe1\xbd\xa0\xce\xb9"}},
+    {0x01FA1, {5, "\xe1\xbd\xa1\xce\xb9"}},
+    {0x01FA2, {5, "\xe1\xbd\xa2\xce\xb9"}},
+    {0x01FA3, {5, "\xe1\xbd\xa3\xce\xb9"}},
+    {0x01FA4, {5, "\xe1\xbd\xa4\xce\xb9"}},
+    {0x01FA5, {5, "\xe1\xbd\xa5\xce\xb9"}},
+    {0x01FA6, {5, "\xe1\xbd\xa6\xce\xb9"}},
+    {0x01FA7, {5, "\xe1\xbd\xa7\xce\xb9"}},
+    {0x01FA8, {5, "\xe1\xbd\xa0\xce\xb9"}},
+    {0x01FA9, {5, "\xe1\xbd\xa1\xce\xb9"}},
+    {0x01FAA, {5, "\xe1\xbd\xa2\xce\xb9"}},
+    {0x01FAB, {5, "\xe1\xbd\xa3\xce\xb9"}},
+    {0x01FAC, {5, "\xe1\xbd\xa4\xce\xb9"}},
+    {0x01FAD, {5, "\xe1\xbd\xa5\xce\xb9"}},
+    {0x01FAE, {5, "\xe1\xbd\xa6\xce\xb9"}},
+    {0x01FAF, {5, "\xe1\xbd\xa7\xce\xb9"}},
+    {0x01FB2, {5, "\xe1\xbd\xb0\xce\xb9"}},
+    {0x01FB3, {4, "\xce\xb1\xce\xb9"}},
+    {0x01FB4, {4, "\xce\xac\xce\xb9"}},
+    {0x01FB6, {4, "\xce\xb1\xcd\x82"}},
+    {0x01FB7, {6, "\xce\xb1\xcd\x82\xce\xb9"}},
+    {0x01FB8, {3, "\xe1\xbe\xb0"}},
+    {0x01FB9, {3, "\xe1\xbe\xb1"}},
+    {0x01FBA, {3, "\xe1\xbd\xb0"}},
+    {0x01FBB, {3, "\xe1\xbd\xb1"}},
+    {0x01FBC, {4, "\xce\xb1\xce\xb9"}},
+    {0x01FBE, {2, "\xce\xb9"}},
+    {0x01FC2, {5, "\xe1\xbd\xb4\xce\xb9"}},
+    {0x01FC3, {4, "\xce\xb7\xce\xb9"}},
+    {0x01FC4, {4, "\xce\xae\xce\xb9"}},
+    {0x01FC6, {4, "\xce\xb7\xcd\x82"}},
+    {0x01FC7, {6, "\xce\xb7\xcd\x82\xce\xb9"}},
+    {0x01FC8, {3, "\xe1\xbd\xb2"}},
+    {0x01FC9, {3, "\xe1\xbd\xb3"}},
+    {0x01FCA, {3, "\xe1\xbd\xb4"}},
+    {0x01FCB, {3, "\xe1\xbd\xb5"}},
+    {0x01FCC, {4, "\xce\xb7\xce\xb9"}},
+    {0x01FD2, {6, "\xce\xb9\xcc\x88\xcc\x80"}},
+    {0x01FD3, {6, "\xce\xb9\xcc\x88\xcc\x81"}},
+    {0x01FD6, {4, "\xce\xb9\xcd\x82"}},
+    {0x01FD7, {6, "\xce\xb9\xcc\x88\xcd\x82"}},
+    {0x01FD8, {3, "\xe1\xbf\x90"}},
+    {0x01FD9, {3, "\xe1\xbf\x91"}},
+    {0x01FDA, {3, "\xe1\xbd\xb6"}},
+    {0x01FDB, {3, "\xe1\xbd\xb7"}},
+    {0x01FE2, {6, "\xcf\x85\xcc\x88\xcc\x80"}},
+    {0x01FE3, {6, "\xcf\x85\xcc\x88\xcc\x81"}},
+    {0x01FE4, {4, "\xcf\x81\xcc\x93"}},
+    {0x01FE6, {4, "\xcf\x85\xcd\x82"}},
+    {0x01FE7, {6, "\xcf\x85\xcc\x88\xcd\x82"}},
+    {0x01FE8, {3, "\xe1\xbf\xa0"}},
+    {0x01FE9, {3, "\xe1\xbf\xa1"}},
+    {0x01FEA, {3, "\xe1\xbd\xba"}},
+    {0x01FEB, {3, "\xe1\xbd\xbb"}},
+    {0x01FEC, {3, "\xe1\xbf\xa5"}},
+    {0x01FF2, {5, "\xe1\xbd\xbc\xce\xb9"}},
+    {0x01FF3, {4, "\xcf\x89\xce\xb9"}},
+    {0x01FF4, {4, "\xcf\x8e\xce\xb9"}},
+    {0x01FF6, {4, "\xcf\x89\xcd\x82"}},
+    {0x01FF7, {6, "\xcf\x89\xcd\x82\xce\xb9"}},
+    {0x01FF8, {3, "\xe1\xbd\xb8"}},
+    {0x01FF9, {3, "\xe1\xbd\xb9"}},
+    {0x01FFA, {3, "\xe1\xbd\xbc"}},
+    {0x01FFB, {3, "\xe1\xbd\xbd"}},
+    {0x01FFC, {4, "\xcf\x89\xce\xb9"}},
+    {0x02126, {2, "\xcf\x89"}},
+    {0x0212A, {1, "\x6b"}},
+    {0x0212B, {2, "\xc3\xa5"}},
+    {0x02132, {3, "\xe2\x85\x8e"}},
+    {0x02160, {3, "\xe2\x85\xb0"}},
+    {0x02161, {3, "\xe2\x85\xb1"}},
+    {0x02162, {3, "\xe2\x85\xb2"}},
+    {0x02163, {3, "\xe2\x85\xb3"}},
+    {0x02164, {3, "\xe2\x85\xb4"}},
+    {0x02165, {3, "\xe2\x85\xb5"}},
+    {0x02166, {3, "\xe2\x85\xb6"}},
+    {0x02167, {3, "\xe2\x85\xb7"}},
+    {0x02168, {3, "\xe2\x85\xb8"}},
+    {0x02169, {3, "\xe2\x85\xb9"}},
+    {0x0216A, {3, "\xe2\x85\xba"}},
+    {0x0216B, {3, "\xe2\x85\xbb"}},
+    {0x0216C, {3, "\xe2\x85\xbc"}},
+    {0x0216D, {3, "\xe2\x85\xbd"}},
+    {0x0216E, {3, "\xe2\x85\xbe"}},
+    {0x0216F, {3, "\xe2\x85\xbf"}},
+    {0x02183, {3, "\xe2\x86\x84"}},
+    {0x024B6, {3, "\xe2\x93\x90"}},
+    {0x024B7, {3, "\xe2\x93\x91"}},
+    {0x024B8, {3, "\xe2\x93\x92"}},
+    {0x024B9, {3, "\xe2\x93\x93"}},
+    {0x024BA, {3, "\xe2\x93\x94"}},
+    {0x024BB, {3, "\xe2\x93\x95"}},
+    {0x024BC, {3, "\xe2\x93\x96"}},
+    {0x024BD, {3, "\xe2\x93\x97"}},
+    {0x024BE, {3, "\xe2\x93\x98"}},
+    {0x024BF, {3, "\xe2\x93\x99"}},
+    {0x024C0, {3, "\xe2\x93\x9a"}},
+    {0x024C1, {3, "\xe2\x93\x9b"}},
+    {0x024C2, {3, "\xe2\x93\x9c"}},
+    {0x024C3, {3, "\xe2\x93\x9d"}},
+    {0x024C4, {3, "\xe2\x93\x9e"}},
+    {0x024C5, {3, "\xe2\x93\x9f"}},
+    {0x024C6, {3, "\xe2\x93\xa0"}},
+    {0x024C7, {3, "\xe2\x93\xa1"}},
+    {0x024C8, {3, "\xe2\x93\xa2"}},
+    {0x024C9, {3, "\xe2\x93\xa3"}},
+    {0x024CA, {3, "\xe2\x93\xa4"}},
+    {0x024CB, {3, "\xe2\x93\xa5"}},
+    {0x024CC, {3, "\xe2\x93\xa6"}},
+    {0x024CD, {3, "\xe2\x93\xa7"}},
+    {0x024CE, {3, "\xe2\x93\xa8"}},
+    {0x024CF, {3, "\xe2\x93\xa9"}},
+    {0x02C00, {3, "\xe2\xb0\xb0"}},
+    {0x02C01, {3, "\xe2\xb0\xb1"}},
+    {0x02C02, {3, "\xe2\xb0\xb2"}},
+    {0x02C03, {3, "\xe2\xb0\xb3"}},
+    {0x02C04, {3, "\xe2\xb0\xb4"}},
+    {0x02C05, {3, "\xe2\xb0\xb5"}},
+    {0x02C06, {3, "\xe2\xb0\xb6"}},
+    {0x02C07, {3, "\xe2\xb0\xb7"}},
+    {0x02C08, {3, "\xe2\xb0\xb8"}},
+    {0x02C09, {3, "\xe2\xb0\xb9"}},
+    {0x02C0A, {3, "\xe2\xb0\xba"}},
+    {0x02C0B, {3, "\xe2\xb0\xbb"}},
+    {0x02C0C, {3, "\xe2\xb0\xbc"}},
+    {0x02C0D, {3, "\xe2\xb0\xbd"}},
+    {0x02C0E, {3, "\xe2\xb0\xbe"}},
+    {0x02C0F, {3, "\xe2\xb0\xbf"}},
+    {0x02C10, {3, "\xe2\xb1\x80"}},
+    {0x02C11, {3, "\xe2\xb1\x81"}},
+    {0x02C12, {3, "\xe2\xb1\x82"}},
+    {0x02C13, {3, "\xe2\xb1\x83"}},
+    {0x02C14, {3, "\xe2\xb1\x84"}},
+    {0x02C15, {3, "\xe2\xb1\x85"}},
+    {0x02C16, {3, "\xe2\xb1\x86"}},
+    {0x02C17, {3, "\xe2\xb1\x87"}},
+    {0x02C18, {3, "\xe2\xb1\x88"}},
+    {0x02C19, {3, "\xe2\xb1\x89"}},
+    {0x02C1A, {3, "\xe2\xb1\x8a"}},
+    {0x02C1B, {3, "\xe2\xb1\x8b"}},
+    {0x02C1C, {3, "\xe2\xb1\x8c"}},
+    {0x02C1D, {3, "\xe2\xb1\x8d"}},
+    {0x02C1E, {3, "\xe2\xb1\x8e"}},
+    {0x02C1F, {3, "\xe2\xb1\x8f"}},
+    {0x02C20, {3, "\xe2\xb1\x90"}},
+    {0x02C21, {3, "\xe2\xb1\x91"}},
+    {0x02C22, {3, "\xe2\xb1\x92"}},
+    {0x02C23, {3, "\xe2\xb1\x93"}},
+    {0x02C24, {3, "\xe2\xb1\x94"}},
+    {0x02C25, {3, "\xe2\xb1\x95"}},
+    {0x02C26, {3, "\xe2\xb1\x96"}},
+    {0x02C27, {3, "\xe2\xb1\x97"}},
+    {0x02C28, {3, "\xe2\xb1\x98"}},
+    {0x02C29, {3, "\xe2\xb1\x99"}},
+    {0x02C2A, {3, "\xe2\xb1\x9a"}},
+    {0x02C2B, {3, "\xe2\xb1\x9b"}},
+    {0x02C2C, {3, "\xe2\xb1\x9c"}},
+    {0x02C2D, {3, "\xe2\xb1\x9d"}},
+    {0x02C2E, {3, "\xe2\xb1\x9e"}},
+    {0x02C2F, {3, "\xe2\xb1\x9f"}},
+    {0x02C60, {3, "\xe2\xb1\xa1"}},
+    {0x02C62, {2, "\xc9\xab"}},
+    {0x02C63, {3, "\xe1\xb5\xbd"}},
+    {0x02C64, {2, "\xc9\xbd"}},
+    {0x02C67, {3, "\xe2\xb1\xa8"}},
+    {0x02C69, {3, "\xe2\xb1\xaa"}},
+    {0x02C6B, {3, "\xe2\xb1\xac"}},
+    {0x02C6D, {2, "\xc9\x91"}},
+    {0x02C6E, {2, "\xc9\xb1"}},
+    {0x02C6F, {2, "\xc9\x90"}},
+    {0x02C70, {2, "\xc9\x92"}},
+    {0x02C72, {3, "\xe2\xb1\xb3"}},
+    {0x02C75, {3, "\xe2\xb1\xb6"}},
+    {0x02C7E, {2, "\xc8\xbf"}},
+    {0x02C7F, {2, "\xc9\x80"}},
+    {0x02C80, {3, "\xe2\xb2\x81"}},
+    {0x02C82, {3, "\xe2\xb2\x83"}},
+    {0x02C84, {3, "\xe2\xb2\x85"}},
+    {0x02C86, {3, "\xe2\xb2\x87"}},
+    {0x02C88, {3, "\xe2\xb2\x89"}},
+    {0x02C8A, {3, "\xe2\xb2\x8b"}},
+    {0x02C8C, {3, "\xe2\xb2\x8d"}},
+    {0x02C8E, {3, "\xe2\xb2\x8f"}},
+    {0x02C90, {3, "\xe2\xb2\x91"}},
+    {0x02C92, {3, "\xe2\xb2\x93"}},
+    {0x02C94, {3, "\xe2\xb2\x95"}},
+    {0x02C96, {3, "\xe2\xb2\x97"}},
+    {0x02C98, {3, "\xe2\xb2\x99"}},
+    {0x02C9A, {3, "\xe2\xb2\x9b"}},
+    {0x02C9C, {3, "\xe2\xb2\x9d"}},
+    {0x02C9E, {3, "\xe2\xb2\x9f"}},
+    {0x02CA0, {3, "\xe2\xb2\xa1"}},
+    {0x02CA2, {3, "\xe2\xb2\xa3"}},
+    {0x02CA4, {3, "\xe2\xb2\xa5"}},
+    {0x02CA6, {3, "\xe2\xb2\xa7"}},
+    {0x02CA8, {3, "\xe2\xb2\xa9"}},
+    {0x02CAA, {3, "\xe2\xb2\xab"}},
+    {0x02CAC, {3, "\xe2\xb2\xad"}},
+    {0x02CAE, {3, "\xe2\xb2\xaf"}},
+    {0x02CB0, {3, "\xe2\xb2\xb1"}},
+    {0x02CB2, {3, "\xe2\xb2\xb3"}},
+    {0x02CB4, {3, "\xe2\xb2\xb5"}},
+    {0x02CB6, {3, "\xe2\xb2\xb7"}},
+    {0x02CB8, {3, "\xe2\xb2\xb9"}},
+    {0x02CBA, {3, "\xe2\xb2\xbb"}},
+    {0x02CBC, {3, "\xe2\xb2\xbd"}},
+    {0x02CBE, {3, "\xe2\xb2\xbf"}},
+    {0x02CC0, {3, "\xe2\xb3\x81"}},
+    {0x02CC2, {3, "\xe2\xb3\x83"}},
+    {0x02CC4, {3, "\xe2\xb3\x85"}},
+    {0x02CC6, {3, "\xe2\xb3\x87"}},
+    {0x02CC8, {3, "\xe2\xb3\x89"}},
+    {0x02CCA, {3, "\xe2\xb3\x8b"}},
+    {0x02CCC, {3, "\xe2\xb3\x8d"}},
+    {0x02CCE, {3, "\xe2\xb3\x8f"}},
+    {0x02CD0, {3, "\xe2\xb3\x91"}},
+    {0x02CD2, {3, "\xe2\xb3\x93"}},
+    {0x02CD4, {3, "\xe2\xb3\x95"}},
+    {0x02CD6, {3, "\xe2\xb3\x97"}},
+    {0x02CD8, {3, "\xe2\xb3\x99"}},
+    {0x02CDA, {3, "\xe2\xb3\x9b"}},
+    {0x02CDC, {3, "\xe2\xb3\x9d"}},
+    {0x02CDE, {3, "\xe2\xb3\x9f"}},
+    {0x02CE0, {3, "\xe2\xb3\xa1"}},
+    {0x02CE2, {3, "\xe2\xb3\xa3"}},
+    {0x02CEB, {3, "\xe2\xb3\xac"}},
+    {0x02CED, {3, "\xe2\xb3\xae"}},
+    {0x02CF2, {3, "\xe2\xb3\xb3"}},
+    {0x0A640, {3, "\xea\x99\x81"}},
+    {0x0A642, {3, "\xea\x99\x83"}},
+    {0x0A644, {3, "\xea\x99\x85"}},
+    {0x0A646, {3, "\xea\x99\x87"}},
+    {0x0A648, {3, "\xea\x99\x89"}},
+    {0x0A64A, {3, "\xea\x99\x8b"}},
+    {0x0A64C, {3, "\xea\x99\x8d"}},
+    {0x0A64E, {3, "\xea\x99\x8f"}},
+    {0x0A650, {3, "\xea\x99\x91"}},
+    {0x0A652, {3, "\xea\x99\x93"}},
+    {0x0A654, {3, "\xea\x99\x95"}},
+    {0x0A656, {3, "\xea\x99\x97"}},
+    {0x0A658, {3, "\xea\x99\x99"}},
+    {0x0A65A, {3, "\xea\x99\x9b"}},
+    {0x0A65C, {3, "\xea\x99\x9d"}},
+    {0x0A65E, {3, "\xea\x99\x9f"}},
+    {0x0A660, {3, "\xea\x99\xa1"}},
+    {0x0A662, {3, "\xea\x99\xa3"}},
+    {0x0A664, {3, "\xea\x99\xa5"}},
+    {0x0A666, {3, "\xea\x99\xa7"}},
+    {0x0A668, {3, "\xea\x99\xa9"}},
+    {0x0A66A, {3, "\xea\x99\xab"}},
+    {0x0A66C, {3, "\xea\x99\xad"}},
+    {0x0A680, {3, "\xea\x9a\x81"}},
+    {0x0A682, {3, "\xea\x9a\x83"}},
+    {0x0A684, {3, "\xea\x9a\x85"}},
+    {0x0A686, {3, "\xea\x9a\x87"}},
+    {0x0A688, {3, "\xea\x9a\x89"}},
+    {0x0A68A, {3, "\xea\x9a\x8b"}},
+    {0x0A68C, {3, "\xea\x9a\x8d"}},
+    {0x0A68E, {3, "\xea\x9a\x8f"}},
+    {0x0A690, {3, "\xea\x9a\x91"}},
+    {0x0A692, {3, "\xea\x9a\x93"}},
+    {0x0A694, {3, "\xea\x9a\x95"}},
+    {0x0A696, {3, "\xea\x9a\x97"}},
+    {0x0A698, {3, "\xea\x9a\x99"}},
+    {0x0A69A, {3, "\xea\x9a\x9b"}},
+    {0x0A722, {3, "\xea\x9c\xa3"}},
+    {0x0A724, {3, "\xea\x9c\xa5"}},
+    {0x0A726, {3, "\xea\x9c\xa7"}},
+    {0x0A728, {3, "\xea\x9c\xa9"}},
+    {0x0A72A, {3, "\xea\x9c\xab"}},
+    {0x0A72C, {3, "\xea\x9c\xad"}},
+    {0x0A72E, {3, "\xea\x9c\xaf"}},
+    {0x0A732, {3, "\xea\x9c\xb3"}},
+    {0x0A734, {3, "\xea\x9c\xb5"}},
+    {0x0A736, {3, "\xea\x9c\xb7"}},
+    {0x0A738, {3, "\xea\x9c\xb9"}},
+    {0x0A73A, {3, "\xea\x9c\xbb"}},
+    {0x0A73C, {3, "\xea\x9c\xbd"}},
+    {0x0A73E, {3, "\xea\x9c\xbf"}},
+    {0x0A740, {3, "\xea\x9d\x81"}},
+    {0x0A742, {3, "\xea\x9d\x83"}},
+    {0x0A744, {3, "\xea\x9d\x85"}},
+    {0x0A746, {3, "\xea\x9d\x87"}},
+    {0x0A748, {3, "\xea\x9d\x89"}},
+    {0x0A74A, {3, "\xea\x9d\x8b"}},
+    {0x0A74C, {3, "\xea\x9d\x8d"}},
+    {0x0A74E, {3, "\xea\x9d\x8f"}},
+    {0x0A750, {3, "\xea\x9d\x91"}},
+    {0x0A752, {3, "\xea\x9d\x93"}},
+    {0x0A754, {3, "\xea\x9d\x95"}},
+    {0x0A756, {3, "\xea\x9d\x97"}},
+    {0x0A758, {3, "\xea\x9d\x99"}},
+    {0x0A75A, {3, "\xea\x9d\x9b"}},
+    {0x0A75C, {3, "\xea\x9d\x9d"}},
+    {0x0A75E, {3, "\xea\x9d\x9f"}},
+    {0x0A760, {3, "\xea\x9d\xa1"}},
+    {0x0A762, {3, "\xea\x9d\xa3"}},
+    {0x0A764, {3, "\xea\x9d\xa5"}},
+    {0x0A766, {3, "\xea\x9d\xa7"}},
+    {0x0A768, {3, "\xea\x9d\xa9"}},
+    {0x0A76A, {3, "\xea\x9d\xab"}},
+    {0x0A76C, {3, "\xea\x9d\xad"}},
+    {0x0A76E, {3, "\xea\x9d\xaf"}},
+    {0x0A779, {3, "\xea\x9d\xba"}},
+    {0x0A77B, {3, "\xea\x9d\xbc"}},
+    {0x0A77D, {3, "\xe1\xb5\xb9"}},
+    {0x0A77E, {3, "\xea\x9d\xbf"}},
+    {0x0A780, {3, "\xea\x9e\x81"}},
+    {0x0A782, {3, "\xea\x9e\x83"}},
+    {0x0A784, {3, "\xea\x9e\x85"}},
+    {0x0A786, {3, "\xea\x9e\x87"}},
+    {0x0A78B, {3, "\xea\x9e\x8c"}},
+    {0x0A78D, {2, "\xc9\xa5"}},
+    {0x0A790, {3, "\xea\x9e\x91"}},
+    {0x0A792, {3, "\xea\x9e\x93"}},
+    {0x0A796, {3, "\xea\x9e\x97"}},
+    {0x0A798, {3, "\xea\x9e\x99"}},
+    {0x0A79A, {3, "\xea\x9e\x9b"}},
+    {0x0A79C, {3, "\xea\x9e\x9d"}},
+    {0x0A79E, {3, "\xea\x9e\x9f"}},
+    {0x0A7A0, {3, "\xea\x9e\xa1"}},
+    {0x0A7A2, {3, "\xea\x9e\xa3"}},
+    {0x0A7A4, {3, "\xea\x9e\xa5"}},
+    {0x0A7A6, {3, "\xea\x9e\xa7"}},
+    {0x0A7A8, {3, "\xea\x9e\xa9"}},
+    {0x0A7AA, {2, "\xc9\xa6"}},
+    {0x0A7AB, {2, "\xc9\x9c"}},
+    {0x0A7AC, {2, "\xc9\xa1"}},
+    {0x0A7AD, {2, "\xc9\xac"}},
+    {0x0A7AE, {2, "\xc9\xaa"}},
+    {0x0A7B0, {2, "\xca\x9e"}},
+    {0x0A7B1, {2, "\xca\x87"}},
+    {0x0A7B2, {2, "\xca\x9d"}},
+    {0x0A7B3, {3, "\xea\xad\x93"}},
+    {0x0A7B4, {3, "\xea\x9e\xb5"}},
+    {0x0A7B6, {3, "\xea\x9e\xb7"}},
+    {0x0A7B8, {3, "\xea\x9e\xb9"}},
+    {0x0A7BA, {3, "\xea\x9e\xbb"}},
+    {0x0A7BC, {3, "\xea\x9e\xbd"}},
+    {0x0A7BE, {3, "\xea\x9e\xbf"}},
+    {0x0A7C0, {3, "\xea\x9f\x81"}},
+    {0x0A7C2, {3, "\xea\x9f\x83"}},
+    {0x0A7C4, {3, "\xea\x9e\x94"}},
+    {0x0A7C5, {2, "\xca\x82"}},
+    {0x0A7C6, {3, "\xe1\xb6\x8e"}},
+    {0x0A7C7, {3, "\xea\x9f\x88"}},
+    {0x0A7C9, {3, "\xea\x9f\x8a"}},
+    {0x0A7D0, {3, "\xea\x9f\x91"}},
+    {0x0A7D6, {3, "\xea\x9f\x97"}},
+    {0x0A7D8, {3, "\xea\x9f\x99"}},
+    {0x0A7F5, {3, "\xea\x9f\xb6"}},
+    {0x0AB70, {3, "\xe1\x8e\xa0"}},
+    {0x0AB71, {3, "\xe1\x8e\xa1"}},
+    {0x0AB72, {3, "\xe1\x8e\xa2"}},
+    {0x0AB73, {3, "\xe1\x8e\xa3"}},
+    {0x0AB74, {3, "\xe1\x8e\xa4"}},
+    {0x0AB75, {3, "\xe1\x8e\xa5"}},
+    {0x0AB76, {3, "\xe1\x8e\xa6"}},
+    {0x0AB77, {3, "\xe1\x8e\xa7"}},
+    {0x0AB78, {3, "\xe1\x8e\xa8"}},
+    {0x0AB79, {3, "\xe1\x8e\xa9"}},
+    {0x0AB7A, {3, "\xe1\x8e\xaa"}},
+    {0x0AB7B, {3, "\xe1\x8e\xab"}},
+    {0x0AB7C, {3, "\xe1\x8e\xac"}},
+    {0x0AB7D, {3, "\xe1\x8e\xad"}},
+    {0x0AB7E, {3, "\xe1\x8e\xae"}},
+    {0x0AB7F, {3, "\xe1\x8e\xaf"}},
+    {0x0AB80, {3, "\xe1\x8e\xb0"}},
+    {0x0AB81, {3, "\xe1\x8e\xb1"}},
+    {0x0AB82, {3, "\xe1\x8e\xb2"}},
+    {0x0AB83, {3, "\xe1\x8e\xb3"}},
+    {0x0AB84, {3, "\xe1\x8e\xb4"}},
+    {0x0AB85, {3, "\xe1\x8e\xb5"}},
+    {0x0AB86, {3, "\xe1\x8e\xb6"}},
+    {0x0AB87, {3, "\xe1\x8e\xb7"}},
+    {0x0AB88, {3, "\xe1\x8e\xb8"}},
+    {0x0AB89, {3, "\xe1\x8e\xb9"}},
+    {0x0AB8A, {3, "\xe1\x8e\xba"}},
+    {0x0AB8B, {3, "\xe1\x8e\xbb"}},
+    {0x0AB8C, {3, "\xe1\x8e\xbc"}},
+    {0x0AB8D, {3, "\xe1\x8e\xbd"}},
+    {0x0AB8E, {3, "\xe1\x8e\xbe"}},
+    {0x0AB8F, {3, "\xe1\x8e\xbf"}},
+    {0x0AB90, {3, "\xe1\x8f\x80"}},
+    {0x0AB91, {3, "\xe1\x8f\x81"}},
+    {0x0AB92, {3, "\xe1\x8f\x82"}},
+    {0x0AB93, {3, "\xe1\x8f\x83"}},
+    {0x0AB94, {3, "\xe1\x8f\x84"}},
+    {0x0AB95, {3, "\xe1\x8f\x85"}},
+    {0x0AB96, {3, "\xe1\x8f\x86"}},
+    {0x0AB97, {3, "\xe1\x8f\x87"}},
+    {0x0AB98, {3, "\xe1\x8f\x88"}},
+    {0x0AB99, {3, "\xe1\x8f\x89"}},
+    {0x0AB9A, {3, "\xe1\x8f\x8a"}},
+    {0x0AB9B, {3, "\xe1\x8f\x8b"}},
+    {0x0AB9C, {3, "\xe1\x8f\x8c"}},
+    {0x0AB9D, {3, "\xe1\x8f\x8d"}},
+    {0x0AB9E, {3, "\xe1\x8f\x8e"}},
+    {0x0AB9F, {3, "\xe1\x8f\x8f"}},
+    {0x0ABA0, {3, "\xe1\x8f\x90"}},
+    {0x0ABA1, {3, "\xe1\x8f\x91"}},
+    {0x0ABA2, {3, "\xe1\x8f\x92"}},
+    {0x0ABA3, {3, "\xe1\x8f\x93"}},
+    {0x0ABA4, {3, "\xe1\x8f\x94"}},
+    {0x0ABA5, {3, "\xe1\x8f\x95"}},
+    {0x0ABA6, {3, "\xe1\x8f\x96"}},
+    {0x0ABA7, {3, "\xe1\x8f\x97"}},
+    {0x0ABA8, {3, "\xe1\x8f\x98"}},
+    {0x0ABA9, {3, "\xe1\x8f\x99"}},
+    {0x0ABAA, {3, "\xe1\x8f\x9a"}},
+    {0x0ABAB, {3, "\xe1\x8f\x9b"}},
+    {0x0ABAC, {3, "\xe1\x8f\x9c"}},
+    {0x0ABAD, {3, "\xe1\x8f\x9d"}},
+    {0x0ABAE, {3, "\xe1\x8f\x9e"}},
+    {0x0ABAF, {3, "\xe1\x8f\x9f"}},
+    {0x0ABB0, {3, "\xe1\x8f\xa0"}},
+    {0x0ABB1, {3, "\xe1\x8f\xa1"}},
+    {0x0ABB2, {3, "\xe1\x8f\xa2"}},
+    {0x0ABB3, {3, "\xe1\x8f\xa3"}},
+    {0x0ABB4, {3, "\xe1\x8f\xa4"}},
+    {0x0ABB5, {3, "\xe1\x8f\xa5"}},
+    {0x0ABB6, {3, "\xe1\x8f\xa6"}},
+    {0x0ABB7, {3, "\xe1\x8f\xa7"}},
+    {0x0ABB8, {3, "\xe1\x8f\xa8"}},
+    {0x0ABB9, {3, "\xe1\x8f\xa9"}},
+    {0x0ABBA, {3, "\xe1\x8f\xaa"}},
+    {0x0ABBB, {3, "\xe1\x8f\xab"}},
+    {0x0ABBC, {3, "\xe1\x8f\xac"}},
+    {0x0ABBD, {3, "\xe1\x8f\xad"}},
+    {0x0ABBE, {3, "\xe1\x8f\xae"}},
+    {0x0ABBF, {3, "\xe1\x8f\xaf"}},
+    {0x0FB00, {2, "\x66\x66"}},
+    {0x0FB01, {2, "\x66\x69"}},
+    {0x0FB02, {2, "\x66\x6c"}},
+    {0x0FB03, {3, "\x66\x66\x69"}},
+    {0x0FB04, {3, "\x66\x66\x6c"}},
+    {0x0FB05, {2, "\x73\x74"}},
+    {0x0FB06, {2, "\x73\x74"}},
+    {0x0FB13, {4, "\xd5\xb4\xd5\xb6"}},
+    {0x0FB14, {4, "\xd5\xb4\xd5\xa5"}},
+    {0x0FB15, {4, "\xd5\xb4\xd5\xab"}},
+    {0x0FB16, {4, "\xd5\xbe\xd5\xb6"}},
+    {0x0FB17, {4, "\xd5\xb4\xd5\xad"}},
+    {0x0FF21, {3, "\xef\xbd\x81"}},
+    {0x0FF22, {3, "\xef\xbd\x82"}},
+    {0x0FF23, {3, "\xef\xbd\x83"}},
+    {0x0FF24, {3, "\xef\xbd\x84"}},
+    {0x0FF25, {3, "\xef\xbd\x85"}},
+    {0x0FF26, {3, "\xef\xbd\x86"}},
+    {0x0FF27, {3, "\xef\xbd\x87"}},
+    {0x0FF28, {3, "\xef\xbd\x88"}},
+    {0x0FF29, {3, "\xef\xbd\x89"}},
+    {0x0FF2A, {3, "\xef\xbd\x8a"}},
+    {0x0FF2B, {3, "\xef\xbd\x8b"}},
+    {0x0FF2C, {3, "\xef\xbd\x8c"}},
+    {0x0FF2D, {3, "\xef\xbd\x8d"}},
+    {0x0FF2E, {3, "\xef\xbd\x8e"}},
+    {0x0FF2F, {3, "\xef\xbd\x8f"}},
+    {0x0FF30, {3, "\xef\xbd\x90"}},
+    {0x0FF31, {3, "\xef\xbd\x91"}},
+    {0x0FF32, {3, "\xef\xbd\x92"}},
+    {0x0FF33, {3, "\xef\xbd\x93"}},
+    {0x0FF34, {3, "\xef\xbd\x94"}},
+    {0x0FF35, {3, "\xef\xbd\x95"}},
+    {0x0FF36, {3, "\xef\xbd\x96"}},
+    {0x0FF37, {3, "\xef\xbd\x97"}},
+    {0x0FF38, {3, "\xef\xbd\x98"}},
+    {0x0FF39, {3, "\xef\xbd\x99"}},
+    {0x0FF3A, {3, "\xef\xbd\x9a"}},
+    {0x10400, {4, "\xf0\x90\x90\xa8"}},
+    {0x10401, {4, "\xf0\x90\x90\xa9"}},
+    {0x10402, {4, "\xf0\x90\x90\xaa"}},
+    {0x10403, {4, "\xf0\x90\x90\xab"}},
+    {0x10404, {4, "\xf0\x90\x90\xac"}},
+    {0x10405, {4, "\xf0\x90\x90\xad"}},
+    {0x10406, {4, "\xf0\x90\x90\xae"}},
+    {0x10407, {4, "\xf0\x90\x90\xaf"}},
+    {0x10408, {4, "\xf0\x90\x90\xb0"}},
+    {0x10409, {4, "\xf0\x90\x90\xb1"}},
+    {0x1040A, {4, "\xf0\x90\x90\xb2"}},
+    {0x1040B, {4, "\xf0\x90\x90\xb3"}},
+    {0x1040C, {4, "\xf0\x90\x90\xb4"}},
+    {0x1040D, {4, "\xf0\x90\x90\xb5"}},
+    {0x1040E, {4, "\xf0\x90\x90\xb6"}},
+    {0x1040F, {4, "\xf0\x90\x90\xb7"}},
+    {0x10410, {4, "\xf0\x90\x90\xb8"}},
+    {0x10411, {4, "\xf0\x90\x90\xb9"}},
+    {0x10412, {4, "\xf0\x90\x90\xba"}},
+    {0x10413, {4, "\xf0\x90\x90\xbb"}},
+    {0x10414, {4, "\xf0\x90\x90\xbc"}},
+    {0x10415, {4, "\xf0\x90\x90\xbd"}},
+    {0x10416, {4, "\xf0\x90\x90\xbe"}},
+    {0x10417, {4, "\xf0\x90\x90\xbf"}},
+    {0x10418, {4, "\xf0\x90\x91\x80"}},
+    {0x10419, {4, "\xf0\x90\x91\x81"}},
+    {0x1041A, {4, "\xf0\x90\x91\x82"}},
+    {0x1041B, {4, "\xf0\x90\x91\x83"}},
+    {0x1041C, {4, "\xf0\x90\x91\x84"}},
+    {0x1041D, {4, "\xf0\x90\x91\x85"}},
+    {0x1041E, {4, "\xf0\x90\x91\x86"}},
+    {0x1041F, {4, "\xf0\x90\x91\x87"}},
+    {0x10420, {4, "\xf0\x90\x91\x88"}},
+    {0x10421, {4, "\xf0\x90\x91\x89"}},
+    {0x10422, {4, "\xf0\x90\x91\x8a"}},
+    {0x10423, {4, "\xf0\x90\x91\x8b"}},
+    {0x10424, {4, "\xf0\x90\x91\x8c"}},
+    {0x10425, {4, "\xf0\x90\x91\x8d"}},
+    {0x10426, {4, "\xf0\x90\x91\x8e"}},
+    {0x10427, {4, "\xf0\x90\x91\x8f"}},
+    {0x104B0, {4, "\xf0\x90\x93\x98"}},
+    {0x104B1, {4, "\xf0\x90\x93\x99"}},
+    {0x104B2, {4, "\xf0\x90\x93\x9a"}},
+    {0x104B3, {4, "\xf0\x90\x93\x9b"}},
+    {0x104B4, {4, "\xf0\x90\x93\x9c"}},
+    {0x104B5, {4, "\xf0\x90\x93\x9d"}},
+    {0x104B6, {4, "\xf0\x90\x93\x9e"}},
+    {0x104B7, {4, "\xf0\x90\x93\x9f"}},
+    {0x104B8, {4, "\xf0\x90\x93\xa0"}},
+    {0x104B9, {4, "\xf0\x90\x93\xa1"}},
+    {0x104BA, {4, "\xf0\x90\x93\xa2"}},
+    {0x104BB, {4, "\xf0\x90\x93\xa3"}},
+    {0x104BC, {4, "\xf0\x90\x93\xa4"}},
+    {0x104BD, {4, "\xf0\x90\x93\xa5"}},
+    {0x104BE, {4, "\xf0\x90\x93\xa6"}},
+    {0x104BF, {4, "\xf0\x90\x93\xa7"}},
+    {0x104C0, {4, "\xf0\x90\x93\xa8"}},
+    {0x104C1, {4, "\xf0\x90\x93\xa9"}},
+    {0x104C2, {4, "\xf0\x90\x93\xaa"}},
+    {0x104C3, {4, "\xf0\x90\x93\xab"}},
+    {0x104C4, {4, "\xf0\x90\x93\xac"}},
+    {0x104C5, {4, "\xf0\x90\x93\xad"}},
+    {0x104C6, {4, "\xf0\x90\x93\xae"}},
+    {0x104C7, {4, "\xf0\x90\x93\xaf"}},
+    {0x104C8, {4, "\xf0\x90\x93\xb0"}},
+    {0x104C9, {4, "\xf0\x90\x93\xb1"}},
+    {0x104CA, {4, "\xf0\x90\x93\xb2"}},
+    {0x104CB, {4, "\xf0\x90\x93\xb3"}},
+    {0x104CC, {4, "\xf0\x90\x93\xb4"}},
+    {0x104CD, {4, "\xf0\x90\x93\xb5"}},
+    {0x104CE, {4, "\xf0\x90\x93\xb6"}},
+    {0x104CF, {4, "\xf0\x90\x93\xb7"}},
+    {0x104D0, {4, "\xf0\x90\x93\xb8"}},
+    {0x104D1, {4, "\xf0\x90\x93\xb9"}},
+    {0x104D2, {4, "\xf0\x90\x93\xba"}},
+    {0x104D3, {4, "\xf0\x90\x93\xbb"}},
+    {0x10570, {4, "\xf0\x90\x96\x97"}},
+    {0x10571, {4, "\xf0\x90\x96\x98"}},
+    {0x10572, {4, "\xf0\x90\x96\x99"}},
+    {0x10573, {4, "\xf0\x90\x96\x9a"}},
+    {0x10574, {4, "\xf0\x90\x96\x9b"}},
+    {0x10575, {4, "\xf0\x90\x96\x9c"}},
+    {0x10576, {4, "\xf0\x90\x96\x9d"}},
+    {0x10577, {4, "\xf0\x90\x96\x9e"}},
+    {0x10578, {4, "\xf0\x90\x96\x9f"}},
+    {0x10579, {4, "\xf0\x90\x96\xa0"}},
+    {0x1057A, {4, "\xf0\x90\x96\xa1"}},
+    {0x1057C, {4, "\xf0\x90\x96\xa3"}},
+    {0x1057D, {4, "\xf0\x90\x96\xa4"}},
+    {0x1057E, {4, "\xf0\x90\x96\xa5"}},
+    {0x1057F, {4, "\xf0\x90\x96\xa6"}},
+    {0x10580, {4, "\xf0\x90\x96\xa7"}},
+    {0x10581, {4, "\xf0\x90\x96\xa8"}},
+    {0x10582, {4, "\xf0\x90\x96\xa9"}},
+    {0x10583, {4, "\xf0\x90\x96\xaa"}},
+    {0x10584, {4, "\xf0\x90\x96\xab"}},
+    {0x10585, {4, "\xf0\x90\x96\xac"}},
+    {0x10586, {4, "\xf0\x90\x96\xad"}},
+    {0x10587, {4, "\xf0\x90\x96\xae"}},
+    {0x10588, {4, "\xf0\x90\x96\xaf"}},
+    {0x10589, {4, "\xf0\x90\x96\xb0"}},
+    {0x1058A, {4, "\xf0\x90\x96\xb1"}},
+    {0x1058C, {4, "\xf0\x90\x96\xb3"}},
+    {0x1058D, {4, "\xf0\x90\x96\xb4"}},
+    {0x1058E, {4, "\xf0\x90\x96\xb5"}},
+    {0x1058F, {4, "\xf0\x90\x96\xb6"}},
+    {0x10590, {4, "\xf0\x90\x96\xb7"}},
+    {0x10591, {4, "\xf0\x90\x96\xb8"}},
+    {0x10592, {4, "\xf0\x90\x96\xb9"}},
+    {0x10594, {4, "\xf0\x90\x96\xbb"}},
+    {0x10595, {4, "\xf0\x90\x96\xbc"}},
+    {0x10C80, {4, "\xf0\x90\xb3\x80"}},
+    {0x10C81, {4, "\xf0\x90\xb3\x81"}},
+    {0x10C82, {4, "\xf0\x90\xb3\x82"}},
+    {0x10C83, {4, "\xf0\x90\xb3\x83"}},
+    {0x10C84, {4, "\xf0\x90\xb3\x84"}},
+    {0x10C85, {4, "\xf0\x90\xb3\x85"}},
+    {0x10C86, {4, "\xf0\x90\xb3\x86"}},
+    {0x10C87, {4, "\xf0\x90\xb3\x87"}},
+    {0x10C88, {4, "\xf0\x90\xb3\x88"}},
+    {0x10C89, {4, "\xf0\x90\xb3\x89"}},
+    {0x10C8A, {4, "\xf0\x90\xb3\x8a"}},
+    {0x10C8B, {4, "\xf0\x90\xb3\x8b"}},
+    {0x10C8C, {4, "\xf0\x90\xb3\x8c"}},
+    {0x10C8D, {4, "\xf0\x90\xb3\x8d"}},
+    {0x10C8E, {4, "\xf0\x90\xb3\x8e"}},
+    {0x10C8F, {4, "\xf0\x90\xb3\x8f"}},
+    {0x10C90, {4, "\xf0\x90\xb3\x90"}},
+    {0x10C91, {4, "\xf0\x90\xb3\x91"}},
+    {0x10C92, {4, "\xf0\x90\xb3\x92"}},
+    {0x10C93, {4, "\xf0\x90\xb3\x93"}},
+    {0x10C94, {4, "\xf0\x90\xb3\x94"}},
+    {0x10C95, {4, "\xf0\x90\xb3\x95"}},
+    {0x10C96, {4, "\xf0\x90\xb3\x96"}},
+    {0x10C97, {4, "\xf0\x90\xb3\x97"}},
+    {0x10C98, {4, "\xf0\x90\xb3\x98"}},
+    {0x10C99, {4, "\xf0\x90\xb3\x99"}},
+    {0x10C9A, {4, "\xf0\x90\xb3\x9a"}},
+    {0x10C9B, {4, "\xf0\x90\xb3\x9b"}},
+    {0x10C9C, {4, "\xf0\x90\xb3\x9c"}},
+    {0x10C9D, {4, "\xf0\x90\xb3\x9d"}},
+    {0x10C9E, {4, "\xf0\x90\xb3\x9e"}},
+    {0x10C9F, {4, "\xf0\x90\xb3\x9f"}},
+    {0x10CA0, {4, "\xf0\x90\xb3\xa0"}},
+    {0x10CA1, {4, "\xf0\x90\xb3\xa1"}},
+    {0x10CA2, {4, "\xf0\x90\xb3\xa2"}},
+    {0x10CA3, {4, "\xf0\x90\xb3\xa3"}},
+    {0x10CA4, {4, "\xf0\x90\xb3\xa4"}},
+    {0x10CA5, {4, "\xf0\x90\xb3\xa5"}},
+    {0x10CA6, {4, "\xf0\x90\xb3\xa6"}},
+    {0x10CA7, {4, "\xf0\x90\xb3\xa7"}},
+    {0x10CA8, {4, "\xf0\x90\xb3\xa8"}},
+    {0x10CA9, {4, "\xf0\x90\xb3\xa9"}},
+    {0x10CAA, {4, "\xf0\x90\xb3\xaa"}},
+    {0x10CAB, {4, "\xf0\x90\xb3\xab"}},
+    {0x10CAC, {4, "\xf0\x90\xb3\xac"}},
+    {0x10CAD, {4, "\xf0\x90\xb3\xad"}},
+    {0x10CAE, {4, "\xf0\x90\xb3\xae"}},
+    {0x10CAF, {4, "\xf0\x90\xb3\xaf"}},
+    {0x10CB0, {4, "\xf0\x90\xb3\xb0"}},
+    {0x10CB1, {4, "\xf0\x90\xb3\xb1"}},
+    {0x10CB2, {4, "\xf0\x90\xb3\xb2"}},
+    {0x118A0, {4, "\xf0\x91\xa3\x80"}},
+    {0x118A1, {4, "\xf0\x91\xa3\x81"}},
+    {0x118A2, {4, "\xf0\x91\xa3\x82"}},
+    {0x118A3, {4, "\xf0\x91\xa3\x83"}},
+    {0x118A4, {4, "\xf0\x91\xa3\x84"}},
+    {0x118A5, {4, "\xf0\x91\xa3\x85"}},
+    {0x118A6, {4, "\xf0\x91\xa3\x86"}},
+    {0x118A7, {4, "\xf0\x91\xa3\x87"}},
+    {0x118A8, {4, "\xf0\x91\xa3\x88"}},
+    {0x118A9, {4, "\xf0\x91\xa3\x89"}},
+    {0x118AA, {4, "\xf0\x91\xa3\x8a"}},
+    {0x118AB, {4, "\xf0\x91\xa3\x8b"}},
+    {0x118AC, {4, "\xf0\x91\xa3\x8c"}},
+    {0x118AD, {4, "\xf0\x91\xa3\x8d"}},
+    {0x118AE, {4, "\xf0\x91\xa3\x8e"}},
+    {0x118AF, {4, "\xf0\x91\xa3\x8f"}},
+    {0x118B0, {4, "\xf0\x91\xa3\x90"}},
+    {0x118B1, {4, "\xf0\x91\xa3\x91"}},
+    {0x118B2, {4, "\xf0\x91\xa3\x92"}},
+    {0x118B3, {4, "\xf0\x91\xa3\x93"}},
+    {0x118B4, {4, "\xf0\x91\xa3\x94"}},
+    {0x118B5, {4, "\xf0\x91\xa3\x95"}},
+    {0x118B6, {4, "\xf0\x91\xa3\x96"}},
+    {0x118B7, {4, "\xf0\x91\xa3\x97"}},
+    {0x118B8, {4, "\xf0\x91\xa3\x98"}},
+    {0x118B9, {4, "\xf0\x91\xa3\x99"}},
+    {0x118BA, {4, "\xf0\x91\xa3\x9a"}},
+    {0x118BB, {4, "\xf0\x91\xa3\x9b"}},
+    {0x118BC, {4, "\xf0\x91\xa3\x9c"}},
+    {0x118BD, {4, "\xf0\x91\xa3\x9d"}},
+    {0x118BE, {4, "\xf0\x91\xa3\x9e"}},
+    {0x118BF, {4, "\xf0\x91\xa3\x9f"}},
+    {0x16E40, {4, "\xf0\x96\xb9\xa0"}},
+    {0x16E41, {4, "\xf0\x96\xb9\xa1"}},
+    {0x16E42, {4, "\xf0\x96\xb9\xa2"}},
+    {0x16E43, {4, "\xf0\x96\xb9\xa3"}},
+    {0x16E44, {4, "\xf0\x96\xb9\xa4"}},
+    {0x16E45, {4, "\xf0\x96\xb9\xa5"}},
+    {0x16E46, {4, "\xf0\x96\xb9\xa6"}},
+    {0x16E47, {4, "\xf0\x96\xb9\xa7"}},
+    {0x16E48, {4, "\xf0\x96\xb9\xa8"}},
+    {0x16E49, {4, "\xf0\x96\xb9\xa9"}},
+    {0x16E4A, {4, "\xf0\x96\xb9\xaa"}},
+    {0x16E4B, {4, "\xf0\x96\xb9\xab"}},
+    {0x16E4C, {4, "\xf0\x96\xb9\xac"}},
+    {0x16E4D, {4, "\xf0\x96\xb9\xad"}},
+    {0x16E4E, {4, "\xf0\x96\xb9\xae"}},
+    {0x16E4F, {4, "\xf0\x96\xb9\xaf"}},
+    {0x16E50, {4, "\xf0\x96\xb9\xb0"}},
+    {0x16E51, {4, "\xf0\x96\xb9\xb1"}},
+    {0x16E52, {4, "\xf0\x96\xb9\xb2"}},
+    {0x16E53, {4, "\xf0\x96\xb9\xb3"}},
+    {0x16E54, {4, "\xf0\x96\xb9\xb4"}},
+    {0x16E55, {4, "\xf0\x96\xb9\xb5"}},
+    {0x16E56, {4, "\xf0\x96\xb9\xb6"}},
+    {0x16E57, {4, "\xf0\x96\xb9\xb7"}},
+    {0x16E58, {4, "\xf0\x96\xb9\xb8"}},
+    {0x16E59, {4, "\xf0\x96\xb9\xb9"}},
+    {0x16E5A, {4, "\xf0\x96\xb9\xba"}},
+    {0x16E5B, {4, "\xf0\x96\xb9\xbb"}},
+    {0x16E5C, {4, "\xf0\x96\xb9\xbc"}},
+    {0x16E5D, {4, "\xf0\x96\xb9\xbd"}},
+    {0x16E5E, {4, "\xf0\x96\xb9\xbe"}},
+    {0x16E5F, {4, "\xf0\x96\xb9\xbf"}},
+    {0x1E900, {4, "\xf0\x9e\xa4\xa2"}},
+    {0x1E901, {4, "\xf0\x9e\xa4\xa3"}},
+    {0x1E902, {4, "\xf0\x9e\xa4\xa4"}},
+    {0x1E903, {4, "\xf0\x9e\xa4\xa5"}},
+    {0x1E904, {4, "\xf0\x9e\xa4\xa6"}},
+    {0x1E905, {4, "\xf0\x9e\xa4\xa7"}},
+    {0x1E906, {4, "\xf0\x9e\xa4\xa8"}},
+    {0x1E907, {4, "\xf0\x9e\xa4\xa9"}},
+    {0x1E908, {4, "\xf0\x9e\xa4\xaa"}},
+    {0x1E909, {4, "\xf0\x9e\xa4\xab"}},
+    {0x1E90A, {4, "\xf0\x9e\xa4\xac"}},
+    {0x1E90B, {4, "\xf0\x9e\xa4\xad"}},
+    {0x1E90C, {4, "\xf0\x9e\xa4\xae"}},
+    {0x1E90D, {4, "\xf0\x9e\xa4\xaf"}},
+    {0x1E90E, {4, "\xf0\x9e\xa4\xb0"}},
+    {0x1E90F, {4, "\xf0\x9e\xa4\xb1"}},
+    {0x1E910, {4, "\xf0\x9e\xa4\xb2"}},
+    {0x1E911, {4, "\xf0\x9e\xa4\xb3"}},
+    {0x1E912, {4, "\xf0\x9e\xa4\xb4"}},
+    {0x1E913, {4, "\xf0\x9e\xa4\xb5"}},
+    {0x1E914, {4, "\xf0\x9e\xa4\xb6"}},
+    {0x1E915, {4, "\xf0\x9e\xa4\xb7"}},
+    {0x1E916, {4, "\xf0\x9e\xa4\xb8"}},
+    {0x1E917, {4, "\xf0\x9e\xa4\xb9"}},
+    {0x1E918, {4, "\xf0\x9e\xa4\xba"}},
+    {0x1E919, {4, "\xf0\x9e\xa4\xbb"}},
+    {0x1E91A, {4, "\xf0\x9e\xa4\xbc"}},
+    {0x1E91B, {4, "\xf0\x9e\xa4\xbd"}},
+    {0x1E91C, {4, "\xf0\x9e\xa4\xbe"}},
+    {0x1E91D, {4, "\xf0\x9e\xa4\xbf"}},
+    {0x1E91E, {4, "\xf0\x9e\xa5\x80"}},
+    {0x1E91F, {4, "\xf0\x9e\xa5\x81"}},
+    {0x1E920, {4, "\xf0\x9e\xa5\x82"}},
+    {0x1E921, {4, "\xf0\x9e\xa5\x83"}},
+};
+
+// bit c >> 6 & 63 of fold_pages[c >> 12] is set when a code point of the 64
+// from c & ~63 is in fold_wide
+static const uint64_t fold_pages[0x110000 >> 12] = {
+    0x0000000000000000ull, 0xff0400000000800cull, 0x000f0000000c0070ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x00006000f6000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x1000100000000000ull,
+    0x00040000006d0000ull, 0x0000000400000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0200000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000001000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+    0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull, 0x0000000000000000ull,
+};
@@ -0,0 +1,246 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "isa.h"
+#include "simdstr.h"
+#include "tail.h"
+
+// Byte sets compiled to the nibble tables of the whitespace classifier of
+// examples/shuffle: a byte b is in the set when lo[b & 15] & hi[b >> 4] is
+// not zero. The high nibbles with the same row of low nibbles share a class,
+// each class is a bit of the tables. One pair of tables holds 8 classes, the
+// sets with more take a second pair, so every set of bytes is exact.
+void simdstr_charset_init(simdstr_charset_t *cs, const char *chars, size_t n) {
+    memset(cs, 0, sizeof(*cs));
+    uint16_t rows[16] = {0};
+    for (size_t i = 0; i < n; i++) {
+        uint8_t b = (uint8_t)chars[i];
+        cs->bits[b >> 6] |= 1ull << (b & 63);
+        rows[b >> 4] |= (uint16_t)(1u << (b & 15));
+    }
+    uint16_t classes[16];
+    int nclasses = 0;
+    for (int h = 0; h < 16; h++) {
+        if (rows[h] == 0) {
+            continue;
+        }
+        int k = 0;
+        while (k < nclasses && classes[k] != rows[h]) k++;
+        if (k == nclasses) {
+            classes[nclasses++] = rows[h];
+        }
+        cs->hi[k / 8][h] |= (uint8_t)(1u << (k % 8));
+    }
+    for (int k = 0; k < nclasses; k++) {
+        for (int l = 0; l < 16; l++) {
+            if (classes[k] >> l & 1) {
+                cs->lo[k / 8][l] |= (uint8_t)(1u << (k % 8));
+            }
+        }
+    }
+    cs->ntables = nclasses > 8 ? 2 : 1;
+}
+
+static inline bool in_set(const simdstr_charset_t *cs, char c) {
+    uint8_t b = (uint8_t)c;
+    return cs->bits[b >> 6] >> (b & 63) & 1;
+}
+
+char* find_first_of_naive(const simdstr_charset_t *cs, const char *s, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (in_set(cs, s[i])) return (char *)s + i;
+    }
+    return NULL;
+}
+
+char* find_first_not_of_naive(const simdstr_charset_t *cs, const char *s, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (!in_set(cs, s[i])) return (char *)s + i;
+    }
+    return NULL;
+}
+
+size_t count_of_naive(const simdstr_charset_t *cs, const char *s, size_t len) {
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++) {
+        n += in_set(cs, s[i]);
+    }
+    return n;
+}
+
+// The kernels take ntables as a constant, the second lookup is compiled out
+// of the loops of the small sets. flip is all ones for find_first_not_of.
+TARGET_SSE4_2
+static inline uint32_t set_mask_sse(const simdstr_charset_t *cs, __m128i x, int ntables) {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i l   = _mm_and_si128(x, nibble);
+    __m128i h   = _mm_and_si128(_mm_srli_epi16(x, 4), nibble);
+    __m128i cls = _mm_and_si128(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)cs->lo[0]), l),
+                                _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)cs->hi[0]), h));
+    if (ntables == 2) {
+        cls = _mm_or_si128(cls, _mm_and_si128(_mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)cs->lo[1]), l),
+                                              _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)cs->hi[1]), h)));
+    }
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(cls, _mm_setzero_si128())) ^ 0xFFFF;
+}
+
+// the tail is loaded whole when it stays in its page, its bits past len are cleared
+TARGET_SSE4_2
+static inline char* find_sse(const simdstr_charset_t *cs, const char *s, size_t len, int ntables,
+                             uint32_t flip) {
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint32_t m = set_mask_sse(cs, _mm_loadu_si128((const __m128i *)(s + i)), ntables) ^ flip;
+        if (m != 0) {
+            return (char *)s + i + __builtin_ctz(m);
+        }
+    }
+    if (i < len) {
+        uint32_t m = set_mask_sse(cs, load_tail_si128(s + i, len - i, 0), ntables) ^ flip;
+        m &= (1u << (len - i)) - 1;
+        if (m != 0) {
+            return (char *)s + i + __builtin_ctz(m);
+        }
+    }
+    return NULL;
+}
+
+TARGET_SSE4_2
+static inline size_t count_sse(const simdstr_charset_t *cs, const char *s, size_t len, int ntables) {
+    size_t n = 0, i = 0;
+    for (; i + 16 <= len; i += 16) {
+        n += _mm_popcnt_u32(set_mask_sse(cs, _mm_loadu_si128((const __m128i *)(s + i)), ntables));
+    }
+    if (i < len) {
+        uint32_t m = set_mask_sse(cs, load_tail_si128(s + i, len - i, 0), ntables);
+        n += _mm_popcnt_u32(m & ((1u << (len - i)) - 1));
+    }
+    return n;
+}
+
+TARGET_SSE4_2
+char* find_first_of_sse(const simdstr_charset_t *cs, const char *s, size_t len) {
+    return cs->ntables == 1 ? find_sse(cs, s, len, 1, 0) : find_sse(cs, s, len, 2, 0);
+}
+
+TARGET_SSE4_2
+char* find_first_not_of_sse(const simdstr_charset_t *cs, const char *s, size_t len) {
+    return cs->ntables == 1 ? find_sse(cs, s, len, 1, 0xFFFF) : find_sse(cs, s, len, 2, 0xFFFF);
+}
+
+TARGET_SSE4_2
+size_t count_of_sse(const simdstr_charset_t *cs, const char *s, size_t len) {
+    return cs->ntables == 1 ? count_sse(cs, s, len, 1) : count_sse(cs, s, len, 2);
+}
+
+TARGET_AVX2
+static inline uint32_t set_mask_avx2(const simdstr_charset_t *cs, __m256i x, int ntables) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i l   = _mm256_and_si256(x, nibble);
+    __m256i h   = _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble);
+    __m256i cls = _mm256_and_si256(
+        _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cs->lo[0])), l),
+        _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cs->hi[0])), h));
+    if (ntables == 2) {
+        cls = _mm256_or_si256(cls, _mm256_and_si256(
+            _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cs->lo[1])), l),
+            _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)cs->hi[1])), h)));
+    }
+    return ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(cls, _mm256_setzero_si256()));
+}
+
+// the tail below 32 bytes goes through the SSE kernel
+TARGET_AVX2
+static inline char* find_avx2(const simdstr_charset_t *cs, const char *s, size_t len, int ntables,
+                              uint32_t flip) {
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        uint32_t m = set_mask_avx2(cs, _mm256_loadu_si256((const __m256i *)(s + i)), ntables) ^ flip;
+        if (m != 0) {
+            return (char *)s + i + _tzcnt_u32(m);
+        }
+    }
+    return find_sse(cs, s + i, len - i, ntables, flip & 0xFFFF);
+}
+
+TARGET_AVX2
+static inline size_t count_avx2(const simdstr_charset_t *cs, const char *s, size_t len, int ntables) {
+    size_t n = 0, i = 0;
+    for (; i + 32 <= len; i += 32) {
+        n += _mm_popcnt_u32(set_mask_avx2(cs, _mm256_loadu_si256((const __m256i *)(s + i)), ntables));
+    }
+    return n + count_sse(cs, s + i, len - i, ntables);
+}
+
+TARGET_AVX2
+char* find_first_of_avx2(const simdstr_charset_t *cs, const char *s, size_t len) {
+    return cs->ntables == 1 ? find_avx2(cs, s, len, 1, 0) : find_avx2(cs, s, len, 2, 0);
+}
+
+TARGET_AVX2
+char* find_first_not_of_avx2(const simdstr_charset_t *cs, const char *s, size_t len) {
+    return cs->ntables == 1 ? find_avx2(cs, s, len, 1, ~0u) : find_avx2(cs, s, len, 2, ~0u);
+}
+
+TARGET_AVX2
+size_t count_of_avx2(const simdstr_charset_t *cs, const char *s, size_t len) {
+    return cs->ntables == 1 ? count_avx2(cs, s, len, 1) : count_avx2(cs, s, len, 2);
+}
+
+TARGET_AVX512
+static inline uint64_t set_mask_avx512(const simdstr_charset_t *cs, __m512i x, int ntables) {
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+    __m512i l   = _mm512_and_si512(x, nibble);
+    __m512i h   = _mm512_and_si512(_mm512_srli_epi16(x, 4), nibble);
+    __m512i cls = _mm512_and_si512(
+        _mm512_shuffle_epi8(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)cs->lo[0])), l),
+        _mm512_shuffle_epi8(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)cs->hi[0])), h));
+    if (ntables == 2) {
+        cls = _mm512_or_si512(cls, _mm512_and_si512(
+            _mm512_shuffle_epi8(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)cs->lo[1])), l),
+            _mm512_shuffle_epi8(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)cs->hi[1])), h)));
+    }
+    return _mm512_test_epi8_mask(cls, cls);
+}
+
+// the tail is a masked block, its bits past len are cleared
+TARGET_AVX512
+static inline char* find_avx512(const simdstr_charset_t *cs, const char *s, size_t len, int ntables,
+                                uint64_t flip) {
+    for (size_t i = 0; i < len; i += 64) {
+        __mmask64 k = len - i >= 64 ? ~0ull : _bzhi_u64(~0ull, len - i);
+        uint64_t  m = (set_mask_avx512(cs, _mm512_maskz_loadu_epi8(k, s + i), ntables) ^ flip) & k;
+        if (m != 0) {
+            return (char *)s + i + _tzcnt_u64(m);
+        }
+    }
+    return NULL;
+}
+
+TARGET_AVX512
+static inline size_t count_avx512(const simdstr_charset_t *cs, const char *s, size_t len, int ntables) {
+    size_t n = 0;
+    for (size_t i = 0; i < len; i += 64) {
+        __mmask64 k = len - i >= 64 ? ~0ull : _bzhi_u64(~0ull, len - i);
+        n += _mm_popcnt_u64(set_mask_avx512(cs, _mm512_maskz_loadu_epi8(k, s + i), ntables) & k);
+    }
+    return n;
+}
+
+TARGET_AVX512
+char* find_first_of_avx512(const simdstr_charset_t *cs, const char *s, size_t len) {
+    return cs->ntables == 1 ? find_avx512(cs, s, len, 1, 0) : find_avx512(cs, s, len, 2, 0);
+}
+
+TARGET_AVX512
+char* find_first_not_of_avx512(const simdstr_charset_t *cs, const char *s, size_t len) {
+    return cs->ntables == 1 ? find_avx512(cs, s, len, 1, ~0ull) : find_avx512(cs, s, len, 2, ~0ull);
+}
+
+TARGET_AVX512
+size_t count_of_avx512(const simdstr_charset_t *cs, const char *s, size_t len) {
+    return cs->ntables == 1 ? count_avx512(cs, s, len, 1) : count_avx512(cs, s, len, 2);
+}
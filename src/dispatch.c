@@ -0,0 +1,734 @@
+#include <cpuid.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "naivestr.h"
+#include "reduce.h"
+#include "simdstr.h"
+
+// The kernels of one ISA level. A public entry point is one indirect call
+// through the active table.
+struct kernels {
+    float (*sum)(const float *vec, size_t len);
+    bool  (*memcmpeq)(const char *s1, const char *s2, size_t len);
+    size_t (*mismatch)(const char *s1, const char *s2, size_t len);
+    int   (*memcmp3)(const char *s1, const char *s2, size_t len);
+    char* (*tolower)(char *dst, const char *src, size_t len);
+    char* (*toupper)(char *dst, const char *src, size_t len);
+    char* (*tolower_inplace)(char *s, size_t len);
+    char* (*toupper_inplace)(char *s, size_t len);
+    int   (*compact)(char *dst, const char *src, size_t len);
+    int   (*qstrlen)(const char *src, size_t len);
+    char* (*strstr)(const char *str, size_t n, const char *substr, size_t sn);
+    int64_t (*json_index)(const char *json, size_t len, uint32_t *index);
+    bool  (*qstrlen_update)(simdstr_qstrlen_state_t *st, const char *src, size_t len);
+    void  (*tolower_batch)(char *const *dst, const simdstr_slice_t *src, size_t count);
+    void  (*memcmpeq_batch)(const simdstr_slice_t *s1, const simdstr_slice_t *s2, size_t count,
+                            bool *out);
+    void  (*qstrlen_batch)(const simdstr_slice_t *src, size_t count, int *out);
+    size_t (*u64toa)(uint64_t val, char *out);
+    size_t (*u64toa_batch)(const uint64_t *vals, size_t count, char *out, size_t *lens);
+    size_t (*i64toa_batch)(const int64_t *vals, size_t count, char *out, size_t *lens);
+    size_t (*atou64)(const char *str, size_t len, uint64_t *val);
+    size_t (*atoi64)(const char *str, size_t len, int64_t *val);
+    size_t (*atof)(const char *str, size_t len, double *val);
+    bool  (*utf8_validate)(const char *s, size_t len);
+    size_t (*utf8_count)(const char *s, size_t len);
+    int64_t (*utf8_to_utf16)(uint16_t *dst, const char *src, size_t len);
+    int64_t (*utf16_to_utf8)(char *dst, const uint16_t *src, size_t len);
+    size_t (*casefold_utf8)(char *dst, const char *src, size_t len);
+    bool  (*memcaseeq)(const char *s1, const char *s2, size_t len);
+    char* (*strcasestr)(const char *str, size_t n, const char *substr, size_t sn);
+    char* (*find_first_of)(const simdstr_charset_t *cs, const char *s, size_t len);
+    char* (*find_first_not_of)(const simdstr_charset_t *cs, const char *s, size_t len);
+    size_t (*count_of)(const simdstr_charset_t *cs, const char *s, size_t len);
+    int64_t (*unquote)(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+    size_t (*quote)(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+    uint32_t (*crc32c)(uint32_t crc, const char *s, size_t len);
+    uint64_t (*hash64)(const char *s, size_t len, uint64_t seed);
+    void  (*hash64_batch)(const simdstr_slice_t *src, size_t count, uint64_t seed, uint64_t *out);
+    size_t (*base64_encode)(char *dst, const char *src, size_t len, simdstr_base64_t alphabet);
+    int64_t (*base64_decode)(char *dst, const char *src, size_t len, simdstr_base64_t alphabet, size_t *error_at);
+    size_t (*hex_encode)(char *dst, const char *src, size_t len);
+    int64_t (*hex_decode)(char *dst, const char *src, size_t len, size_t *error_at);
+    char* (*memchr)(const char *s, int c, size_t len);
+    char* (*memrchr)(const char *s, int c, size_t len);
+    char* (*memchr2)(const char *s, int c1, int c2, size_t len);
+    char* (*memchr3)(const char *s, int c1, int c2, int c3, size_t len);
+    size_t (*count_byte)(const char *s, int c, size_t len);
+    size_t (*newline_index)(const char *s, size_t len, uint64_t base, uint64_t *offsets);
+    char* (*memcpy)(char *dst, const char *src, size_t len);
+    char* (*memmove)(char *dst, const char *src, size_t len);
+    float (*sum_fast)(const float *vec, size_t len);
+    float (*sum_kahan)(const float *vec, size_t len);
+    sum_block_t sum_repro;
+    float (*dot_fast)(const float *a, const float *b, size_t len);
+    float (*dot_kahan)(const float *a, const float *b, size_t len);
+    dot_block_t dot_repro;
+    float (*min)(const float *vec, size_t len);
+    float (*max)(const float *vec, size_t len);
+};
+
+static char* tolower_inplace_naive(char *s, size_t len) {
+    return tolower_naive(s, s, len);
+}
+
+static char* toupper_inplace_naive(char *s, size_t len) {
+    return toupper_naive(s, s, len);
+}
+
+static const struct kernels kernels_naive = {
+    .sum      = sum_naive,
+    .memcmpeq = memcmpeq_naive,
+    .mismatch = mismatch_naive,
+    .memcmp3  = memcmp3_naive,
+    .tolower  = tolower_naive,
+    .toupper  = toupper_naive,
+    .tolower_inplace = tolower_inplace_naive,
+    .toupper_inplace = toupper_inplace_naive,
+    .compact  = compact_naive,
+    .qstrlen  = qstrlen_naive,
+    .strstr   = strstr_naive,
+    .qstrlen_update = qstrlen_update_naive,
+    .json_index     = json_index_naive,
+    .tolower_batch  = tolower_batch_naive,
+    .memcmpeq_batch = memcmpeq_batch_naive,
+    .qstrlen_batch  = qstrlen_batch_naive,
+    .u64toa         = u64toa_naive,
+    .u64toa_batch   = u64toa_batch_naive,
+    .i64toa_batch   = i64toa_batch_naive,
+    .atou64         = atou64_naive,
+    .atoi64         = atoi64_naive,
+    .atof           = atof_naive,
+    .utf8_validate  = utf8_validate_naive,
+    .utf8_count     = utf8_count_naive,
+    .utf8_to_utf16  = utf8_to_utf16_naive,
+    .utf16_to_utf8  = utf16_to_utf8_naive,
+    .casefold_utf8  = casefold_utf8_naive,
+    .memcaseeq      = memcaseeq_naive,
+    .strcasestr     = strcasestr_naive,
+    .find_first_of     = find_first_of_naive,
+    .find_first_not_of = find_first_not_of_naive,
+    .count_of          = count_of_naive,
+    .unquote  = unquote_naive,
+    .quote    = quote_naive,
+    .crc32c   = crc32c_naive,
+    .hash64   = hash64_naive,
+    .hash64_batch = hash64_batch_naive,
+    .base64_encode = base64_encode_naive,
+    .base64_decode = base64_decode_naive,
+    .hex_encode = hex_encode_naive,
+    .hex_decode = hex_decode_naive,
+    .memchr   = memchr_naive,
+    .memrchr  = memrchr_naive,
+    .memchr2  = memchr2_naive,
+    .memchr3  = memchr3_naive,
+    .count_byte = count_byte_naive,
+    .newline_index = newline_index_naive,
+    .memcpy   = memcpy_naive,
+    .memmove  = memmove_naive,
+    .sum_fast  = sum_naive,
+    .sum_kahan = sum_kahan_naive,
+    .sum_repro = sum_repro_block_naive,
+    .dot_fast  = dot_naive,
+    .dot_kahan = dot_kahan_naive,
+    .dot_repro = dot_repro_block_naive,
+    .min       = min_naive,
+    .max       = max_naive,
+};
+
+static const struct kernels kernels_sse4_2 = {
+    .sum      = sum_sse,
+    .memcmpeq = memcmpeq_sse,
+    .mismatch = mismatch_sse,
+    .memcmp3  = memcmp3_sse,
+    .tolower  = tolower_sse,
+    .toupper  = toupper_sse,
+    .tolower_inplace = tolower_inplace_sse,
+    .toupper_inplace = toupper_inplace_sse,
+    .compact  = compact_sse,
+    .qstrlen  = qstrlen_sse,
+    .strstr   = strstr_sse,
+    .qstrlen_update = qstrlen_update_sse,
+    .json_index     = json_index_sse,
+    .tolower_batch  = tolower_batch_sse,
+    .memcmpeq_batch = memcmpeq_batch_sse,
+    .qstrlen_batch  = qstrlen_batch_sse,
+    .u64toa         = u64toa_sse,
+    .u64toa_batch   = u64toa_batch_sse,
+    .i64toa_batch   = i64toa_batch_sse,
+    .atou64         = atou64_sse,
+    .atoi64         = atoi64_sse,
+    .atof           = atof_sse,
+    .utf8_validate  = utf8_validate_sse,
+    .utf8_count     = utf8_count_sse,
+    .utf8_to_utf16  = utf8_to_utf16_sse,
+    .utf16_to_utf8  = utf16_to_utf8_sse,
+    .casefold_utf8  = casefold_utf8_sse,
+    .memcaseeq      = memcaseeq_sse,
+    .strcasestr     = strcasestr_sse,
+    .find_first_of     = find_first_of_sse,
+    .find_first_not_of = find_first_not_of_sse,
+    .count_of          = count_of_sse,
+    .unquote  = unquote_sse,
+    .quote    = quote_sse,
+    .crc32c   = crc32c_sse,
+    .hash64   = hash64_sse,
+    .hash64_batch = hash64_batch_sse,
+    .base64_encode = base64_encode_sse,
+    .base64_decode = base64_decode_sse,
+    .hex_encode = hex_encode_sse,
+    .hex_decode = hex_decode_sse,
+    .memchr   = memchr_sse,
+    .memrchr  = memrchr_sse,
+    .memchr2  = memchr2_sse,
+    .memchr3  = memchr3_sse,
+    .count_byte = count_byte_sse,
+    .newline_index = newline_index_sse,
+    .memcpy   = memcpy_sse,
+    .memmove  = memmove_sse,
+    .sum_fast  = sum_fast_sse,
+    .sum_kahan = sum_kahan_sse,
+    .sum_repro = sum_repro_block_sse,
+    .dot_fast  = dot_fast_sse,
+    .dot_kahan = dot_kahan_sse,
+    .dot_repro = dot_repro_block_sse,
+    .min       = min_sse,
+    .max       = max_sse,
+};
+
+static const struct kernels kernels_avx2 = {
+    .sum      = sum_simd_fast,
+    .memcmpeq = memcmpeq_avx2,
+    .mismatch = mismatch_avx2,
+    .memcmp3  = memcmp3_avx2,
+    .tolower  = tolower_avx2,
+    .toupper  = toupper_avx2,
+    .tolower_inplace = tolower_inplace_avx2,
+    .toupper_inplace = toupper_inplace_avx2,
+    .compact  = compact_avx2,
+    .qstrlen  = qstrlen_avx2,
+    .strstr   = strstr_avx2,
+    .qstrlen_update = qstrlen_update_avx2,
+    .json_index     = json_index_avx2,
+    .tolower_batch  = tolower_batch_avx2,
+    .memcmpeq_batch = memcmpeq_batch_avx2,
+    .qstrlen_batch  = qstrlen_batch_avx2,
+    .u64toa         = u64toa_sse,
+    .u64toa_batch   = u64toa_batch_avx2,
+    .i64toa_batch   = i64toa_batch_avx2,
+    .atou64         = atou64_sse,
+    .atoi64         = atoi64_sse,
+    .atof           = atof_sse,
+    .utf8_validate  = utf8_validate_avx2,
+    .utf8_count     = utf8_count_avx2,
+    .utf8_to_utf16  = utf8_to_utf16_avx2,
+    .utf16_to_utf8  = utf16_to_utf8_avx2,
+    .casefold_utf8  = casefold_utf8_avx2,
+    .memcaseeq      = memcaseeq_avx2,
+    .strcasestr     = strcasestr_avx2,
+    .find_first_of     = find_first_of_avx2,
+    .find_first_not_of = find_first_not_of_avx2,
+    .count_of          = count_of_avx2,
+    .unquote  = unquote_avx2,
+    .quote    = quote_avx2,
+    .crc32c   = crc32c_sse,
+    .hash64   = hash64_avx2,
+    .hash64_batch = hash64_batch_avx2,
+    .base64_encode = base64_encode_avx2,
+    .base64_decode = base64_decode_avx2,
+    .hex_encode = hex_encode_avx2,
+    .hex_decode = hex_decode_avx2,
+    .memchr   = memchr_avx2,
+    .memrchr  = memrchr_avx2,
+    .memchr2  = memchr2_avx2,
+    .memchr3  = memchr3_avx2,
+    .count_byte = count_byte_avx2,
+    .newline_index = newline_index_avx2,
+    .memcpy   = memcpy_avx2,
+    .memmove  = memmove_avx2,
+    .sum_fast  = sum_fast_avx2,
+    .sum_kahan = sum_kahan_avx2,
+    .sum_repro = sum_repro_block_avx2,
+    .dot_fast  = dot_fast_avx2,
+    .dot_kahan = dot_kahan_avx2,
+    .dot_repro = dot_repro_block_avx2,
+    .min       = min_avx2,
+    .max       = max_avx2,
+};
+
+// patched by init_dispatch for the missing extensions
+static struct kernels kernels_avx512 = {
+    .sum      = sum_avx512,
+    .memcmpeq = memcmpeq_avx512,
+    .mismatch = mismatch_avx512,
+    .memcmp3  = memcmp3_avx512,
+    .tolower  = tolower_avx512,
+    .toupper  = toupper_avx512,
+    .tolower_inplace = tolower_inplace_avx512,
+    .toupper_inplace = toupper_inplace_avx512,
+    .compact  = compact_avx512,
+    .qstrlen  = qstrlen_avx512,
+    .strstr   = strstr_avx512,
+    .qstrlen_update = qstrlen_update_avx512,
+    .json_index     = json_index_avx512,
+    .tolower_batch  = tolower_batch_avx512,
+    .memcmpeq_batch = memcmpeq_batch_avx512,
+    .qstrlen_batch  = qstrlen_batch_avx512,
+    .u64toa         = u64toa_sse,
+    .u64toa_batch   = u64toa_batch_avx2,
+    .i64toa_batch   = i64toa_batch_avx2,
+    .atou64         = atou64_sse,
+    .atoi64         = atoi64_sse,
+    .atof           = atof_sse,
+    .utf8_validate  = utf8_validate_avx512,
+    .utf8_count     = utf8_count_avx512,
+    .utf8_to_utf16  = utf8_to_utf16_avx512,
+    .utf16_to_utf8  = utf16_to_utf8_avx512,
+    .casefold_utf8  = casefold_utf8_avx512,
+    .memcaseeq      = memcaseeq_avx512,
+    .strcasestr     = strcasestr_avx512,
+    .find_first_of     = find_first_of_avx512,
+    .find_first_not_of = find_first_not_of_avx512,
+    .count_of          = count_of_avx512,
+    .unquote  = unquote_avx512,
+    .quote    = quote_avx512,
+    .crc32c   = crc32c_sse,
+    .hash64   = hash64_avx512,
+    .hash64_batch = hash64_batch_avx512,
+    .base64_encode = base64_encode_avx512,
+    .base64_decode = base64_decode_avx512,
+    .hex_encode = hex_encode_avx512,
+    .hex_decode = hex_decode_avx512,
+    .memchr   = memchr_avx512,
+    .memrchr  = memrchr_avx512,
+    .memchr2  = memchr2_avx512,
+    .memchr3  = memchr3_avx512,
+    .count_byte = count_byte_avx512,
+    .newline_index = newline_index_avx512,
+    .memcpy   = memcpy_avx512,
+    .memmove  = memmove_avx512,
+    .sum_fast  = sum_fast_avx512,
+    .sum_kahan = sum_kahan_avx512,
+    // the same bits, the 4 accumulators of AVX2 hide more of the add latency
+    .sum_repro = sum_repro_block_avx2,
+    .dot_fast  = dot_fast_avx512,
+    .dot_kahan = dot_kahan_avx512,
+    .dot_repro = dot_repro_block_avx2,
+    .min       = min_avx512,
+    .max       = max_avx512,
+};
+
+static const struct kernels *const kernels_of[] = {
+    [SIMDSTR_ISA_NAIVE]  = &kernels_naive,
+    [SIMDSTR_ISA_SSE4_2] = &kernels_sse4_2,
+    [SIMDSTR_ISA_AVX2]   = &kernels_avx2,
+    [SIMDSTR_ISA_AVX512] = &kernels_avx512,
+};
+
+static const char *const isa_names[] = {
+    [SIMDSTR_ISA_NAIVE]  = "naive",
+    [SIMDSTR_ISA_SSE4_2] = "sse4_2",
+    [SIMDSTR_ISA_AVX2]   = "avx2",
+    [SIMDSTR_ISA_AVX512] = "avx512",
+};
+
+static simdstr_isa_t cpu_isa    = SIMDSTR_ISA_NAIVE;
+static unsigned      cpu_features = 0;
+static simdstr_isa_t active_isa = SIMDSTR_ISA_NAIVE;
+static const struct kernels *active = &kernels_naive;
+
+// __builtin_cpu_supports also checks that the OS saves the wider registers.
+static simdstr_isa_t probe_cpu(void) {
+    __builtin_cpu_init();
+    bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")
+        && __builtin_cpu_supports("bmi2");
+    if (avx2 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return SIMDSTR_ISA_AVX512;
+    }
+    if (avx2) {
+        return SIMDSTR_ISA_AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) {
+        return SIMDSTR_ISA_SSE4_2;
+    }
+    return SIMDSTR_ISA_NAIVE;
+}
+
+static unsigned probe_features(void) {
+    unsigned features = 0;
+    if (__builtin_cpu_supports("avx512vbmi2")) {
+        features |= SIMDSTR_CPU_AVX512VBMI2;
+    }
+    if (__builtin_cpu_supports("avx512vbmi")) {
+        features |= SIMDSTR_CPU_AVX512VBMI;
+    }
+    // not known to __builtin_cpu_supports, leaf 7 has it in ebx bit 9
+    unsigned eax, ebx, ecx, edx;
+    if (__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & (1u << 9))) {
+        features |= SIMDSTR_CPU_ERMS;
+    }
+    return features;
+}
+
+// The copy thresholds of glibc: rep movsb is ahead of the vector loops of isa
+// from 2 KiB per 16 bytes of its vectors on, and a copy past 3/4 of the last
+// level cache would evict everything else from it. Fast short rep movsb does
+// not move the first one, the vector copies are still ahead below 1 KiB.
+static size_t llc_size = 8 << 20;
+
+static void init_copy_thresholds(simdstr_isa_t isa) {
+    size_t movsb = SIZE_MAX;
+    if (cpu_features & SIMDSTR_CPU_ERMS) {
+        movsb = isa == SIMDSTR_ISA_AVX512 ? 8192 : isa == SIMDSTR_ISA_AVX2 ? 4096 : 2048;
+    }
+    simdstr_set_copy_thresholds(movsb, llc_size / 4 * 3);
+}
+
+__attribute__((constructor))
+static void init_dispatch(void) {
+    cpu_isa = probe_cpu();
+    cpu_features = probe_features();
+    long llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (llc <= 0) {
+        llc = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    }
+    if (llc > 0) {
+        llc_size = (size_t)llc;
+    }
+    if (!(cpu_features & SIMDSTR_CPU_AVX512VBMI2)) {
+        kernels_avx512.compact = compact_avx2;
+        kernels_avx512.utf16_to_utf8 = utf16_to_utf8_avx2;
+    }
+    if ((cpu_features & (SIMDSTR_CPU_AVX512VBMI | SIMDSTR_CPU_AVX512VBMI2))
+        != (SIMDSTR_CPU_AVX512VBMI | SIMDSTR_CPU_AVX512VBMI2)) {
+        kernels_avx512.utf8_to_utf16 = utf8_to_utf16_avx2;
+    }
+    if (!(cpu_features & SIMDSTR_CPU_AVX512VBMI)) {
+        kernels_avx512.base64_encode = base64_encode_avx2;
+        kernels_avx512.base64_decode = base64_decode_avx2;
+    }
+    active_isa = cpu_isa;
+    active = kernels_of[cpu_isa];
+    init_copy_thresholds(cpu_isa);
+
+    // an unknown level or one above the cpu one keeps the cpu one, said on
+    // stderr so that a typo does not go unnoticed
+    const char *name = getenv("SIMDSTR_ISA");
+    if (name != NULL) {
+        int forced = simdstr_isa_from_name(name);
+        if (forced < 0) {
+            fprintf(stderr, "simdstr: unknown SIMDSTR_ISA=%s, using %s\n", name, isa_names[cpu_isa]);
+        } else if (!simdstr_set_isa((simdstr_isa_t)forced)) {
+            fprintf(stderr, "simdstr: SIMDSTR_ISA=%s is not supported by the cpu, using %s\n", name,
+                    isa_names[cpu_isa]);
+        }
+    }
+}
+
+simdstr_isa_t simdstr_cpu_isa(void) {
+    return cpu_isa;
+}
+
+unsigned simdstr_cpu_features(void) {
+    return cpu_features;
+}
+
+simdstr_isa_t simdstr_isa(void) {
+    return active_isa;
+}
+
+bool simdstr_set_isa(simdstr_isa_t isa) {
+    if (isa < SIMDSTR_ISA_NAIVE || isa > cpu_isa) {
+        return false;
+    }
+    active_isa = isa;
+    active = kernels_of[isa];
+    init_copy_thresholds(isa);
+    return true;
+}
+
+const char* simdstr_isa_name(simdstr_isa_t isa) {
+    if (isa < SIMDSTR_ISA_NAIVE || isa > SIMDSTR_ISA_AVX512) {
+        return "unknown";
+    }
+    return isa_names[isa];
+}
+
+int simdstr_isa_from_name(const char *name) {
+    for (int i = SIMDSTR_ISA_NAIVE; i <= SIMDSTR_ISA_AVX512; i++) {
+        if (strcmp(name, isa_names[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+float simdstr_sum(const float *vec, size_t len) {
+    return active->sum(vec, len);
+}
+
+bool simdstr_memcmpeq(const char *s1, const char *s2, size_t len) {
+    return active->memcmpeq(s1, s2, len);
+}
+
+size_t simdstr_mismatch(const char *s1, const char *s2, size_t len) {
+    return active->mismatch(s1, s2, len);
+}
+
+int simdstr_memcmp3(const char *s1, const char *s2, size_t len) {
+    return active->memcmp3(s1, s2, len);
+}
+
+bool simdstr_memcaseeq(const char *s1, const char *s2, size_t len) {
+    return active->memcaseeq(s1, s2, len);
+}
+
+char* simdstr_tolower(char *dst, const char *src, size_t len) {
+    if (dst == src) {
+        return active->tolower_inplace(dst, len);
+    }
+    return active->tolower(dst, src, len);
+}
+
+char* simdstr_toupper(char *dst, const char *src, size_t len) {
+    if (dst == src) {
+        return active->toupper_inplace(dst, len);
+    }
+    return active->toupper(dst, src, len);
+}
+
+int simdstr_compact(char *dst, const char *src, size_t len) {
+    return active->compact(dst, src, len);
+}
+
+int simdstr_qstrlen(const char *src, size_t len) {
+    return active->qstrlen(src, len);
+}
+
+char* simdstr_strstr(const char *str, size_t n, const char *substr, size_t sn) {
+    return active->strstr(str, n, substr, sn);
+}
+
+char* simdstr_strcasestr(const char *str, size_t n, const char *substr, size_t sn) {
+    return active->strcasestr(str, n, substr, sn);
+}
+
+char* simdstr_memchr(const char *s, int c, size_t len) {
+    return active->memchr(s, c, len);
+}
+
+char* simdstr_memrchr(const char *s, int c, size_t len) {
+    return active->memrchr(s, c, len);
+}
+
+char* simdstr_memchr2(const char *s, int c1, int c2, size_t len) {
+    return active->memchr2(s, c1, c2, len);
+}
+
+char* simdstr_memchr3(const char *s, int c1, int c2, int c3, size_t len) {
+    return active->memchr3(s, c1, c2, c3, len);
+}
+
+size_t simdstr_count_byte(const char *s, int c, size_t len) {
+    return active->count_byte(s, c, len);
+}
+
+size_t simdstr_newline_index(const char *s, size_t len, uint64_t base, uint64_t *offsets) {
+    return active->newline_index(s, len, base, offsets);
+}
+
+char* simdstr_memcpy(char *dst, const char *src, size_t len) {
+    return active->memcpy(dst, src, len);
+}
+
+char* simdstr_memmove(char *dst, const char *src, size_t len) {
+    return active->memmove(dst, src, len);
+}
+
+bool simdstr_qstrlen_update(simdstr_qstrlen_state_t *st, const char *chunk, size_t len) {
+    return active->qstrlen_update(st, chunk, len);
+}
+
+int64_t simdstr_json_index(const char *json, size_t len, uint32_t *index) {
+    return active->json_index(json, len, index);
+}
+
+void simdstr_compact_init(simdstr_compact_state_t *st, char *dst) {
+    st->dst = dst;
+    st->len = 0;
+}
+
+// compact has no state across bytes, a chunk continues at the cursor
+size_t simdstr_compact_update(simdstr_compact_state_t *st, const char *chunk, size_t len) {
+    size_t n = (size_t)active->compact(st->dst + st->len, chunk, len);
+    st->len += n;
+    return n;
+}
+
+void simdstr_tolower_batch(char *const *dst, const simdstr_slice_t *src, size_t count) {
+    active->tolower_batch(dst, src, count);
+}
+
+void simdstr_memcmpeq_batch(const simdstr_slice_t *s1, const simdstr_slice_t *s2, size_t count,
+                            bool *out) {
+    active->memcmpeq_batch(s1, s2, count, out);
+}
+
+void simdstr_qstrlen_batch(const simdstr_slice_t *src, size_t count, int *out) {
+    active->qstrlen_batch(src, count, out);
+}
+
+void simdstr_hash64_batch(const simdstr_slice_t *src, size_t count, uint64_t seed, uint64_t *out) {
+    active->hash64_batch(src, count, seed, out);
+}
+
+bool simdstr_utf8_validate(const char *s, size_t len) {
+    return active->utf8_validate(s, len);
+}
+
+size_t simdstr_utf8_count(const char *s, size_t len) {
+    return active->utf8_count(s, len);
+}
+
+int64_t simdstr_utf8_to_utf16(uint16_t *dst, const char *src, size_t len) {
+    return active->utf8_to_utf16(dst, src, len);
+}
+
+int64_t simdstr_utf16_to_utf8(char *dst, const uint16_t *src, size_t len) {
+    return active->utf16_to_utf8(dst, src, len);
+}
+
+size_t simdstr_casefold_utf8(char *dst, const char *src, size_t len) {
+    return active->casefold_utf8(dst, src, len);
+}
+
+char* simdstr_find_first_of(const simdstr_charset_t *cs, const char *s, size_t len) {
+    return active->find_first_of(cs, s, len);
+}
+
+char* simdstr_find_first_not_of(const simdstr_charset_t *cs, const char *s, size_t len) {
+    return active->find_first_not_of(cs, s, len);
+}
+
+size_t simdstr_count_of(const simdstr_charset_t *cs, const char *s, size_t len) {
+    return active->count_of(cs, s, len);
+}
+
+size_t simdstr_span(const simdstr_charset_t *cs, const char *s, size_t len) {
+    char *p = active->find_first_not_of(cs, s, len);
+    return p != NULL ? (size_t)(p - s) : len;
+}
+
+int64_t simdstr_unquote(char *dst, const char *src, size_t len, simdstr_escape_t mode) {
+    return active->unquote(dst, src, len, mode);
+}
+
+size_t simdstr_quote(char *dst, const char *src, size_t len, simdstr_escape_t mode) {
+    return active->quote(dst, src, len, mode);
+}
+
+uint32_t simdstr_crc32c(uint32_t crc, const char *s, size_t len) {
+    return active->crc32c(crc, s, len);
+}
+
+uint64_t simdstr_hash64(const char *s, size_t len, uint64_t seed) {
+    return active->hash64(s, len, seed);
+}
+
+size_t simdstr_base64_encode(char *dst, const char *src, size_t len, simdstr_base64_t alphabet) {
+    return active->base64_encode(dst, src, len, alphabet);
+}
+
+int64_t simdstr_base64_decode(char *dst, const char *src, size_t len, simdstr_base64_t alphabet,
+                              size_t *error_at) {
+    return active->base64_decode(dst, src, len, alphabet, error_at);
+}
+
+size_t simdstr_hex_encode(char *dst, const char *src, size_t len) {
+    return active->hex_encode(dst, src, len);
+}
+
+int64_t simdstr_hex_decode(char *dst, const char *src, size_t len, size_t *error_at) {
+    return active->hex_decode(dst, src, len, error_at);
+}
+
+size_t simdstr_u64toa(uint64_t val, char *out) {
+    return active->u64toa(val, out);
+}
+
+size_t simdstr_i64toa(int64_t val, char *out) {
+    *out = '-';
+    return (val < 0) + active->u64toa(val < 0 ? 0 - (uint64_t)val : (uint64_t)val, out + (val < 0));
+}
+
+size_t simdstr_u32toa(uint32_t val, char *out) {
+    return active->u64toa(val, out);
+}
+
+size_t simdstr_atou64(const char *str, size_t len, uint64_t *val) {
+    return active->atou64(str, len, val);
+}
+
+size_t simdstr_atoi64(const char *str, size_t len, int64_t *val) {
+    return active->atoi64(str, len, val);
+}
+
+size_t simdstr_atof(const char *str, size_t len, double *val) {
+    return active->atof(str, len, val);
+}
+
+size_t simdstr_u64toa_batch(const uint64_t *vals, size_t count, char *out, size_t *lens) {
+    return active->u64toa_batch(vals, count, out, lens);
+}
+
+size_t simdstr_i64toa_batch(const int64_t *vals, size_t count, char *out, size_t *lens) {
+    return active->i64toa_batch(vals, count, out, lens);
+}
+
+float simdstr_reduce_sum(const float *vec, size_t len, simdstr_reduce_t mode) {
+    switch (mode) {
+    case SIMDSTR_REDUCE_COMPENSATED:
+        return active->sum_kahan(vec, len);
+    case SIMDSTR_REDUCE_REPRODUCIBLE:
+        return sum_repro_blocks(active->sum_repro, vec, len);
+    default:
+        return active->sum_fast(vec, len);
+    }
+}
+
+float simdstr_reduce_mean(const float *vec, size_t len, simdstr_reduce_t mode) {
+    if (len == 0) {
+        return NAN;
+    }
+    return (float)((double)simdstr_reduce_sum(vec, len, mode) / len);
+}
+
+float simdstr_reduce_dot(const float *a, const float *b, size_t len, simdstr_reduce_t mode) {
+    switch (mode) {
+    case SIMDSTR_REDUCE_COMPENSATED:
+        return active->dot_kahan(a, b, len);
+    case SIMDSTR_REDUCE_REPRODUCIBLE:
+        return dot_repro_blocks(active->dot_repro, a, b, len);
+    default:
+        return active->dot_fast(a, b, len);
+    }
+}
+
+float simdstr_reduce_min(const float *vec, size_t len) {
+    return active->min(vec, len);
+}
+
+float simdstr_reduce_max(const float *vec, size_t len) {
+    return active->max(vec, len);
+}
+
+double simdstr_sum_repro_block(const float *vec, size_t len) {
+    return active->sum_repro(vec, len);
+}
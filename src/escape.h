@@ -0,0 +1,33 @@
+#pragma once
+
+#include <stdint.h>
+
+// The bitmask string scanning of qstrlen and the JSON indexer, one bit per
+// byte of a 64-byte block. The escaped bytes follow an odd-length run of
+// backslashes, found with a carry-propagating add as in the simdjson string
+// scanner; prev_escaped carries the escape of the first byte of the next
+// block.
+static inline uint64_t find_escaped(uint64_t backslash, uint64_t *prev_escaped) {
+    const uint64_t even_bits = 0x5555555555555555ull;
+    // an escaped backslash does not escape the next byte
+    backslash &= ~*prev_escaped;
+    uint64_t follows_escape = backslash << 1 | *prev_escaped;
+    uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+    unsigned long long sequences_starting_on_even_bits;
+    *prev_escaped = __builtin_uaddll_overflow(odd_sequence_starts, backslash,
+                                              &sequences_starting_on_even_bits);
+    uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+    return (even_bits ^ invert_mask) & follows_escape;
+}
+
+// Bit i is the xor of the bits 0 to i: set from an opening quote up to the
+// byte before the closing one.
+static inline uint64_t prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
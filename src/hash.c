@@ -0,0 +1,426 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "crc32c_table.h"
+#include "isa.h"
+#include "simdstr.h"
+#include "tail.h"
+
+static inline uint64_t read64(const char *p) {
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+static inline uint32_t read32(const char *p) {
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+uint32_t crc32c_naive(uint32_t crc, const char *s, size_t len) {
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc = crc >> 8 ^ crc32c_table[(crc ^ (uint8_t)s[i]) & 0xFF];
+    }
+    return ~crc;
+}
+
+// the register advanced over the zero bytes of a table of crc32c_table.h
+static inline uint32_t crc32c_shift(const uint32_t zeros[4][256], uint32_t crc) {
+    return zeros[0][crc & 0xFF] ^ zeros[1][crc >> 8 & 0xFF] ^ zeros[2][crc >> 16 & 0xFF] ^ zeros[3][crc >> 24];
+}
+
+// Three lanes of n bytes each: the crc32 instruction has a latency of 3 and a
+// throughput of 1, the lanes keep it busy and are joined with the tables.
+TARGET_SSE4_2
+static inline uint32_t crc32c_lanes(uint32_t crc, const char **p, size_t *len, size_t n,
+                                    const uint32_t zeros[4][256]) {
+    while (*len >= 3 * n) {
+        const char *s = *p;
+        uint64_t c0 = crc, c1 = 0, c2 = 0;
+        for (size_t i = 0; i < n; i += 8) {
+            c0 = _mm_crc32_u64(c0, read64(s + i));
+            c1 = _mm_crc32_u64(c1, read64(s + n + i));
+            c2 = _mm_crc32_u64(c2, read64(s + 2 * n + i));
+        }
+        crc = crc32c_shift(zeros, (uint32_t)c0) ^ (uint32_t)c1;
+        crc = crc32c_shift(zeros, crc) ^ (uint32_t)c2;
+        *p += 3 * n;
+        *len -= 3 * n;
+    }
+    return crc;
+}
+
+TARGET_SSE4_2
+uint32_t crc32c_sse(uint32_t crc, const char *s, size_t len) {
+    crc = ~crc;
+    crc = crc32c_lanes(crc, &s, &len, CRC32C_LONG, crc32c_long);
+    crc = crc32c_lanes(crc, &s, &len, CRC32C_SHORT, crc32c_short);
+    uint64_t c = crc;
+    for (; len >= 8; s += 8, len -= 8) {
+        c = _mm_crc32_u64(c, read64(s));
+    }
+    crc = (uint32_t)c;
+    for (; len > 0; s++, len--) {
+        crc = _mm_crc32_u8(crc, (uint8_t)*s);
+    }
+    return ~crc;
+}
+
+// A 64-bit hash after XXH3: the strings up to 16 bytes are one multiply of
+// their two words, up to 128 bytes the sum of the multiplies of 16-byte
+// pairs from both ends, and longer ones 8 lanes of 64 bits that accumulate
+// the 32x32-bit products of the keyed input, one 64-byte stripe at a time,
+// scrambled every HASH_BLOCK stripes. The lanes are the same on every ISA
+// level, the vectors only hold more of them at once.
+#define HASH_STRIPE 64
+#define HASH_BLOCK  16
+
+#define P32_1 0x9E3779B1u
+#define P32_2 0x85EBCA77u
+#define P32_3 0xC2B2AE3Du
+#define P64_1 0x9E3779B185EBCA87ull
+#define P64_2 0xC2B2AE3D27D4EB4Full
+#define P64_3 0x165667B19E3779F9ull
+#define P64_4 0x85EBCA77C2B2AE63ull
+#define P64_5 0x27D4EB2F165667C5ull
+
+// the keys, the first outputs of splitmix64 seeded with 0
+static const uint64_t hash_secret[24] = {
+    0xE220A8397B1DCDAFull, 0x6E789E6AA1B965F4ull, 0x06C45D188009454Full,
+    0xF88BB8A8724C81ECull, 0x1B39896A51A8749Bull, 0x53CB9F0C747EA2EAull,
+    0x2C829ABE1F4532E1ull, 0xC584133AC916AB3Cull, 0x3EE5789041C98AC3ull,
+    0xF3B8488C368CB0A6ull, 0x657EECDD3CB13D09ull, 0xC2D326E0055BDEF6ull,
+    0x8621A03FE0BBDB7Bull, 0x8E1F7555983AA92Full, 0xB54E0F1600CC4D19ull,
+    0x84BB3F97971D80ABull, 0x7D29825C75521255ull, 0xC3CF17102B7F7F86ull,
+    0x3466E9A083914F64ull, 0xD81A8D2B5A4485ACull, 0xDB01602B100B9ED7ull,
+    0xA9038A921825F10Dull, 0xEDF5F1D90DCA2F6Aull, 0x54496AD67BD2634Cull,
+};
+
+// the keys of the scramble and of the last stripe
+#define HASH_SCRAMBLE_KEYS 16
+#define HASH_LAST_KEYS     11
+
+static inline uint64_t mul_fold(uint64_t a, uint64_t b) {
+    __uint128_t p = (__uint128_t)a * b;
+    return (uint64_t)p ^ (uint64_t)(p >> 64);
+}
+
+static inline uint64_t avalanche(uint64_t h) {
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ull;
+    return h ^ h >> 32;
+}
+
+// lo and hi are the bytes of the string, zero past its length
+static inline uint64_t hash_short(uint64_t lo, uint64_t hi, size_t len, uint64_t seed) {
+    uint64_t a = lo ^ (hash_secret[0] + seed);
+    uint64_t b = hi ^ (hash_secret[1] - seed);
+    return avalanche(len * P64_1 + __builtin_bswap64(lo) + hi + mul_fold(a, b));
+}
+
+// the two words from overlapping loads, the bytes loaded twice land on themselves
+static inline uint64_t hash_upto16(const char *s, size_t len, uint64_t seed) {
+    uint64_t lo = 0, hi = 0;
+    if (len > 8) {
+        lo = read64(s);
+        hi = read64(s + len - 8) >> (128 - 8 * len);
+    } else if (len >= 4) {
+        lo = read32(s) | (uint64_t)read32(s + len - 4) << (8 * (len - 4));
+    } else if (len > 0) {
+        const uint8_t *u = (const uint8_t *)s;
+        lo = u[0] | (uint64_t)u[len / 2] << (8 * (len / 2)) | (uint64_t)u[len - 1] << (8 * (len - 1));
+    }
+    return hash_short(lo, hi, len, seed);
+}
+
+static inline uint64_t mix16(const char *p, int k, uint64_t seed) {
+    return mul_fold(read64(p) ^ (hash_secret[k] + seed), read64(p + 8) ^ (hash_secret[k + 1] - seed));
+}
+
+// 17 to 128 bytes
+static inline uint64_t hash_mid(const char *s, size_t len, uint64_t seed) {
+    uint64_t acc = len * P64_1;
+    for (size_t i = 0; i <= (len - 1) / 32; i++) {
+        acc += mix16(s + 16 * i, 4 * i, seed) + mix16(s + len - 16 * (i + 1), 4 * i + 2, seed);
+    }
+    return avalanche(acc);
+}
+
+static inline uint64_t hash_merge(const uint64_t acc[8], size_t len) {
+    uint64_t h = len * P64_1;
+    for (int i = 0; i < 4; i++) {
+        h += mul_fold(acc[2 * i] ^ hash_secret[3 + 2 * i], acc[2 * i + 1] ^ hash_secret[4 + 2 * i]);
+    }
+    return avalanche(h);
+}
+
+// The long strings: the blocks, the whole stripes after them and the last 64
+// bytes as a stripe of its own, overlapping the ones before.
+#define HASH_LONG(stripe, scramble, s, len)                                         \
+    do {                                                                            \
+        size_t nblocks = (len - 1) / (HASH_STRIPE * HASH_BLOCK);                    \
+        for (size_t b = 0; b < nblocks; b++) {                                      \
+            for (int n = 0; n < HASH_BLOCK; n++) {                                  \
+                stripe(s + (b * HASH_BLOCK + n) * HASH_STRIPE, n);                  \
+            }                                                                       \
+            scramble();                                                             \
+        }                                                                           \
+        size_t nstripes = (len - 1 - nblocks * HASH_STRIPE * HASH_BLOCK) / HASH_STRIPE; \
+        for (size_t n = 0; n < nstripes; n++) {                                     \
+            stripe(s + (nblocks * HASH_BLOCK + n) * HASH_STRIPE, n);                \
+        }                                                                           \
+        stripe(s + len - HASH_STRIPE, HASH_LAST_KEYS);                              \
+    } while (0)
+
+static const uint64_t hash_init[8] = {P32_3, P64_1, P64_2, P64_3, P64_4, P32_2, P64_5, P32_1};
+
+uint64_t hash64_naive(const char *s, size_t len, uint64_t seed) {
+    if (len <= 16) {
+        return hash_upto16(s, len, seed);
+    }
+    if (len <= 128) {
+        return hash_mid(s, len, seed);
+    }
+    uint64_t acc[8];
+    memcpy(acc, hash_init, sizeof(acc));
+#define STRIPE(p, n)                                                                \
+    for (int i = 0; i < 8; i++) {                                                   \
+        uint64_t d = read64((p) + 8 * i);                                           \
+        uint64_t k = d ^ (hash_secret[(n) + i] + seed);                             \
+        acc[i ^ 1] += d;                                                            \
+        acc[i] += (k & 0xFFFFFFFF) * (k >> 32);                                     \
+    }
+#define SCRAMBLE()                                                                  \
+    for (int i = 0; i < 8; i++) {                                                   \
+        uint64_t a = acc[i] ^ acc[i] >> 47;                                         \
+        acc[i] = (a ^ (hash_secret[HASH_SCRAMBLE_KEYS + i] + seed)) * P32_1;        \
+    }
+    HASH_LONG(STRIPE, SCRAMBLE, s, len);
+#undef STRIPE
+#undef SCRAMBLE
+    return hash_merge(acc, len);
+}
+
+// acc += the swapped words + the products of the keyed words
+TARGET_SSE4_2
+static inline __m128i stripe_sse(__m128i acc, __m128i d, __m128i key) {
+    __m128i k = _mm_xor_si128(d, key);
+    __m128i product = _mm_mul_epu32(k, _mm_srli_epi64(k, 32));
+    return _mm_add_epi64(acc, _mm_add_epi64(_mm_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)), product));
+}
+
+// (acc ^ acc >> 47 ^ key) * P32_1, the product of the 32-bit halves
+TARGET_SSE4_2
+static inline __m128i scramble_sse(__m128i acc, __m128i key) {
+    __m128i a  = _mm_xor_si128(_mm_xor_si128(acc, _mm_srli_epi64(acc, 47)), key);
+    __m128i p  = _mm_set1_epi64x(P32_1);
+    __m128i lo = _mm_mul_epu32(a, p);
+    __m128i hi = _mm_mul_epu32(_mm_srli_epi64(a, 32), p);
+    return _mm_add_epi64(lo, _mm_slli_epi64(hi, 32));
+}
+
+TARGET_SSE4_2
+static inline __m128i keys_sse(int n, __m128i seed) {
+    return _mm_add_epi64(_mm_loadu_si128((const __m128i *)&hash_secret[n]), seed);
+}
+
+TARGET_SSE4_2
+uint64_t hash64_sse(const char *s, size_t len, uint64_t seed) {
+    if (len <= 16) {
+        return hash_upto16(s, len, seed);
+    }
+    if (len <= 128) {
+        return hash_mid(s, len, seed);
+    }
+    const __m128i vseed = _mm_set1_epi64x(seed);
+    __m128i acc[4];
+    for (int j = 0; j < 4; j++) {
+        acc[j] = _mm_loadu_si128((const __m128i *)&hash_init[2 * j]);
+    }
+#define STRIPE(p, n)                                                                \
+    for (int j = 0; j < 4; j++) {                                                   \
+        acc[j] = stripe_sse(acc[j], _mm_loadu_si128((const __m128i *)((p) + 16 * j)), \
+                            keys_sse((n) + 2 * j, vseed));                          \
+    }
+#define SCRAMBLE()                                                                  \
+    for (int j = 0; j < 4; j++) {                                                   \
+        acc[j] = scramble_sse(acc[j], keys_sse(HASH_SCRAMBLE_KEYS + 2 * j, vseed)); \
+    }
+    HASH_LONG(STRIPE, SCRAMBLE, s, len);
+#undef STRIPE
+#undef SCRAMBLE
+    uint64_t out[8];
+    for (int j = 0; j < 4; j++) {
+        _mm_storeu_si128((__m128i *)&out[2 * j], acc[j]);
+    }
+    return hash_merge(out, len);
+}
+
+TARGET_AVX2
+static inline __m256i stripe_avx2(__m256i acc, __m256i d, __m256i key) {
+    __m256i k = _mm256_xor_si256(d, key);
+    __m256i product = _mm256_mul_epu32(k, _mm256_srli_epi64(k, 32));
+    return _mm256_add_epi64(acc, _mm256_add_epi64(_mm256_shuffle_epi32(d, _MM_SHUFFLE(1, 0, 3, 2)), product));
+}
+
+TARGET_AVX2
+static inline __m256i scramble_avx2(__m256i acc, __m256i key) {
+    __m256i a  = _mm256_xor_si256(_mm256_xor_si256(acc, _mm256_srli_epi64(acc, 47)), key);
+    __m256i p  = _mm256_set1_epi64x(P32_1);
+    __m256i lo = _mm256_mul_epu32(a, p);
+    __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), p);
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+}
+
+TARGET_AVX2
+static inline __m256i keys_avx2(int n, __m256i seed) {
+    return _mm256_add_epi64(_mm256_loadu_si256((const __m256i *)&hash_secret[n]), seed);
+}
+
+TARGET_AVX2
+uint64_t hash64_avx2(const char *s, size_t len, uint64_t seed) {
+    if (len <= 16) {
+        return hash_upto16(s, len, seed);
+    }
+    if (len <= 128) {
+        return hash_mid(s, len, seed);
+    }
+    const __m256i vseed = _mm256_set1_epi64x(seed);
+    __m256i acc0 = _mm256_loadu_si256((const __m256i *)&hash_init[0]);
+    __m256i acc1 = _mm256_loadu_si256((const __m256i *)&hash_init[4]);
+#define STRIPE(p, n)                                                                \
+    acc0 = stripe_avx2(acc0, _mm256_loadu_si256((const __m256i *)(p)), keys_avx2((n), vseed)); \
+    acc1 = stripe_avx2(acc1, _mm256_loadu_si256((const __m256i *)((p) + 32)), keys_avx2((n) + 4, vseed));
+#define SCRAMBLE()                                                                  \
+    acc0 = scramble_avx2(acc0, keys_avx2(HASH_SCRAMBLE_KEYS, vseed));               \
+    acc1 = scramble_avx2(acc1, keys_avx2(HASH_SCRAMBLE_KEYS + 4, vseed));
+    HASH_LONG(STRIPE, SCRAMBLE, s, len);
+#undef STRIPE
+#undef SCRAMBLE
+    uint64_t out[8];
+    _mm256_storeu_si256((__m256i *)&out[0], acc0);
+    _mm256_storeu_si256((__m256i *)&out[4], acc1);
+    return hash_merge(out, len);
+}
+
+TARGET_AVX512
+static inline __m512i keys_avx512(int n, __m512i seed) {
+    return _mm512_add_epi64(_mm512_loadu_si512(&hash_secret[n]), seed);
+}
+
+TARGET_AVX512
+uint64_t hash64_avx512(const char *s, size_t len, uint64_t seed) {
+    if (len <= 16) {
+        return hash_upto16(s, len, seed);
+    }
+    if (len <= 128) {
+        return hash_mid(s, len, seed);
+    }
+    const __m512i vseed = _mm512_set1_epi64(seed);
+    const __m512i p     = _mm512_set1_epi64(P32_1);
+    __m512i acc = _mm512_loadu_si512(hash_init);
+#define STRIPE(ptr, n)                                                              \
+    do {                                                                            \
+        __m512i d = _mm512_loadu_si512(ptr);                                        \
+        __m512i k = _mm512_xor_si512(d, keys_avx512((n), vseed));                   \
+        __m512i product = _mm512_mul_epu32(k, _mm512_srli_epi64(k, 32));            \
+        acc = _mm512_add_epi64(acc, _mm512_add_epi64(_mm512_shuffle_epi32(d, _MM_PERM_BADC), product)); \
+    } while (0)
+#define SCRAMBLE()                                                                  \
+    do {                                                                            \
+        __m512i a = _mm512_xor_si512(_mm512_xor_si512(acc, _mm512_srli_epi64(acc, 47)), \
+                                     keys_avx512(HASH_SCRAMBLE_KEYS, vseed));       \
+        acc = _mm512_add_epi64(_mm512_mul_epu32(a, p),                              \
+                               _mm512_slli_epi64(_mm512_mul_epu32(_mm512_srli_epi64(a, 32), p), 32)); \
+    } while (0)
+    HASH_LONG(STRIPE, SCRAMBLE, s, len);
+#undef STRIPE
+#undef SCRAMBLE
+    uint64_t out[8];
+    _mm512_storeu_si512(out, acc);
+    return hash_merge(out, len);
+}
+
+// The batch kernels take the strings in groups of BATCH_GROUP: when all of a
+// group are 16 bytes or less their words are loaded first, without the
+// branches of the lengths, and the independent multiplies of the group are
+// in flight together. Longer strings take the kernel of one string.
+#define BATCH_GROUP 4
+
+static inline bool batch_short(const simdstr_slice_t *s) {
+    bool fits = true;
+    for (int k = 0; k < BATCH_GROUP; k++) {
+        fits &= s[k].len <= 16;
+    }
+    return fits;
+}
+
+void hash64_batch_naive(const simdstr_slice_t *src, size_t count, uint64_t seed, uint64_t *out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = hash64_naive(src[i].ptr, src[i].len, seed);
+    }
+}
+
+TARGET_SSE4_2
+static inline void hash64_batch_tail_sse(const simdstr_slice_t *src, size_t count, uint64_t seed,
+                                         uint64_t *out, uint64_t (*hash64)(const char *, size_t, uint64_t)) {
+    size_t i = 0;
+    for (; i + BATCH_GROUP <= count; i += BATCH_GROUP) {
+        if (!batch_short(src + i)) {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                out[i + k] = hash64(src[i + k].ptr, src[i + k].len, seed);
+            }
+            continue;
+        }
+        __m128i x[BATCH_GROUP];
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            x[k] = load_tail_si128(src[i + k].ptr, src[i + k].len, 0);
+        }
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            out[i + k] = hash_short(_mm_cvtsi128_si64(x[k]), _mm_extract_epi64(x[k], 1), src[i + k].len, seed);
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = hash64(src[i].ptr, src[i].len, seed);
+    }
+}
+
+TARGET_SSE4_2
+void hash64_batch_sse(const simdstr_slice_t *src, size_t count, uint64_t seed, uint64_t *out) {
+    hash64_batch_tail_sse(src, count, seed, out, hash64_sse);
+}
+
+TARGET_AVX2
+void hash64_batch_avx2(const simdstr_slice_t *src, size_t count, uint64_t seed, uint64_t *out) {
+    hash64_batch_tail_sse(src, count, seed, out, hash64_avx2);
+}
+
+// masked loads, no page check
+TARGET_AVX512
+void hash64_batch_avx512(const simdstr_slice_t *src, size_t count, uint64_t seed, uint64_t *out) {
+    size_t i = 0;
+    for (; i + BATCH_GROUP <= count; i += BATCH_GROUP) {
+        if (!batch_short(src + i)) {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                out[i + k] = hash64_avx512(src[i + k].ptr, src[i + k].len, seed);
+            }
+            continue;
+        }
+        __m128i x[BATCH_GROUP];
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            __mmask64 tail = _bzhi_u64(~0ull, src[i + k].len);
+            x[k] = _mm512_castsi512_si128(_mm512_maskz_loadu_epi8(tail, src[i + k].ptr));
+        }
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            out[i + k] = hash_short(_mm_cvtsi128_si64(x[k]), _mm_extract_epi64(x[k], 1), src[i + k].len, seed);
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = hash64_avx512(src[i].ptr, src[i].len, seed);
+    }
+}
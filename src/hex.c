@@ -0,0 +1,207 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "isa.h"
+#include "simdstr.h"
+
+// Hex in lowercase, decoded in either case. The encoders look the nibbles up
+// with pshufb and interleave the high and the low ones, the decoders take a
+// digit as c - '0' <= 9 and a letter as (c | 0x20) - 'a' <= 5, and join the
+// pairs with one pmaddubsw.
+static const char hex_digits[16] = "0123456789abcdef";
+
+static inline void set_error(size_t *error_at, size_t pos) {
+    if (error_at != NULL) {
+        *error_at = pos;
+    }
+}
+
+size_t hex_encode_naive(char *dst, const char *src, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dst[2 * i]     = hex_digits[(uint8_t)src[i] >> 4];
+        dst[2 * i + 1] = hex_digits[(uint8_t)src[i] & 15];
+    }
+    return 2 * len;
+}
+
+static inline int hex_value(char c) {
+    if ((uint8_t)(c - '0') <= 9) {
+        return c - '0';
+    }
+    if ((uint8_t)((c | 0x20) - 'a') <= 5) {
+        return (c | 0x20) - 'a' + 10;
+    }
+    return -1;
+}
+
+int64_t hex_decode_naive(char *dst, const char *src, size_t len, size_t *error_at) {
+    size_t n = len / 2;
+    for (size_t i = 0; i < n; i++) {
+        int hi = hex_value(src[2 * i]);
+        int lo = hex_value(src[2 * i + 1]);
+        if (hi < 0 || lo < 0) {
+            set_error(error_at, 2 * i + (hi >= 0));
+            return -1;
+        }
+        dst[i] = (char)(hi << 4 | lo);
+    }
+    if (len % 2 != 0) {
+        // half a byte
+        set_error(error_at, len - 1);
+        return -1;
+    }
+    return n;
+}
+
+// The decoding of the tail by the kernel below, after the done bytes the
+// blocks decoded: the offset of an error in the tail is moved past them. A
+// block with an invalid byte reports it itself and never gets here.
+static inline int64_t hex_decode_rest(int64_t (*decode)(char *, const char *, size_t, size_t *),
+                                      char *dst, const char *src, size_t done, size_t len, size_t *error_at) {
+    size_t  err;
+    int64_t n = decode(dst + done / 2, src + done, len - done, &err);
+    if (n < 0) {
+        set_error(error_at, done + err);
+        return -1;
+    }
+    return done / 2 + n;
+}
+
+TARGET_SSE4_2
+size_t hex_encode_sse(char *dst, const char *src, size_t len) {
+    const __m128i digits = _mm_loadu_si128((const __m128i *)hex_digits);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i x  = _mm_loadu_si128((const __m128i *)(src + i));
+        __m128i hi = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(x, 4), nibble));
+        __m128i lo = _mm_shuffle_epi8(digits, _mm_and_si128(x, nibble));
+        _mm_storeu_si128((__m128i *)(dst + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(dst + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    return 2 * i + hex_encode_naive(dst + 2 * i, src + i, len - i);
+}
+
+// the values of the nibbles, and the mask of the invalid bytes
+TARGET_SSE4_2
+static inline __m128i hex_values_sse(__m128i x, uint32_t *invalid) {
+    __m128i d = _mm_sub_epi8(x, _mm_set1_epi8('0'));
+    __m128i l = _mm_sub_epi8(_mm_or_si128(x, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i is_d = _mm_cmpeq_epi8(_mm_min_epu8(d, _mm_set1_epi8(9)), d);
+    __m128i is_l = _mm_cmpeq_epi8(_mm_min_epu8(l, _mm_set1_epi8(5)), l);
+    *invalid = ~_mm_movemask_epi8(_mm_or_si128(is_d, is_l)) & 0xFFFF;
+    return _mm_blendv_epi8(_mm_add_epi8(l, _mm_set1_epi8(10)), d, is_d);
+}
+
+TARGET_SSE4_2
+int64_t hex_decode_sse(char *dst, const char *src, size_t len, size_t *error_at) {
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint32_t invalid;
+        __m128i  v = hex_values_sse(_mm_loadu_si128((const __m128i *)(src + i)), &invalid);
+        if (invalid != 0) {
+            set_error(error_at, i + __builtin_ctz(invalid));
+            return -1;
+        }
+        v = _mm_maddubs_epi16(v, _mm_set1_epi16(0x0110));
+        _mm_storel_epi64((__m128i *)(dst + i / 2), _mm_packus_epi16(v, v));
+    }
+    return hex_decode_rest(hex_decode_naive, dst, src, i, len, error_at);
+}
+
+TARGET_AVX2
+size_t hex_encode_avx2(char *dst, const char *src, size_t len) {
+    const __m256i digits = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)hex_digits));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i x  = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i hi = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble));
+        __m256i lo = _mm256_shuffle_epi8(digits, _mm256_and_si256(x, nibble));
+        __m256i a  = _mm256_unpacklo_epi8(hi, lo);
+        __m256i b  = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256((__m256i *)(dst + 2 * i), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256((__m256i *)(dst + 2 * i + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    return 2 * i + hex_encode_sse(dst + 2 * i, src + i, len - i);
+}
+
+TARGET_AVX2
+int64_t hex_decode_avx2(char *dst, const char *src, size_t len, size_t *error_at) {
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(src + i));
+        __m256i d = _mm256_sub_epi8(x, _mm256_set1_epi8('0'));
+        __m256i l = _mm256_sub_epi8(_mm256_or_si256(x, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+        __m256i is_d = _mm256_cmpeq_epi8(_mm256_min_epu8(d, _mm256_set1_epi8(9)), d);
+        __m256i is_l = _mm256_cmpeq_epi8(_mm256_min_epu8(l, _mm256_set1_epi8(5)), l);
+        uint32_t invalid = ~(uint32_t)_mm256_movemask_epi8(_mm256_or_si256(is_d, is_l));
+        if (invalid != 0) {
+            set_error(error_at, i + __builtin_ctz(invalid));
+            return -1;
+        }
+        __m256i v = _mm256_blendv_epi8(_mm256_add_epi8(l, _mm256_set1_epi8(10)), d, is_d);
+        v = _mm256_maddubs_epi16(v, _mm256_set1_epi16(0x0110));
+        v = _mm256_permute4x64_epi64(_mm256_packus_epi16(v, v), 0xD8);
+        _mm_storeu_si128((__m128i *)(dst + i / 2), _mm256_castsi256_si128(v));
+    }
+    return hex_decode_rest(hex_decode_sse, dst, src, i, len, error_at);
+}
+
+// the 128 hex bytes of 64 bytes, in the order of the input
+TARGET_AVX512
+static inline void hex_encode_block_avx512(__m512i x, __m512i *first, __m512i *second) {
+    const __m512i digits = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)hex_digits));
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+    __m512i hi = _mm512_shuffle_epi8(digits, _mm512_and_si512(_mm512_srli_epi16(x, 4), nibble));
+    __m512i lo = _mm512_shuffle_epi8(digits, _mm512_and_si512(x, nibble));
+    __m512i a  = _mm512_unpacklo_epi8(hi, lo);
+    __m512i b  = _mm512_unpackhi_epi8(hi, lo);
+    *first  = _mm512_permutex2var_epi64(a, _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11), b);
+    *second = _mm512_permutex2var_epi64(a, _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15), b);
+}
+
+// the tail in one masked block
+TARGET_AVX512
+size_t hex_encode_avx512(char *dst, const char *src, size_t len) {
+    __m512i first, second;
+    size_t  i = 0;
+    for (; i + 64 <= len; i += 64) {
+        hex_encode_block_avx512(_mm512_loadu_si512(src + i), &first, &second);
+        _mm512_storeu_si512(dst + 2 * i, first);
+        _mm512_storeu_si512(dst + 2 * i + 64, second);
+    }
+    size_t n = len - i;
+    if (n > 0) {
+        hex_encode_block_avx512(_mm512_maskz_loadu_epi8((1ull << n) - 1, src + i), &first, &second);
+        _mm512_mask_storeu_epi8(dst + 2 * i, n >= 32 ? ~0ull : (1ull << 2 * n) - 1, first);
+        _mm512_mask_storeu_epi8(dst + 2 * i + 64, n <= 32 ? 0 : (1ull << (2 * n - 64)) - 1, second);
+    }
+    return 2 * len;
+}
+
+TARGET_AVX512
+int64_t hex_decode_avx512(char *dst, const char *src, size_t len, size_t *error_at) {
+    const __m512i pack = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        __m512i x = _mm512_loadu_si512(src + i);
+        __m512i d = _mm512_sub_epi8(x, _mm512_set1_epi8('0'));
+        __m512i l = _mm512_sub_epi8(_mm512_or_si512(x, _mm512_set1_epi8(0x20)), _mm512_set1_epi8('a'));
+        __mmask64 is_d = _mm512_cmple_epu8_mask(d, _mm512_set1_epi8(9));
+        __mmask64 is_l = _mm512_cmple_epu8_mask(l, _mm512_set1_epi8(5));
+        __mmask64 invalid = ~(is_d | is_l);
+        if (invalid != 0) {
+            set_error(error_at, i + __builtin_ctzll(invalid));
+            return -1;
+        }
+        __m512i v = _mm512_mask_blend_epi8(is_d, _mm512_add_epi8(l, _mm512_set1_epi8(10)), d);
+        v = _mm512_maddubs_epi16(v, _mm512_set1_epi16(0x0110));
+        v = _mm512_permutexvar_epi64(pack, _mm512_packus_epi16(v, v));
+        _mm256_storeu_si256((__m256i *)(dst + i / 2), _mm512_castsi512_si256(v));
+    }
+    return hex_decode_rest(hex_decode_avx2, dst, src, i, len, error_at);
+}
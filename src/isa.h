@@ -0,0 +1,16 @@
+#pragma once
+
+// Target attributes for the per-ISA kernels. The library itself is built for
+// the baseline x86_64 ISA, every wider kernel opts in with one of these and is
+// only reached through the runtime dispatch in dispatch.c.
+#define TARGET_SSE4_2 __attribute__((target("sse4.2,popcnt")))
+#define TARGET_AVX    __attribute__((target("avx")))
+#define TARGET_AVX2   __attribute__((target("avx2,fma,bmi,bmi2,popcnt,lzcnt")))
+#define TARGET_AVX512 __attribute__((target("avx512f,avx512bw,avx2,fma,bmi,bmi2,popcnt,lzcnt")))
+#define TARGET_AVX512_VBMI2 \
+    __attribute__((target("avx512f,avx512bw,avx512vbmi2,avx2,fma,bmi,bmi2,popcnt,lzcnt")))
+#define TARGET_AVX512_VBMI \
+    __attribute__((target("avx512f,avx512bw,avx512vbmi,avx2,fma,bmi,bmi2,popcnt,lzcnt")))
+// VBMI2 and the VBMI before it, every cpu with VBMI2 has both
+#define TARGET_AVX512_VBMI_VBMI2 \
+    __attribute__((target("avx512f,avx512bw,avx512vbmi,avx512vbmi2,avx2,fma,bmi,bmi2,popcnt,lzcnt")))
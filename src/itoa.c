@@ -0,0 +1,246 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "isa.h"
+#include "simdstr.h"
+
+// Integer to decimal string. The SIMD kernels are the Digits8toaSSE of
+// examples/simd_itoa: the 8 digits of a value below 10^8 are computed in the
+// 16-bit lanes of a vector by multiplications with reciprocals, then the
+// leading zeros are shifted out with pshufb. Every step stays in a 128-bit
+// lane, so AVX2 converts the digits of two numbers at once.
+
+static const char digits2[200] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const uint64_t pow10_u64[20] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+    100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+    10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+    100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull,
+};
+
+// the number of digits, 1 for 0: log10 from the bit length, corrected by one compare
+static inline int ndigits_u64(uint64_t v) {
+    int t = ((64 - __builtin_clzll(v | 1)) * 1233) >> 12;
+    return t + (v >= pow10_u64[t]) + (v == 0);
+}
+
+// the n digits of v backwards, two at a time
+static inline void write_digits(uint64_t v, int n, char *out) {
+    char *p = out + n;
+    while (v >= 100) {
+        p -= 2;
+        memcpy(p, digits2 + 2 * (v % 100), 2);
+        v /= 100;
+    }
+    if (v >= 10) {
+        memcpy(p - 2, digits2 + 2 * v, 2);
+    } else {
+        p[-1] = (char)('0' + v);
+    }
+}
+
+static inline size_t u64toa_scalar(uint64_t val, char *out) {
+    int n = ndigits_u64(val);
+    write_digits(val, n, out);
+    return n;
+}
+
+size_t u64toa_naive(uint64_t val, char *out) {
+    return u64toa_scalar(val, out);
+}
+
+size_t u64toa_batch_naive(const uint64_t *vals, size_t count, char *out, size_t *lens) {
+    char *p = out;
+    for (size_t i = 0; i < count; i++) {
+        size_t n = u64toa_naive(vals[i], p);
+        if (lens) lens[i] = n;
+        p += n;
+    }
+    return p - out;
+}
+
+// -INT64_MIN as unsigned without the overflow
+static inline uint64_t abs_u64(int64_t v) {
+    return v < 0 ? 0 - (uint64_t)v : (uint64_t)v;
+}
+
+size_t i64toa_batch_naive(const int64_t *vals, size_t count, char *out, size_t *lens) {
+    char *p = out;
+    for (size_t i = 0; i < count; i++) {
+        *p = '-';
+        size_t n = (vals[i] < 0) + u64toa_naive(abs_u64(vals[i]), p + (vals[i] < 0));
+        if (lens) lens[i] = n;
+        p += n;
+    }
+    return p - out;
+}
+
+// the constants of Digits8toaSSE for one 128-bit lane
+#define DIV_10K        0xd1b71759
+#define DIV_POWERS     0x20c5, 0x147b, 0x3334, 0x8000, 0x20c5, 0x147b, 0x3334, 0x8000
+#define SHIFT_POWERS   0x0080, 0x0800, 0x2000, 0x8000, 0x0080, 0x0800, 0x2000, 0x8000
+
+// v < 10^8 in the low 32 bits of the lane to its digits abcdefgh in 16-bit
+// lanes: abcd and efgh by a multiply-shift division by 10^4, then each of
+// them divided by 10^3, 10^2, 10^1 and 10^0 with mulhi, the quotients
+// a, ab, abc, abcd minus 10 times the previous one give the digits.
+TARGET_SSE4_2
+static inline __m128i digits8_sse(__m128i v) {
+    __m128i abcd = _mm_srli_epi64(_mm_mul_epu32(v, _mm_set1_epi32(DIV_10K)), 45);
+    __m128i efgh = _mm_sub_epi32(v, _mm_mul_epu32(abcd, _mm_set1_epi32(10000)));
+    __m128i x = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+    x = _mm_unpacklo_epi32(_mm_unpacklo_epi16(x, x), _mm_unpacklo_epi16(x, x));
+    x = _mm_mulhi_epu16(_mm_mulhi_epu16(x, _mm_setr_epi16(DIV_POWERS)), _mm_setr_epi16(SHIFT_POWERS));
+    __m128i tens = _mm_slli_epi64(_mm_mullo_epi16(x, _mm_set1_epi16(10)), 16);
+    return _mm_sub_epi16(x, tens);
+}
+
+TARGET_AVX2
+static inline __m256i digits8_avx2(__m256i v) {
+    __m256i abcd = _mm256_srli_epi64(_mm256_mul_epu32(v, _mm256_set1_epi32(DIV_10K)), 45);
+    __m256i efgh = _mm256_sub_epi32(v, _mm256_mul_epu32(abcd, _mm256_set1_epi32(10000)));
+    __m256i x = _mm256_slli_epi64(_mm256_unpacklo_epi16(abcd, efgh), 2);
+    x = _mm256_unpacklo_epi32(_mm256_unpacklo_epi16(x, x), _mm256_unpacklo_epi16(x, x));
+    x = _mm256_mulhi_epu16(_mm256_mulhi_epu16(x, _mm256_setr_epi16(DIV_POWERS, DIV_POWERS)),
+                           _mm256_setr_epi16(SHIFT_POWERS, SHIFT_POWERS));
+    __m256i tens = _mm256_slli_epi64(_mm256_mullo_epi16(x, _mm256_set1_epi16(10)), 16);
+    return _mm256_sub_epi16(x, tens);
+}
+
+#undef DIV_10K
+#undef DIV_POWERS
+#undef SHIFT_POWERS
+
+// pshufb indices from a sliding window: at shift_window + 16 - n, the last n
+// of 16 bytes move to the front and the rest become zeros.
+static const uint8_t shift_window[32] = {
+    0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+    0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+// the 16 digits of v < 10^16 with the leading zeros
+TARGET_SSE4_2
+static inline __m128i digits16_sse(uint64_t v) {
+    __m128i hi = digits8_sse(_mm_cvtsi32_si128((int)(v / 100000000)));
+    __m128i lo = digits8_sse(_mm_cvtsi32_si128((int)(v % 100000000)));
+    return _mm_add_epi8(_mm_packus_epi16(hi, lo), _mm_set1_epi8('0'));
+}
+
+// the short values are cheaper with the scalar pairs of digits
+TARGET_SSE4_2
+size_t u64toa_sse(uint64_t val, char *out) {
+    if (val < 10000) {
+        return u64toa_scalar(val, out);
+    }
+    if (val >= 10000000000000000ull) {
+        // 17 to 20 digits: at most 4 then 16
+        size_t n = u64toa_scalar(val / 10000000000000000ull, out);
+        _mm_storeu_si128((__m128i *)(out + n), digits16_sse(val % 10000000000000000ull));
+        return n + 16;
+    }
+    int n = ndigits_u64(val);
+    __m128i shift = _mm_loadu_si128((const __m128i *)(shift_window + 16 - n));
+    _mm_storeu_si128((__m128i *)out, _mm_shuffle_epi8(digits16_sse(val), shift));
+    return n;
+}
+
+TARGET_SSE4_2
+size_t u64toa_batch_sse(const uint64_t *vals, size_t count, char *out, size_t *lens) {
+    char *p = out;
+    for (size_t i = 0; i < count; i++) {
+        size_t n = u64toa_sse(vals[i], p);
+        if (lens) lens[i] = n;
+        p += n;
+    }
+    return p - out;
+}
+
+TARGET_SSE4_2
+size_t i64toa_batch_sse(const int64_t *vals, size_t count, char *out, size_t *lens) {
+    char *p = out;
+    for (size_t i = 0; i < count; i++) {
+        *p = '-';
+        size_t n = (vals[i] < 0) + u64toa_sse(abs_u64(vals[i]), p + (vals[i] < 0));
+        if (lens) lens[i] = n;
+        p += n;
+    }
+    return p - out;
+}
+
+// Two values below 10^16 at once, one per 128-bit lane, each after its sign.
+// Return the end of the second one.
+TARGET_AVX2
+static inline char* u64toa_pair_avx2(uint64_t a, uint64_t b, bool neg_a, bool neg_b, char *p,
+                                     size_t *len_a, size_t *len_b) {
+    __m256i hi = _mm256_setr_epi32((int)(a / 100000000), 0, 0, 0, (int)(b / 100000000), 0, 0, 0);
+    __m256i lo = _mm256_setr_epi32((int)(a % 100000000), 0, 0, 0, (int)(b % 100000000), 0, 0, 0);
+    __m256i x  = _mm256_packus_epi16(digits8_avx2(hi), digits8_avx2(lo));
+    int na = ndigits_u64(a), nb = ndigits_u64(b);
+    __m256i shift = _mm256_setr_m128i(_mm_loadu_si128((const __m128i *)(shift_window + 16 - na)),
+                                      _mm_loadu_si128((const __m128i *)(shift_window + 16 - nb)));
+    x = _mm256_shuffle_epi8(_mm256_add_epi8(x, _mm256_set1_epi8('0')), shift);
+    *p = '-';
+    p += neg_a;
+    _mm_storeu_si128((__m128i *)p, _mm256_castsi256_si128(x));
+    p += na;
+    *p = '-';
+    p += neg_b;
+    _mm_storeu_si128((__m128i *)p, _mm256_extracti128_si256(x, 1));
+    *len_a = neg_a + na;
+    *len_b = neg_b + nb;
+    return p + nb;
+}
+
+// a pair with a value of 17 digits or more goes through the SSE kernel
+TARGET_AVX2
+size_t u64toa_batch_avx2(const uint64_t *vals, size_t count, char *out, size_t *lens) {
+    const uint64_t max = 10000000000000000ull;
+    char *p = out;
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        size_t la, lb;
+        if (vals[i] < max && vals[i + 1] < max) {
+            p = u64toa_pair_avx2(vals[i], vals[i + 1], false, false, p, &la, &lb);
+        } else {
+            la = u64toa_sse(vals[i], p);
+            lb = u64toa_sse(vals[i + 1], p + la);
+            p += la + lb;
+        }
+        if (lens) lens[i] = la, lens[i + 1] = lb;
+    }
+    if (i < count) {
+        p += u64toa_batch_sse(vals + i, count - i, p, lens ? lens + i : NULL);
+    }
+    return p - out;
+}
+
+TARGET_AVX2
+size_t i64toa_batch_avx2(const int64_t *vals, size_t count, char *out, size_t *lens) {
+    const uint64_t max = 10000000000000000ull;
+    char *p = out;
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        uint64_t a = abs_u64(vals[i]), b = abs_u64(vals[i + 1]);
+        size_t la, lb;
+        if (a < max && b < max) {
+            p = u64toa_pair_avx2(a, b, vals[i] < 0, vals[i + 1] < 0, p, &la, &lb);
+        } else {
+            la = i64toa_batch_sse(vals + i, 1, p, NULL);
+            lb = i64toa_batch_sse(vals + i + 1, 1, p + la, NULL);
+            p += la + lb;
+        }
+        if (lens) lens[i] = la, lens[i + 1] = lb;
+    }
+    if (i < count) {
+        p += i64toa_batch_sse(vals + i, count - i, p, lens ? lens + i : NULL);
+    }
+    return p - out;
+}
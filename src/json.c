@@ -0,0 +1,191 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "escape.h"
+#include "isa.h"
+#include "simdstr.h"
+#include "tail.h"
+
+// JSON stage 1, the structural index: 64-byte blocks are turned into bitmasks
+// of their backslashes, quotes and structural characters. The unescaped
+// quotes are the string boundaries, their prefix xor masks the bytes inside
+// the strings, and the structural characters outside them are flattened to
+// offsets with tzcnt. A backslash escapes the next byte anywhere, so invalid
+// JSON gets the same index on every ISA level.
+//
+// The structural characters are classified with two pshufb lookups, as the
+// whitespace of examples/shuffle: a byte is structural when the entries of
+// its low and high nibbles share a bit.
+//   ',' 0x2C  ':' 0x3A  '[' 0x5B  ']' 0x5D  '{' 0x7B  '}' 0x7D
+static const uint8_t op_lo[16] = {[0xA] = 2, [0xB] = 4, [0xC] = 1, [0xD] = 4};
+static const uint8_t op_hi[16] = {[0x2] = 1, [0x3] = 2, [0x5] = 4, [0x7] = 4};
+
+static inline bool is_op(char c) {
+    uint8_t b = (uint8_t)c;
+    return (op_lo[b & 0xF] & op_hi[b >> 4]) != 0;
+}
+
+int64_t json_index_naive(const char *json, size_t len, uint32_t *index) {
+    if (len > UINT32_MAX) {
+        return -1;
+    }
+    uint32_t *out = index;
+    bool in_string = false, escaped = false;
+    for (size_t i = 0; i < len; i++) {
+        char c = json[i];
+        bool quote = c == '"' && !escaped;
+        escaped = c == '\\' && !escaped;
+        if (quote) {
+            in_string = !in_string;
+            *out++ = (uint32_t)i;
+        } else if (!in_string && is_op(c)) {
+            *out++ = (uint32_t)i;
+        }
+    }
+    return in_string ? -1 : out - index;
+}
+
+// the masks of one block
+typedef void (*json_masks_t)(const char *p, uint64_t *backslash, uint64_t *quote, uint64_t *op);
+
+// the escape and the string of the previous block
+struct json_state {
+    uint64_t prev_escaped;
+    uint64_t prev_in_string;      // all ones inside a string
+};
+
+static inline uint64_t json_structurals(uint64_t backslash, uint64_t quote, uint64_t op,
+                                        struct json_state *st) {
+    quote &= ~find_escaped(backslash, &st->prev_escaped);
+    uint64_t in_string = prefix_xor(quote) ^ st->prev_in_string;
+    st->prev_in_string = (uint64_t)((int64_t)in_string >> 63);
+    return (op & ~in_string) | quote;
+}
+
+static inline uint32_t* flatten(uint32_t *out, uint64_t bits, uint32_t base) {
+    while (bits != 0) {
+        *out++ = base + (uint32_t)__builtin_ctzll(bits);
+        bits &= bits - 1;
+    }
+    return out;
+}
+
+// The tail is scanned in place when its 64-byte block stays in the page and
+// its bits past len are cleared, otherwise it is copied to a zeroed block.
+static inline int64_t json_index_blocks(const char *json, size_t len, uint32_t *index,
+                                        json_masks_t masks) {
+    if (len > UINT32_MAX) {
+        return -1;
+    }
+    struct json_state st = {0, 0};
+    uint64_t backslash, quote, op;
+    uint32_t *out = index;
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        masks(json + i, &backslash, &quote, &op);
+        out = flatten(out, json_structurals(backslash, quote, op, &st), (uint32_t)i);
+    }
+    if (i < len) {
+        size_t n = len - i;
+        if (tail_in_page(json + i, 64)) {
+            masks(json + i, &backslash, &quote, &op);
+        } else {
+            char buf[64] = {0};
+            memcpy(buf, json + i, n);
+            masks(buf, &backslash, &quote, &op);
+        }
+        uint64_t keep = (1ull << n) - 1;
+        uint64_t bits = json_structurals(backslash & keep, quote & keep, op & keep, &st);
+        out = flatten(out, bits, (uint32_t)i);
+    }
+    return st.prev_in_string ? -1 : out - index;
+}
+
+TARGET_SSE4_2
+static inline void json_masks_sse(const char *p, uint64_t *backslash, uint64_t *quote, uint64_t *op) {
+    const __m128i lo = _mm_loadu_si128((const __m128i *)op_lo);
+    const __m128i hi = _mm_loadu_si128((const __m128i *)op_hi);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    uint64_t b = 0, q = 0, o = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i x   = _mm_loadu_si128((const __m128i *)(p + 16 * i));
+        __m128i cls = _mm_and_si128(_mm_shuffle_epi8(lo, _mm_and_si128(x, nibble)),
+                                    _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi16(x, 4), nibble)));
+        uint32_t none = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(cls, _mm_setzero_si128()));
+        b |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8('\\'))) << (16 * i);
+        q |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8('"'))) << (16 * i);
+        o |= (uint64_t)(~none & 0xFFFF) << (16 * i);
+    }
+    *backslash = b;
+    *quote = q;
+    *op = o;
+}
+
+TARGET_SSE4_2
+int64_t json_index_sse(const char *json, size_t len, uint32_t *index) {
+    return json_index_blocks(json, len, index, json_masks_sse);
+}
+
+TARGET_AVX2
+static inline void json_masks_avx2(const char *p, uint64_t *backslash, uint64_t *quote, uint64_t *op) {
+    const __m256i lo = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)op_lo));
+    const __m256i hi = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)op_hi));
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    uint64_t b = 0, q = 0, o = 0;
+    for (int i = 0; i < 2; i++) {
+        __m256i x   = _mm256_loadu_si256((const __m256i *)(p + 32 * i));
+        __m256i cls = _mm256_and_si256(
+            _mm256_shuffle_epi8(lo, _mm256_and_si256(x, nibble)),
+            _mm256_shuffle_epi8(hi, _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble)));
+        uint32_t none = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(cls, _mm256_setzero_si256()));
+        b |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\\'))) << (32 * i);
+        q |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('"'))) << (32 * i);
+        o |= (uint64_t)~none << (32 * i);
+    }
+    *backslash = b;
+    *quote = q;
+    *op = o;
+}
+
+TARGET_AVX2
+int64_t json_index_avx2(const char *json, size_t len, uint32_t *index) {
+    return json_index_blocks(json, len, index, json_masks_avx2);
+}
+
+TARGET_AVX512
+static inline void json_classify_avx512(__m512i x, uint64_t *backslash, uint64_t *quote, uint64_t *op) {
+    const __m512i lo = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)op_lo));
+    const __m512i hi = _mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)op_hi));
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+    __m512i cls = _mm512_and_si512(
+        _mm512_shuffle_epi8(lo, _mm512_and_si512(x, nibble)),
+        _mm512_shuffle_epi8(hi, _mm512_and_si512(_mm512_srli_epi16(x, 4), nibble)));
+    *backslash = _mm512_cmpeq_epi8_mask(x, _mm512_set1_epi8('\\'));
+    *quote     = _mm512_cmpeq_epi8_mask(x, _mm512_set1_epi8('"'));
+    *op        = _mm512_test_epi8_mask(cls, cls);
+}
+
+// the tail is a masked load, the bytes out of the mask are zeros
+TARGET_AVX512
+int64_t json_index_avx512(const char *json, size_t len, uint32_t *index) {
+    if (len > UINT32_MAX) {
+        return -1;
+    }
+    struct json_state st = {0, 0};
+    uint64_t backslash, quote, op;
+    uint32_t *out = index;
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        json_classify_avx512(_mm512_loadu_si512(json + i), &backslash, &quote, &op);
+        out = flatten(out, json_structurals(backslash, quote, op, &st), (uint32_t)i);
+    }
+    if (i < len) {
+        __m512i x = _mm512_maskz_loadu_epi8(_bzhi_u64(~0ull, len - i), json + i);
+        json_classify_avx512(x, &backslash, &quote, &op);
+        out = flatten(out, json_structurals(backslash, quote, op, &st), (uint32_t)i);
+    }
+    return st.prev_in_string ? -1 : out - index;
+}
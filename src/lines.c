@@ -0,0 +1,235 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "simdstr.h"
+
+// The newline index is built over chunks of this size, counted first and
+// then indexed into the slots the counts give them.
+#define INDEX_CHUNK (256 * 1024)
+
+// ranges of lines per thread, the ranges balance lines of uneven cost
+#define RANGES_PER_THREAD 4
+
+// fn over the lines of src from its start, each line found with memchr
+static size_t map_lines_serial(char *dst, const char *src, size_t len, simdstr_line_fn fn, void *ctx) {
+    size_t w = 0, i = 0;
+    while (i < len) {
+        const char *nl = simdstr_memchr(src + i, '\n', len - i);
+        size_t end = nl ? (size_t)(nl - src) : len;
+        w += fn(dst + w, src + i, end - i, ctx);
+        if (nl) {
+            dst[w++] = '\n';
+        }
+        i = end + 1;
+    }
+    return w;
+}
+
+// the first byte of line k, line 0 starting at 0 and line total + 1 at len
+static inline size_t line_start(const uint64_t *nl, size_t total, size_t len, size_t k) {
+    return k == 0 ? 0 : k <= total ? nl[k - 1] + 1 : len;
+}
+
+// fn over the lines first to last - 1 of the index
+static size_t map_lines_index(char *dst, const char *src, size_t len, const uint64_t *nl, size_t total,
+                              size_t first, size_t last, simdstr_line_fn fn, void *ctx) {
+    size_t w = 0;
+    for (size_t k = first; k < last; k++) {
+        size_t start = line_start(nl, total, len, k);
+        if (k < total) {
+            w += fn(dst + w, src + start, nl[k] - start, ctx);
+            dst[w++] = '\n';
+        } else if (start < len) {
+            w += fn(dst + w, src + start, len - start, ctx);
+        }
+    }
+    return w;
+}
+
+// the newline index of src, NULL when out of memory
+static uint64_t* newline_index_parallel(const char *src, size_t len, size_t *total, int nthreads) {
+    long    nchunks = (long)((len + INDEX_CHUNK - 1) / INDEX_CHUNK);
+    size_t *slots = malloc((nchunks + 1) * sizeof(size_t));
+    if (slots == NULL) {
+        return NULL;
+    }
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(nthreads)
+#endif
+    for (long i = 0; i < nchunks; i++) {
+        size_t offset = (size_t)i * INDEX_CHUNK;
+        slots[i + 1] = simdstr_count_byte(src + offset, '\n', len - offset < INDEX_CHUNK ? len - offset : INDEX_CHUNK);
+    }
+    slots[0] = 0;
+    for (long i = 0; i < nchunks; i++) {
+        slots[i + 1] += slots[i];
+    }
+    *total = slots[nchunks];
+    uint64_t *nl = malloc((*total + 1) * sizeof(uint64_t));
+    if (nl != NULL) {
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(static) num_threads(nthreads)
+#endif
+        for (long i = 0; i < nchunks; i++) {
+            size_t offset = (size_t)i * INDEX_CHUNK;
+            simdstr_newline_index(src + offset, len - offset < INDEX_CHUNK ? len - offset : INDEX_CHUNK,
+                                  offset, nl + slots[i]);
+        }
+    }
+    free(slots);
+    return nl;
+}
+
+// The ranges start at the line of each 1/nranges of the bytes, the index
+// gives it without a scan. The output of a range is at most its bytes.
+int64_t map_lines_parallel(char *dst, const char *src, size_t len, simdstr_line_fn fn, void *ctx,
+                           int nthreads) {
+#ifdef _OPENMP
+    nthreads = nthreads > 0 ? nthreads : omp_get_max_threads();
+#else
+    nthreads = 1;
+#endif
+    if (len < SIMDSTR_PARALLEL_MIN || nthreads <= 1) {
+        return map_lines_serial(dst, src, len, fn, ctx);
+    }
+    size_t    total;
+    uint64_t *nl = newline_index_parallel(src, len, &total, nthreads);
+    long      nranges = (long)nthreads * RANGES_PER_THREAD;
+    size_t   *first = malloc((nranges + 1) * sizeof(size_t));
+    size_t   *sizes = malloc((nranges + 1) * sizeof(size_t));
+    char    **bufs = calloc(nranges, sizeof(char *));
+    if (nl == NULL || first == NULL || sizes == NULL || bufs == NULL) {
+        free(nl);
+        free(first);
+        free(sizes);
+        free(bufs);
+        return -1;
+    }
+    for (long r = 0; r < nranges; r++) {
+        // the first newline at or after the split is the end of its line
+        size_t split = (size_t)((unsigned __int128)len * r / nranges);
+        size_t lo = 0, hi = total;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (nl[mid] < split) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        first[r] = lo;
+    }
+    first[nranges] = total + 1;
+    bool failed = false;
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
+#endif
+    for (long r = 0; r < nranges; r++) {
+        size_t bytes = line_start(nl, total, len, first[r + 1]) - line_start(nl, total, len, first[r]);
+        sizes[r] = 0;
+        if (bytes == 0) {
+            continue;
+        }
+        if ((bufs[r] = malloc(bytes)) == NULL) {
+#ifdef _OPENMP
+            #pragma omp atomic write
+#endif
+            failed = true;
+            continue;
+        }
+        sizes[r] = map_lines_index(bufs[r], src, len, nl, total, first[r], first[r + 1], fn, ctx);
+    }
+    // stitched in order
+    size_t out = 0;
+    for (long r = 0; r < nranges; r++) {
+        size_t n = sizes[r];
+        sizes[r] = out;
+        out += n;
+    }
+    sizes[nranges] = out;
+    if (!failed) {
+#ifdef _OPENMP
+        #pragma omp parallel for schedule(dynamic, 1) num_threads(nthreads)
+#endif
+        for (long r = 0; r < nranges; r++) {
+            memcpy(dst + sizes[r], bufs[r], sizes[r + 1] - sizes[r]);
+        }
+    }
+    for (long r = 0; r < nranges; r++) {
+        free(bufs[r]);
+    }
+    free(nl);
+    free(first);
+    free(sizes);
+    free(bufs);
+    return failed ? -1 : (int64_t)out;
+}
+
+// Both files are mapped, the output one at the size of the input and cut to
+// the bytes written at the end.
+int64_t map_lines_file(const char *in_path, const char *out_path, simdstr_line_fn fn, void *ctx,
+                       int nthreads) {
+    int in = open(in_path, O_RDONLY);
+    if (in < 0) {
+        return -1;
+    }
+    struct stat st, ost;
+    if (fstat(in, &st) != 0) {
+        close(in);
+        return -1;
+    }
+    // the truncation of the output would empty the input
+    if (stat(out_path, &ost) == 0 && ost.st_dev == st.st_dev && ost.st_ino == st.st_ino) {
+        close(in);
+        errno = EINVAL;
+        return -1;
+    }
+    int out = open(out_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (out < 0) {
+        close(in);
+        return -1;
+    }
+    size_t  len = (size_t)st.st_size;
+    int64_t n = 0;
+    if (len > 0) {
+        char *src = mmap(NULL, len, PROT_READ, MAP_PRIVATE, in, 0);
+        char *dst = MAP_FAILED;
+        if (src != MAP_FAILED && ftruncate(out, (off_t)len) == 0) {
+            dst = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, out, 0);
+        }
+        if (dst == MAP_FAILED) {
+            n = -1;
+        } else {
+            madvise(src, len, MADV_SEQUENTIAL);
+            n = map_lines_parallel(dst, src, len, fn, ctx, nthreads);
+            if (n < 0) {
+                errno = ENOMEM;
+            }
+            munmap(dst, len);
+        }
+        if (src != MAP_FAILED) {
+            munmap(src, len);
+        }
+        if (n >= 0 && ftruncate(out, (off_t)n) != 0) {
+            n = -1;
+        }
+    }
+    int err = errno;
+    close(in);
+    if (close(out) != 0 && n >= 0) {
+        return -1;
+    }
+    errno = err;
+    return n;
+}
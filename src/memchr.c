@@ -0,0 +1,421 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#include "isa.h"
+#include "simdstr.h"
+#include "tail.h"
+
+// Byte search. The kernels compare the blocks with 1 to 3 bytes, n of the
+// inline helpers, and OR the results. The AVX2 and AVX-512 searches test 4
+// blocks per iteration and only locate the byte in the iteration with a hit,
+// so a far hit costs one branch per 128 or 256 bytes.
+
+char* memchr_naive(const char *s, int c, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (s[i] == (char)c) {
+            return (char *)s + i;
+        }
+    }
+    return NULL;
+}
+
+char* memrchr_naive(const char *s, int c, size_t len) {
+    for (size_t i = len; i > 0; i--) {
+        if (s[i - 1] == (char)c) {
+            return (char *)s + i - 1;
+        }
+    }
+    return NULL;
+}
+
+char* memchr2_naive(const char *s, int c1, int c2, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (s[i] == (char)c1 || s[i] == (char)c2) {
+            return (char *)s + i;
+        }
+    }
+    return NULL;
+}
+
+char* memchr3_naive(const char *s, int c1, int c2, int c3, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        if (s[i] == (char)c1 || s[i] == (char)c2 || s[i] == (char)c3) {
+            return (char *)s + i;
+        }
+    }
+    return NULL;
+}
+
+size_t count_byte_naive(const char *s, int c, size_t len) {
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++) {
+        n += s[i] == (char)c;
+    }
+    return n;
+}
+
+TARGET_SSE4_2
+static inline uint32_t eq_mask_sse(__m128i x, int n, __m128i c1, __m128i c2, __m128i c3) {
+    __m128i eq = _mm_cmpeq_epi8(x, c1);
+    if (n >= 2) {
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi8(x, c2));
+    }
+    if (n >= 3) {
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi8(x, c3));
+    }
+    return _mm_movemask_epi8(eq);
+}
+
+TARGET_SSE4_2
+static inline char* find_sse(const char *s, size_t len, int n, int c1, int c2, int c3) {
+    const __m128i v1 = _mm_set1_epi8((char)c1), v2 = _mm_set1_epi8((char)c2), v3 = _mm_set1_epi8((char)c3);
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint32_t m = eq_mask_sse(_mm_loadu_si128((const __m128i *)(s + i)), n, v1, v2, v3);
+        if (m != 0) {
+            return (char *)s + i + __builtin_ctz(m);
+        }
+    }
+    if (i < len) {
+        uint32_t m = eq_mask_sse(load_tail_si128(s + i, len - i, 0), n, v1, v2, v3);
+        m &= (1u << (len - i)) - 1;
+        if (m != 0) {
+            return (char *)s + i + __builtin_ctz(m);
+        }
+    }
+    return NULL;
+}
+
+TARGET_SSE4_2
+char* memchr_sse(const char *s, int c, size_t len) {
+    return find_sse(s, len, 1, c, c, c);
+}
+
+TARGET_SSE4_2
+char* memchr2_sse(const char *s, int c1, int c2, size_t len) {
+    return find_sse(s, len, 2, c1, c2, c2);
+}
+
+TARGET_SSE4_2
+char* memchr3_sse(const char *s, int c1, int c2, int c3, size_t len) {
+    return find_sse(s, len, 3, c1, c2, c3);
+}
+
+// the blocks from the end, the head below 16 bytes loaded as a tail
+TARGET_SSE4_2
+char* memrchr_sse(const char *s, int c, size_t len) {
+    const __m128i v = _mm_set1_epi8((char)c);
+    size_t i = len;
+    for (; i >= 16; i -= 16) {
+        uint32_t m = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(s + i - 16)), v));
+        if (m != 0) {
+            return (char *)s + i - 16 + 31 - __builtin_clz(m);
+        }
+    }
+    if (i > 0) {
+        uint32_t m = _mm_movemask_epi8(_mm_cmpeq_epi8(load_tail_si128(s, i, 0), v)) & ((1u << i) - 1);
+        if (m != 0) {
+            return (char *)s + 31 - __builtin_clz(m);
+        }
+    }
+    return NULL;
+}
+
+TARGET_SSE4_2
+size_t count_byte_sse(const char *s, int c, size_t len) {
+    const __m128i v = _mm_set1_epi8((char)c);
+    size_t n = 0, i = 0;
+    for (; i + 16 <= len; i += 16) {
+        n += _mm_popcnt_u32(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i *)(s + i)), v)));
+    }
+    if (i < len) {
+        uint32_t m = _mm_movemask_epi8(_mm_cmpeq_epi8(load_tail_si128(s + i, len - i, 0), v));
+        n += _mm_popcnt_u32(m & ((1u << (len - i)) - 1));
+    }
+    return n;
+}
+
+TARGET_AVX2
+static inline __m256i eq_avx2(__m256i x, int n, __m256i c1, __m256i c2, __m256i c3) {
+    __m256i eq = _mm256_cmpeq_epi8(x, c1);
+    if (n >= 2) {
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi8(x, c2));
+    }
+    if (n >= 3) {
+        eq = _mm256_or_si256(eq, _mm256_cmpeq_epi8(x, c3));
+    }
+    return eq;
+}
+
+// The first block is unaligned, the ones after it aligned: they start at most
+// 31 bytes back in the block already searched. The tail below 32 bytes goes
+// through the SSE kernel.
+TARGET_AVX2
+static inline char* find_avx2(const char *s, size_t len, int n, int c1, int c2, int c3) {
+    const __m256i v1 = _mm256_set1_epi8((char)c1), v2 = _mm256_set1_epi8((char)c2), v3 = _mm256_set1_epi8((char)c3);
+    size_t i = 0;
+    if (len >= 32) {
+        uint32_t m = _mm256_movemask_epi8(eq_avx2(_mm256_loadu_si256((const __m256i *)s), n, v1, v2, v3));
+        if (m != 0) {
+            return (char *)s + _tzcnt_u32(m);
+        }
+        i = 32 - ((uintptr_t)s & 31);
+    }
+    for (; i + 128 <= len; i += 128) {
+        __m256i e0 = eq_avx2(_mm256_loadu_si256((const __m256i *)(s + i)), n, v1, v2, v3);
+        __m256i e1 = eq_avx2(_mm256_loadu_si256((const __m256i *)(s + i + 32)), n, v1, v2, v3);
+        __m256i e2 = eq_avx2(_mm256_loadu_si256((const __m256i *)(s + i + 64)), n, v1, v2, v3);
+        __m256i e3 = eq_avx2(_mm256_loadu_si256((const __m256i *)(s + i + 96)), n, v1, v2, v3);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+        if (!_mm256_testz_si256(any, any)) {
+            uint64_t lo = (uint32_t)_mm256_movemask_epi8(e0) | (uint64_t)(uint32_t)_mm256_movemask_epi8(e1) << 32;
+            if (lo != 0) {
+                return (char *)s + i + _tzcnt_u64(lo);
+            }
+            uint64_t hi = (uint32_t)_mm256_movemask_epi8(e2) | (uint64_t)(uint32_t)_mm256_movemask_epi8(e3) << 32;
+            return (char *)s + i + 64 + _tzcnt_u64(hi);
+        }
+    }
+    for (; i + 32 <= len; i += 32) {
+        uint32_t m = _mm256_movemask_epi8(eq_avx2(_mm256_loadu_si256((const __m256i *)(s + i)), n, v1, v2, v3));
+        if (m != 0) {
+            return (char *)s + i + _tzcnt_u32(m);
+        }
+    }
+    return find_sse(s + i, len - i, n, c1, c2, c3);
+}
+
+TARGET_AVX2
+char* memchr_avx2(const char *s, int c, size_t len) {
+    return find_avx2(s, len, 1, c, c, c);
+}
+
+TARGET_AVX2
+char* memchr2_avx2(const char *s, int c1, int c2, size_t len) {
+    return find_avx2(s, len, 2, c1, c2, c2);
+}
+
+TARGET_AVX2
+char* memchr3_avx2(const char *s, int c1, int c2, int c3, size_t len) {
+    return find_avx2(s, len, 3, c1, c2, c3);
+}
+
+// find_avx2 from the end: the last block is unaligned, the ones before it
+// aligned.
+TARGET_AVX2
+char* memrchr_avx2(const char *s, int c, size_t len) {
+    const __m256i v = _mm256_set1_epi8((char)c);
+    size_t i = len;
+    if (i >= 32) {
+        uint32_t m = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + i - 32)), v));
+        if (m != 0) {
+            return (char *)s + i - 1 - _lzcnt_u32(m);
+        }
+        i -= 32;
+        i += -(uintptr_t)(s + i) & 31;
+    }
+    for (; i >= 128; i -= 128) {
+        const char *p = s + i - 128;
+        __m256i e0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)p), v);
+        __m256i e1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + 32)), v);
+        __m256i e2 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + 64)), v);
+        __m256i e3 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(p + 96)), v);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(e0, e1), _mm256_or_si256(e2, e3));
+        if (!_mm256_testz_si256(any, any)) {
+            uint64_t hi = (uint32_t)_mm256_movemask_epi8(e2) | (uint64_t)(uint32_t)_mm256_movemask_epi8(e3) << 32;
+            if (hi != 0) {
+                return (char *)p + 127 - _lzcnt_u64(hi);
+            }
+            uint64_t lo = (uint32_t)_mm256_movemask_epi8(e0) | (uint64_t)(uint32_t)_mm256_movemask_epi8(e1) << 32;
+            return (char *)p + 63 - _lzcnt_u64(lo);
+        }
+    }
+    for (; i >= 32; i -= 32) {
+        uint32_t m = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + i - 32)), v));
+        if (m != 0) {
+            return (char *)s + i - 1 - _lzcnt_u32(m);
+        }
+    }
+    return memrchr_sse(s, c, i);
+}
+
+// The equal bytes are counted in byte lanes, -1 per match, and summed with
+// psadbw every 63 iterations of 4 blocks, before a lane could wrap.
+TARGET_AVX2
+size_t count_byte_avx2(const char *s, int c, size_t len) {
+    const __m256i v = _mm256_set1_epi8((char)c);
+    __m256i sums = _mm256_setzero_si256();
+    size_t  i = 0;
+    while (i + 128 <= len) {
+        __m256i acc = _mm256_setzero_si256();
+        for (int r = 0; r < 63 && i + 128 <= len; r++, i += 128) {
+            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + i)), v));
+            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + i + 32)), v));
+            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + i + 64)), v));
+            acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + i + 96)), v));
+        }
+        sums = _mm256_add_epi64(sums, _mm256_sad_epu8(acc, _mm256_setzero_si256()));
+    }
+    size_t n = _mm256_extract_epi64(sums, 0) + _mm256_extract_epi64(sums, 1) +
+               _mm256_extract_epi64(sums, 2) + _mm256_extract_epi64(sums, 3);
+    for (; i + 32 <= len; i += 32) {
+        n += _mm_popcnt_u32(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + i)), v)));
+    }
+    return n + count_byte_sse(s + i, c, len - i);
+}
+
+TARGET_AVX512
+static inline uint64_t eq_mask_avx512(__m512i x, int n, __m512i c1, __m512i c2, __m512i c3) {
+    uint64_t m = _mm512_cmpeq_epi8_mask(x, c1);
+    if (n >= 2) {
+        m |= _mm512_cmpeq_epi8_mask(x, c2);
+    }
+    if (n >= 3) {
+        m |= _mm512_cmpeq_epi8_mask(x, c3);
+    }
+    return m;
+}
+
+// the tail is a masked block, its bits past len are cleared
+TARGET_AVX512
+static inline char* find_avx512(const char *s, size_t len, int n, int c1, int c2, int c3) {
+    const __m512i v1 = _mm512_set1_epi8((char)c1), v2 = _mm512_set1_epi8((char)c2), v3 = _mm512_set1_epi8((char)c3);
+    size_t i = 0;
+    for (; i + 256 <= len; i += 256) {
+        uint64_t m0 = eq_mask_avx512(_mm512_loadu_si512(s + i), n, v1, v2, v3);
+        uint64_t m1 = eq_mask_avx512(_mm512_loadu_si512(s + i + 64), n, v1, v2, v3);
+        uint64_t m2 = eq_mask_avx512(_mm512_loadu_si512(s + i + 128), n, v1, v2, v3);
+        uint64_t m3 = eq_mask_avx512(_mm512_loadu_si512(s + i + 192), n, v1, v2, v3);
+        if ((m0 | m1 | m2 | m3) != 0) {
+            size_t off = m0 ? 0 : m1 ? 64 : m2 ? 128 : 192;
+            uint64_t m = m0 ? m0 : m1 ? m1 : m2 ? m2 : m3;
+            return (char *)s + i + off + _tzcnt_u64(m);
+        }
+    }
+    for (; i < len; i += 64) {
+        __mmask64 k = len - i >= 64 ? ~0ull : _bzhi_u64(~0ull, len - i);
+        uint64_t  m = eq_mask_avx512(_mm512_maskz_loadu_epi8(k, s + i), n, v1, v2, v3) & k;
+        if (m != 0) {
+            return (char *)s + i + _tzcnt_u64(m);
+        }
+    }
+    return NULL;
+}
+
+TARGET_AVX512
+char* memchr_avx512(const char *s, int c, size_t len) {
+    return find_avx512(s, len, 1, c, c, c);
+}
+
+TARGET_AVX512
+char* memchr2_avx512(const char *s, int c1, int c2, size_t len) {
+    return find_avx512(s, len, 2, c1, c2, c2);
+}
+
+TARGET_AVX512
+char* memchr3_avx512(const char *s, int c1, int c2, int c3, size_t len) {
+    return find_avx512(s, len, 3, c1, c2, c3);
+}
+
+TARGET_AVX512
+char* memrchr_avx512(const char *s, int c, size_t len) {
+    const __m512i v = _mm512_set1_epi8((char)c);
+    size_t i = len;
+    for (; i >= 256; i -= 256) {
+        const char *p = s + i - 256;
+        uint64_t m0 = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p), v);
+        uint64_t m1 = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p + 64), v);
+        uint64_t m2 = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p + 128), v);
+        uint64_t m3 = _mm512_cmpeq_epi8_mask(_mm512_loadu_si512(p + 192), v);
+        if ((m0 | m1 | m2 | m3) != 0) {
+            size_t off = m3 ? 192 : m2 ? 128 : m1 ? 64 : 0;
+            uint64_t m = m3 ? m3 : m2 ? m2 : m1 ? m1 : m0;
+            return (char *)p + off + 63 - _lzcnt_u64(m);
+        }
+    }
+    for (; i > 0; i -= i >= 64 ? 64 : i) {
+        size_t    n = i >= 64 ? 64 : i;
+        __mmask64 k = _bzhi_u64(~0ull, n);
+        uint64_t  m = _mm512_cmpeq_epi8_mask(_mm512_maskz_loadu_epi8(k, s + i - n), v) & k;
+        if (m != 0) {
+            return (char *)s + i - n + 63 - _lzcnt_u64(m);
+        }
+    }
+    return NULL;
+}
+
+// the popcounts of the masks in 4 sums, added once at the end
+TARGET_AVX512
+size_t count_byte_avx512(const char *s, int c, size_t len) {
+    const __m512i v = _mm512_set1_epi8((char)c);
+    size_t n0 = 0, n1 = 0, n2 = 0, n3 = 0, i = 0;
+    for (; i + 256 <= len; i += 256) {
+        n0 += _mm_popcnt_u64(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(s + i), v));
+        n1 += _mm_popcnt_u64(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(s + i + 64), v));
+        n2 += _mm_popcnt_u64(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(s + i + 128), v));
+        n3 += _mm_popcnt_u64(_mm512_cmpeq_epi8_mask(_mm512_loadu_si512(s + i + 192), v));
+    }
+    for (; i < len; i += 64) {
+        __mmask64 k = len - i >= 64 ? ~0ull : _bzhi_u64(~0ull, len - i);
+        n0 += _mm_popcnt_u64(_mm512_mask_cmpeq_epi8_mask(k, _mm512_maskz_loadu_epi8(k, s + i), v));
+    }
+    return n0 + n1 + n2 + n3;
+}
+
+// The newline index: base plus the offset of each '\n', written from the
+// bits of the compare masks.
+size_t newline_index_naive(const char *s, size_t len, uint64_t base, uint64_t *offsets) {
+    size_t n = 0;
+    for (size_t i = 0; i < len; i++) {
+        if (s[i] == '\n') {
+            offsets[n++] = base + i;
+        }
+    }
+    return n;
+}
+
+TARGET_SSE4_2
+size_t newline_index_sse(const char *s, size_t len, uint64_t base, uint64_t *offsets) {
+    const __m128i nl = _mm_set1_epi8('\n');
+    size_t n = 0;
+    for (size_t i = 0; i < len; i += 16) {
+        uint32_t m = _mm_movemask_epi8(_mm_cmpeq_epi8(load_tail_si128(s + i, len - i, 0), nl));
+        if (len - i < 16) {
+            m &= (1u << (len - i)) - 1;
+        }
+        for (; m != 0; m &= m - 1) {
+            offsets[n++] = base + i + __builtin_ctz(m);
+        }
+    }
+    return n;
+}
+
+TARGET_AVX2
+size_t newline_index_avx2(const char *s, size_t len, uint64_t base, uint64_t *offsets) {
+    const __m256i nl = _mm256_set1_epi8('\n');
+    size_t n = 0, i = 0;
+    for (; i + 64 <= len; i += 64) {
+        uint64_t m = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + i)), nl)) |
+                     (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *)(s + i + 32)), nl)) << 32;
+        for (; m != 0; m = _blsr_u64(m)) {
+            offsets[n++] = base + i + _tzcnt_u64(m);
+        }
+    }
+    return n + newline_index_sse(s + i, len - i, base + i, offsets + n);
+}
+
+TARGET_AVX512
+size_t newline_index_avx512(const char *s, size_t len, uint64_t base, uint64_t *offsets) {
+    const __m512i nl = _mm512_set1_epi8('\n');
+    size_t n = 0;
+    for (size_t i = 0; i < len; i += 64) {
+        __mmask64 k = len - i >= 64 ? ~0ull : _bzhi_u64(~0ull, len - i);
+        uint64_t  m = _mm512_mask_cmpeq_epi8_mask(k, _mm512_maskz_loadu_epi8(k, s + i), nl);
+        for (; m != 0; m = _blsr_u64(m)) {
+            offsets[n++] = base + i + _tzcnt_u64(m);
+        }
+    }
+    return n;
+}
@@ -0,0 +1,435 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "isa.h"
+#include "simdstr.h"
+
+// The copies by size class: up to 64 bytes with loads from both ends that
+// overlap in the middle, up to 4 vectors the same way, then a loop of 4
+// vectors to stores aligned to the cache lines, with the first line and the
+// last 4 vectors loaded up front. Every load of a class is done before its
+// first store, so that the small classes are also memmove. From
+// movsb_threshold bytes on the copies are one rep movsb, and from
+// nt_threshold bytes on the stores bypass the cache, the copy would only
+// evict the working set.
+static size_t movsb_threshold = SIZE_MAX;
+static size_t nt_threshold    = SIZE_MAX;
+
+void simdstr_copy_thresholds(size_t *movsb, size_t *nontemporal) {
+    *movsb = movsb_threshold;
+    *nontemporal = nt_threshold;
+}
+
+void simdstr_set_copy_thresholds(size_t movsb, size_t nontemporal) {
+    movsb_threshold = movsb;
+    nt_threshold = nontemporal;
+}
+
+static inline bool overlap(const char *dst, const char *src, size_t len) {
+    return (uintptr_t)dst - (uintptr_t)src < len || (uintptr_t)src - (uintptr_t)dst < len;
+}
+
+static inline void rep_movsb(char *dst, const char *src, size_t len) {
+    __asm__ volatile("rep movsb" : "+D"(dst), "+S"(src), "+c"(len) : : "memory");
+}
+
+// the fixed-size memcpy are single moves
+static inline void copy_le16(char *dst, const char *src, size_t len) {
+    if (len >= 8) {
+        uint64_t a, b;
+        memcpy(&a, src, 8);
+        memcpy(&b, src + len - 8, 8);
+        memcpy(dst, &a, 8);
+        memcpy(dst + len - 8, &b, 8);
+    } else if (len >= 4) {
+        uint32_t a, b;
+        memcpy(&a, src, 4);
+        memcpy(&b, src + len - 4, 4);
+        memcpy(dst, &a, 4);
+        memcpy(dst + len - 4, &b, 4);
+    } else if (len >= 2) {
+        uint16_t a, b;
+        memcpy(&a, src, 2);
+        memcpy(&b, src + len - 2, 2);
+        memcpy(dst, &a, 2);
+        memcpy(dst + len - 2, &b, 2);
+    } else if (len == 1) {
+        *dst = *src;
+    }
+}
+
+char* memcpy_naive(char *dst, const char *src, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        dst[i] = src[i];
+    }
+    return dst;
+}
+
+char* memmove_naive(char *dst, const char *src, size_t len) {
+    if (dst <= src) {
+        return memcpy_naive(dst, src, len);
+    }
+    for (size_t i = len; i > 0; i--) {
+        dst[i - 1] = src[i - 1];
+    }
+    return dst;
+}
+
+TARGET_SSE4_2
+static inline void copy_le64_sse(char *dst, const char *src, size_t len) {
+    if (len <= 16) {
+        copy_le16(dst, src, len);
+    } else if (len <= 32) {
+        __m128i a = _mm_loadu_si128((const __m128i *)src);
+        __m128i b = _mm_loadu_si128((const __m128i *)(src + len - 16));
+        _mm_storeu_si128((__m128i *)dst, a);
+        _mm_storeu_si128((__m128i *)(dst + len - 16), b);
+    } else {
+        __m128i a = _mm_loadu_si128((const __m128i *)src);
+        __m128i b = _mm_loadu_si128((const __m128i *)(src + 16));
+        __m128i c = _mm_loadu_si128((const __m128i *)(src + len - 32));
+        __m128i d = _mm_loadu_si128((const __m128i *)(src + len - 16));
+        _mm_storeu_si128((__m128i *)dst, a);
+        _mm_storeu_si128((__m128i *)(dst + 16), b);
+        _mm_storeu_si128((__m128i *)(dst + len - 32), c);
+        _mm_storeu_si128((__m128i *)(dst + len - 16), d);
+    }
+}
+
+// len > 64, dst below src or apart from it
+TARGET_SSE4_2
+static inline void copy_forward_sse(char *dst, const char *src, size_t len, bool nt) {
+    __m128i h0 = _mm_loadu_si128((const __m128i *)src);
+    __m128i h1 = _mm_loadu_si128((const __m128i *)(src + 16));
+    __m128i h2 = _mm_loadu_si128((const __m128i *)(src + 32));
+    __m128i h3 = _mm_loadu_si128((const __m128i *)(src + 48));
+    __m128i t0 = _mm_loadu_si128((const __m128i *)(src + len - 64));
+    __m128i t1 = _mm_loadu_si128((const __m128i *)(src + len - 48));
+    __m128i t2 = _mm_loadu_si128((const __m128i *)(src + len - 32));
+    __m128i t3 = _mm_loadu_si128((const __m128i *)(src + len - 16));
+    char       *end = dst + len;
+    size_t      skip = 64 - ((uintptr_t)dst & 63);
+    char       *p = dst + skip;
+    const char *q = src + skip;
+    for (; end - p > 64; p += 64, q += 64) {
+        __m128i a = _mm_loadu_si128((const __m128i *)q);
+        __m128i b = _mm_loadu_si128((const __m128i *)(q + 16));
+        __m128i c = _mm_loadu_si128((const __m128i *)(q + 32));
+        __m128i d = _mm_loadu_si128((const __m128i *)(q + 48));
+        if (nt) {
+            _mm_stream_si128((__m128i *)p, a);
+            _mm_stream_si128((__m128i *)(p + 16), b);
+            _mm_stream_si128((__m128i *)(p + 32), c);
+            _mm_stream_si128((__m128i *)(p + 48), d);
+        } else {
+            _mm_store_si128((__m128i *)p, a);
+            _mm_store_si128((__m128i *)(p + 16), b);
+            _mm_store_si128((__m128i *)(p + 32), c);
+            _mm_store_si128((__m128i *)(p + 48), d);
+        }
+    }
+    if (nt) {
+        _mm_sfence();
+    }
+    _mm_storeu_si128((__m128i *)dst, h0);
+    _mm_storeu_si128((__m128i *)(dst + 16), h1);
+    _mm_storeu_si128((__m128i *)(dst + 32), h2);
+    _mm_storeu_si128((__m128i *)(dst + 48), h3);
+    _mm_storeu_si128((__m128i *)(end - 64), t0);
+    _mm_storeu_si128((__m128i *)(end - 48), t1);
+    _mm_storeu_si128((__m128i *)(end - 32), t2);
+    _mm_storeu_si128((__m128i *)(end - 16), t3);
+}
+
+// len > 64, dst above src and overlapping it
+TARGET_SSE4_2
+static inline void copy_backward_sse(char *dst, const char *src, size_t len) {
+    __m128i tail = _mm_loadu_si128((const __m128i *)(src + len - 16));
+    __m128i h0 = _mm_loadu_si128((const __m128i *)src);
+    __m128i h1 = _mm_loadu_si128((const __m128i *)(src + 16));
+    __m128i h2 = _mm_loadu_si128((const __m128i *)(src + 32));
+    __m128i h3 = _mm_loadu_si128((const __m128i *)(src + 48));
+    char       *p = (char *)((uintptr_t)(dst + len) & ~(uintptr_t)15);
+    const char *q = src + (p - dst);
+    for (; p - dst > 64; p -= 64, q -= 64) {
+        __m128i a = _mm_loadu_si128((const __m128i *)(q - 64));
+        __m128i b = _mm_loadu_si128((const __m128i *)(q - 48));
+        __m128i c = _mm_loadu_si128((const __m128i *)(q - 32));
+        __m128i d = _mm_loadu_si128((const __m128i *)(q - 16));
+        _mm_store_si128((__m128i *)(p - 64), a);
+        _mm_store_si128((__m128i *)(p - 48), b);
+        _mm_store_si128((__m128i *)(p - 32), c);
+        _mm_store_si128((__m128i *)(p - 16), d);
+    }
+    _mm_storeu_si128((__m128i *)(dst + len - 16), tail);
+    _mm_storeu_si128((__m128i *)dst, h0);
+    _mm_storeu_si128((__m128i *)(dst + 16), h1);
+    _mm_storeu_si128((__m128i *)(dst + 32), h2);
+    _mm_storeu_si128((__m128i *)(dst + 48), h3);
+}
+
+TARGET_SSE4_2
+char* memcpy_sse(char *dst, const char *src, size_t len) {
+    if (len <= 64) {
+        copy_le64_sse(dst, src, len);
+    } else if (len >= movsb_threshold && len < nt_threshold) {
+        rep_movsb(dst, src, len);
+    } else {
+        copy_forward_sse(dst, src, len, len >= nt_threshold);
+    }
+    return dst;
+}
+
+TARGET_SSE4_2
+char* memmove_sse(char *dst, const char *src, size_t len) {
+    if (len <= 64 || !overlap(dst, src, len)) {
+        return memcpy_sse(dst, src, len);
+    }
+    if (dst < src) {
+        copy_forward_sse(dst, src, len, false);
+    } else if (dst > src) {
+        copy_backward_sse(dst, src, len);
+    }
+    return dst;
+}
+
+TARGET_AVX2
+static inline void copy_le64_avx2(char *dst, const char *src, size_t len) {
+    if (len <= 16) {
+        copy_le16(dst, src, len);
+    } else if (len <= 32) {
+        __m128i a = _mm_loadu_si128((const __m128i *)src);
+        __m128i b = _mm_loadu_si128((const __m128i *)(src + len - 16));
+        _mm_storeu_si128((__m128i *)dst, a);
+        _mm_storeu_si128((__m128i *)(dst + len - 16), b);
+    } else {
+        __m256i a = _mm256_loadu_si256((const __m256i *)src);
+        __m256i b = _mm256_loadu_si256((const __m256i *)(src + len - 32));
+        _mm256_storeu_si256((__m256i *)dst, a);
+        _mm256_storeu_si256((__m256i *)(dst + len - 32), b);
+    }
+}
+
+// 64 < len <= 128
+TARGET_AVX2
+static inline void copy_le128_avx2(char *dst, const char *src, size_t len) {
+    __m256i a = _mm256_loadu_si256((const __m256i *)src);
+    __m256i b = _mm256_loadu_si256((const __m256i *)(src + 32));
+    __m256i c = _mm256_loadu_si256((const __m256i *)(src + len - 64));
+    __m256i d = _mm256_loadu_si256((const __m256i *)(src + len - 32));
+    _mm256_storeu_si256((__m256i *)dst, a);
+    _mm256_storeu_si256((__m256i *)(dst + 32), b);
+    _mm256_storeu_si256((__m256i *)(dst + len - 64), c);
+    _mm256_storeu_si256((__m256i *)(dst + len - 32), d);
+}
+
+// len > 128, dst below src or apart from it
+TARGET_AVX2
+static inline void copy_forward_avx2(char *dst, const char *src, size_t len, bool nt) {
+    __m256i h0 = _mm256_loadu_si256((const __m256i *)src);
+    __m256i h1 = _mm256_loadu_si256((const __m256i *)(src + 32));
+    __m256i t0 = _mm256_loadu_si256((const __m256i *)(src + len - 128));
+    __m256i t1 = _mm256_loadu_si256((const __m256i *)(src + len - 96));
+    __m256i t2 = _mm256_loadu_si256((const __m256i *)(src + len - 64));
+    __m256i t3 = _mm256_loadu_si256((const __m256i *)(src + len - 32));
+    char       *end = dst + len;
+    size_t      skip = 64 - ((uintptr_t)dst & 63);
+    char       *p = dst + skip;
+    const char *q = src + skip;
+    for (; end - p > 128; p += 128, q += 128) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)q);
+        __m256i b = _mm256_loadu_si256((const __m256i *)(q + 32));
+        __m256i c = _mm256_loadu_si256((const __m256i *)(q + 64));
+        __m256i d = _mm256_loadu_si256((const __m256i *)(q + 96));
+        if (nt) {
+            _mm256_stream_si256((__m256i *)p, a);
+            _mm256_stream_si256((__m256i *)(p + 32), b);
+            _mm256_stream_si256((__m256i *)(p + 64), c);
+            _mm256_stream_si256((__m256i *)(p + 96), d);
+        } else {
+            _mm256_store_si256((__m256i *)p, a);
+            _mm256_store_si256((__m256i *)(p + 32), b);
+            _mm256_store_si256((__m256i *)(p + 64), c);
+            _mm256_store_si256((__m256i *)(p + 96), d);
+        }
+    }
+    if (nt) {
+        _mm_sfence();
+    }
+    _mm256_storeu_si256((__m256i *)dst, h0);
+    _mm256_storeu_si256((__m256i *)(dst + 32), h1);
+    _mm256_storeu_si256((__m256i *)(end - 128), t0);
+    _mm256_storeu_si256((__m256i *)(end - 96), t1);
+    _mm256_storeu_si256((__m256i *)(end - 64), t2);
+    _mm256_storeu_si256((__m256i *)(end - 32), t3);
+}
+
+// len > 128, dst above src and overlapping it
+TARGET_AVX2
+static inline void copy_backward_avx2(char *dst, const char *src, size_t len) {
+    __m256i tail = _mm256_loadu_si256((const __m256i *)(src + len - 32));
+    __m256i h0 = _mm256_loadu_si256((const __m256i *)src);
+    __m256i h1 = _mm256_loadu_si256((const __m256i *)(src + 32));
+    __m256i h2 = _mm256_loadu_si256((const __m256i *)(src + 64));
+    __m256i h3 = _mm256_loadu_si256((const __m256i *)(src + 96));
+    char       *p = (char *)((uintptr_t)(dst + len) & ~(uintptr_t)31);
+    const char *q = src + (p - dst);
+    for (; p - dst > 128; p -= 128, q -= 128) {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(q - 128));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(q - 96));
+        __m256i c = _mm256_loadu_si256((const __m256i *)(q - 64));
+        __m256i d = _mm256_loadu_si256((const __m256i *)(q - 32));
+        _mm256_store_si256((__m256i *)(p - 128), a);
+        _mm256_store_si256((__m256i *)(p - 96), b);
+        _mm256_store_si256((__m256i *)(p - 64), c);
+        _mm256_store_si256((__m256i *)(p - 32), d);
+    }
+    _mm256_storeu_si256((__m256i *)(dst + len - 32), tail);
+    _mm256_storeu_si256((__m256i *)dst, h0);
+    _mm256_storeu_si256((__m256i *)(dst + 32), h1);
+    _mm256_storeu_si256((__m256i *)(dst + 64), h2);
+    _mm256_storeu_si256((__m256i *)(dst + 96), h3);
+}
+
+TARGET_AVX2
+char* memcpy_avx2(char *dst, const char *src, size_t len) {
+    if (len <= 64) {
+        copy_le64_avx2(dst, src, len);
+    } else if (len <= 128) {
+        copy_le128_avx2(dst, src, len);
+    } else if (len >= movsb_threshold && len < nt_threshold) {
+        rep_movsb(dst, src, len);
+    } else {
+        copy_forward_avx2(dst, src, len, len >= nt_threshold);
+    }
+    return dst;
+}
+
+TARGET_AVX2
+char* memmove_avx2(char *dst, const char *src, size_t len) {
+    if (len <= 128 || !overlap(dst, src, len)) {
+        return memcpy_avx2(dst, src, len);
+    }
+    if (dst < src) {
+        copy_forward_avx2(dst, src, len, false);
+    } else if (dst > src) {
+        copy_backward_avx2(dst, src, len);
+    }
+    return dst;
+}
+
+// 64 < len <= 256, with the small classes of avx2 below
+TARGET_AVX512
+static inline void copy_le256_avx512(char *dst, const char *src, size_t len) {
+    if (len <= 128) {
+        __m512i a = _mm512_loadu_si512(src);
+        __m512i b = _mm512_loadu_si512(src + len - 64);
+        _mm512_storeu_si512(dst, a);
+        _mm512_storeu_si512(dst + len - 64, b);
+    } else {
+        __m512i a = _mm512_loadu_si512(src);
+        __m512i b = _mm512_loadu_si512(src + 64);
+        __m512i c = _mm512_loadu_si512(src + len - 128);
+        __m512i d = _mm512_loadu_si512(src + len - 64);
+        _mm512_storeu_si512(dst, a);
+        _mm512_storeu_si512(dst + 64, b);
+        _mm512_storeu_si512(dst + len - 128, c);
+        _mm512_storeu_si512(dst + len - 64, d);
+    }
+}
+
+// len > 256, dst below src or apart from it
+TARGET_AVX512
+static inline void copy_forward_avx512(char *dst, const char *src, size_t len, bool nt) {
+    __m512i head = _mm512_loadu_si512(src);
+    __m512i t0 = _mm512_loadu_si512(src + len - 256);
+    __m512i t1 = _mm512_loadu_si512(src + len - 192);
+    __m512i t2 = _mm512_loadu_si512(src + len - 128);
+    __m512i t3 = _mm512_loadu_si512(src + len - 64);
+    char       *end = dst + len;
+    size_t      skip = 64 - ((uintptr_t)dst & 63);
+    char       *p = dst + skip;
+    const char *q = src + skip;
+    for (; end - p > 256; p += 256, q += 256) {
+        __m512i a = _mm512_loadu_si512(q);
+        __m512i b = _mm512_loadu_si512(q + 64);
+        __m512i c = _mm512_loadu_si512(q + 128);
+        __m512i d = _mm512_loadu_si512(q + 192);
+        if (nt) {
+            _mm512_stream_si512((__m512i *)p, a);
+            _mm512_stream_si512((__m512i *)(p + 64), b);
+            _mm512_stream_si512((__m512i *)(p + 128), c);
+            _mm512_stream_si512((__m512i *)(p + 192), d);
+        } else {
+            _mm512_store_si512(p, a);
+            _mm512_store_si512(p + 64, b);
+            _mm512_store_si512(p + 128, c);
+            _mm512_store_si512(p + 192, d);
+        }
+    }
+    if (nt) {
+        _mm_sfence();
+    }
+    _mm512_storeu_si512(dst, head);
+    _mm512_storeu_si512(end - 256, t0);
+    _mm512_storeu_si512(end - 192, t1);
+    _mm512_storeu_si512(end - 128, t2);
+    _mm512_storeu_si512(end - 64, t3);
+}
+
+// len > 256, dst above src and overlapping it
+TARGET_AVX512
+static inline void copy_backward_avx512(char *dst, const char *src, size_t len) {
+    __m512i tail = _mm512_loadu_si512(src + len - 64);
+    __m512i h0 = _mm512_loadu_si512(src);
+    __m512i h1 = _mm512_loadu_si512(src + 64);
+    __m512i h2 = _mm512_loadu_si512(src + 128);
+    __m512i h3 = _mm512_loadu_si512(src + 192);
+    char       *p = (char *)((uintptr_t)(dst + len) & ~(uintptr_t)63);
+    const char *q = src + (p - dst);
+    for (; p - dst > 256; p -= 256, q -= 256) {
+        __m512i a = _mm512_loadu_si512(q - 256);
+        __m512i b = _mm512_loadu_si512(q - 192);
+        __m512i c = _mm512_loadu_si512(q - 128);
+        __m512i d = _mm512_loadu_si512(q - 64);
+        _mm512_store_si512(p - 256, a);
+        _mm512_store_si512(p - 192, b);
+        _mm512_store_si512(p - 128, c);
+        _mm512_store_si512(p - 64, d);
+    }
+    _mm512_storeu_si512(dst + len - 64, tail);
+    _mm512_storeu_si512(dst, h0);
+    _mm512_storeu_si512(dst + 64, h1);
+    _mm512_storeu_si512(dst + 128, h2);
+    _mm512_storeu_si512(dst + 192, h3);
+}
+
+TARGET_AVX512
+char* memcpy_avx512(char *dst, const char *src, size_t len) {
+    if (len <= 64) {
+        copy_le64_avx2(dst, src, len);
+    } else if (len <= 256) {
+        copy_le256_avx512(dst, src, len);
+    } else if (len >= movsb_threshold && len < nt_threshold) {
+        rep_movsb(dst, src, len);
+    } else {
+        copy_forward_avx512(dst, src, len, len >= nt_threshold);
+    }
+    return dst;
+}
+
+TARGET_AVX512
+char* memmove_avx512(char *dst, const char *src, size_t len) {
+    if (len <= 256 || !overlap(dst, src, len)) {
+        return memcpy_avx512(dst, src, len);
+    }
+    if (dst < src) {
+        copy_forward_avx512(dst, src, len, false);
+    } else if (dst > src) {
+        copy_backward_avx512(dst, src, len);
+    }
+    return dst;
+}
@@ -1,3 +1,4 @@
+#include <math.h>
 #include <stdbool.h>
 #include <stddef.h>
 
@@ -11,11 +12,65 @@ float sum_naive(const float *arr, size_t len) {
     return sum;
 }
 
+float dot_naive(const float *a, const float *b, size_t len) {
+    float sum = 0.0;
+    for (size_t i = 0; i < len; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+// Return the minimum of vec, NaNs are skipped. INFINITY for an empty vec.
+float min_naive(const float *vec, size_t len) {
+    float min = INFINITY;
+    for (size_t i = 0; i < len; i++) {
+        if (vec[i] < min) min = vec[i];
+    }
+    return min;
+}
+
+// Return the maximum of vec, NaNs are skipped. -INFINITY for an empty vec.
+float max_naive(const float *vec, size_t len) {
+    float max = -INFINITY;
+    for (size_t i = 0; i < len; i++) {
+        if (vec[i] > max) max = vec[i];
+    }
+    return max;
+}
+
 bool memcmpeq_naive(const char *s1, const char *s2, size_t len) {
     while (len > 0 && *s1++ == *s2++) len--;
     return len == 0;
 }
 
+// Return the index of the first differing byte, or len if s1 equals s2.
+size_t mismatch_naive(const char *s1, const char *s2, size_t len) {
+    size_t i = 0;
+    while (i < len && s1[i] == s2[i]) i++;
+    return i;
+}
+
+// Compare the unsigned bytes like memcmp, return <0, 0 or >0.
+int memcmp3_naive(const char *s1, const char *s2, size_t len) {
+    size_t i = mismatch_naive(s1, s2, len);
+    if (i == len) {
+        return 0;
+    }
+    return (unsigned char)s1[i] - (unsigned char)s2[i];
+}
+
+// Compare like memcmpeq with the ASCII letters of both sides in lower case.
+bool memcaseeq_naive(const char *s1, const char *s2, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        char c1 = (s1[i] >= 'A' && s1[i] <= 'Z') ? s1[i] + 32 : s1[i];
+        char c2 = (s2[i] >= 'A' && s2[i] <= 'Z') ? s2[i] + 32 : s2[i];
+        if (c1 != c2) {
+            return false;
+        }
+    }
+    return true;
+}
+
 // Convert src to lower case and copy to dst, src is a ASCII string.
 char* tolower_naive(char *dst, const char *src, size_t len) {
     for (size_t i = 0; i < len; i++) {
@@ -25,6 +80,15 @@ char* tolower_naive(char *dst, const char *src, size_t len) {
     return dst;
 }
 
+// Convert src to upper case and copy to dst, src is a ASCII string.
+char* toupper_naive(char *dst, const char *src, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        bool is_lower = (src[i] >= 'a' && src[i] <= 'z');
+        dst[i] =  is_lower ? src[i] - 32 : src[i];
+    }
+    return dst;
+}
+
 // Remove whitespaces from src and copy to dst. Whitespace is defined as ' ', '\t', '\r', '\n'.
 // return the length of dst.
 int compact_naive(char *dst, const char *src, size_t len) {
@@ -87,7 +151,7 @@ char* strstr_naive(const char *str, size_t n, const char *substr, size_t sn) {
     if (sn == 0 || sn > n) {
         return (char*)str;
     }
-    for (size_t i = 0; i < n; i++) {
+    for (size_t i = 0; i + sn <= n; i++) {
         if (str[i] == substr[0]) {
             bool is_match = true;
             for (size_t j = 1; j < sn; j++) {
@@ -103,3 +167,16 @@ char* strstr_naive(const char *str, size_t n, const char *substr, size_t sn) {
     }
     return NULL;
 }
+
+// strstr_naive with the ASCII case ignored.
+char* strcasestr_naive(const char *str, size_t n, const char *substr, size_t sn) {
+    if (sn == 0 || sn > n) {
+        return (char*)str;
+    }
+    for (size_t i = 0; i + sn <= n; i++) {
+        if (memcaseeq_naive(str + i, substr, sn)) {
+            return (char*)str + i;
+        }
+    }
+    return NULL;
+}
@@ -0,0 +1,127 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "reduce.h"
+#include "simdstr.h"
+
+// The chunks fit in L2, so a thread streams one chunk through its own cache
+// while the others load theirs.
+#define CHUNK_BYTES (256 * 1024)
+
+#ifdef _OPENMP
+static int threads_of(int nthreads) {
+    return nthreads > 0 ? nthreads : omp_get_max_threads();
+}
+#endif
+
+// The OpenMP runtime keeps its threads parked between the parallel regions,
+// so the pool is created on the first call only.
+bool memcmpeq_parallel(const char *s1, const char *s2, size_t len, int nthreads) {
+#ifdef _OPENMP
+    if (len < SIMDSTR_PARALLEL_MIN || nthreads == 1) {
+        return simdstr_memcmpeq(s1, s2, len);
+    }
+    long nchunks = (long)((len + CHUNK_BYTES - 1) / CHUNK_BYTES);
+    // cleared by the first mismatching chunk, the chunks after it are skipped
+    int equal = 1;
+    #pragma omp parallel for schedule(dynamic, 1) num_threads(threads_of(nthreads))
+    for (long i = 0; i < nchunks; i++) {
+        int still;
+        #pragma omp atomic read
+        still = equal;
+        if (!still) {
+            continue;
+        }
+        size_t offset = (size_t)i * CHUNK_BYTES;
+        size_t n = len - offset < CHUNK_BYTES ? len - offset : CHUNK_BYTES;
+        if (!simdstr_memcmpeq(s1 + offset, s2 + offset, n)) {
+            #pragma omp atomic write
+            equal = 0;
+        }
+    }
+    return equal;
+#else
+    (void)nthreads;
+    return simdstr_memcmpeq(s1, s2, len);
+#endif
+}
+
+// The chunk sums are added in chunk order, the result does not depend on the
+// number of threads.
+float sum_parallel(const float *vec, size_t len, int nthreads) {
+    const size_t chunk = CHUNK_BYTES / sizeof(float);
+    long nchunks = (long)((len + chunk - 1) / chunk);
+    float *sums = NULL;
+    if (len * sizeof(float) < SIMDSTR_PARALLEL_MIN
+        || (sums = malloc(nchunks * sizeof(float))) == NULL) {
+        return simdstr_sum(vec, len);
+    }
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(threads_of(nthreads))
+#else
+    (void)nthreads;
+#endif
+    for (long i = 0; i < nchunks; i++) {
+        size_t offset = (size_t)i * chunk;
+        size_t n = len - offset < chunk ? len - offset : chunk;
+        sums[i] = simdstr_sum(vec + offset, n);
+    }
+    float ret = 0.0;
+    for (long i = 0; i < nchunks; i++) {
+        ret += sums[i];
+    }
+    free(sums);
+    return ret;
+}
+
+// The chunks are the blocks of the reproducible mode, and their results are
+// added in order in double for every mode.
+float reduce_sum_parallel(const float *vec, size_t len, simdstr_reduce_t mode, int nthreads) {
+    const size_t chunk = SIMDSTR_REDUCE_BLOCK;
+    long nchunks = (long)((len + chunk - 1) / chunk);
+    double *sums = NULL;
+    if (len * sizeof(float) < SIMDSTR_PARALLEL_MIN
+        || (sums = malloc(nchunks * sizeof(double))) == NULL) {
+        return simdstr_reduce_sum(vec, len, mode);
+    }
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) num_threads(threads_of(nthreads))
+#else
+    (void)nthreads;
+#endif
+    for (long i = 0; i < nchunks; i++) {
+        size_t offset = (size_t)i * chunk;
+        size_t n = len - offset < chunk ? len - offset : chunk;
+        sums[i] = mode == SIMDSTR_REDUCE_REPRODUCIBLE ? simdstr_sum_repro_block(vec + offset, n)
+            : simdstr_reduce_sum(vec + offset, n, mode);
+    }
+    double ret = 0.0;
+    for (long i = 0; i < nchunks; i++) {
+        ret += sums[i];
+    }
+    free(sums);
+    return (float)ret;
+}
+
+// over the chunks of memcmpeq_parallel
+size_t count_byte_parallel(const char *s, int c, size_t len, int nthreads) {
+    long nchunks = (long)((len + CHUNK_BYTES - 1) / CHUNK_BYTES);
+    size_t n = 0;
+    if (len < SIMDSTR_PARALLEL_MIN) {
+        return simdstr_count_byte(s, c, len);
+    }
+#ifdef _OPENMP
+    #pragma omp parallel for schedule(static) reduction(+:n) num_threads(threads_of(nthreads))
+#else
+    (void)nthreads;
+#endif
+    for (long i = 0; i < nchunks; i++) {
+        size_t offset = (size_t)i * CHUNK_BYTES;
+        n += simdstr_count_byte(s + offset, c, len - offset < CHUNK_BYTES ? len - offset : CHUNK_BYTES);
+    }
+    return n;
+}
@@ -0,0 +1,363 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "isa.h"
+#include "simdstr.h"
+
+// Quote and unquote. The SIMD kernels store every block to dst before they
+// look at it, a block without escape sites is then done, and a block with
+// one is done up to it: the escape is handled in scalar and the scan goes on
+// from the byte after it. The stores never pass the end of dst: unquote
+// never grows a string and quote grows it by its escapes only.
+
+// one bit test for both, a branch on each mispredicts on mixed escapes
+static inline bool quote_or_backslash(char c) {
+    uint8_t d = (uint8_t)(c - '"');
+    return d < 64 && (1ull << d & (1ull | 1ull << ('\\' - '"'))) != 0;
+}
+
+static inline int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// the 4 hex digits at p, -1 if one is not a digit
+static inline int32_t hex4(const char *p) {
+    int32_t v = 0;
+    for (int i = 0; i < 4; i++) {
+        int d = hex_value(p[i]);
+        if (d < 0) return -1;
+        v = v << 4 | d;
+    }
+    return v;
+}
+
+static inline char* put_utf8(char *out, uint32_t cp) {
+    if (cp < 0x80) {
+        *out++ = (char)cp;
+    } else if (cp < 0x800) {
+        *out++ = (char)(0xC0 | cp >> 6);
+        *out++ = (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        *out++ = (char)(0xE0 | cp >> 12);
+        *out++ = (char)(0x80 | (cp >> 6 & 0x3F));
+        *out++ = (char)(0x80 | (cp & 0x3F));
+    } else {
+        *out++ = (char)(0xF0 | cp >> 18);
+        *out++ = (char)(0x80 | (cp >> 12 & 0x3F));
+        *out++ = (char)(0x80 | (cp >> 6 & 0x3F));
+        *out++ = (char)(0x80 | (cp & 0x3F));
+    }
+    return out;
+}
+
+// The escape at *p, a backslash: its byte or code point goes to *out and *p
+// moves past it. Return false for an invalid or truncated escape.
+static inline bool unescape(const char **p, const char *end, char **out, simdstr_escape_t mode) {
+    const char *s = *p;
+    if (end - s < 2) {
+        return false;
+    }
+    char c = s[1];
+    if (quote_or_backslash(c)) {
+        *(*out)++ = c;
+        *p = s + 2;
+        return true;
+    }
+    if (mode != SIMDSTR_ESCAPE_JSON) {
+        return false;
+    }
+    switch (c) {
+    case '/': c = '/';  break;
+    case 'b': c = '\b'; break;
+    case 'f': c = '\f'; break;
+    case 'n': c = '\n'; break;
+    case 'r': c = '\r'; break;
+    case 't': c = '\t'; break;
+    case 'u': {
+        int32_t cp = end - s >= 6 ? hex4(s + 2) : -1;
+        if (cp < 0 || (cp >= 0xDC00 && cp < 0xE000)) {
+            return false;
+        }
+        s += 6;
+        if (cp >= 0xD800 && cp < 0xDC00) {
+            // the high surrogate of a pair, the low one follows
+            int32_t lo = end - s >= 6 && s[0] == '\\' && s[1] == 'u' ? hex4(s + 2) : -1;
+            if (lo < 0xDC00 || lo >= 0xE000) {
+                return false;
+            }
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+            s += 6;
+        }
+        *out = put_utf8(*out, (uint32_t)cp);
+        *p = s;
+        return true;
+    }
+    default:
+        return false;
+    }
+    *(*out)++ = c;
+    *p = s + 2;
+    return true;
+}
+
+// the byte loop from p to the closing quote
+static inline int64_t unquote_bytes(char *dst, char *out, const char *p, const char *end,
+                                    simdstr_escape_t mode) {
+    while (p < end) {
+        if (*p == '"') {
+            return out - dst;
+        }
+        if (*p == '\\') {
+            if (!unescape(&p, end, &out, mode)) return -1;
+        } else {
+            *out++ = *p++;
+        }
+    }
+    return -1;
+}
+
+int64_t unquote_naive(char *dst, const char *src, size_t len, simdstr_escape_t mode) {
+    if (len == 0 || src[0] != '"') {
+        return -1;
+    }
+    return unquote_bytes(dst, dst, src + 1, src + len, mode);
+}
+
+// the escape of c into out, return its end
+static inline char* escape(char *out, char c, simdstr_escape_t mode) {
+    static const char hex[] = "0123456789abcdef";
+    if (quote_or_backslash(c)) {
+        out[0] = '\\';
+        out[1] = c;
+        return out + 2;
+    }
+    if (mode != SIMDSTR_ESCAPE_JSON || (uint8_t)c >= 0x20) {
+        *out = c;
+        return out + 1;
+    }
+    char e = 0;
+    switch (c) {
+    case '\b': e = 'b'; break;
+    case '\f': e = 'f'; break;
+    case '\n': e = 'n'; break;
+    case '\r': e = 'r'; break;
+    case '\t': e = 't'; break;
+    }
+    if (e != 0) {
+        out[0] = '\\';
+        out[1] = e;
+        return out + 2;
+    }
+    memcpy(out, "\\u00", 4);
+    out[4] = hex[c >> 4];
+    out[5] = hex[c & 15];
+    return out + 6;
+}
+
+static inline char* quote_bytes(char *out, const char *p, const char *end, simdstr_escape_t mode) {
+    while (p < end) {
+        out = escape(out, *p++, mode);
+    }
+    *out++ = '"';
+    return out;
+}
+
+size_t quote_naive(char *dst, const char *src, size_t len, simdstr_escape_t mode) {
+    dst[0] = '"';
+    return quote_bytes(dst + 1, src, src + len, mode) - dst;
+}
+
+// The escape sites of a block: the backslashes and the quotes, and for quote
+// with SIMDSTR_ESCAPE_JSON the control bytes too.
+TARGET_SSE4_2
+static inline uint32_t escapes_sse(__m128i x, bool controls) {
+    __m128i m = _mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8('\\')), _mm_cmpeq_epi8(x, _mm_set1_epi8('"')));
+    if (controls) {
+        m = _mm_or_si128(m, _mm_cmpeq_epi8(_mm_min_epu8(x, _mm_set1_epi8(0x1F)), x));
+    }
+    return (uint32_t)_mm_movemask_epi8(m);
+}
+
+TARGET_SSE4_2
+static inline int64_t unquote_blocks_sse(char *dst, char *out, const char *p, const char *end,
+                                         simdstr_escape_t mode) {
+    while (end - p >= 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)p);
+        _mm_storeu_si128((__m128i *)out, x);
+        uint32_t m = escapes_sse(x, false);
+        if (m == 0) {
+            p += 16;
+            out += 16;
+            continue;
+        }
+        p += __builtin_ctz(m);
+        out += __builtin_ctz(m);
+        if (*p == '"') {
+            return out - dst;
+        }
+        if (!unescape(&p, end, &out, mode)) {
+            return -1;
+        }
+    }
+    return unquote_bytes(dst, out, p, end, mode);
+}
+
+TARGET_SSE4_2
+int64_t unquote_sse(char *dst, const char *src, size_t len, simdstr_escape_t mode) {
+    if (len == 0 || src[0] != '"') {
+        return -1;
+    }
+    return unquote_blocks_sse(dst, dst, src + 1, src + len, mode);
+}
+
+TARGET_SSE4_2
+static inline char* quote_blocks_sse(char *out, const char *p, const char *end, simdstr_escape_t mode) {
+    bool json = mode == SIMDSTR_ESCAPE_JSON;
+    while (end - p >= 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)p);
+        _mm_storeu_si128((__m128i *)out, x);
+        uint32_t m = escapes_sse(x, json);
+        if (m == 0) {
+            p += 16;
+            out += 16;
+            continue;
+        }
+        p += __builtin_ctz(m);
+        out = escape(out + __builtin_ctz(m), *p++, mode);
+    }
+    return quote_bytes(out, p, end, mode);
+}
+
+TARGET_SSE4_2
+size_t quote_sse(char *dst, const char *src, size_t len, simdstr_escape_t mode) {
+    dst[0] = '"';
+    return quote_blocks_sse(dst + 1, src, src + len, mode) - dst;
+}
+
+TARGET_AVX2
+static inline uint32_t escapes_avx2(__m256i x, bool controls) {
+    __m256i m = _mm256_or_si256(_mm256_cmpeq_epi8(x, _mm256_set1_epi8('\\')),
+                                _mm256_cmpeq_epi8(x, _mm256_set1_epi8('"')));
+    if (controls) {
+        m = _mm256_or_si256(m, _mm256_cmpeq_epi8(_mm256_min_epu8(x, _mm256_set1_epi8(0x1F)), x));
+    }
+    return (uint32_t)_mm256_movemask_epi8(m);
+}
+
+// the bytes after the last 32-byte block go through the SSE blocks
+TARGET_AVX2
+int64_t unquote_avx2(char *dst, const char *src, size_t len, simdstr_escape_t mode) {
+    if (len == 0 || src[0] != '"') {
+        return -1;
+    }
+    const char *p = src + 1, *end = src + len;
+    char *out = dst;
+    while (end - p >= 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)p);
+        _mm256_storeu_si256((__m256i *)out, x);
+        uint32_t m = escapes_avx2(x, false);
+        if (m == 0) {
+            p += 32;
+            out += 32;
+            continue;
+        }
+        p += _tzcnt_u32(m);
+        out += _tzcnt_u32(m);
+        if (*p == '"') {
+            return out - dst;
+        }
+        if (!unescape(&p, end, &out, mode)) {
+            return -1;
+        }
+    }
+    return unquote_blocks_sse(dst, out, p, end, mode);
+}
+
+TARGET_AVX2
+size_t quote_avx2(char *dst, const char *src, size_t len, simdstr_escape_t mode) {
+    bool json = mode == SIMDSTR_ESCAPE_JSON;
+    const char *p = src, *end = src + len;
+    char *out = dst;
+    *out++ = '"';
+    while (end - p >= 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)p);
+        _mm256_storeu_si256((__m256i *)out, x);
+        uint32_t m = escapes_avx2(x, json);
+        if (m == 0) {
+            p += 32;
+            out += 32;
+            continue;
+        }
+        p += _tzcnt_u32(m);
+        out = escape(out + _tzcnt_u32(m), *p++, mode);
+    }
+    return quote_blocks_sse(out, p, end, mode) - dst;
+}
+
+TARGET_AVX512
+static inline uint64_t escapes_avx512(__m512i x, bool controls) {
+    uint64_t m = _mm512_cmpeq_epi8_mask(x, _mm512_set1_epi8('\\')) | _mm512_cmpeq_epi8_mask(x, _mm512_set1_epi8('"'));
+    if (controls) {
+        m |= _mm512_cmple_epu8_mask(x, _mm512_set1_epi8(0x1F));
+    }
+    return m;
+}
+
+// the tail is a masked block, loaded and stored to len only
+TARGET_AVX512
+int64_t unquote_avx512(char *dst, const char *src, size_t len, simdstr_escape_t mode) {
+    if (len == 0 || src[0] != '"') {
+        return -1;
+    }
+    const char *p = src + 1, *end = src + len;
+    char *out = dst;
+    while (p < end) {
+        __mmask64 k = end - p >= 64 ? ~0ull : _bzhi_u64(~0ull, end - p);
+        __m512i   x = _mm512_maskz_loadu_epi8(k, p);
+        _mm512_mask_storeu_epi8(out, k, x);
+        uint64_t m = escapes_avx512(x, false) & k;
+        if (m == 0) {
+            p += _mm_popcnt_u64(k);
+            out += _mm_popcnt_u64(k);
+            continue;
+        }
+        p += _tzcnt_u64(m);
+        out += _tzcnt_u64(m);
+        if (*p == '"') {
+            return out - dst;
+        }
+        if (!unescape(&p, end, &out, mode)) {
+            return -1;
+        }
+    }
+    return -1;
+}
+
+TARGET_AVX512
+size_t quote_avx512(char *dst, const char *src, size_t len, simdstr_escape_t mode) {
+    bool json = mode == SIMDSTR_ESCAPE_JSON;
+    const char *p = src, *end = src + len;
+    char *out = dst;
+    *out++ = '"';
+    while (p < end) {
+        __mmask64 k = end - p >= 64 ? ~0ull : _bzhi_u64(~0ull, end - p);
+        __m512i   x = _mm512_maskz_loadu_epi8(k, p);
+        _mm512_mask_storeu_epi8(out, k, x);
+        uint64_t m = escapes_avx512(x, json) & k;
+        if (m == 0) {
+            p += _mm_popcnt_u64(k);
+            out += _mm_popcnt_u64(k);
+            continue;
+        }
+        p += _tzcnt_u64(m);
+        out = escape(out + _tzcnt_u64(m), *p++, mode);
+    }
+    *out++ = '"';
+    return out - dst;
+}
@@ -0,0 +1,737 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "isa.h"
+#include "naivestr.h"
+#include "reduce.h"
+#include "simdstr.h"
+#include "tail.h"
+
+// The float reductions of simdstr_reduce_t. This file is built with
+// -ffp-contract=off: the compensated and reproducible kernels rely on every
+// addition being rounded as written, FMA is only used where it is spelled out.
+
+// TwoSum: s + *err == a + b exactly, without the branch of Neumaier.
+static inline float two_sum(float a, float b, float *err) {
+    float s  = a + b;
+    float bp = s - a;
+    *err = (a - (s - bp)) + (b - bp);
+    return s;
+}
+
+// TwoProduct through double: the product of two floats is exact in a double,
+// and so is its rounding error.
+static inline float two_prod(float a, float b, float *err) {
+    double p = (double)a * b;
+    float  r = (float)p;
+    *err = (float)(p - r);
+    return r;
+}
+
+// add the compensated lanes in double
+static inline float kahan_finish(const float *s, const float *c, int n) {
+    double total = 0.0;
+    for (int i = 0; i < n; i++) {
+        total += (double)s[i] + c[i];
+    }
+    return (float)total;
+}
+
+// The fixed pairwise tree of the 16 reproducible lanes.
+#define REPRO_LANES 16
+
+static inline double repro_tree(double *lane) {
+    for (int w = REPRO_LANES / 2; w > 0; w /= 2) {
+        for (int i = 0; i < w; i++) {
+            lane[i] += lane[i + w];
+        }
+    }
+    return lane[0];
+}
+
+float sum_repro_blocks(sum_block_t block, const float *vec, size_t len) {
+    double total = 0.0;
+    for (size_t i = 0; i < len; i += SIMDSTR_REDUCE_BLOCK) {
+        size_t n = len - i < SIMDSTR_REDUCE_BLOCK ? len - i : SIMDSTR_REDUCE_BLOCK;
+        total += block(vec + i, n);
+    }
+    return (float)total;
+}
+
+float dot_repro_blocks(dot_block_t block, const float *a, const float *b, size_t len) {
+    double total = 0.0;
+    for (size_t i = 0; i < len; i += SIMDSTR_REDUCE_BLOCK) {
+        size_t n = len - i < SIMDSTR_REDUCE_BLOCK ? len - i : SIMDSTR_REDUCE_BLOCK;
+        total += block(a + i, b + i, n);
+    }
+    return (float)total;
+}
+
+// The scalar kernels of the naive level, the reference of the SIMD ones.
+
+float sum_kahan_naive(const float *vec, size_t len) {
+    float s = 0.0, c = 0.0, e;
+    for (size_t i = 0; i < len; i++) {
+        s = two_sum(s, vec[i], &e);
+        c += e;
+    }
+    return kahan_finish(&s, &c, 1);
+}
+
+float dot_kahan_naive(const float *a, const float *b, size_t len) {
+    float s = 0.0, c = 0.0, e, pe;
+    for (size_t i = 0; i < len; i++) {
+        float p = two_prod(a[i], b[i], &pe);
+        s = two_sum(s, p, &e);
+        c += e + pe;
+    }
+    return kahan_finish(&s, &c, 1);
+}
+
+double sum_repro_block_naive(const float *vec, size_t len) {
+    double lane[REPRO_LANES] = {0};
+    for (size_t i = 0; i < len; i++) {
+        lane[i % REPRO_LANES] += vec[i];
+    }
+    return repro_tree(lane);
+}
+
+double dot_repro_block_naive(const float *a, const float *b, size_t len) {
+    double lane[REPRO_LANES] = {0};
+    for (size_t i = 0; i < len; i++) {
+        lane[i % REPRO_LANES] += (double)a[i] * b[i];
+    }
+    return repro_tree(lane);
+}
+
+float sum_repro_naive(const float *vec, size_t len) {
+    return sum_repro_blocks(sum_repro_block_naive, vec, len);
+}
+
+float dot_repro_naive(const float *a, const float *b, size_t len) {
+    return dot_repro_blocks(dot_repro_block_naive, a, b, len);
+}
+
+// SSE: the tails are loaded padded by load_tail_ps.
+
+static inline float hsum_sse(__m128 x) {
+    x = _mm_add_ps(x, _mm_movehl_ps(x, x));
+    x = _mm_add_ss(x, _mm_shuffle_ps(x, x, 1));
+    return _mm_cvtss_f32(x);
+}
+
+static inline void two_sum_sse(__m128 *s, __m128 *c, __m128 x) {
+    __m128 t  = _mm_add_ps(*s, x);
+    __m128 bp = _mm_sub_ps(t, *s);
+    __m128 e  = _mm_add_ps(_mm_sub_ps(*s, _mm_sub_ps(t, bp)), _mm_sub_ps(x, bp));
+    *c = _mm_add_ps(*c, e);
+    *s = t;
+}
+
+// TwoProduct of 4 lanes in two double halves
+static inline __m128 two_prod_sse(__m128 a, __m128 b, __m128 *err) {
+    __m128d lo = _mm_mul_pd(_mm_cvtps_pd(a), _mm_cvtps_pd(b));
+    __m128d hi = _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(a, a)), _mm_cvtps_pd(_mm_movehl_ps(b, b)));
+    __m128  p  = _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+    __m128d elo = _mm_sub_pd(lo, _mm_cvtps_pd(p));
+    __m128d ehi = _mm_sub_pd(hi, _mm_cvtps_pd(_mm_movehl_ps(p, p)));
+    *err = _mm_movelh_ps(_mm_cvtpd_ps(elo), _mm_cvtpd_ps(ehi));
+    return p;
+}
+
+float sum_fast_sse(const float *vec, size_t len) {
+    __m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps();
+    __m128 s2 = _mm_setzero_ps(), s3 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        s0 = _mm_add_ps(s0, _mm_loadu_ps(vec + i));
+        s1 = _mm_add_ps(s1, _mm_loadu_ps(vec + i + 4));
+        s2 = _mm_add_ps(s2, _mm_loadu_ps(vec + i + 8));
+        s3 = _mm_add_ps(s3, _mm_loadu_ps(vec + i + 12));
+    }
+    for (; i + 4 <= len; i += 4) {
+        s0 = _mm_add_ps(s0, _mm_loadu_ps(vec + i));
+    }
+    s0 = _mm_add_ps(s0, load_tail_ps(vec + i, len - i, 0.0f));
+    return hsum_sse(_mm_add_ps(_mm_add_ps(s0, s1), _mm_add_ps(s2, s3)));
+}
+
+float dot_fast_sse(const float *a, const float *b, size_t len) {
+    __m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps();
+    __m128 s2 = _mm_setzero_ps(), s3 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(a + i),      _mm_loadu_ps(b + i)));
+        s1 = _mm_add_ps(s1, _mm_mul_ps(_mm_loadu_ps(a + i + 4),  _mm_loadu_ps(b + i + 4)));
+        s2 = _mm_add_ps(s2, _mm_mul_ps(_mm_loadu_ps(a + i + 8),  _mm_loadu_ps(b + i + 8)));
+        s3 = _mm_add_ps(s3, _mm_mul_ps(_mm_loadu_ps(a + i + 12), _mm_loadu_ps(b + i + 12)));
+    }
+    for (; i + 4 <= len; i += 4) {
+        s0 = _mm_add_ps(s0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    __m128 ta = load_tail_ps(a + i, len - i, 0.0f);
+    __m128 tb = load_tail_ps(b + i, len - i, 0.0f);
+    s0 = _mm_add_ps(s0, _mm_mul_ps(ta, tb));
+    return hsum_sse(_mm_add_ps(_mm_add_ps(s0, s1), _mm_add_ps(s2, s3)));
+}
+
+float sum_kahan_sse(const float *vec, size_t len) {
+    __m128 s0 = _mm_setzero_ps(), c0 = _mm_setzero_ps();
+    __m128 s1 = _mm_setzero_ps(), c1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        two_sum_sse(&s0, &c0, _mm_loadu_ps(vec + i));
+        two_sum_sse(&s1, &c1, _mm_loadu_ps(vec + i + 4));
+    }
+    for (; i + 4 <= len; i += 4) {
+        two_sum_sse(&s0, &c0, _mm_loadu_ps(vec + i));
+    }
+    two_sum_sse(&s1, &c1, load_tail_ps(vec + i, len - i, 0.0f));
+    float s[8], c[8];
+    _mm_storeu_ps(s, s0), _mm_storeu_ps(s + 4, s1);
+    _mm_storeu_ps(c, c0), _mm_storeu_ps(c + 4, c1);
+    return kahan_finish(s, c, 8);
+}
+
+float dot_kahan_sse(const float *a, const float *b, size_t len) {
+    __m128 s = _mm_setzero_ps(), c = _mm_setzero_ps(), pe;
+    size_t i = 0;
+    for (; i + 4 <= len; i += 4) {
+        __m128 p = two_prod_sse(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i), &pe);
+        two_sum_sse(&s, &c, p);
+        c = _mm_add_ps(c, pe);
+    }
+    __m128 ta = load_tail_ps(a + i, len - i, 0.0f);
+    __m128 tb = load_tail_ps(b + i, len - i, 0.0f);
+    __m128 p  = two_prod_sse(ta, tb, &pe);
+    two_sum_sse(&s, &c, p);
+    c = _mm_add_ps(c, pe);
+    float sv[4], cv[4];
+    _mm_storeu_ps(sv, s);
+    _mm_storeu_ps(cv, c);
+    return kahan_finish(sv, cv, 4);
+}
+
+// the 16 lanes are 8 pairs of doubles, lane 2j and 2j+1 in acc[j]
+static inline void repro_sum16_sse(__m128d *acc, const float *p) {
+    for (int j = 0; j < 4; j++) {
+        __m128 x = _mm_loadu_ps(p + 4 * j);
+        acc[2 * j]     = _mm_add_pd(acc[2 * j],     _mm_cvtps_pd(x));
+        acc[2 * j + 1] = _mm_add_pd(acc[2 * j + 1], _mm_cvtps_pd(_mm_movehl_ps(x, x)));
+    }
+}
+
+static inline void repro_dot16_sse(__m128d *acc, const float *a, const float *b) {
+    for (int j = 0; j < 4; j++) {
+        __m128 x = _mm_loadu_ps(a + 4 * j);
+        __m128 y = _mm_loadu_ps(b + 4 * j);
+        acc[2 * j]     = _mm_add_pd(acc[2 * j], _mm_mul_pd(_mm_cvtps_pd(x), _mm_cvtps_pd(y)));
+        acc[2 * j + 1] = _mm_add_pd(acc[2 * j + 1],
+            _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(x, x)), _mm_cvtps_pd(_mm_movehl_ps(y, y))));
+    }
+}
+
+static inline double repro_finish_sse(const __m128d *acc) {
+    double lane[REPRO_LANES];
+    for (int j = 0; j < 8; j++) {
+        _mm_storeu_pd(lane + 2 * j, acc[j]);
+    }
+    return repro_tree(lane);
+}
+
+// Adding the zeros of the padding keeps a lane as is: a lane starts at +0.0
+// and never becomes -0.0.
+double sum_repro_block_sse(const float *vec, size_t len) {
+    __m128d acc[8];
+    for (int j = 0; j < 8; j++) acc[j] = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + REPRO_LANES <= len; i += REPRO_LANES) {
+        repro_sum16_sse(acc, vec + i);
+    }
+    if (i < len) {
+        float buf[REPRO_LANES] = {0};
+        memcpy(buf, vec + i, (len - i) * sizeof(float));
+        repro_sum16_sse(acc, buf);
+    }
+    return repro_finish_sse(acc);
+}
+
+double dot_repro_block_sse(const float *a, const float *b, size_t len) {
+    __m128d acc[8];
+    for (int j = 0; j < 8; j++) acc[j] = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + REPRO_LANES <= len; i += REPRO_LANES) {
+        repro_dot16_sse(acc, a + i, b + i);
+    }
+    if (i < len) {
+        float bufa[REPRO_LANES] = {0}, bufb[REPRO_LANES] = {0};
+        memcpy(bufa, a + i, (len - i) * sizeof(float));
+        memcpy(bufb, b + i, (len - i) * sizeof(float));
+        repro_dot16_sse(acc, bufa, bufb);
+    }
+    return repro_finish_sse(acc);
+}
+
+float sum_repro_sse(const float *vec, size_t len) {
+    return sum_repro_blocks(sum_repro_block_sse, vec, len);
+}
+
+float dot_repro_sse(const float *a, const float *b, size_t len) {
+    return dot_repro_blocks(dot_repro_block_sse, a, b, len);
+}
+
+// min(x, m) returns m when x is NaN, so the NaNs are skipped as long as the
+// accumulators start at the infinities. The tails are padded with them.
+static inline __m128 extreme_sse(__m128 x, __m128 m, bool is_max) {
+    return is_max ? _mm_max_ps(x, m) : _mm_min_ps(x, m);
+}
+
+static inline float extreme_lanes(const float *lane, int n, bool is_max) {
+    float m = lane[0];
+    for (int i = 1; i < n; i++) {
+        if (is_max ? lane[i] > m : lane[i] < m) m = lane[i];
+    }
+    return m;
+}
+
+static inline float extreme_of_sse(const float *vec, size_t len, bool is_max) {
+    const float pad = is_max ? -INFINITY : INFINITY;
+    __m128 m0 = _mm_set1_ps(pad), m1 = _mm_set1_ps(pad);
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        m0 = extreme_sse(_mm_loadu_ps(vec + i), m0, is_max);
+        m1 = extreme_sse(_mm_loadu_ps(vec + i + 4), m1, is_max);
+    }
+    for (; i + 4 <= len; i += 4) {
+        m0 = extreme_sse(_mm_loadu_ps(vec + i), m0, is_max);
+    }
+    m1 = extreme_sse(load_tail_ps(vec + i, len - i, pad), m1, is_max);
+    float lane[4];
+    _mm_storeu_ps(lane, extreme_sse(m0, m1, is_max));
+    return extreme_lanes(lane, 4, is_max);
+}
+
+float min_sse(const float *vec, size_t len) {
+    return extreme_of_sse(vec, len, false);
+}
+
+float max_sse(const float *vec, size_t len) {
+    return extreme_of_sse(vec, len, true);
+}
+
+// AVX2: the tails are masked loads, which never fault on the lanes out of the
+// mask and load zeros there.
+
+TARGET_AVX2
+static inline __m256i tail_mask_avx2(int n) {
+    const __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(n), idx);
+}
+
+TARGET_AVX2
+static inline float hsum_avx2(__m256 x) {
+    __m128 h = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+    h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+    h = _mm_add_ss(h, _mm_movehdup_ps(h));
+    return _mm_cvtss_f32(h);
+}
+
+TARGET_AVX2
+static inline void two_sum_avx2(__m256 *s, __m256 *c, __m256 x) {
+    __m256 t  = _mm256_add_ps(*s, x);
+    __m256 bp = _mm256_sub_ps(t, *s);
+    __m256 e  = _mm256_add_ps(_mm256_sub_ps(*s, _mm256_sub_ps(t, bp)), _mm256_sub_ps(x, bp));
+    *c = _mm256_add_ps(*c, e);
+    *s = t;
+}
+
+TARGET_AVX2
+float sum_fast_avx2(const float *vec, size_t len) {
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+    __m256 s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        s0 = _mm256_add_ps(s0, _mm256_loadu_ps(vec + i));
+        s1 = _mm256_add_ps(s1, _mm256_loadu_ps(vec + i + 8));
+        s2 = _mm256_add_ps(s2, _mm256_loadu_ps(vec + i + 16));
+        s3 = _mm256_add_ps(s3, _mm256_loadu_ps(vec + i + 24));
+    }
+    for (; i + 8 <= len; i += 8) {
+        s0 = _mm256_add_ps(s0, _mm256_loadu_ps(vec + i));
+    }
+    s1 = _mm256_add_ps(s1, _mm256_maskload_ps(vec + i, tail_mask_avx2((int)(len - i))));
+    return hsum_avx2(_mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3)));
+}
+
+TARGET_AVX2
+float dot_fast_avx2(const float *a, const float *b, size_t len) {
+    __m256 s0 = _mm256_setzero_ps(), s1 = _mm256_setzero_ps();
+    __m256 s2 = _mm256_setzero_ps(), s3 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        s0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i),      _mm256_loadu_ps(b + i),      s0);
+        s1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8),  _mm256_loadu_ps(b + i + 8),  s1);
+        s2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), s2);
+        s3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), s3);
+    }
+    for (; i + 8 <= len; i += 8) {
+        s0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), s0);
+    }
+    __m256i tail = tail_mask_avx2((int)(len - i));
+    s1 = _mm256_fmadd_ps(_mm256_maskload_ps(a + i, tail), _mm256_maskload_ps(b + i, tail), s1);
+    return hsum_avx2(_mm256_add_ps(_mm256_add_ps(s0, s1), _mm256_add_ps(s2, s3)));
+}
+
+TARGET_AVX2
+float sum_kahan_avx2(const float *vec, size_t len) {
+    __m256 s0 = _mm256_setzero_ps(), c0 = _mm256_setzero_ps();
+    __m256 s1 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        two_sum_avx2(&s0, &c0, _mm256_loadu_ps(vec + i));
+        two_sum_avx2(&s1, &c1, _mm256_loadu_ps(vec + i + 8));
+    }
+    for (; i + 8 <= len; i += 8) {
+        two_sum_avx2(&s0, &c0, _mm256_loadu_ps(vec + i));
+    }
+    two_sum_avx2(&s1, &c1, _mm256_maskload_ps(vec + i, tail_mask_avx2((int)(len - i))));
+    float s[16], c[16];
+    _mm256_storeu_ps(s, s0), _mm256_storeu_ps(s + 8, s1);
+    _mm256_storeu_ps(c, c0), _mm256_storeu_ps(c + 8, c1);
+    return kahan_finish(s, c, 16);
+}
+
+// Dot2: the error of each product is exact with FMA.
+TARGET_AVX2
+static inline void dot2_avx2(__m256 *s, __m256 *c, __m256 a, __m256 b) {
+    __m256 p  = _mm256_mul_ps(a, b);
+    __m256 pe = _mm256_fmsub_ps(a, b, p);
+    two_sum_avx2(s, c, p);
+    *c = _mm256_add_ps(*c, pe);
+}
+
+TARGET_AVX2
+float dot_kahan_avx2(const float *a, const float *b, size_t len) {
+    __m256 s0 = _mm256_setzero_ps(), c0 = _mm256_setzero_ps();
+    __m256 s1 = _mm256_setzero_ps(), c1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        dot2_avx2(&s0, &c0, _mm256_loadu_ps(a + i),     _mm256_loadu_ps(b + i));
+        dot2_avx2(&s1, &c1, _mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8));
+    }
+    for (; i + 8 <= len; i += 8) {
+        dot2_avx2(&s0, &c0, _mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i));
+    }
+    __m256i tail = tail_mask_avx2((int)(len - i));
+    dot2_avx2(&s1, &c1, _mm256_maskload_ps(a + i, tail), _mm256_maskload_ps(b + i, tail));
+    float s[16], c[16];
+    _mm256_storeu_ps(s, s0), _mm256_storeu_ps(s + 8, s1);
+    _mm256_storeu_ps(c, c0), _mm256_storeu_ps(c + 8, c1);
+    return kahan_finish(s, c, 16);
+}
+
+// the 16 lanes are 4 vectors of doubles, n floats from p with n <= 16
+TARGET_AVX2
+static inline void repro_sum16_avx2(__m256d *acc, const float *p, size_t n) {
+    for (int j = 0; j < 4; j++) {
+        __m128 x = n >= 16 ? _mm_loadu_ps(p + 4 * j)
+            : _mm_maskload_ps(p + 4 * j, _mm256_castsi256_si128(tail_mask_avx2((int)n - 4 * j)));
+        acc[j] = _mm256_add_pd(acc[j], _mm256_cvtps_pd(x));
+    }
+}
+
+TARGET_AVX2
+static inline void repro_dot16_avx2(__m256d *acc, const float *a, const float *b, size_t n) {
+    for (int j = 0; j < 4; j++) {
+        __m128 x, y;
+        if (n >= 16) {
+            x = _mm_loadu_ps(a + 4 * j);
+            y = _mm_loadu_ps(b + 4 * j);
+        } else {
+            __m128i tail = _mm256_castsi256_si128(tail_mask_avx2((int)n - 4 * j));
+            x = _mm_maskload_ps(a + 4 * j, tail);
+            y = _mm_maskload_ps(b + 4 * j, tail);
+        }
+        acc[j] = _mm256_add_pd(acc[j], _mm256_mul_pd(_mm256_cvtps_pd(x), _mm256_cvtps_pd(y)));
+    }
+}
+
+TARGET_AVX2
+static inline double repro_finish_avx2(const __m256d *acc) {
+    double lane[REPRO_LANES];
+    for (int j = 0; j < 4; j++) {
+        _mm256_storeu_pd(lane + 4 * j, acc[j]);
+    }
+    return repro_tree(lane);
+}
+
+TARGET_AVX2
+double sum_repro_block_avx2(const float *vec, size_t len) {
+    __m256d acc[4];
+    for (int j = 0; j < 4; j++) acc[j] = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + REPRO_LANES <= len; i += REPRO_LANES) {
+        repro_sum16_avx2(acc, vec + i, REPRO_LANES);
+    }
+    if (i < len) {
+        repro_sum16_avx2(acc, vec + i, len - i);
+    }
+    return repro_finish_avx2(acc);
+}
+
+TARGET_AVX2
+double dot_repro_block_avx2(const float *a, const float *b, size_t len) {
+    __m256d acc[4];
+    for (int j = 0; j < 4; j++) acc[j] = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + REPRO_LANES <= len; i += REPRO_LANES) {
+        repro_dot16_avx2(acc, a + i, b + i, REPRO_LANES);
+    }
+    if (i < len) {
+        repro_dot16_avx2(acc, a + i, b + i, len - i);
+    }
+    return repro_finish_avx2(acc);
+}
+
+TARGET_AVX2
+float sum_repro_avx2(const float *vec, size_t len) {
+    return sum_repro_blocks(sum_repro_block_avx2, vec, len);
+}
+
+TARGET_AVX2
+float dot_repro_avx2(const float *a, const float *b, size_t len) {
+    return dot_repro_blocks(dot_repro_block_avx2, a, b, len);
+}
+
+TARGET_AVX2
+static inline __m256 extreme_avx2(__m256 x, __m256 m, bool is_max) {
+    return is_max ? _mm256_max_ps(x, m) : _mm256_min_ps(x, m);
+}
+
+TARGET_AVX2
+static inline float extreme_of_avx2(const float *vec, size_t len, bool is_max) {
+    const __m256 pad = _mm256_set1_ps(is_max ? -INFINITY : INFINITY);
+    __m256 m0 = pad, m1 = pad;
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        m0 = extreme_avx2(_mm256_loadu_ps(vec + i), m0, is_max);
+        m1 = extreme_avx2(_mm256_loadu_ps(vec + i + 8), m1, is_max);
+    }
+    for (; i + 8 <= len; i += 8) {
+        m0 = extreme_avx2(_mm256_loadu_ps(vec + i), m0, is_max);
+    }
+    __m256i tail = tail_mask_avx2((int)(len - i));
+    __m256  x = _mm256_blendv_ps(pad, _mm256_maskload_ps(vec + i, tail), _mm256_castsi256_ps(tail));
+    m1 = extreme_avx2(x, m1, is_max);
+    float lane[8];
+    _mm256_storeu_ps(lane, extreme_avx2(m0, m1, is_max));
+    return extreme_lanes(lane, 8, is_max);
+}
+
+TARGET_AVX2
+float min_avx2(const float *vec, size_t len) {
+    return extreme_of_avx2(vec, len, false);
+}
+
+TARGET_AVX2
+float max_avx2(const float *vec, size_t len) {
+    return extreme_of_avx2(vec, len, true);
+}
+
+// AVX-512: the tails are zero-masked loads.
+
+TARGET_AVX512
+static inline __mmask16 tail_mask_avx512(size_t n) {
+    return (__mmask16)_bzhi_u32(~0u, n);
+}
+
+TARGET_AVX512
+static inline void two_sum_avx512(__m512 *s, __m512 *c, __m512 x) {
+    __m512 t  = _mm512_add_ps(*s, x);
+    __m512 bp = _mm512_sub_ps(t, *s);
+    __m512 e  = _mm512_add_ps(_mm512_sub_ps(*s, _mm512_sub_ps(t, bp)), _mm512_sub_ps(x, bp));
+    *c = _mm512_add_ps(*c, e);
+    *s = t;
+}
+
+TARGET_AVX512
+static inline void dot2_avx512(__m512 *s, __m512 *c, __m512 a, __m512 b) {
+    __m512 p  = _mm512_mul_ps(a, b);
+    __m512 pe = _mm512_fmsub_ps(a, b, p);
+    two_sum_avx512(s, c, p);
+    *c = _mm512_add_ps(*c, pe);
+}
+
+TARGET_AVX512
+float sum_fast_avx512(const float *vec, size_t len) {
+    __m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+    __m512 s2 = _mm512_setzero_ps(), s3 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        s0 = _mm512_add_ps(s0, _mm512_loadu_ps(vec + i));
+        s1 = _mm512_add_ps(s1, _mm512_loadu_ps(vec + i + 16));
+        s2 = _mm512_add_ps(s2, _mm512_loadu_ps(vec + i + 32));
+        s3 = _mm512_add_ps(s3, _mm512_loadu_ps(vec + i + 48));
+    }
+    for (; i + 16 <= len; i += 16) {
+        s0 = _mm512_add_ps(s0, _mm512_loadu_ps(vec + i));
+    }
+    s1 = _mm512_add_ps(s1, _mm512_maskz_loadu_ps(tail_mask_avx512(len - i), vec + i));
+    return _mm512_reduce_add_ps(_mm512_add_ps(_mm512_add_ps(s0, s1), _mm512_add_ps(s2, s3)));
+}
+
+TARGET_AVX512
+float dot_fast_avx512(const float *a, const float *b, size_t len) {
+    __m512 s0 = _mm512_setzero_ps(), s1 = _mm512_setzero_ps();
+    __m512 s2 = _mm512_setzero_ps(), s3 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        s0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i),      _mm512_loadu_ps(b + i),      s0);
+        s1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16), s1);
+        s2 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 32), _mm512_loadu_ps(b + i + 32), s2);
+        s3 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 48), _mm512_loadu_ps(b + i + 48), s3);
+    }
+    for (; i + 16 <= len; i += 16) {
+        s0 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), s0);
+    }
+    __mmask16 tail = tail_mask_avx512(len - i);
+    s1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(tail, a + i), _mm512_maskz_loadu_ps(tail, b + i), s1);
+    return _mm512_reduce_add_ps(_mm512_add_ps(_mm512_add_ps(s0, s1), _mm512_add_ps(s2, s3)));
+}
+
+TARGET_AVX512
+float sum_kahan_avx512(const float *vec, size_t len) {
+    __m512 s0 = _mm512_setzero_ps(), c0 = _mm512_setzero_ps();
+    __m512 s1 = _mm512_setzero_ps(), c1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        two_sum_avx512(&s0, &c0, _mm512_loadu_ps(vec + i));
+        two_sum_avx512(&s1, &c1, _mm512_loadu_ps(vec + i + 16));
+    }
+    for (; i + 16 <= len; i += 16) {
+        two_sum_avx512(&s0, &c0, _mm512_loadu_ps(vec + i));
+    }
+    two_sum_avx512(&s1, &c1, _mm512_maskz_loadu_ps(tail_mask_avx512(len - i), vec + i));
+    float s[32], c[32];
+    _mm512_storeu_ps(s, s0), _mm512_storeu_ps(s + 16, s1);
+    _mm512_storeu_ps(c, c0), _mm512_storeu_ps(c + 16, c1);
+    return kahan_finish(s, c, 32);
+}
+
+TARGET_AVX512
+float dot_kahan_avx512(const float *a, const float *b, size_t len) {
+    __m512 s0 = _mm512_setzero_ps(), c0 = _mm512_setzero_ps();
+    __m512 s1 = _mm512_setzero_ps(), c1 = _mm512_setzero_ps();
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        dot2_avx512(&s0, &c0, _mm512_loadu_ps(a + i),      _mm512_loadu_ps(b + i));
+        dot2_avx512(&s1, &c1, _mm512_loadu_ps(a + i + 16), _mm512_loadu_ps(b + i + 16));
+    }
+    for (; i + 16 <= len; i += 16) {
+        dot2_avx512(&s0, &c0, _mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i));
+    }
+    __mmask16 tail = tail_mask_avx512(len - i);
+    dot2_avx512(&s1, &c1, _mm512_maskz_loadu_ps(tail, a + i), _mm512_maskz_loadu_ps(tail, b + i));
+    float s[32], c[32];
+    _mm512_storeu_ps(s, s0), _mm512_storeu_ps(s + 16, s1);
+    _mm512_storeu_ps(c, c0), _mm512_storeu_ps(c + 16, c1);
+    return kahan_finish(s, c, 32);
+}
+
+// the 16 lanes are 2 vectors of doubles, lanes 0..7 and 8..15
+TARGET_AVX512
+static inline void repro_cvt_avx512(__m512 x, __m512d *lo, __m512d *hi) {
+    *lo = _mm512_cvtps_pd(_mm512_castps512_ps256(x));
+    *hi = _mm512_cvtps_pd(_mm256_castpd_ps(_mm512_extractf64x4_pd(_mm512_castps_pd(x), 1)));
+}
+
+TARGET_AVX512
+static inline double repro_finish_avx512(__m512d acc0, __m512d acc1) {
+    double lane[REPRO_LANES];
+    _mm512_storeu_pd(lane, acc0);
+    _mm512_storeu_pd(lane + 8, acc1);
+    return repro_tree(lane);
+}
+
+TARGET_AVX512
+double sum_repro_block_avx512(const float *vec, size_t len) {
+    __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd(), lo, hi;
+    size_t i = 0;
+    for (; i + REPRO_LANES <= len; i += REPRO_LANES) {
+        repro_cvt_avx512(_mm512_loadu_ps(vec + i), &lo, &hi);
+        acc0 = _mm512_add_pd(acc0, lo);
+        acc1 = _mm512_add_pd(acc1, hi);
+    }
+    if (i < len) {
+        repro_cvt_avx512(_mm512_maskz_loadu_ps(tail_mask_avx512(len - i), vec + i), &lo, &hi);
+        acc0 = _mm512_add_pd(acc0, lo);
+        acc1 = _mm512_add_pd(acc1, hi);
+    }
+    return repro_finish_avx512(acc0, acc1);
+}
+
+TARGET_AVX512
+double dot_repro_block_avx512(const float *a, const float *b, size_t len) {
+    __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd(), alo, ahi, blo, bhi;
+    size_t i = 0;
+    for (; i + REPRO_LANES <= len; i += REPRO_LANES) {
+        repro_cvt_avx512(_mm512_loadu_ps(a + i), &alo, &ahi);
+        repro_cvt_avx512(_mm512_loadu_ps(b + i), &blo, &bhi);
+        acc0 = _mm512_add_pd(acc0, _mm512_mul_pd(alo, blo));
+        acc1 = _mm512_add_pd(acc1, _mm512_mul_pd(ahi, bhi));
+    }
+    if (i < len) {
+        __mmask16 tail = tail_mask_avx512(len - i);
+        repro_cvt_avx512(_mm512_maskz_loadu_ps(tail, a + i), &alo, &ahi);
+        repro_cvt_avx512(_mm512_maskz_loadu_ps(tail, b + i), &blo, &bhi);
+        acc0 = _mm512_add_pd(acc0, _mm512_mul_pd(alo, blo));
+        acc1 = _mm512_add_pd(acc1, _mm512_mul_pd(ahi, bhi));
+    }
+    return repro_finish_avx512(acc0, acc1);
+}
+
+TARGET_AVX512
+float sum_repro_avx512(const float *vec, size_t len) {
+    return sum_repro_blocks(sum_repro_block_avx512, vec, len);
+}
+
+TARGET_AVX512
+float dot_repro_avx512(const float *a, const float *b, size_t len) {
+    return dot_repro_blocks(dot_repro_block_avx512, a, b, len);
+}
+
+TARGET_AVX512
+static inline float extreme_of_avx512(const float *vec, size_t len, bool is_max) {
+    const __m512 pad = _mm512_set1_ps(is_max ? -INFINITY : INFINITY);
+    __m512 m0 = pad, m1 = pad;
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m512 x0 = _mm512_loadu_ps(vec + i);
+        __m512 x1 = _mm512_loadu_ps(vec + i + 16);
+        m0 = is_max ? _mm512_max_ps(x0, m0) : _mm512_min_ps(x0, m0);
+        m1 = is_max ? _mm512_max_ps(x1, m1) : _mm512_min_ps(x1, m1);
+    }
+    for (; i < len; i += 16) {
+        __mmask16 load = len - i >= 16 ? 0xffff : tail_mask_avx512(len - i);
+        __m512 x = _mm512_mask_loadu_ps(pad, load, vec + i);
+        m0 = is_max ? _mm512_max_ps(x, m0) : _mm512_min_ps(x, m0);
+    }
+    return is_max ? _mm512_reduce_max_ps(_mm512_max_ps(m0, m1))
+                  : _mm512_reduce_min_ps(_mm512_min_ps(m0, m1));
+}
+
+TARGET_AVX512
+float min_avx512(const float *vec, size_t len) {
+    return extreme_of_avx512(vec, len, false);
+}
+
+TARGET_AVX512
+float max_avx512(const float *vec, size_t len) {
+    return extreme_of_avx512(vec, len, true);
+}
+
+#undef REPRO_LANES
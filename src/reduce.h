@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stddef.h>
+
+// The block kernels of the reproducible reductions, shared by dispatch.c and
+// parallel.c. A block of at most SIMDSTR_REDUCE_BLOCK floats is reduced to a
+// double by the fixed 16-lane tree, the same bits on every ISA level.
+typedef double (*sum_block_t)(const float *vec, size_t len);
+typedef double (*dot_block_t)(const float *a, const float *b, size_t len);
+
+double sum_repro_block_naive(const float *vec, size_t len);
+double sum_repro_block_sse(const float *vec, size_t len);
+double sum_repro_block_avx2(const float *vec, size_t len);
+double sum_repro_block_avx512(const float *vec, size_t len);
+double dot_repro_block_naive(const float *a, const float *b, size_t len);
+double dot_repro_block_sse(const float *a, const float *b, size_t len);
+double dot_repro_block_avx2(const float *a, const float *b, size_t len);
+double dot_repro_block_avx512(const float *a, const float *b, size_t len);
+
+// add the blocks in order
+float sum_repro_blocks(sum_block_t block, const float *vec, size_t len);
+float dot_repro_blocks(dot_block_t block, const float *a, const float *b, size_t len);
+
+// the block kernel of simdstr_isa()
+double simdstr_sum_repro_block(const float *vec, size_t len);
@@ -1,11 +1,46 @@
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 #include <immintrin.h>
 
+#include "escape.h"
+#include "isa.h"
 #include "naivestr.h"
 #include "simdstr.h"
+#include "tail.h"
 
+float sum_sse(const float *arr, size_t len) {
+    float ret = 0.0;
+    __m128 sum1 = _mm_setzero_ps();
+    __m128 sum2 = _mm_setzero_ps();
+    const float *ap = arr;
+    while (len >= 8) {
+        __m128 block1 = _mm_loadu_ps(ap);
+        __m128 block2 = _mm_loadu_ps(ap + 4);
+        sum1 = _mm_add_ps(sum1, block1);
+        sum2 = _mm_add_ps(sum2, block2);
+        ap  += 8;
+        len -= 8;
+    }
+
+    // add the trail floats of array, padded with zeros
+    sum1 = _mm_add_ps(sum1, load_tail_ps(ap, len, 0.0f));
+    if (len > 4) {
+        sum2 = _mm_add_ps(sum2, load_tail_ps(ap + 4, len - 4, 0.0f));
+    }
+
+    // add the reduced float vector
+    float temp[4];
+    sum1 = _mm_add_ps(sum1, sum2);
+    _mm_storeu_ps(temp, sum1);
+    for (int j = 0; j < 4; j++) {
+        ret += temp[j];
+    }
+    return ret;
+}
+
+TARGET_AVX
 float sum_simd(const float *arr, size_t len) {
     float ret = 0.0;
     __m256 sum =  _mm256_setzero_ps();
@@ -17,21 +52,19 @@ float sum_simd(const float *arr, size_t len) {
         len -= 8;
     }
 
+    // add the trail floats of array, the masked lanes load zeros
+    sum = _mm256_add_ps(sum, _mm256_maskload_ps(ap, tail_mask_ps(len)));
+
     // add the reduced float vector
     float temp[8];
     _mm256_storeu_ps(temp, sum);
     for (int j = 0; j < 8; j++) {
         ret += temp[j];
     }
-
-    // add the trail floats of array
-    while (len > 0) {
-        ret += *ap;
-        ap++, len--;
-    }
     return ret;
 }
 
+TARGET_AVX
 float sum_simd_fast(const float *arr, size_t len) {
     float ret = 0.0;
     __m256 sum1 =  _mm256_setzero_ps();
@@ -46,6 +79,12 @@ float sum_simd_fast(const float *arr, size_t len) {
         len -= 16;
     }
 
+    // add the trail floats of array, the masked lanes load zeros
+    sum1 = _mm256_add_ps(sum1, _mm256_maskload_ps(ap, tail_mask_ps(len)));
+    if (len > 8) {
+        sum2 = _mm256_add_ps(sum2, _mm256_maskload_ps(ap + 8, tail_mask_ps(len - 8)));
+    }
+
     // add the reduced float vector
     float temp[8];
     sum1 = _mm256_add_ps(sum1, sum2);
@@ -53,13 +92,31 @@ float sum_simd_fast(const float *arr, size_t len) {
     for (int j = 0; j < 8; j++) {
         ret += temp[j];
     }
+    return ret;
+}
 
-    // add the trail floats of array
-    while (len > 0) {
-        ret += *ap;
-        ap++, len--;
+TARGET_AVX512
+float sum_avx512(const float *arr, size_t len) {
+    const float *ap = arr;
+    __m512 sum1 = _mm512_setzero_ps();
+    __m512 sum2 = _mm512_setzero_ps();
+    while (len >= 32) {
+        __m512 block1 = _mm512_loadu_ps(ap);
+        __m512 block2 = _mm512_loadu_ps(ap + 16);
+        sum1 = _mm512_add_ps(sum1, block1);
+        sum2 = _mm512_add_ps(sum2, block2);
+        ap  += 32;
+        len -= 32;
     }
-    return ret;
+
+    // add the trail floats of array, the masked lanes load zeros
+    sum1 = _mm512_add_ps(sum1, _mm512_maskz_loadu_ps(_bzhi_u32(~0u, len < 16 ? len : 16), ap));
+    if (len > 16) {
+        sum2 = _mm512_add_ps(sum2, _mm512_maskz_loadu_ps(_bzhi_u32(~0u, len - 16), ap + 16));
+    }
+
+    // add the reduced float vector
+    return _mm512_reduce_add_ps(_mm512_add_ps(sum1, sum2));
 }
 
 bool memcmpeq_autovec(const char *s1, const char *s2, size_t len) {
@@ -75,8 +132,26 @@ bool memcmpeq_autovec(const char *s1, const char *s2, size_t len) {
     return ret;
 }
 
+// Compare the last len < 16 bytes. back is true when the inputs have 16 bytes
+// before s1 + len, which are loaded as an overlapping final block.
+static inline bool memcmpeq_tail_sse(const char *s1, const char *s2, size_t len, bool back) {
+    __m128i v1, v2;
+    if (len == 0) {
+        return true;
+    }
+    if (back) {
+        v1 = _mm_loadu_si128((__m128i *)(s1 + len - 16));
+        v2 = _mm_loadu_si128((__m128i *)(s2 + len - 16));
+    } else {
+        v1 = load_tail_si128(s1, len, 0);
+        v2 = load_tail_si128(s2, len, 0);
+    }
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(v1, v2)) == 0xffff;
+}
+
 // memcmpeq use SSE
 bool memcmpeq_sse(const char *s1, const char *s2, size_t len) {
+    bool back = len >= 16;
     // use SSE for 16-byte loop
     while (len >= 16) {
         __m128i  v1  = _mm_loadu_si128((__m128i *)s1);
@@ -91,14 +166,15 @@ bool memcmpeq_sse(const char *s1, const char *s2, size_t len) {
         len -= 16;
     };
     // deal with trailing bytes
-    while (len > 0 && *s1++ == *s2++) len--;
-    return len == 0;
+    return memcmpeq_tail_sse(s1, s2, len, back);
 }
 
 // memcmpeq use SSE 4.2, reference:
 // https://www.intel.com/content/www/us/en/docs/intrinsics-guide/index.html#ssetechs=SSE4_2
 // https://en.wikipedia.org/wiki/SSE4
+TARGET_SSE4_2
 bool memcmpeq_sse4_2(const char *s1, const char *s2, size_t len) {
+    bool back = len >= 16;
     // use SSE4.2 for 16-byte loop
     while (len >= 16) {
         __m128i  v1   = _mm_loadu_si128((__m128i *)s1);
@@ -112,11 +188,12 @@ bool memcmpeq_sse4_2(const char *s1, const char *s2, size_t len) {
         len -= 16;
     };
     // deal with trailing bytes
-    while (len > 0 && *s1++ == *s2++) len--;
-    return len == 0;
+    return memcmpeq_tail_sse(s1, s2, len, back);
 }
 
+TARGET_SSE4_2
 bool memcmpeq_sse4_2_fast(const char *s1, const char *s2, size_t len) {
+    bool back = len >= 16;
     // use SSE4.2 for 16-byte loop
     while (len >= 16) {
         __m128i  v1   = _mm_loadu_si128((__m128i *)s1);
@@ -130,12 +207,13 @@ bool memcmpeq_sse4_2_fast(const char *s1, const char *s2, size_t len) {
         len -= 16;
     };
     // deal with trailing bytes
-    while (len > 0 && *s1++ == *s2++) len--;
-    return len == 0;
+    return memcmpeq_tail_sse(s1, s2, len, back);
 }
 
 // memcmpeq use AVX2
+TARGET_AVX2
 bool memcmpeq_avx2(const char *s1, const char *s2, size_t len) {
+    bool back = len >= 32;
     // use AVX2 for 32-byte loop
     while (len >= 32) {
         __m256i  v1 = _mm256_loadu_si256((__m256i *)s1);
@@ -149,12 +227,17 @@ bool memcmpeq_avx2(const char *s1, const char *s2, size_t len) {
         s2  += 32;
         len -= 32;
     };
-    // deal with trailing bytes
+    // deal with trailing bytes, an overlapping final block
+    if (back && len > 0) {
+        __m256i v1 = _mm256_loadu_si256((__m256i *)(s1 + len - 32));
+        __m256i v2 = _mm256_loadu_si256((__m256i *)(s2 + len - 32));
+        return (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v1, v2)) == 0xFFFFFFFFu;
+    }
     return memcmpeq_sse(s1, s2, len);
 }
 
-#if __AVX512F__ &&  __AVX512BW__
 // memcmpeq use AVX512
+TARGET_AVX512
 bool memcmpeq_avx512(const char *s1, const char *s2, size_t len) {
     // use AVX512 for 64-byte loop
     while (len >= 64) {
@@ -168,13 +251,1779 @@ bool memcmpeq_avx512(const char *s1, const char *s2, size_t len) {
         s2  += 64;
         len -= 64;
     };
-    // deal with trailing bytes
-    return memcmpeq_avx2(s1, s2, len);
+    // deal with trailing bytes, the masked bytes load zeros
+    __mmask64 tail = _bzhi_u64(~0ull, len);
+    __m512i   v1 = _mm512_maskz_loadu_epi8(tail, s1);
+    __m512i   v2 = _mm512_maskz_loadu_epi8(tail, s2);
+    return _mm512_cmpneq_epi8_mask(v1, v2) == 0;
+}
+
+// mismatch compares blocks like memcmpeq and finds the first differing byte
+// with tzcnt on the inequality mask. The padding of the short tails is equal.
+static inline size_t mismatch_small(const char *s1, const char *s2, size_t len) {
+    __m128i  v1  = load_tail_si128(s1, len, 0);
+    __m128i  v2  = load_tail_si128(s2, len, 0);
+    uint32_t neq = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v1, v2)) ^ 0xffff;
+    return neq != 0 ? (size_t)__builtin_ctz(neq) : len;
+}
+
+static inline uint32_t neq_mask_sse(const char *s1, const char *s2) {
+    __m128i v1 = _mm_loadu_si128((__m128i *)s1);
+    __m128i v2 = _mm_loadu_si128((__m128i *)s2);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v1, v2)) ^ 0xffff;
+}
+
+// the tail is an overlapping final block
+size_t mismatch_sse(const char *s1, const char *s2, size_t len) {
+    if (len < 16) {
+        return mismatch_small(s1, s2, len);
+    }
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        uint32_t neq = neq_mask_sse(s1 + i, s2 + i);
+        if (neq != 0) {
+            return i + __builtin_ctz(neq);
+        }
+    }
+    if (i < len) {
+        uint32_t neq = neq_mask_sse(s1 + len - 16, s2 + len - 16);
+        if (neq != 0) {
+            return len - 16 + __builtin_ctz(neq);
+        }
+    }
+    return len;
+}
+
+TARGET_AVX2
+size_t mismatch_avx2(const char *s1, const char *s2, size_t len) {
+    if (len < 32) {
+        return mismatch_sse(s1, s2, len);
+    }
+    size_t i = 0;
+    for (;; i += 32) {
+        if (i + 32 > len) {
+            // overlapping final block
+            if (i == len) break;
+            i = len - 32;
+        }
+        __m256i  v1 = _mm256_loadu_si256((__m256i *)(s1 + i));
+        __m256i  v2 = _mm256_loadu_si256((__m256i *)(s2 + i));
+        uint32_t neq = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v1, v2));
+        if (neq != 0) {
+            return i + _tzcnt_u32(neq);
+        }
+        if (i + 32 == len) break;
+    }
+    return len;
+}
+
+// the tail is a masked block, which never faults past len
+TARGET_AVX512
+size_t mismatch_avx512(const char *s1, const char *s2, size_t len) {
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        __m512i  v1 = _mm512_loadu_si512((__m512i *)(s1 + i));
+        __m512i  v2 = _mm512_loadu_si512((__m512i *)(s2 + i));
+        uint64_t neq = _mm512_cmpneq_epi8_mask(v1, v2);
+        if (neq != 0) {
+            return i + _tzcnt_u64(neq);
+        }
+    }
+    if (i < len) {
+        __mmask64 tail = _bzhi_u64(~0ull, len - i);
+        __m512i   v1 = _mm512_maskz_loadu_epi8(tail, s1 + i);
+        __m512i   v2 = _mm512_maskz_loadu_epi8(tail, s2 + i);
+        uint64_t  neq = _mm512_cmpneq_epi8_mask(v1, v2);
+        if (neq != 0) {
+            return i + _tzcnt_u64(neq);
+        }
+    }
+    return len;
+}
+
+// the order of the first differing bytes
+static inline int memcmp3_at(const char *s1, const char *s2, size_t i, size_t len) {
+    if (i == len) {
+        return 0;
+    }
+    return (unsigned char)s1[i] - (unsigned char)s2[i];
+}
+
+int memcmp3_sse(const char *s1, const char *s2, size_t len) {
+    return memcmp3_at(s1, s2, mismatch_sse(s1, s2, len), len);
+}
+
+TARGET_AVX2
+int memcmp3_avx2(const char *s1, const char *s2, size_t len) {
+    return memcmp3_at(s1, s2, mismatch_avx2(s1, s2, len), len);
+}
+
+TARGET_AVX512
+int memcmp3_avx512(const char *s1, const char *s2, size_t len) {
+    return memcmp3_at(s1, s2, mismatch_avx512(s1, s2, len), len);
+}
+
+// Case conversion flips bit 5 (0x20) of the ASCII letters in [lo, lo + 25]:
+// lo is 'A' for tolower and 'a' for toupper. Converting a converted byte again
+// is a no-op, so the tails re-convert an overlapping final block instead of
+// falling back to a byte loop. Non ASCII bytes (UTF-8) are kept as is.
+
+// convert 8 packed bytes without SIMD registers
+static inline uint64_t convcase_swar(uint64_t x, uint8_t lo) {
+    const uint64_t ones = 0x0101010101010101ull;
+    uint64_t heptets = x & (0x7f * ones);
+    uint64_t ge_lo = heptets + (uint64_t)(0x80 - lo) * ones;
+    uint64_t gt_hi = heptets + (uint64_t)(0x7f - (lo + 25)) * ones;
+    uint64_t in = (ge_lo ^ gt_hi) & ~x & (0x80 * ones);
+    return x ^ (in >> 2);
+}
+
+// convert less than 16 bytes
+static inline void convcase_small(char *dst, const char *src, size_t len, uint8_t lo) {
+    uint64_t x1 = 0, x2 = 0;
+    if (len >= 8) {
+        // two overlapping words
+        memcpy(&x1, src, 8);
+        memcpy(&x2, src + len - 8, 8);
+        x1 = convcase_swar(x1, lo);
+        x2 = convcase_swar(x2, lo);
+        memcpy(dst, &x1, 8);
+        memcpy(dst + len - 8, &x2, 8);
+    } else if (len > 0) {
+        memcpy(&x1, src, len);
+        x1 = convcase_swar(x1, lo);
+        memcpy(dst, &x1, len);
+    }
+}
+
+// the letters mask of 16 bytes, a range compare on the signed bytes
+static inline __m128i letters_sse(__m128i x, uint8_t lo) {
+    __m128i shifted = _mm_sub_epi8(x, _mm_set1_epi8((char)(lo + 0x80)));
+    return _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(0x80 + 26)));
+}
+
+static inline __m128i convcase_sse(__m128i x, uint8_t lo) {
+    __m128i in = letters_sse(x, lo);
+    return _mm_xor_si128(x, _mm_and_si128(in, _mm_set1_epi8(0x20)));
+}
+
+static inline char* convcase_copy_sse(char *dst, const char *src, size_t len, uint8_t lo) {
+    if (len < 16) {
+        convcase_small(dst, src, len, lo);
+        return dst;
+    }
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i x = _mm_loadu_si128((__m128i *)(src + i));
+        _mm_storeu_si128((__m128i *)(dst + i), convcase_sse(x, lo));
+    }
+    // overlapping final block
+    if (i < len) {
+        __m128i x = _mm_loadu_si128((__m128i *)(src + len - 16));
+        _mm_storeu_si128((__m128i *)(dst + len - 16), convcase_sse(x, lo));
+    }
+    return dst;
+}
+
+// in place, the blocks without letters to convert are not written back
+static inline char* convcase_inplace_sse(char *s, size_t len, uint8_t lo) {
+    if (len < 16) {
+        convcase_small(s, s, len, lo);
+        return s;
+    }
+    size_t i = 0;
+    for (;; i += 16) {
+        if (i + 16 > len) {
+            // overlapping final block
+            if (i == len) break;
+            i = len - 16;
+        }
+        __m128i x  = _mm_loadu_si128((__m128i *)(s + i));
+        __m128i in = letters_sse(x, lo);
+        if (_mm_movemask_epi8(in) != 0) {
+            x = _mm_xor_si128(x, _mm_and_si128(in, _mm_set1_epi8(0x20)));
+            _mm_storeu_si128((__m128i *)(s + i), x);
+        }
+        if (i + 16 == len) break;
+    }
+    return s;
+}
+
+TARGET_AVX2
+static inline __m256i letters_avx2(__m256i x, uint8_t lo) {
+    __m256i shifted = _mm256_sub_epi8(x, _mm256_set1_epi8((char)(lo + 0x80)));
+    return _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)), shifted);
+}
+
+TARGET_AVX2
+static inline __m256i convcase_avx2(__m256i x, uint8_t lo) {
+    __m256i in = letters_avx2(x, lo);
+    return _mm256_xor_si256(x, _mm256_and_si256(in, _mm256_set1_epi8(0x20)));
+}
+
+TARGET_AVX2
+static inline char* convcase_copy_avx2(char *dst, const char *src, size_t len, uint8_t lo) {
+    if (len < 32) {
+        return convcase_copy_sse(dst, src, len, lo);
+    }
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i x = _mm256_loadu_si256((__m256i *)(src + i));
+        _mm256_storeu_si256((__m256i *)(dst + i), convcase_avx2(x, lo));
+    }
+    // overlapping final block
+    if (i < len) {
+        __m256i x = _mm256_loadu_si256((__m256i *)(src + len - 32));
+        _mm256_storeu_si256((__m256i *)(dst + len - 32), convcase_avx2(x, lo));
+    }
+    return dst;
+}
+
+TARGET_AVX2
+static inline char* convcase_inplace_avx2(char *s, size_t len, uint8_t lo) {
+    if (len < 32) {
+        return convcase_inplace_sse(s, len, lo);
+    }
+    size_t i = 0;
+    for (;; i += 32) {
+        if (i + 32 > len) {
+            // overlapping final block
+            if (i == len) break;
+            i = len - 32;
+        }
+        __m256i x  = _mm256_loadu_si256((__m256i *)(s + i));
+        __m256i in = letters_avx2(x, lo);
+        if (_mm256_movemask_epi8(in) != 0) {
+            x = _mm256_xor_si256(x, _mm256_and_si256(in, _mm256_set1_epi8(0x20)));
+            _mm256_storeu_si256((__m256i *)(s + i), x);
+        }
+        if (i + 32 == len) break;
+    }
+    return s;
+}
+
+TARGET_AVX512
+static inline __mmask64 letters_avx512(__m512i x, uint8_t lo) {
+    __m512i offset = _mm512_sub_epi8(x, _mm512_set1_epi8((char)lo));
+    return _mm512_cmplt_epu8_mask(offset, _mm512_set1_epi8(26));
+}
+
+// the tail is handled by masked loads and stores, which never fault on the
+// bytes out of the mask.
+TARGET_AVX512
+static inline char* convcase_copy_avx512(char *dst, const char *src, size_t len, uint8_t lo) {
+    const __m512i flip = _mm512_set1_epi8(0x20);
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        __m512i   x  = _mm512_loadu_si512((__m512i *)(src + i));
+        __mmask64 in = letters_avx512(x, lo);
+        x = _mm512_mask_blend_epi8(in, x, _mm512_xor_si512(x, flip));
+        _mm512_storeu_si512((__m512i *)(dst + i), x);
+    }
+    if (i < len) {
+        __mmask64 tail = _bzhi_u64(~0ull, len - i);
+        __m512i   x    = _mm512_maskz_loadu_epi8(tail, src + i);
+        __mmask64 in   = letters_avx512(x, lo);
+        x = _mm512_mask_blend_epi8(in, x, _mm512_xor_si512(x, flip));
+        _mm512_mask_storeu_epi8(dst + i, tail, x);
+    }
+    return dst;
+}
+
+// in place, only the converted letters are stored
+TARGET_AVX512
+static inline char* convcase_inplace_avx512(char *s, size_t len, uint8_t lo) {
+    const __m512i flip = _mm512_set1_epi8(0x20);
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        __m512i   x  = _mm512_loadu_si512((__m512i *)(s + i));
+        __mmask64 in = letters_avx512(x, lo);
+        _mm512_mask_storeu_epi8(s + i, in, _mm512_xor_si512(x, flip));
+    }
+    if (i < len) {
+        __mmask64 tail = _bzhi_u64(~0ull, len - i);
+        __m512i   x    = _mm512_maskz_loadu_epi8(tail, s + i);
+        __mmask64 in   = letters_avx512(x, lo) & tail;
+        _mm512_mask_storeu_epi8(s + i, in, _mm512_xor_si512(x, flip));
+    }
+    return s;
+}
+
+char* tolower_sse(char *dst, const char *src, size_t len) {
+    return convcase_copy_sse(dst, src, len, 'A');
+}
+
+char* toupper_sse(char *dst, const char *src, size_t len) {
+    return convcase_copy_sse(dst, src, len, 'a');
+}
+
+char* tolower_inplace_sse(char *s, size_t len) {
+    return convcase_inplace_sse(s, len, 'A');
+}
+
+char* toupper_inplace_sse(char *s, size_t len) {
+    return convcase_inplace_sse(s, len, 'a');
+}
+
+TARGET_AVX2
+char* tolower_avx2(char *dst, const char *src, size_t len) {
+    return convcase_copy_avx2(dst, src, len, 'A');
+}
+
+TARGET_AVX2
+char* toupper_avx2(char *dst, const char *src, size_t len) {
+    return convcase_copy_avx2(dst, src, len, 'a');
+}
+
+TARGET_AVX2
+char* tolower_inplace_avx2(char *s, size_t len) {
+    return convcase_inplace_avx2(s, len, 'A');
+}
+
+TARGET_AVX2
+char* toupper_inplace_avx2(char *s, size_t len) {
+    return convcase_inplace_avx2(s, len, 'a');
+}
+
+TARGET_AVX512
+char* tolower_avx512(char *dst, const char *src, size_t len) {
+    return convcase_copy_avx512(dst, src, len, 'A');
+}
+
+TARGET_AVX512
+char* toupper_avx512(char *dst, const char *src, size_t len) {
+    return convcase_copy_avx512(dst, src, len, 'a');
+}
+
+TARGET_AVX512
+char* tolower_inplace_avx512(char *s, size_t len) {
+    return convcase_inplace_avx512(s, len, 'A');
+}
+
+TARGET_AVX512
+char* toupper_inplace_avx512(char *s, size_t len) {
+    return convcase_inplace_avx512(s, len, 'a');
+}
+
+// memcaseeq compares like memcmpeq with the ASCII case folded on the fly: two
+// bytes match when they are equal, or when they are equal with bit 5 set and
+// the first one is then a lower case letter. x | 0x20 is a lower case letter
+// only when x is a letter, so one range compare covers both cases.
+static inline uint32_t caseneq_mask_sse(__m128i v1, __m128i v2) {
+    const __m128i bit5 = _mm_set1_epi8(0x20);
+    __m128i l1 = _mm_or_si128(v1, bit5);
+    __m128i eq = _mm_or_si128(_mm_cmpeq_epi8(v1, v2), letters_sse(l1, 'a'));
+    eq = _mm_and_si128(eq, _mm_cmpeq_epi8(l1, _mm_or_si128(v2, bit5)));
+    return (uint32_t)_mm_movemask_epi8(eq) ^ 0xffff;
+}
+
+// the tail is an overlapping final block, the padding of the short inputs is equal
+bool memcaseeq_sse(const char *s1, const char *s2, size_t len) {
+    if (len < 16) {
+        return caseneq_mask_sse(load_tail_si128(s1, len, 0), load_tail_si128(s2, len, 0)) == 0;
+    }
+    size_t i = 0;
+    for (; i + 16 <= len; i += 16) {
+        __m128i v1 = _mm_loadu_si128((__m128i *)(s1 + i));
+        __m128i v2 = _mm_loadu_si128((__m128i *)(s2 + i));
+        if (caseneq_mask_sse(v1, v2) != 0) {
+            return false;
+        }
+    }
+    if (i < len) {
+        __m128i v1 = _mm_loadu_si128((__m128i *)(s1 + len - 16));
+        __m128i v2 = _mm_loadu_si128((__m128i *)(s2 + len - 16));
+        return caseneq_mask_sse(v1, v2) == 0;
+    }
+    return true;
+}
+
+TARGET_AVX2
+static inline uint32_t caseneq_mask_avx2(__m256i v1, __m256i v2) {
+    const __m256i bit5 = _mm256_set1_epi8(0x20);
+    __m256i l1 = _mm256_or_si256(v1, bit5);
+    __m256i eq = _mm256_or_si256(_mm256_cmpeq_epi8(v1, v2), letters_avx2(l1, 'a'));
+    eq = _mm256_and_si256(eq, _mm256_cmpeq_epi8(l1, _mm256_or_si256(v2, bit5)));
+    return ~(uint32_t)_mm256_movemask_epi8(eq);
+}
+
+TARGET_AVX2
+bool memcaseeq_avx2(const char *s1, const char *s2, size_t len) {
+    if (len < 32) {
+        return memcaseeq_sse(s1, s2, len);
+    }
+    size_t i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i v1 = _mm256_loadu_si256((__m256i *)(s1 + i));
+        __m256i v2 = _mm256_loadu_si256((__m256i *)(s2 + i));
+        if (caseneq_mask_avx2(v1, v2) != 0) {
+            return false;
+        }
+    }
+    // overlapping final block
+    if (i < len) {
+        __m256i v1 = _mm256_loadu_si256((__m256i *)(s1 + len - 32));
+        __m256i v2 = _mm256_loadu_si256((__m256i *)(s2 + len - 32));
+        return caseneq_mask_avx2(v1, v2) == 0;
+    }
+    return true;
+}
+
+TARGET_AVX512
+static inline __mmask64 caseneq_mask_avx512(__m512i v1, __m512i v2) {
+    const __m512i bit5 = _mm512_set1_epi8(0x20);
+    __m512i   l1 = _mm512_or_si512(v1, bit5);
+    __mmask64 eq = _mm512_cmpeq_epi8_mask(v1, v2) | letters_avx512(l1, 'a');
+    return ~(eq & _mm512_cmpeq_epi8_mask(l1, _mm512_or_si512(v2, bit5)));
+}
+
+// the tail is a masked block, the masked bytes load zeros
+TARGET_AVX512
+bool memcaseeq_avx512(const char *s1, const char *s2, size_t len) {
+    size_t i = 0;
+    for (; i + 64 <= len; i += 64) {
+        __m512i v1 = _mm512_loadu_si512((__m512i *)(s1 + i));
+        __m512i v2 = _mm512_loadu_si512((__m512i *)(s2 + i));
+        if (caseneq_mask_avx512(v1, v2) != 0) {
+            return false;
+        }
+    }
+    __mmask64 tail = _bzhi_u64(~0ull, len - i);
+    __m512i   v1 = _mm512_maskz_loadu_epi8(tail, s1 + i);
+    __m512i   v2 = _mm512_maskz_loadu_epi8(tail, s2 + i);
+    return caseneq_mask_avx512(v1, v2) == 0;
+}
+
+// Left-pack shuffles for compact, entry k moves the bytes at the set bits
+// of k to the front of an 8-byte group and zeroes the rest.
+static const uint64_t compact_lut[256] = {
+    0x8080808080808080ull, 0x8080808080808000ull, 0x8080808080808001ull, 0x8080808080800100ull,
+    0x8080808080808002ull, 0x8080808080800200ull, 0x8080808080800201ull, 0x8080808080020100ull,
+    0x8080808080808003ull, 0x8080808080800300ull, 0x8080808080800301ull, 0x8080808080030100ull,
+    0x8080808080800302ull, 0x8080808080030200ull, 0x8080808080030201ull, 0x8080808003020100ull,
+    0x8080808080808004ull, 0x8080808080800400ull, 0x8080808080800401ull, 0x8080808080040100ull,
+    0x8080808080800402ull, 0x8080808080040200ull, 0x8080808080040201ull, 0x8080808004020100ull,
+    0x8080808080800403ull, 0x8080808080040300ull, 0x8080808080040301ull, 0x8080808004030100ull,
+    0x8080808080040302ull, 0x8080808004030200ull, 0x8080808004030201ull, 0x8080800403020100ull,
+    0x8080808080808005ull, 0x8080808080800500ull, 0x8080808080800501ull, 0x8080808080050100ull,
+    0x8080808080800502ull, 0x8080808080050200ull, 0x8080808080050201ull, 0x8080808005020100ull,
+    0x8080808080800503ull, 0x8080808080050300ull, 0x8080808080050301ull, 0x8080808005030100ull,
+    0x8080808080050302ull, 0x8080808005030200ull, 0x8080808005030201ull, 0x8080800503020100ull,
+    0x8080808080800504ull, 0x8080808080050400ull, 0x8080808080050401ull, 0x8080808005040100ull,
+    0x8080808080050402ull, 0x8080808005040200ull, 0x8080808005040201ull, 0x8080800504020100ull,
+    0x8080808080050403ull, 0x8080808005040300ull, 0x8080808005040301ull, 0x8080800504030100ull,
+    0x8080808005040302ull, 0x8080800504030200ull, 0x8080800504030201ull, 0x8080050403020100ull,
+    0x8080808080808006ull, 0x8080808080800600ull, 0x8080808080800601ull, 0x8080808080060100ull,
+    0x8080808080800602ull, 0x8080808080060200ull, 0x8080808080060201ull, 0x8080808006020100ull,
+    0x8080808080800603ull, 0x8080808080060300ull, 0x8080808080060301ull, 0x8080808006030100ull,
+    0x8080808080060302ull, 0x8080808006030200ull, 0x8080808006030201ull, 0x8080800603020100ull,
+    0x8080808080800604ull, 0x8080808080060400ull, 0x8080808080060401ull, 0x8080808006040100ull,
+    0x8080808080060402ull, 0x8080808006040200ull, 0x8080808006040201ull, 0x8080800604020100ull,
+    0x8080808080060403ull, 0x8080808006040300ull, 0x8080808006040301ull, 0x8080800604030100ull,
+    0x8080808006040302ull, 0x8080800604030200ull, 0x8080800604030201ull, 0x8080060403020100ull,
+    0x8080808080800605ull, 0x8080808080060500ull, 0x8080808080060501ull, 0x8080808006050100ull,
+    0x8080808080060502ull, 0x8080808006050200ull, 0x8080808006050201ull, 0x8080800605020100ull,
+    0x8080808080060503ull, 0x8080808006050300ull, 0x8080808006050301ull, 0x8080800605030100ull,
+    0x8080808006050302ull, 0x8080800605030200ull, 0x8080800605030201ull, 0x8080060503020100ull,
+    0x8080808080060504ull, 0x8080808006050400ull, 0x8080808006050401ull, 0x8080800605040100ull,
+    0x8080808006050402ull, 0x8080800605040200ull, 0x8080800605040201ull, 0x8080060504020100ull,
+    0x8080808006050403ull, 0x8080800605040300ull, 0x8080800605040301ull, 0x8080060504030100ull,
+    0x8080800605040302ull, 0x8080060504030200ull, 0x8080060504030201ull, 0x8006050403020100ull,
+    0x8080808080808007ull, 0x8080808080800700ull, 0x8080808080800701ull, 0x8080808080070100ull,
+    0x8080808080800702ull, 0x8080808080070200ull, 0x8080808080070201ull, 0x8080808007020100ull,
+    0x8080808080800703ull, 0x8080808080070300ull, 0x8080808080070301ull, 0x8080808007030100ull,
+    0x8080808080070302ull, 0x8080808007030200ull, 0x8080808007030201ull, 0x8080800703020100ull,
+    0x8080808080800704ull, 0x8080808080070400ull, 0x8080808080070401ull, 0x8080808007040100ull,
+    0x8080808080070402ull, 0x8080808007040200ull, 0x8080808007040201ull, 0x8080800704020100ull,
+    0x8080808080070403ull, 0x8080808007040300ull, 0x8080808007040301ull, 0x8080800704030100ull,
+    0x8080808007040302ull, 0x8080800704030200ull, 0x8080800704030201ull, 0x8080070403020100ull,
+    0x8080808080800705ull, 0x8080808080070500ull, 0x8080808080070501ull, 0x8080808007050100ull,
+    0x8080808080070502ull, 0x8080808007050200ull, 0x8080808007050201ull, 0x8080800705020100ull,
+    0x8080808080070503ull, 0x8080808007050300ull, 0x8080808007050301ull, 0x8080800705030100ull,
+    0x8080808007050302ull, 0x8080800705030200ull, 0x8080800705030201ull, 0x8080070503020100ull,
+    0x8080808080070504ull, 0x8080808007050400ull, 0x8080808007050401ull, 0x8080800705040100ull,
+    0x8080808007050402ull, 0x8080800705040200ull, 0x8080800705040201ull, 0x8080070504020100ull,
+    0x8080808007050403ull, 0x8080800705040300ull, 0x8080800705040301ull, 0x8080070504030100ull,
+    0x8080800705040302ull, 0x8080070504030200ull, 0x8080070504030201ull, 0x8007050403020100ull,
+    0x8080808080800706ull, 0x8080808080070600ull, 0x8080808080070601ull, 0x8080808007060100ull,
+    0x8080808080070602ull, 0x8080808007060200ull, 0x8080808007060201ull, 0x8080800706020100ull,
+    0x8080808080070603ull, 0x8080808007060300ull, 0x8080808007060301ull, 0x8080800706030100ull,
+    0x8080808007060302ull, 0x8080800706030200ull, 0x8080800706030201ull, 0x8080070603020100ull,
+    0x8080808080070604ull, 0x8080808007060400ull, 0x8080808007060401ull, 0x8080800706040100ull,
+    0x8080808007060402ull, 0x8080800706040200ull, 0x8080800706040201ull, 0x8080070604020100ull,
+    0x8080808007060403ull, 0x8080800706040300ull, 0x8080800706040301ull, 0x8080070604030100ull,
+    0x8080800706040302ull, 0x8080070604030200ull, 0x8080070604030201ull, 0x8007060403020100ull,
+    0x8080808080070605ull, 0x8080808007060500ull, 0x8080808007060501ull, 0x8080800706050100ull,
+    0x8080808007060502ull, 0x8080800706050200ull, 0x8080800706050201ull, 0x8080070605020100ull,
+    0x8080808007060503ull, 0x8080800706050300ull, 0x8080800706050301ull, 0x8080070605030100ull,
+    0x8080800706050302ull, 0x8080070605030200ull, 0x8080070605030201ull, 0x8007060503020100ull,
+    0x8080808007060504ull, 0x8080800706050400ull, 0x8080800706050401ull, 0x8080070605040100ull,
+    0x8080800706050402ull, 0x8080070605040200ull, 0x8080070605040201ull, 0x8007060504020100ull,
+    0x8080800706050403ull, 0x8080070605040300ull, 0x8080070605040301ull, 0x8007060504030100ull,
+    0x8080070605040302ull, 0x8007060504030200ull, 0x8007060504030201ull, 0x0706050403020100ull,
+};
+
+// The whitespace classifier of examples/shuffle: the low nibble of a byte
+// selects its only possible whitespace value, and a byte is whitespace iff it
+// equals the selected entry. Bytes >= 0x80 select 0 and never match.
+#define SPACE_TAB \
+    '\x20', 0, 0, 0, 0, 0, 0, 0, 0, '\x09', '\x0A', 0, 0, '\x0D', 0, 0
+
+TARGET_SSE4_2
+static inline uint32_t nonspaces_sse(__m128i x) {
+    const __m128i space_tab = _mm_setr_epi8(SPACE_TAB);
+    __m128i spaces = _mm_cmpeq_epi8(x, _mm_shuffle_epi8(space_tab, x));
+    return ~(uint32_t)_mm_movemask_epi8(spaces) & 0xffff;
+}
+
+// Left-pack the bytes of x selected by the 16-bit keep mask to dst, return
+// the count. It stores 16 bytes at most from dst, which never passes the
+// source block, so dst may trail the source in place.
+TARGET_SSE4_2
+static inline size_t compact16_sse(char *dst, __m128i x, uint32_t keep) {
+    uint32_t lo = keep & 0xff;
+    uint32_t hi = keep >> 8;
+    __m128i shuf = _mm_set_epi64x(
+        (long long)(compact_lut[hi] + 0x0808080808080808ull), (long long)compact_lut[lo]);
+    __m128i packed = _mm_shuffle_epi8(x, shuf);
+    size_t n = _mm_popcnt_u32(lo);
+    _mm_storel_epi64((__m128i *)dst, packed);
+    _mm_storel_epi64((__m128i *)(dst + n), _mm_unpackhi_epi64(packed, packed));
+    return n + _mm_popcnt_u32(hi);
+}
+
+// the tail is padded with spaces, which are compacted away. It is packed to
+// a buffer, 16 bytes from dst may pass the end of dst.
+TARGET_SSE4_2
+static inline size_t compact_tail_sse(char *dst, const char *src, size_t len) {
+    char out[16];
+    __m128i x = load_tail_si128(src, len, ' ');
+    size_t n = compact16_sse(out, x, nonspaces_sse(x));
+    memcpy(dst, out, n);
+    return n;
+}
+
+TARGET_SSE4_2
+int compact_sse(char *dst, const char *src, size_t len) {
+    char *dp = dst;
+    while (len >= 16) {
+        __m128i x = _mm_loadu_si128((__m128i *)src);
+        dp  += compact16_sse(dp, x, nonspaces_sse(x));
+        src += 16;
+        len -= 16;
+    }
+    dp += compact_tail_sse(dp, src, len);
+    return dp - dst;
+}
+
+TARGET_AVX2
+int compact_avx2(char *dst, const char *src, size_t len) {
+    const __m256i space_tab = _mm256_setr_epi8(SPACE_TAB, SPACE_TAB);
+    char *dp = dst;
+    while (len >= 32) {
+        __m256i  x = _mm256_loadu_si256((__m256i *)src);
+        __m256i  spaces = _mm256_cmpeq_epi8(x, _mm256_shuffle_epi8(space_tab, x));
+        uint32_t keep = ~(uint32_t)_mm256_movemask_epi8(spaces);
+        dp  += compact16_sse(dp, _mm256_castsi256_si128(x), keep & 0xffff);
+        dp  += compact16_sse(dp, _mm256_extracti128_si256(x, 1), keep >> 16);
+        src += 32;
+        len -= 32;
+    }
+    if (len >= 16) {
+        __m128i x = _mm_loadu_si128((__m128i *)src);
+        dp  += compact16_sse(dp, x, nonspaces_sse(x));
+        src += 16;
+        len -= 16;
+    }
+    dp += compact_tail_sse(dp, src, len);
+    return dp - dst;
+}
+
+// vpcompressb left-packs the whole 64-byte block, needs AVX512_VBMI2.
+TARGET_AVX512_VBMI2
+int compact_avx512(char *dst, const char *src, size_t len) {
+    const __m512i space_tab = _mm512_broadcast_i32x4(_mm_setr_epi8(SPACE_TAB));
+    char *dp = dst;
+    while (len >= 64) {
+        __m512i   x    = _mm512_loadu_si512((__m512i *)src);
+        __mmask64 keep = _mm512_cmpneq_epi8_mask(x, _mm512_shuffle_epi8(space_tab, x));
+        _mm512_storeu_si512((__m512i *)dp, _mm512_maskz_compress_epi8(keep, x));
+        dp  += _mm_popcnt_u64(keep);
+        src += 64;
+        len -= 64;
+    }
+    if (len > 0) {
+        __mmask64 tail = _bzhi_u64(~0ull, len);
+        __m512i   x    = _mm512_maskz_loadu_epi8(tail, src);
+        __mmask64 keep = _mm512_cmpneq_epi8_mask(x, _mm512_shuffle_epi8(space_tab, x)) & tail;
+        size_t    n    = _mm_popcnt_u64(keep);
+        _mm512_mask_storeu_epi8(dp, _bzhi_u64(~0ull, n), _mm512_maskz_compress_epi8(keep, x));
+        dp += n;
+    }
+    return dp - dst;
+}
+
+#undef SPACE_TAB
+
+// qstrlen scans the string after the start quote in 64-byte blocks, with one
+// bit per byte for the backslashes and the quotes, see escape.h.
+
+// Scan the bits of a block of nbytes bytes, return true when the result is
+// known and stored to count: -1 for an invalid escape, or the unquoted length
+// when the block has the ending quote. The escape of the byte after a partial
+// block goes to prev_escaped, for the next chunk of a stream.
+static inline bool qstrlen_block(uint64_t backslash, uint64_t quote, size_t nbytes,
+                                 uint64_t *prev_escaped, int *count) {
+    uint64_t escaped = find_escaped(backslash, prev_escaped);
+    if (nbytes < 64) {
+        *prev_escaped = escaped >> nbytes & 1;
+        escaped &= ((1ull << nbytes) - 1);
+    }
+    uint64_t escapes = backslash & ~escaped;
+    uint64_t invalid = escaped & ~(backslash | quote);
+    quote &= ~escaped;
+    if (quote != 0) {
+        // the bytes before the ending quote
+        uint64_t before = (quote ^ (quote - 1)) >> 1;
+        if (invalid & before) {
+            *count = -1;
+        } else {
+            *count += __builtin_ctzll(quote) - __builtin_popcountll(escapes & before);
+        }
+        return true;
+    }
+    if (invalid) {
+        *count = -1;
+        return true;
+    }
+    *count += nbytes - __builtin_popcountll(escapes);
+    return false;
+}
+
+// The phases of simdstr_qstrlen_state_t.
+enum { QSTRLEN_START, QSTRLEN_STRING, QSTRLEN_DONE };
+
+typedef bool (*qstrlen_scan_t)(const char *src, size_t len, uint64_t *prev_escaped, int *count);
+
+// Feed a chunk of the quoted string to the scan of a kernel. The start quote
+// is checked on the first byte of the stream, the scan state carries the
+// escape and the count to the next chunk.
+static inline bool qstrlen_update(simdstr_qstrlen_state_t *st, const char *src, size_t len,
+                                  qstrlen_scan_t scan) {
+    if (st->phase == QSTRLEN_DONE) {
+        return true;
+    }
+    if (st->phase == QSTRLEN_START) {
+        if (len == 0) {
+            return false;
+        }
+        if (src[0] != '"') {
+            st->count = -1;
+            st->phase = QSTRLEN_DONE;
+            return true;
+        }
+        st->phase = QSTRLEN_STRING;
+        src++, len--;
+    }
+    if (scan(src, len, &st->prev_escaped, &st->count)) {
+        st->phase = QSTRLEN_DONE;
+        return true;
+    }
+    return false;
+}
+
+// the byte loop of qstrlen_naive, resumable
+bool qstrlen_update_naive(simdstr_qstrlen_state_t *st, const char *src, size_t len) {
+    for (size_t i = 0; i < len && st->phase != QSTRLEN_DONE; i++) {
+        char c = src[i];
+        if (st->phase == QSTRLEN_START) {
+            st->phase = c == '"' ? QSTRLEN_STRING : QSTRLEN_DONE;
+            st->count = c == '"' ? 0 : -1;
+        } else if (st->prev_escaped) {
+            st->prev_escaped = 0;
+            if (c != '\\' && c != '"') {
+                st->count = -1;
+                st->phase = QSTRLEN_DONE;
+            } else {
+                st->count++;
+            }
+        } else if (c == '\\') {
+            st->prev_escaped = 1;
+        } else if (c == '"') {
+            st->phase = QSTRLEN_DONE;
+        } else {
+            st->count++;
+        }
+    }
+    return st->phase == QSTRLEN_DONE;
+}
+
+void simdstr_qstrlen_init(simdstr_qstrlen_state_t *st) {
+    st->prev_escaped = 0;
+    st->count = 0;
+    st->phase = QSTRLEN_START;
+}
+
+int simdstr_qstrlen_final(const simdstr_qstrlen_state_t *st) {
+    return st->phase == QSTRLEN_DONE ? st->count : -1;
+}
+
+TARGET_SSE4_2
+static inline void qstrlen_masks_sse(const char *p, uint64_t *backslash, uint64_t *quote) {
+    const __m128i bs = _mm_set1_epi8('\\');
+    const __m128i qt = _mm_set1_epi8('"');
+    uint64_t b = 0, q = 0;
+    for (int i = 0; i < 4; i++) {
+        __m128i x = _mm_loadu_si128((__m128i *)(p + 16 * i));
+        b |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, bs)) << (16 * i);
+        q |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, qt)) << (16 * i);
+    }
+    *backslash = b;
+    *quote = q;
+}
+
+TARGET_AVX2
+static inline void qstrlen_masks_avx2(const char *p, uint64_t *backslash, uint64_t *quote) {
+    const __m256i bs = _mm256_set1_epi8('\\');
+    const __m256i qt = _mm256_set1_epi8('"');
+    __m256i lo = _mm256_loadu_si256((__m256i *)p);
+    __m256i hi = _mm256_loadu_si256((__m256i *)(p + 32));
+    *backslash = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, bs))
+        | (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, bs)) << 32;
+    *quote = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, qt))
+        | (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, qt)) << 32;
+}
+
+// The tail is scanned in place when its 64-byte block stays in the page, its
+// bits past len are cleared. Otherwise it is copied into a zeroed block, zero
+// is neither a quote nor a backslash.
+TARGET_SSE4_2
+static inline bool qstrlen_scan_sse(const char *src, size_t len, uint64_t *prev_escaped, int *count) {
+    uint64_t backslash, quote;
+    while (len >= 64) {
+        qstrlen_masks_sse(src, &backslash, &quote);
+        if (qstrlen_block(backslash, quote, 64, prev_escaped, count)) {
+            return true;
+        }
+        src += 64;
+        len -= 64;
+    }
+    if (len == 0) {
+        return false;
+    }
+    if (tail_in_page(src, 64)) {
+        qstrlen_masks_sse(src, &backslash, &quote);
+        backslash &= (1ull << len) - 1;
+        quote     &= (1ull << len) - 1;
+    } else {
+        char buf[64] = {0};
+        memcpy(buf, src, len);
+        qstrlen_masks_sse(buf, &backslash, &quote);
+    }
+    return qstrlen_block(backslash, quote, len, prev_escaped, count);
+}
+
+TARGET_SSE4_2
+int qstrlen_sse(const char *src, size_t len) {
+    uint64_t prev_escaped = 0;
+    int count = 0;
+    if (len == 0 || src[0] != '"') {
+        return -1;
+    }
+    return qstrlen_scan_sse(src + 1, len - 1, &prev_escaped, &count) ? count : -1;
+}
+
+TARGET_SSE4_2
+bool qstrlen_update_sse(simdstr_qstrlen_state_t *st, const char *src, size_t len) {
+    return qstrlen_update(st, src, len, qstrlen_scan_sse);
+}
+
+TARGET_AVX2
+static inline bool qstrlen_scan_avx2(const char *src, size_t len, uint64_t *prev_escaped, int *count) {
+    uint64_t backslash, quote;
+    while (len >= 64) {
+        qstrlen_masks_avx2(src, &backslash, &quote);
+        if (qstrlen_block(backslash, quote, 64, prev_escaped, count)) {
+            return true;
+        }
+        src += 64;
+        len -= 64;
+    }
+    if (len == 0) {
+        return false;
+    }
+    if (tail_in_page(src, 64)) {
+        qstrlen_masks_avx2(src, &backslash, &quote);
+        backslash &= (1ull << len) - 1;
+        quote     &= (1ull << len) - 1;
+    } else {
+        char buf[64] = {0};
+        memcpy(buf, src, len);
+        qstrlen_masks_avx2(buf, &backslash, &quote);
+    }
+    return qstrlen_block(backslash, quote, len, prev_escaped, count);
+}
+
+TARGET_AVX2
+int qstrlen_avx2(const char *src, size_t len) {
+    uint64_t prev_escaped = 0;
+    int count = 0;
+    if (len == 0 || src[0] != '"') {
+        return -1;
+    }
+    return qstrlen_scan_avx2(src + 1, len - 1, &prev_escaped, &count) ? count : -1;
+}
+
+TARGET_AVX2
+bool qstrlen_update_avx2(simdstr_qstrlen_state_t *st, const char *src, size_t len) {
+    return qstrlen_update(st, src, len, qstrlen_scan_avx2);
+}
+
+TARGET_AVX512
+static inline bool qstrlen_scan_avx512(const char *src, size_t len, uint64_t *prev_escaped,
+                                       int *count) {
+    const __m512i bs = _mm512_set1_epi8('\\');
+    const __m512i qt = _mm512_set1_epi8('"');
+    while (len >= 64) {
+        __m512i x = _mm512_loadu_si512((__m512i *)src);
+        uint64_t backslash = _mm512_cmpeq_epi8_mask(x, bs);
+        uint64_t quote     = _mm512_cmpeq_epi8_mask(x, qt);
+        if (qstrlen_block(backslash, quote, 64, prev_escaped, count)) {
+            return true;
+        }
+        src += 64;
+        len -= 64;
+    }
+    if (len == 0) {
+        return false;
+    }
+    __m512i x = _mm512_maskz_loadu_epi8(_bzhi_u64(~0ull, len), src);
+    uint64_t backslash = _mm512_cmpeq_epi8_mask(x, bs);
+    uint64_t quote     = _mm512_cmpeq_epi8_mask(x, qt);
+    return qstrlen_block(backslash, quote, len, prev_escaped, count);
+}
+
+TARGET_AVX512
+int qstrlen_avx512(const char *src, size_t len) {
+    uint64_t prev_escaped = 0;
+    int count = 0;
+    if (len == 0 || src[0] != '"') {
+        return -1;
+    }
+    return qstrlen_scan_avx512(src + 1, len - 1, &prev_escaped, &count) ? count : -1;
+}
+
+TARGET_AVX512
+bool qstrlen_update_avx512(simdstr_qstrlen_state_t *st, const char *src, size_t len) {
+    return qstrlen_update(st, src, len, qstrlen_scan_avx512);
+}
+
+// Byte frequency ranks of typical text, markup and code, higher is more
+// common. strstr filters the haystack on the two rarest needle bytes.
+static const uint8_t byte_rank[256] = {
+    109, 108, 107, 106, 105, 104, 103, 102, 101, 197, 240, 100,  99, 196,  98,  97,
+     96,  95,  94,  93,  92,  91,  90,  89,  88,  87,  86,  85,  84,  83,  82,  81,
+    255, 165, 231, 172, 161, 167, 174, 191, 199, 198, 173, 171, 234, 224, 233, 222,
+    228, 227, 223, 211, 207, 208, 201, 200, 202, 205, 226, 179, 178, 221, 177, 166,
+    162, 217, 194, 215, 203, 214, 193, 189, 195, 216, 175, 184, 204, 210, 212, 209,
+    206, 169, 213, 218, 219, 187, 185, 190, 170, 176, 168, 181, 163, 180, 159, 225,
+    158, 252, 232, 243, 244, 254, 239, 237, 246, 250, 192, 229, 245, 241, 249, 251,
+    238, 188, 247, 248, 253, 242, 230, 236, 220, 235, 186, 183, 164, 182, 160,  80,
+    156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156,
+    156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156,
+    156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156,
+    156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156, 156,
+     79,  78, 139, 138, 137, 136, 135, 134, 133, 132, 131, 130, 129, 128, 127, 126,
+    125, 124, 123, 122, 121, 120, 119, 118, 117, 116, 115, 114, 113, 112, 111, 110,
+    155, 154, 153, 152, 151, 150, 149, 148, 147, 146, 145, 144, 143, 142, 141, 140,
+     77,  76,  75,  74,  73,  72,  71,  70,  69,  68,  67,  66,  65,  64,  63,  62,
+};
+
+// Needles longer than this are searched with Two-Way, which stays linear
+// where the candidates of the pair filter would be verified over and over.
+#define STRSTR_PAIR_MAX 32
+
+// the ASCII lower case of c when icase, the case-insensitive kernels compare
+// the bytes folded this way
+static inline uint8_t fold_case(uint8_t c, bool icase) {
+    return icase && (uint8_t)(c - 'A') < 26 ? c | 0x20 : c;
+}
+
+// Positions of the two rarest bytes of the needle, a distinct byte for the
+// second one when the needle has it. The letters rank as their lower case
+// when icase, the more common one.
+static inline void strstr_rare_pair(const char *substr, size_t sn, bool icase, size_t *i1, size_t *i2) {
+    const uint8_t *ns = (const uint8_t *)substr;
+    size_t r1 = 0;
+    for (size_t i = 1; i < sn; i++) {
+        if (byte_rank[fold_case(ns[i], icase)] < byte_rank[fold_case(ns[r1], icase)]) r1 = i;
+    }
+    size_t r2 = r1;
+    unsigned best = ~0u;
+    for (size_t i = 0; i < sn; i++) {
+        uint8_t c = fold_case(ns[i], icase);
+        unsigned score = byte_rank[c] + (c == fold_case(ns[r1], icase) ? 256 : 0);
+        if (i != r1 && score < best) {
+            r2 = i;
+            best = score;
+        }
+    }
+    *i1 = r1;
+    *i2 = r2;
+}
+
+// Two-Way string matching (Crochemore-Perrin) with the bad-character shift
+// on the last byte of the window, as in musl's memmem. With icase every byte
+// is compared folded, the needle and the haystack are not copied.
+static inline char* twoway(const char *str, size_t n, const char *substr, size_t sn, bool icase) {
+    const uint8_t *h = (const uint8_t *)str;
+    const uint8_t *z = h + n;
+    const uint8_t *ns = (const uint8_t *)substr;
+    size_t ip, jp, k, p, ms, p0, mem, mem0;
+    uint64_t byteset[4] = {0};
+    size_t shift[256];
+
+#define NS(i) fold_case(ns[i], icase)
+#define H(i)  fold_case(h[i], icase)
+    for (size_t i = 0; i < sn; i++) {
+        byteset[NS(i) >> 6] |= 1ull << (NS(i) & 63);
+        shift[NS(i)] = i + 1;
+    }
+
+    // maximal suffix
+    ip = (size_t)-1; jp = 0; k = p = 1;
+    while (jp + k < sn) {
+        if (NS(ip + k) == NS(jp + k)) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            } else {
+                k++;
+            }
+        } else if (NS(ip + k) > NS(jp + k)) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        } else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    ms = ip;
+    p0 = p;
+
+    // and with the opposite comparison
+    ip = (size_t)-1; jp = 0; k = p = 1;
+    while (jp + k < sn) {
+        if (NS(ip + k) == NS(jp + k)) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            } else {
+                k++;
+            }
+        } else if (NS(ip + k) < NS(jp + k)) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        } else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    if (ip + 1 > ms + 1) {
+        ms = ip;
+    } else {
+        p = p0;
+    }
+
+    // periodic needle?
+    if (icase ? !memcaseeq_sse(substr, substr + p, ms + 1) : memcmp(ns, ns + p, ms + 1) != 0) {
+        mem0 = 0;
+        p = (ms > sn - ms - 1 ? ms : sn - ms - 1) + 1;
+    } else {
+        mem0 = sn - p;
+    }
+    mem = 0;
+
+    for (;;) {
+        if ((size_t)(z - h) < sn) {
+            return NULL;
+        }
+
+        // check the last byte first, advance by shift on mismatch
+        uint8_t last = H(sn - 1);
+        if (byteset[last >> 6] & (1ull << (last & 63))) {
+            k = sn - shift[last];
+            if (k) {
+                if (k < mem) k = mem;
+                h += k;
+                mem = 0;
+                continue;
+            }
+        } else {
+            h += sn;
+            mem = 0;
+            continue;
+        }
+
+        // compare the right half
+        for (k = ms + 1 > mem ? ms + 1 : mem; k < sn && NS(k) == H(k); k++);
+        if (k < sn) {
+            h += k - ms;
+            mem = 0;
+            continue;
+        }
+        // compare the left half
+        for (k = ms + 1; k > mem && NS(k - 1) == H(k - 1); k--);
+        if (k <= mem) {
+            return (char *)h;
+        }
+        h += p;
+        mem = mem0;
+    }
+#undef NS
+#undef H
+}
+
+static char* strstr_twoway(const char *str, size_t n, const char *substr, size_t sn) {
+    return twoway(str, n, substr, sn, false);
+}
+
+static char* strcasestr_twoway(const char *str, size_t n, const char *substr, size_t sn) {
+    return twoway(str, n, substr, sn, true);
+}
+
+// Filter 16 candidate positions at once from p on. The loads of the pair
+// bytes never pass the last candidate, so they stay in the haystack.
+TARGET_SSE4_2
+static inline char* strstr_pair_sse(const char *str, size_t n, const char *substr, size_t sn,
+                                    size_t i1, size_t i2, size_t p) {
+    const __m128i c1 = _mm_set1_epi8(substr[i1]);
+    const __m128i c2 = _mm_set1_epi8(substr[i2]);
+    size_t ncand = n - sn + 1;
+    if (ncand < 16) {
+        if (p >= ncand) {
+            return NULL;
+        }
+        // the pair bytes of the candidates are in the haystack
+        __m128i  a = load_tail_si128(str + p + i1, ncand - p, 0);
+        __m128i  b = load_tail_si128(str + p + i2, ncand - p, 0);
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, c1), _mm_cmpeq_epi8(b, c2)));
+        mask &= (1u << (ncand - p)) - 1;
+        while (mask != 0) {
+            size_t k = __builtin_ctz(mask);
+            if (memcmpeq_sse(str + p + k, substr, sn)) {
+                return (char *)str + p + k;
+            }
+            mask &= mask - 1;
+        }
+        return NULL;
+    }
+    while (p < ncand) {
+        uint32_t skip = 0;
+        if (p + 16 > ncand) {
+            // overlapping final block, skip the checked positions
+            skip = p - (ncand - 16);
+            p = ncand - 16;
+        }
+        __m128i  a = _mm_loadu_si128((__m128i *)(str + p + i1));
+        __m128i  b = _mm_loadu_si128((__m128i *)(str + p + i2));
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, c1), _mm_cmpeq_epi8(b, c2)));
+        mask &= ~0u << skip;
+        while (mask != 0) {
+            size_t k = __builtin_ctz(mask);
+            if (memcmpeq_sse(str + p + k, substr, sn)) {
+                return (char *)str + p + k;
+            }
+            mask &= mask - 1;
+        }
+        p += 16;
+    }
+    return NULL;
+}
+
+// Match the substr in str like strstr_naive: the empty substr, or a substr
+// longer than str, matches at str. A single byte is a memchr.
+TARGET_SSE4_2
+char* strstr_sse(const char *str, size_t n, const char *substr, size_t sn) {
+    if (sn == 0 || sn > n) {
+        return (char *)str;
+    }
+    if (sn == 1) {
+        return memchr_sse(str, substr[0], n);
+    }
+    if (sn > STRSTR_PAIR_MAX) {
+        return strstr_twoway(str, n, substr, sn);
+    }
+    size_t i1, i2;
+    strstr_rare_pair(substr, sn, false, &i1, &i2);
+    return strstr_pair_sse(str, n, substr, sn, i1, i2, 0);
+}
+
+TARGET_AVX2
+char* strstr_avx2(const char *str, size_t n, const char *substr, size_t sn) {
+    if (sn == 0 || sn > n) {
+        return (char *)str;
+    }
+    if (sn == 1) {
+        return memchr_avx2(str, substr[0], n);
+    }
+    if (sn > STRSTR_PAIR_MAX) {
+        return strstr_twoway(str, n, substr, sn);
+    }
+    size_t i1, i2;
+    strstr_rare_pair(substr, sn, false, &i1, &i2);
+    const __m256i c1 = _mm256_set1_epi8(substr[i1]);
+    const __m256i c2 = _mm256_set1_epi8(substr[i2]);
+    size_t ncand = n - sn + 1;
+    size_t p = 0;
+    for (; p + 32 <= ncand; p += 32) {
+        __m256i  a = _mm256_loadu_si256((__m256i *)(str + p + i1));
+        __m256i  b = _mm256_loadu_si256((__m256i *)(str + p + i2));
+        __m256i  eq = _mm256_and_si256(_mm256_cmpeq_epi8(a, c1), _mm256_cmpeq_epi8(b, c2));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(eq);
+        while (mask != 0) {
+            size_t k = _tzcnt_u32(mask);
+            if (memcmpeq_avx2(str + p + k, substr, sn)) {
+                return (char *)str + p + k;
+            }
+            mask = _blsr_u32(mask);
+        }
+    }
+    return strstr_pair_sse(str, n, substr, sn, i1, i2, p);
+}
+
+TARGET_AVX512
+char* strstr_avx512(const char *str, size_t n, const char *substr, size_t sn) {
+    if (sn == 0 || sn > n) {
+        return (char *)str;
+    }
+    if (sn == 1) {
+        return memchr_avx512(str, substr[0], n);
+    }
+    if (sn > STRSTR_PAIR_MAX) {
+        return strstr_twoway(str, n, substr, sn);
+    }
+    size_t i1, i2;
+    strstr_rare_pair(substr, sn, false, &i1, &i2);
+    const __m512i c1 = _mm512_set1_epi8(substr[i1]);
+    const __m512i c2 = _mm512_set1_epi8(substr[i2]);
+    size_t ncand = n - sn + 1;
+    for (size_t p = 0; p < ncand; p += 64) {
+        // the last block loads the remaining candidates only
+        __mmask64 load = ncand - p >= 64 ? ~0ull : _bzhi_u64(~0ull, ncand - p);
+        __m512i   a = _mm512_maskz_loadu_epi8(load, str + p + i1);
+        __m512i   b = _mm512_maskz_loadu_epi8(load, str + p + i2);
+        uint64_t  mask = _mm512_mask_cmpeq_epi8_mask(_mm512_cmpeq_epi8_mask(a, c1) & load, b, c2);
+        while (mask != 0) {
+            size_t k = _tzcnt_u64(mask);
+            if (memcmpeq_avx2(str + p + k, substr, sn)) {
+                return (char *)str + p + k;
+            }
+            mask = _blsr_u64(mask);
+        }
+    }
+    return NULL;
+}
+
+// strcasestr filters on the rarest pair like strstr, each pair byte of the
+// haystack ORed with 0x20 when the needle byte is a letter: x | 0x20 equals a
+// lower case letter only for its two cases. The candidates are verified with
+// memcaseeq, the long needles go to the folding Two-Way.
+static inline uint8_t case_or(char c) {
+    return (uint8_t)((c | 0x20) - 'a') < 26 ? 0x20 : 0;
+}
+
+TARGET_SSE4_2
+static inline char* strcasestr_pair_sse(const char *str, size_t n, const char *substr, size_t sn,
+                                        size_t i1, size_t i2, size_t p) {
+    const __m128i o1 = _mm_set1_epi8(case_or(substr[i1]));
+    const __m128i o2 = _mm_set1_epi8(case_or(substr[i2]));
+    const __m128i c1 = _mm_set1_epi8(substr[i1] | case_or(substr[i1]));
+    const __m128i c2 = _mm_set1_epi8(substr[i2] | case_or(substr[i2]));
+    size_t ncand = n - sn + 1;
+    if (ncand < 16) {
+        if (p >= ncand) {
+            return NULL;
+        }
+        __m128i  a = _mm_or_si128(load_tail_si128(str + p + i1, ncand - p, 0), o1);
+        __m128i  b = _mm_or_si128(load_tail_si128(str + p + i2, ncand - p, 0), o2);
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, c1), _mm_cmpeq_epi8(b, c2)));
+        mask &= (1u << (ncand - p)) - 1;
+        while (mask != 0) {
+            size_t k = __builtin_ctz(mask);
+            if (memcaseeq_sse(str + p + k, substr, sn)) {
+                return (char *)str + p + k;
+            }
+            mask &= mask - 1;
+        }
+        return NULL;
+    }
+    while (p < ncand) {
+        uint32_t skip = 0;
+        if (p + 16 > ncand) {
+            // overlapping final block, skip the checked positions
+            skip = p - (ncand - 16);
+            p = ncand - 16;
+        }
+        __m128i  a = _mm_or_si128(_mm_loadu_si128((__m128i *)(str + p + i1)), o1);
+        __m128i  b = _mm_or_si128(_mm_loadu_si128((__m128i *)(str + p + i2)), o2);
+        uint32_t mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, c1), _mm_cmpeq_epi8(b, c2)));
+        mask &= ~0u << skip;
+        while (mask != 0) {
+            size_t k = __builtin_ctz(mask);
+            if (memcaseeq_sse(str + p + k, substr, sn)) {
+                return (char *)str + p + k;
+            }
+            mask &= mask - 1;
+        }
+        p += 16;
+    }
+    return NULL;
+}
+
+// the empty substr, or a substr longer than str, matches at str like strstr
+TARGET_SSE4_2
+char* strcasestr_sse(const char *str, size_t n, const char *substr, size_t sn) {
+    if (sn == 0 || sn > n) {
+        return (char *)str;
+    }
+    if (sn > STRSTR_PAIR_MAX) {
+        return strcasestr_twoway(str, n, substr, sn);
+    }
+    size_t i1, i2;
+    strstr_rare_pair(substr, sn, true, &i1, &i2);
+    return strcasestr_pair_sse(str, n, substr, sn, i1, i2, 0);
+}
+
+TARGET_AVX2
+char* strcasestr_avx2(const char *str, size_t n, const char *substr, size_t sn) {
+    if (sn == 0 || sn > n) {
+        return (char *)str;
+    }
+    if (sn > STRSTR_PAIR_MAX) {
+        return strcasestr_twoway(str, n, substr, sn);
+    }
+    size_t i1, i2;
+    strstr_rare_pair(substr, sn, true, &i1, &i2);
+    const __m256i o1 = _mm256_set1_epi8(case_or(substr[i1]));
+    const __m256i o2 = _mm256_set1_epi8(case_or(substr[i2]));
+    const __m256i c1 = _mm256_set1_epi8(substr[i1] | case_or(substr[i1]));
+    const __m256i c2 = _mm256_set1_epi8(substr[i2] | case_or(substr[i2]));
+    size_t ncand = n - sn + 1;
+    size_t p = 0;
+    for (; p + 32 <= ncand; p += 32) {
+        __m256i  a = _mm256_or_si256(_mm256_loadu_si256((__m256i *)(str + p + i1)), o1);
+        __m256i  b = _mm256_or_si256(_mm256_loadu_si256((__m256i *)(str + p + i2)), o2);
+        __m256i  eq = _mm256_and_si256(_mm256_cmpeq_epi8(a, c1), _mm256_cmpeq_epi8(b, c2));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(eq);
+        while (mask != 0) {
+            size_t k = _tzcnt_u32(mask);
+            if (memcaseeq_avx2(str + p + k, substr, sn)) {
+                return (char *)str + p + k;
+            }
+            mask = _blsr_u32(mask);
+        }
+    }
+    return strcasestr_pair_sse(str, n, substr, sn, i1, i2, p);
+}
+
+TARGET_AVX512
+char* strcasestr_avx512(const char *str, size_t n, const char *substr, size_t sn) {
+    if (sn == 0 || sn > n) {
+        return (char *)str;
+    }
+    if (sn > STRSTR_PAIR_MAX) {
+        return strcasestr_twoway(str, n, substr, sn);
+    }
+    size_t i1, i2;
+    strstr_rare_pair(substr, sn, true, &i1, &i2);
+    const __m512i o1 = _mm512_set1_epi8(case_or(substr[i1]));
+    const __m512i o2 = _mm512_set1_epi8(case_or(substr[i2]));
+    const __m512i c1 = _mm512_set1_epi8(substr[i1] | case_or(substr[i1]));
+    const __m512i c2 = _mm512_set1_epi8(substr[i2] | case_or(substr[i2]));
+    size_t ncand = n - sn + 1;
+    for (size_t p = 0; p < ncand; p += 64) {
+        // the last block loads the remaining candidates only
+        __mmask64 load = ncand - p >= 64 ? ~0ull : _bzhi_u64(~0ull, ncand - p);
+        __m512i   a = _mm512_or_si512(_mm512_maskz_loadu_epi8(load, str + p + i1), o1);
+        __m512i   b = _mm512_or_si512(_mm512_maskz_loadu_epi8(load, str + p + i2), o2);
+        uint64_t  mask = _mm512_mask_cmpeq_epi8_mask(_mm512_cmpeq_epi8_mask(a, c1) & load, b, c2);
+        while (mask != 0) {
+            size_t k = _tzcnt_u64(mask);
+            if (memcaseeq_avx2(str + p + k, substr, sn)) {
+                return (char *)str + p + k;
+            }
+            mask = _blsr_u64(mask);
+        }
+    }
+    return NULL;
+}
+
+#undef STRSTR_PAIR_MAX
+
+// The batch kernels take the strings in groups of 4 when each string of the
+// group fits in a few blocks, all the loads of a group are issued before its
+// results are needed. A string of at most 32 bytes is two overlapping blocks
+// of 16 on SSE and AVX2, one block of 32 on AVX2, and a shorter one is one
+// block past its length masked; on AVX-512 a string of at most 64 bytes is one
+// masked block. The longer strings and the strings after the last group run
+// the inlined kernel of one string, without the indirect call of the dispatch.
+#define BATCH_GROUP 4
+
+void tolower_batch_naive(char *const *dst, const simdstr_slice_t *src, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        tolower_naive(dst[i], src[i].ptr, src[i].len);
+    }
+}
+
+void memcmpeq_batch_naive(const simdstr_slice_t *s1, const simdstr_slice_t *s2, size_t count,
+                          bool *out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = s1[i].len == s2[i].len && memcmpeq_naive(s1[i].ptr, s2[i].ptr, s1[i].len);
+    }
+}
+
+void qstrlen_batch_naive(const simdstr_slice_t *src, size_t count, int *out) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = qstrlen_naive(src[i].ptr, src[i].len);
+    }
+}
+
+// the longest string of a group of the batch
+static inline size_t batch_max_len(const simdstr_slice_t *s) {
+    size_t len = s[0].len;
+    for (int k = 1; k < BATCH_GROUP; k++) {
+        len = s[k].len > len ? s[k].len : len;
+    }
+    return len;
+}
+
+// whether the width bytes from every string of a group stay in its page, an
+// empty string may point past its buffer
+static inline bool batch_in_page(const simdstr_slice_t *s, size_t width) {
+    bool in_page = true;
+    for (int k = 0; k < BATCH_GROUP; k++) {
+        in_page &= s[k].len > 0 && tail_in_page(s[k].ptr, width);
+    }
+    return in_page;
+}
+
+// compare less than 16 bytes with two overlapping words
+static inline bool memcmpeq_small(const char *s1, const char *s2, size_t len) {
+    uint64_t a1, a2, b1, b2;
+    if (len >= 8) {
+        memcpy(&a1, s1, 8);
+        memcpy(&a2, s1 + len - 8, 8);
+        memcpy(&b1, s2, 8);
+        memcpy(&b2, s2 + len - 8, 8);
+        return ((a1 ^ b1) | (a2 ^ b2)) == 0;
+    }
+    if (len >= 4) {
+        uint32_t c1, c2, d1, d2;
+        memcpy(&c1, s1, 4);
+        memcpy(&c2, s1 + len - 4, 4);
+        memcpy(&d1, s2, 4);
+        memcpy(&d2, s2 + len - 4, 4);
+        return ((c1 ^ d1) | (c2 ^ d2)) == 0;
+    }
+    if (len >= 2) {
+        uint16_t e1, e2, f1, f2;
+        memcpy(&e1, s1, 2);
+        memcpy(&e2, s1 + len - 2, 2);
+        memcpy(&f1, s2, 2);
+        memcpy(&f2, s2 + len - 2, 2);
+        return ((e1 ^ f1) | (e2 ^ f2)) == 0;
+    }
+    return len == 0 || *s1 == *s2;
+}
+
+// compare 16 to 32 bytes with two overlapping blocks
+static inline bool memcmpeq_16_32_sse(const char *s1, const char *s2, size_t len) {
+    __m128i x1 = _mm_loadu_si128((__m128i *)s1);
+    __m128i x2 = _mm_loadu_si128((__m128i *)(s1 + len - 16));
+    __m128i y1 = _mm_loadu_si128((__m128i *)s2);
+    __m128i y2 = _mm_loadu_si128((__m128i *)(s2 + len - 16));
+    __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(x1, y1), _mm_cmpeq_epi8(x2, y2));
+    return _mm_movemask_epi8(eq) == 0xffff;
+}
+
+// The first and the last 16 bytes of a string of at most 32, both the string
+// followed by zeros when it is shorter than 16.
+static inline void load_le32_sse(const char *p, size_t len, __m128i *lo, __m128i *hi) {
+    if (len >= 16) {
+        *lo = _mm_loadu_si128((const __m128i *)p);
+        *hi = _mm_loadu_si128((const __m128i *)(p + len - 16));
+    } else {
+        *lo = *hi = load_tail_si128(p, len, 0);
+    }
+}
+
+static inline void store_le32_sse(char *p, size_t len, __m128i lo, __m128i hi) {
+    if (len >= 16) {
+        _mm_storeu_si128((__m128i *)(p + len - 16), hi);
+        _mm_storeu_si128((__m128i *)p, lo);
+    } else {
+        store_tail_si128(p, lo, len);
+    }
+}
+
+// the bits of the bytes of the blocks of load_le32_sse, in the order of the string
+static inline uint32_t le32_bits(uint32_t lo, uint32_t hi, size_t len) {
+    return len > 16 ? lo | hi << (len - 16) : lo;
+}
+
+TARGET_SSE4_2
+void tolower_batch_sse(char *const *dst, const simdstr_slice_t *src, size_t count) {
+    size_t i = 0;
+    for (; i + BATCH_GROUP <= count; i += BATCH_GROUP) {
+        if (batch_max_len(src + i) > 32) {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                convcase_copy_sse(dst[i + k], src[i + k].ptr, src[i + k].len, 'A');
+            }
+            continue;
+        }
+        __m128i lo[BATCH_GROUP], hi[BATCH_GROUP];
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            load_le32_sse(src[i + k].ptr, src[i + k].len, &lo[k], &hi[k]);
+        }
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            store_le32_sse(dst[i + k], src[i + k].len, convcase_sse(lo[k], 'A'), convcase_sse(hi[k], 'A'));
+        }
+    }
+    for (; i < count; i++) {
+        convcase_copy_sse(dst[i], src[i].ptr, src[i].len, 'A');
+    }
+}
+
+TARGET_SSE4_2
+static inline bool memcmpeq_one_sse(const char *s1, const char *s2, size_t len) {
+    if (len < 16) {
+        return memcmpeq_small(s1, s2, len);
+    }
+    if (len <= 32) {
+        return memcmpeq_16_32_sse(s1, s2, len);
+    }
+    return memcmpeq_sse(s1, s2, len);
+}
+
+TARGET_SSE4_2
+void memcmpeq_batch_sse(const simdstr_slice_t *s1, const simdstr_slice_t *s2, size_t count,
+                        bool *out) {
+    size_t i = 0;
+    for (; i + BATCH_GROUP <= count; i += BATCH_GROUP) {
+        size_t width = batch_max_len(s1 + i) <= 16 ? 16 : 32;
+        if (batch_max_len(s1 + i) > 32 || !batch_in_page(s1 + i, width) || !batch_in_page(s2 + i, width)) {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                size_t len = s1[i + k].len;
+                out[i + k] = len == s2[i + k].len && memcmpeq_one_sse(s1[i + k].ptr, s2[i + k].ptr, len);
+            }
+            continue;
+        }
+        // width bytes of every string, the bits past the shorter one dropped: a
+        // length mismatch is unequal anyway
+        uint32_t eq[BATCH_GROUP];
+        if (width == 16) {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                __m128i x = _mm_loadu_si128((const __m128i *)s1[i + k].ptr);
+                __m128i y = _mm_loadu_si128((const __m128i *)s2[i + k].ptr);
+                eq[k] = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+            }
+        } else {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                __m128i x1 = _mm_loadu_si128((const __m128i *)s1[i + k].ptr);
+                __m128i x2 = _mm_loadu_si128((const __m128i *)(s1[i + k].ptr + 16));
+                __m128i y1 = _mm_loadu_si128((const __m128i *)s2[i + k].ptr);
+                __m128i y2 = _mm_loadu_si128((const __m128i *)(s2[i + k].ptr + 16));
+                eq[k] = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x1, y1))
+                      | (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x2, y2)) << 16;
+            }
+        }
+        uint32_t neq[BATCH_GROUP];
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            size_t len = s1[i + k].len < s2[i + k].len ? s1[i + k].len : s2[i + k].len;
+            neq[k] = ~eq[k] & (uint32_t)((1ull << len) - 1);
+        }
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            out[i + k] = s1[i + k].len == s2[i + k].len && neq[k] == 0;
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = s1[i].len == s2[i].len && memcmpeq_one_sse(s1[i].ptr, s2[i].ptr, s1[i].len);
+    }
+}
+
+// Quoted strings of at most max + 1 bytes: the masks of the group first, then
+// the scalar scans of qstrlen_block. An empty string wraps around and is left
+// to the kernel of one string.
+static inline bool qstrlen_batch_fits(const simdstr_slice_t *src, size_t max) {
+    bool fits = true;
+    for (int k = 0; k < BATCH_GROUP; k++) {
+        fits &= src[k].len - 1 <= max;
+    }
+    return fits;
+}
+
+static inline int qstrlen_batch_result(const char *src, uint64_t backslash, uint64_t quote, size_t n) {
+    uint64_t prev_escaped = 0;
+    int      count = 0;
+    return src[0] == '"' && qstrlen_block(backslash, quote, n, &prev_escaped, &count) ? count : -1;
+}
+
+TARGET_SSE4_2
+void qstrlen_batch_sse(const simdstr_slice_t *src, size_t count, int *out) {
+    const __m128i bs = _mm_set1_epi8('\\');
+    const __m128i qt = _mm_set1_epi8('"');
+    size_t i = 0;
+    for (; i + BATCH_GROUP <= count; i += BATCH_GROUP) {
+        if (!qstrlen_batch_fits(src + i, 32)) {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                out[i + k] = qstrlen_sse(src[i + k].ptr, src[i + k].len);
+            }
+            continue;
+        }
+        uint32_t backslash[BATCH_GROUP], quote[BATCH_GROUP];
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            size_t  n = src[i + k].len - 1;
+            __m128i lo, hi;
+            load_le32_sse(src[i + k].ptr + 1, n, &lo, &hi);
+            backslash[k] = le32_bits(_mm_movemask_epi8(_mm_cmpeq_epi8(lo, bs)),
+                                     _mm_movemask_epi8(_mm_cmpeq_epi8(hi, bs)), n);
+            quote[k]     = le32_bits(_mm_movemask_epi8(_mm_cmpeq_epi8(lo, qt)),
+                                     _mm_movemask_epi8(_mm_cmpeq_epi8(hi, qt)), n);
+        }
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            out[i + k] = qstrlen_batch_result(src[i + k].ptr, backslash[k], quote[k], src[i + k].len - 1);
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = qstrlen_sse(src[i].ptr, src[i].len);
+    }
+}
+
+// the two blocks of load_le32_sse in one, the first in the low lane
+TARGET_AVX2
+static inline __m256i load_le32_avx2(const char *p, size_t len) {
+    if (len >= 32) {
+        return _mm256_loadu_si256((const __m256i *)p);
+    }
+    __m128i lo, hi;
+    load_le32_sse(p, len, &lo, &hi);
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+}
+
+TARGET_AVX2
+static inline void store_le32_avx2(char *p, size_t len, __m256i x) {
+    if (len >= 32) {
+        _mm256_storeu_si256((__m256i *)p, x);
+    } else {
+        store_le32_sse(p, len, _mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+    }
+}
+
+TARGET_AVX2
+void tolower_batch_avx2(char *const *dst, const simdstr_slice_t *src, size_t count) {
+    size_t i = 0;
+    for (; i + BATCH_GROUP <= count; i += BATCH_GROUP) {
+        if (batch_max_len(src + i) > 32) {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                convcase_copy_avx2(dst[i + k], src[i + k].ptr, src[i + k].len, 'A');
+            }
+            continue;
+        }
+        __m256i x[BATCH_GROUP];
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            x[k] = load_le32_avx2(src[i + k].ptr, src[i + k].len);
+        }
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            store_le32_avx2(dst[i + k], src[i + k].len, convcase_avx2(x[k], 'A'));
+        }
+    }
+    for (; i < count; i++) {
+        convcase_copy_avx2(dst[i], src[i].ptr, src[i].len, 'A');
+    }
+}
+
+TARGET_AVX2
+static inline bool memcmpeq_one_avx2(const char *p1, const char *p2, size_t len) {
+    if (len < 16) {
+        return memcmpeq_small(p1, p2, len);
+    }
+    if (len <= 32) {
+        return memcmpeq_16_32_sse(p1, p2, len);
+    }
+    if (len <= 64) {
+        // two overlapping blocks
+        __m256i x1 = _mm256_loadu_si256((__m256i *)p1);
+        __m256i x2 = _mm256_loadu_si256((__m256i *)(p1 + len - 32));
+        __m256i y1 = _mm256_loadu_si256((__m256i *)p2);
+        __m256i y2 = _mm256_loadu_si256((__m256i *)(p2 + len - 32));
+        __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(x1, y1), _mm256_cmpeq_epi8(x2, y2));
+        return (uint32_t)_mm256_movemask_epi8(eq) == 0xFFFFFFFFu;
+    }
+    return memcmpeq_avx2(p1, p2, len);
+}
+
+TARGET_AVX2
+void memcmpeq_batch_avx2(const simdstr_slice_t *s1, const simdstr_slice_t *s2, size_t count,
+                         bool *out) {
+    size_t i = 0;
+    for (; i + BATCH_GROUP <= count; i += BATCH_GROUP) {
+        size_t width = batch_max_len(s1 + i) <= 16 ? 16 : 32;
+        if (batch_max_len(s1 + i) > 32 || !batch_in_page(s1 + i, width) || !batch_in_page(s2 + i, width)) {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                size_t len = s1[i + k].len;
+                out[i + k] = len == s2[i + k].len && memcmpeq_one_avx2(s1[i + k].ptr, s2[i + k].ptr, len);
+            }
+            continue;
+        }
+        // width bytes of every string, the bits past the shorter one dropped: a
+        // length mismatch is unequal anyway
+        uint32_t eq[BATCH_GROUP];
+        if (width == 16) {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                __m128i x = _mm_loadu_si128((const __m128i *)s1[i + k].ptr);
+                __m128i y = _mm_loadu_si128((const __m128i *)s2[i + k].ptr);
+                eq[k] = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y));
+            }
+        } else {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                __m256i x = _mm256_loadu_si256((const __m256i *)s1[i + k].ptr);
+                __m256i y = _mm256_loadu_si256((const __m256i *)s2[i + k].ptr);
+                eq[k] = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y));
+            }
+        }
+        uint32_t neq[BATCH_GROUP];
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            size_t len = s1[i + k].len < s2[i + k].len ? s1[i + k].len : s2[i + k].len;
+            neq[k] = ~eq[k] & (uint32_t)((1ull << len) - 1);
+        }
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            out[i + k] = s1[i + k].len == s2[i + k].len && neq[k] == 0;
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = s1[i].len == s2[i].len && memcmpeq_one_avx2(s1[i].ptr, s2[i].ptr, s1[i].len);
+    }
+}
+
+TARGET_AVX2
+void qstrlen_batch_avx2(const simdstr_slice_t *src, size_t count, int *out) {
+    const __m256i bs = _mm256_set1_epi8('\\');
+    const __m256i qt = _mm256_set1_epi8('"');
+    size_t i = 0;
+    for (; i + BATCH_GROUP <= count; i += BATCH_GROUP) {
+        if (!qstrlen_batch_fits(src + i, 32)) {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                out[i + k] = qstrlen_avx2(src[i + k].ptr, src[i + k].len);
+            }
+            continue;
+        }
+        uint32_t backslash[BATCH_GROUP], quote[BATCH_GROUP];
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            size_t   n = src[i + k].len - 1;
+            __m256i  x = load_le32_avx2(src[i + k].ptr + 1, n);
+            uint32_t b = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, bs));
+            uint32_t q = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, qt));
+            backslash[k] = n >= 32 ? b : le32_bits(b & 0xFFFF, b >> 16, n);
+            quote[k]     = n >= 32 ? q : le32_bits(q & 0xFFFF, q >> 16, n);
+        }
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            out[i + k] = qstrlen_batch_result(src[i + k].ptr, backslash[k], quote[k], src[i + k].len - 1);
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = qstrlen_avx2(src[i].ptr, src[i].len);
+    }
+}
+
+TARGET_AVX512
+void tolower_batch_avx512(char *const *dst, const simdstr_slice_t *src, size_t count) {
+    const __m512i flip = _mm512_set1_epi8(0x20);
+    size_t i = 0;
+    for (; i + BATCH_GROUP <= count; i += BATCH_GROUP) {
+        if (batch_max_len(src + i) > 64) {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                convcase_copy_avx512(dst[i + k], src[i + k].ptr, src[i + k].len, 'A');
+            }
+            continue;
+        }
+        __mmask64 tail[BATCH_GROUP];
+        __m512i   x[BATCH_GROUP];
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            tail[k] = _bzhi_u64(~0ull, src[i + k].len);
+            x[k] = _mm512_maskz_loadu_epi8(tail[k], src[i + k].ptr);
+        }
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            __mmask64 in = letters_avx512(x[k], 'A');
+            __m512i   y  = _mm512_mask_blend_epi8(in, x[k], _mm512_xor_si512(x[k], flip));
+            _mm512_mask_storeu_epi8(dst[i + k], tail[k], y);
+        }
+    }
+    for (; i < count; i++) {
+        convcase_copy_avx512(dst[i], src[i].ptr, src[i].len, 'A');
+    }
+}
+
+TARGET_AVX512
+void memcmpeq_batch_avx512(const simdstr_slice_t *s1, const simdstr_slice_t *s2, size_t count,
+                           bool *out) {
+    size_t i = 0;
+    for (; i + BATCH_GROUP <= count; i += BATCH_GROUP) {
+        if (batch_max_len(s1 + i) > 64) {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                size_t len = s1[i + k].len;
+                out[i + k] = len == s2[i + k].len && memcmpeq_avx512(s1[i + k].ptr, s2[i + k].ptr, len);
+            }
+            continue;
+        }
+        // the loads stop at the shorter string, a length mismatch is unequal anyway
+        __mmask64 neq[BATCH_GROUP];
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            size_t    len  = s1[i + k].len < s2[i + k].len ? s1[i + k].len : s2[i + k].len;
+            __mmask64 tail = _bzhi_u64(~0ull, len);
+            __m512i   x    = _mm512_maskz_loadu_epi8(tail, s1[i + k].ptr);
+            __m512i   y    = _mm512_maskz_loadu_epi8(tail, s2[i + k].ptr);
+            neq[k] = _mm512_cmpneq_epi8_mask(x, y);
+        }
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            out[i + k] = s1[i + k].len == s2[i + k].len && neq[k] == 0;
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = s1[i].len == s2[i].len && memcmpeq_avx512(s1[i].ptr, s2[i].ptr, s1[i].len);
+    }
+}
+
+// A group of quoted strings of at most 65 bytes: the masks of all of them
+// first, then the scalar scans of qstrlen_block.
+TARGET_AVX512
+void qstrlen_batch_avx512(const simdstr_slice_t *src, size_t count, int *out) {
+    const __m512i bs = _mm512_set1_epi8('\\');
+    const __m512i qt = _mm512_set1_epi8('"');
+    size_t i = 0;
+    for (; i + BATCH_GROUP <= count; i += BATCH_GROUP) {
+        if (!qstrlen_batch_fits(src + i, 64)) {
+            for (int k = 0; k < BATCH_GROUP; k++) {
+                out[i + k] = qstrlen_avx512(src[i + k].ptr, src[i + k].len);
+            }
+            continue;
+        }
+        uint64_t backslash[BATCH_GROUP], quote[BATCH_GROUP];
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            __mmask64 tail = _bzhi_u64(~0ull, src[i + k].len - 1);
+            __m512i   x    = _mm512_maskz_loadu_epi8(tail, src[i + k].ptr + 1);
+            backslash[k] = _mm512_cmpeq_epi8_mask(x, bs);
+            quote[k]     = _mm512_cmpeq_epi8_mask(x, qt);
+        }
+        for (int k = 0; k < BATCH_GROUP; k++) {
+            out[i + k] = qstrlen_batch_result(src[i + k].ptr, backslash[k], quote[k], src[i + k].len - 1);
+        }
+    }
+    for (; i < count; i++) {
+        out[i] = qstrlen_avx512(src[i].ptr, src[i].len);
+    }
 }
-#endif
 
-// TODO: implememt follow functions
-// char* tolower_simd(char *dst, const char *src, size_t len);
-// int   compact_simd(char *dst, const char *src, size_t len);
-// int   qstrlen_simd(const char *src, size_t len);
-// char* strstr_simd(const char *str, size_t n, const char *substr, size_t sn);
\ No newline at end of file
+#undef BATCH_GROUP
@@ -0,0 +1,417 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "isa.h"
+#include "simdstr.h"
+
+// Pattern sets up to this size are scanned with Teddy, larger ones with
+// Aho-Corasick only. Teddy has 8 buckets, so more patterns per bucket mean
+// more candidates to verify.
+#define TEDDY_MAX_PATTERNS 32
+#define TEDDY_BUCKETS      8
+#define TEDDY_MAX_MASKS    3
+
+// Teddy: a position is a candidate of bucket b when each of its first nmasks
+// bytes has bucket bit b set in both tables of its nibbles. The tables are
+// looked up for 16/32 positions at once with pshufb.
+struct teddy {
+    int      nmasks;
+    uint8_t  lo[TEDDY_MAX_MASKS][16];
+    uint8_t  hi[TEDDY_MAX_MASKS][16];
+    size_t  *ids;                         // pattern ids grouped by bucket
+    size_t   bucket_start[TEDDY_BUCKETS + 1];
+};
+
+// Aho-Corasick as a DFA over the byte classes of the patterns, the bytes in
+// no pattern share class 0.
+struct aho {
+    size_t    nclasses;
+    uint8_t   classes[256];
+    uint32_t *next;                       // nstates * nclasses transitions
+    uint32_t *out_start;                  // the matches of each state in out_ids
+    uint32_t *out_len;
+    uint32_t *out_ids;
+};
+
+struct strstr_multi {
+    size_t   count;
+    char    *bytes;                       // the patterns back to back
+    size_t  *offsets;
+    size_t  *lens;
+    bool     use_teddy;
+    struct teddy teddy;
+    struct aho   aho;
+};
+
+// the state of one scan
+struct scan {
+    const strstr_multi_t *m;
+    const char           *str;
+    size_t                n;
+    strstr_multi_fn       on_match;
+    void                 *ctx;
+    size_t                nmatch;
+};
+
+// report a match, return false once the callback stops the scan.
+static inline bool report(struct scan *sc, size_t id, size_t offset) {
+    sc->nmatch++;
+    return sc->on_match(id, offset, sc->ctx);
+}
+
+static int cmp_prefix(const strstr_multi_t *m, size_t a, size_t b, int nmasks) {
+    return memcmp(m->bytes + m->offsets[a], m->bytes + m->offsets[b], nmasks);
+}
+
+static bool teddy_build(strstr_multi_t *m) {
+    struct teddy *t = &m->teddy;
+    size_t minlen = m->lens[0];
+    for (size_t i = 1; i < m->count; i++) {
+        if (m->lens[i] < minlen) minlen = m->lens[i];
+    }
+    t->nmasks = minlen < TEDDY_MAX_MASKS ? (int)minlen : TEDDY_MAX_MASKS;
+
+    t->ids = malloc(m->count * sizeof(size_t));
+    if (t->ids == NULL) {
+        return false;
+    }
+    // sort by the fingerprint bytes, so the patterns of a bucket look alike
+    for (size_t i = 0; i < m->count; i++) {
+        size_t j = i;
+        for (; j > 0 && cmp_prefix(m, t->ids[j - 1], i, t->nmasks) > 0; j--) {
+            t->ids[j] = t->ids[j - 1];
+        }
+        t->ids[j] = i;
+    }
+
+    memset(t->lo, 0, sizeof(t->lo));
+    memset(t->hi, 0, sizeof(t->hi));
+    for (int b = 0; b <= TEDDY_BUCKETS; b++) {
+        t->bucket_start[b] = m->count * b / TEDDY_BUCKETS;
+    }
+    for (int b = 0; b < TEDDY_BUCKETS; b++) {
+        for (size_t i = t->bucket_start[b]; i < t->bucket_start[b + 1]; i++) {
+            const uint8_t *p = (const uint8_t *)m->bytes + m->offsets[t->ids[i]];
+            for (int k = 0; k < t->nmasks; k++) {
+                t->lo[k][p[k] & 0xf] |= 1u << b;
+                t->hi[k][p[k] >> 4]  |= 1u << b;
+            }
+        }
+    }
+    return true;
+}
+
+static bool aho_build(strstr_multi_t *m) {
+    struct aho *a = &m->aho;
+
+    bool used[256] = {false};
+    size_t distinct = 0;
+    for (size_t i = 0; i < m->count; i++) {
+        const uint8_t *p = (const uint8_t *)m->bytes + m->offsets[i];
+        for (size_t k = 0; k < m->lens[i]; k++) {
+            distinct += !used[p[k]];
+            used[p[k]] = true;
+        }
+    }
+    // every byte its own class when class 0 would be left without bytes
+    a->nclasses = distinct >= 255 ? 256 : distinct + 1;
+    for (int b = 0, c = 1; b < 256; b++) {
+        a->classes[b] = a->nclasses == 256 ? b : used[b] ? c++ : 0;
+    }
+
+    size_t total = 1;
+    for (size_t i = 0; i < m->count; i++) {
+        total += m->lens[i];
+    }
+    size_t nc = a->nclasses;
+    a->next = calloc(total * nc, sizeof(uint32_t));
+    uint32_t *fail  = calloc(total, sizeof(uint32_t));
+    uint32_t *queue = malloc(total * sizeof(uint32_t));
+    // own matches of a state, linked through the pattern ids
+    size_t   *own_head = malloc(total * sizeof(size_t));
+    size_t   *own_next = malloc(m->count * sizeof(size_t));
+    a->out_start = malloc(total * sizeof(uint32_t));
+    a->out_len   = malloc(total * sizeof(uint32_t));
+    bool ok = a->next && fail && queue && own_head && own_next && a->out_start && a->out_len;
+    if (!ok) {
+        goto done;
+    }
+
+    // the trie, 0 is both the root and "no edge" as no edge goes to the root
+    size_t nstates = 1;
+    for (size_t s = 0; s < total; s++) {
+        own_head[s] = SIZE_MAX;
+    }
+    for (size_t i = 0; i < m->count; i++) {
+        const uint8_t *p = (const uint8_t *)m->bytes + m->offsets[i];
+        uint32_t s = 0;
+        for (size_t k = 0; k < m->lens[i]; k++) {
+            uint32_t *edge = &a->next[s * nc + a->classes[p[k]]];
+            if (*edge == 0) {
+                *edge = (uint32_t)nstates++;
+            }
+            s = *edge;
+        }
+        own_next[i] = own_head[s];
+        own_head[s] = i;
+    }
+
+    // breadth first: the fail links, the missing edges, and the matches of
+    // each state followed by those of its fail state
+    size_t nout = 0, cap = total;
+    a->out_ids = malloc(cap * sizeof(uint32_t));
+    if (a->out_ids == NULL) {
+        ok = false;
+        goto done;
+    }
+    size_t head = 0, tail = 0;
+    queue[tail++] = 0;
+    while (head < tail) {
+        uint32_t s = queue[head++];
+        uint32_t f = fail[s];
+
+        size_t own = 0;
+        for (size_t i = own_head[s]; i != SIZE_MAX; i = own_next[i]) own++;
+        size_t need = nout + own + (s == 0 ? 0 : a->out_len[f]);
+        if (need > cap) {
+            while (cap < need) cap *= 2;
+            uint32_t *ids = realloc(a->out_ids, cap * sizeof(uint32_t));
+            if (ids == NULL) {
+                ok = false;
+                goto done;
+            }
+            a->out_ids = ids;
+        }
+        a->out_start[s] = (uint32_t)nout;
+        for (size_t i = own_head[s]; i != SIZE_MAX; i = own_next[i]) {
+            a->out_ids[nout++] = (uint32_t)i;
+        }
+        if (s != 0) {
+            memcpy(a->out_ids + nout, a->out_ids + a->out_start[f], a->out_len[f] * sizeof(uint32_t));
+            nout += a->out_len[f];
+        }
+        a->out_len[s] = (uint32_t)(nout - a->out_start[s]);
+
+        for (size_t c = 0; c < nc; c++) {
+            uint32_t *edge = &a->next[s * nc + c];
+            if (*edge != 0) {
+                fail[*edge] = s == 0 ? 0 : a->next[f * nc + c];
+                queue[tail++] = *edge;
+            } else if (s != 0) {
+                *edge = a->next[f * nc + c];
+            }
+        }
+    }
+
+done:
+    free(fail);
+    free(queue);
+    free(own_head);
+    free(own_next);
+    return ok;
+}
+
+strstr_multi_t* strstr_multi_new(const char *const *patterns, const size_t *lens, size_t count) {
+    if (count == 0) {
+        return NULL;
+    }
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (lens[i] == 0) {
+            return NULL;
+        }
+        total += lens[i];
+    }
+
+    strstr_multi_t *m = calloc(1, sizeof(strstr_multi_t));
+    if (m == NULL) {
+        return NULL;
+    }
+    m->count   = count;
+    m->bytes   = malloc(total);
+    m->offsets = malloc(count * sizeof(size_t));
+    m->lens    = malloc(count * sizeof(size_t));
+    if (m->bytes == NULL || m->offsets == NULL || m->lens == NULL) {
+        strstr_multi_free(m);
+        return NULL;
+    }
+    size_t offset = 0;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(m->bytes + offset, patterns[i], lens[i]);
+        m->offsets[i] = offset;
+        m->lens[i]    = lens[i];
+        offset += lens[i];
+    }
+
+    // Aho-Corasick also backs Teddy below SSE4.2
+    m->use_teddy = count <= TEDDY_MAX_PATTERNS;
+    if ((m->use_teddy && !teddy_build(m)) || !aho_build(m)) {
+        strstr_multi_free(m);
+        return NULL;
+    }
+    return m;
+}
+
+void strstr_multi_free(strstr_multi_t *m) {
+    if (m == NULL) {
+        return;
+    }
+    free(m->bytes);
+    free(m->offsets);
+    free(m->lens);
+    free(m->teddy.ids);
+    free(m->aho.next);
+    free(m->aho.out_start);
+    free(m->aho.out_len);
+    free(m->aho.out_ids);
+    free(m);
+}
+
+static bool aho_scan(struct scan *sc) {
+    const struct aho *a = &sc->m->aho;
+    const uint8_t *p = (const uint8_t *)sc->str;
+    uint32_t s = 0;
+    for (size_t i = 0; i < sc->n; i++) {
+        s = a->next[s * a->nclasses + a->classes[p[i]]];
+        for (uint32_t k = 0; k < a->out_len[s]; k++) {
+            size_t id = a->out_ids[a->out_start[s] + k];
+            if (!report(sc, id, i + 1 - sc->m->lens[id])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// Verify the candidates of a block at offset p, mask has a bit per candidate
+// lane and res the bucket bits of each lane.
+static inline bool teddy_verify(struct scan *sc, size_t p, uint32_t mask, const uint8_t *res) {
+    const strstr_multi_t *m = sc->m;
+    const struct teddy *t = &m->teddy;
+    while (mask != 0) {
+        size_t   j = __builtin_ctz(mask);
+        unsigned buckets = res[j];
+        mask &= mask - 1;
+        while (buckets != 0) {
+            int b = __builtin_ctz(buckets);
+            buckets &= buckets - 1;
+            for (size_t i = t->bucket_start[b]; i < t->bucket_start[b + 1]; i++) {
+                size_t id = t->ids[i];
+                if (p + j + m->lens[id] <= sc->n
+                    && memcmp(sc->str + p + j, m->bytes + m->offsets[id], m->lens[id]) == 0
+                    && !report(sc, id, p + j)) {
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+TARGET_SSE4_2
+static inline __m128i teddy_block_sse(const struct teddy *t, const char *s) {
+    const __m128i nibble = _mm_set1_epi8(0x0f);
+    __m128i res = _mm_set1_epi8((char)0xff);
+    for (int k = 0; k < t->nmasks; k++) {
+        __m128i x  = _mm_loadu_si128((__m128i *)(s + k));
+        __m128i lo = _mm_and_si128(x, nibble);
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), nibble);
+        __m128i lo_tab = _mm_loadu_si128((__m128i *)t->lo[k]);
+        __m128i hi_tab = _mm_loadu_si128((__m128i *)t->hi[k]);
+        res = _mm_and_si128(res, _mm_and_si128(_mm_shuffle_epi8(lo_tab, lo), _mm_shuffle_epi8(hi_tab, hi)));
+    }
+    return res;
+}
+
+// The blocks read nmasks - 1 bytes past their 16 positions, the tail is
+// copied into a zeroed buffer.
+TARGET_SSE4_2
+static bool teddy_scan_sse(struct scan *sc) {
+    const struct teddy *t = &sc->m->teddy;
+    const size_t over = t->nmasks - 1;
+    uint8_t res[16];
+    size_t p = 0;
+    for (; p + 16 + over <= sc->n; p += 16) {
+        __m128i  r = teddy_block_sse(t, sc->str + p);
+        uint32_t mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(r, _mm_setzero_si128())) & 0xffff;
+        if (mask != 0) {
+            _mm_storeu_si128((__m128i *)res, r);
+            if (!teddy_verify(sc, p, mask, res)) return false;
+        }
+    }
+    for (; p < sc->n; p += 16) {
+        char   buf[16 + TEDDY_MAX_MASKS] = {0};
+        size_t rest = sc->n - p;
+        memcpy(buf, sc->str + p, rest < sizeof(buf) ? rest : sizeof(buf));
+        __m128i  r = teddy_block_sse(t, buf);
+        uint32_t mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(r, _mm_setzero_si128())) & 0xffff;
+        if (rest < 16) mask &= (1u << rest) - 1;
+        if (mask != 0) {
+            _mm_storeu_si128((__m128i *)res, r);
+            if (!teddy_verify(sc, p, mask, res)) return false;
+        }
+    }
+    return true;
+}
+
+TARGET_AVX2
+static inline __m256i teddy_block_avx2(const struct teddy *t, const char *s) {
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    __m256i res = _mm256_set1_epi8((char)0xff);
+    for (int k = 0; k < t->nmasks; k++) {
+        __m256i x  = _mm256_loadu_si256((__m256i *)(s + k));
+        __m256i lo = _mm256_and_si256(x, nibble);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(x, 4), nibble);
+        __m256i lo_tab = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)t->lo[k]));
+        __m256i hi_tab = _mm256_broadcastsi128_si256(_mm_loadu_si128((__m128i *)t->hi[k]));
+        res = _mm256_and_si256(res,
+            _mm256_and_si256(_mm256_shuffle_epi8(lo_tab, lo), _mm256_shuffle_epi8(hi_tab, hi)));
+    }
+    return res;
+}
+
+TARGET_AVX2
+static bool teddy_scan_avx2(struct scan *sc) {
+    const struct teddy *t = &sc->m->teddy;
+    const size_t over = t->nmasks - 1;
+    uint8_t res[32];
+    size_t p = 0;
+    for (; p + 32 + over <= sc->n; p += 32) {
+        __m256i  r = teddy_block_avx2(t, sc->str + p);
+        uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(r, _mm256_setzero_si256()));
+        if (mask != 0) {
+            _mm256_storeu_si256((__m256i *)res, r);
+            if (!teddy_verify(sc, p, mask, res)) return false;
+        }
+    }
+    for (; p < sc->n; p += 32) {
+        char   buf[32 + TEDDY_MAX_MASKS] = {0};
+        size_t rest = sc->n - p;
+        memcpy(buf, sc->str + p, rest < sizeof(buf) ? rest : sizeof(buf));
+        __m256i  r = teddy_block_avx2(t, buf);
+        uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(r, _mm256_setzero_si256()));
+        if (rest < 32) mask &= (1u << rest) - 1;
+        if (mask != 0) {
+            _mm256_storeu_si256((__m256i *)res, r);
+            if (!teddy_verify(sc, p, mask, res)) return false;
+        }
+    }
+    return true;
+}
+
+size_t strstr_multi_scan(const strstr_multi_t *m, const char *str, size_t n,
+                         strstr_multi_fn on_match, void *ctx) {
+    struct scan sc = {m, str, n, on_match, ctx, 0};
+    if (m->use_teddy && simdstr_isa() >= SIMDSTR_ISA_AVX2) {
+        teddy_scan_avx2(&sc);
+    } else if (m->use_teddy && simdstr_isa() >= SIMDSTR_ISA_SSE4_2) {
+        teddy_scan_sse(&sc);
+    } else {
+        aho_scan(&sc);
+    }
+    return sc.nmatch;
+}
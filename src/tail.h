@@ -0,0 +1,94 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "isa.h"
+
+// Tail loads shared by the kernels. A load cannot fault while it stays in a
+// page the input touches, so a short tail is loaded as one whole vector from
+// its first byte when that vector ends in the same page, and the lanes past
+// the tail are replaced by a padding value. Only the tails in the last bytes
+// of a page are copied. The over-read is invisible to the program but not to
+// memory checkers such as valgrind.
+#define TAIL_PAGE 4096
+
+static inline bool tail_in_page(const void *p, size_t width) {
+    return ((uintptr_t)p & (TAIL_PAGE - 1)) <= TAIL_PAGE - width;
+}
+
+// min(len, 16) bytes of p, pad in the bytes after them.
+static inline __m128i load_tail_si128(const char *p, size_t len, char pad) {
+    if (len >= 16) {
+        return _mm_loadu_si128((const __m128i *)p);
+    }
+    if (len == 0) {
+        return _mm_set1_epi8(pad);
+    }
+    __m128i x;
+    if (tail_in_page(p, 16)) {
+        x = _mm_loadu_si128((const __m128i *)p);
+    } else {
+        char buf[16] = {0};
+        memcpy(buf, p, len);
+        x = _mm_loadu_si128((const __m128i *)buf);
+    }
+    const __m128i idx = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    __m128i keep = _mm_cmplt_epi8(idx, _mm_set1_epi8((char)len));
+    return _mm_or_si128(_mm_and_si128(keep, x), _mm_andnot_si128(keep, _mm_set1_epi8(pad)));
+}
+
+// min(n, 4) floats of p, pad in the lanes after them.
+static inline __m128 load_tail_ps(const float *p, size_t n, float pad) {
+    if (n >= 4) {
+        return _mm_loadu_ps(p);
+    }
+    if (n == 0) {
+        return _mm_set1_ps(pad);
+    }
+    __m128 x;
+    if (tail_in_page(p, 16)) {
+        x = _mm_loadu_ps(p);
+    } else {
+        float buf[4] = {0};
+        memcpy(buf, p, n * sizeof(float));
+        x = _mm_loadu_ps(buf);
+    }
+    __m128 keep = _mm_castsi128_ps(_mm_cmplt_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32((int)n)));
+    return _mm_or_ps(_mm_and_ps(keep, x), _mm_andnot_ps(keep, _mm_set1_ps(pad)));
+}
+
+// The lane mask of vmaskmovps for min(n, 8) floats, from a sliding window so
+// it needs AVX only.
+TARGET_AVX
+static inline __m256i tail_mask_ps(size_t n) {
+    static const int32_t window[16] = {-1, -1, -1, -1, -1, -1, -1, -1};
+    return _mm256_loadu_si256((const __m256i *)(window + 8 - (n < 8 ? n : 8)));
+}
+
+// the first len < 16 bytes of x to p, in pieces of 8, 4, 2 and 1 bytes
+static inline void store_tail_si128(char *p, __m128i x, size_t len) {
+    if (len & 8) {
+        _mm_storel_epi64((__m128i *)p, x);
+        x = _mm_srli_si128(x, 8);
+        p += 8;
+    }
+    if (len & 4) {
+        uint32_t v = (uint32_t)_mm_cvtsi128_si32(x);
+        memcpy(p, &v, 4);
+        x = _mm_srli_si128(x, 4);
+        p += 4;
+    }
+    if (len & 2) {
+        uint16_t v = (uint16_t)_mm_cvtsi128_si32(x);
+        memcpy(p, &v, 2);
+        x = _mm_srli_si128(x, 2);
+        p += 2;
+    }
+    if (len & 1) {
+        *p = (char)_mm_cvtsi128_si32(x);
+    }
+}
@@ -0,0 +1,538 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "isa.h"
+#include "simdstr.h"
+#include "tail.h"
+#include "utf8.h"
+
+// UTF-8 validation after Keiser and Lemire, "Validating UTF-8 In Less Than
+// One Instruction Per Byte": every error of a 2-byte window is one of the
+// bits below, and three pshufb lookups, on the high and the low nibble of
+// the previous byte and on the high nibble of the byte, give the errors each
+// nibble allows. Their and is the set of errors of the window. A third or
+// fourth byte of a sequence is a continuation after a continuation, which
+// the lookups report as TWO_CONTS, and is checked against the lead bytes 2
+// and 3 bytes back.
+#define TOO_SHORT      (1 << 0)   // a lead not followed by a continuation
+#define TOO_LONG       (1 << 1)   // a continuation after ASCII
+#define OVERLONG_3     (1 << 2)   // E0 80..9F
+#define TOO_LARGE      (1 << 3)   // F4 90..BF, F5..FF
+#define SURROGATE      (1 << 4)   // ED A0..BF
+#define OVERLONG_2     (1 << 5)   // C0..C1
+#define TOO_LARGE_1000 (1 << 6)   // F5..FF 80..8F
+#define OVERLONG_4     (1 << 6)   // F0 80..8F
+#define TWO_CONTS      (1 << 7)   // a continuation after a continuation
+#define CARRY          (TOO_SHORT | TOO_LONG | TWO_CONTS)
+
+static const uint8_t byte1_high[16] = {
+    TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+    TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+    TOO_SHORT | OVERLONG_2,
+    TOO_SHORT,
+    TOO_SHORT | OVERLONG_3 | SURROGATE,
+    TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4,
+};
+
+static const uint8_t byte1_low[16] = {
+    CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+    CARRY | OVERLONG_2,
+    CARRY,
+    CARRY,
+    CARRY | TOO_LARGE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+    CARRY | TOO_LARGE | TOO_LARGE_1000,
+};
+
+static const uint8_t byte2_high[16] = {
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+    TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+};
+
+static inline uint16_t* put_utf16(uint16_t *out, uint32_t cp) {
+    if (cp < 0x10000) {
+        *out++ = (uint16_t)cp;
+    } else {
+        cp -= 0x10000;
+        *out++ = (uint16_t)(0xD800 | cp >> 10);
+        *out++ = (uint16_t)(0xDC00 | (cp & 0x3FF));
+    }
+    return out;
+}
+
+// The UTF-8 of the code point at p and the units it takes, 0 for an unpaired
+// surrogate.
+static inline size_t encode_utf16(const uint16_t *p, const uint16_t *end, char **out) {
+    uint32_t cp = p[0];
+    size_t n = 1;
+    if (cp >= 0xD800 && cp <= 0xDFFF) {
+        if (cp >= 0xDC00 || end - p < 2 || p[1] < 0xDC00 || p[1] > 0xDFFF) {
+            return 0;
+        }
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (p[1] - 0xDC00);
+        n = 2;
+    }
+    uint8_t *o = (uint8_t *)*out;
+    if (cp < 0x80) {
+        *o++ = (uint8_t)cp;
+    } else if (cp < 0x800) {
+        *o++ = (uint8_t)(0xC0 | cp >> 6);
+        *o++ = (uint8_t)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        *o++ = (uint8_t)(0xE0 | cp >> 12);
+        *o++ = (uint8_t)(0x80 | (cp >> 6 & 0x3F));
+        *o++ = (uint8_t)(0x80 | (cp & 0x3F));
+    } else {
+        *o++ = (uint8_t)(0xF0 | cp >> 18);
+        *o++ = (uint8_t)(0x80 | (cp >> 12 & 0x3F));
+        *o++ = (uint8_t)(0x80 | (cp >> 6 & 0x3F));
+        *o++ = (uint8_t)(0x80 | (cp & 0x3F));
+    }
+    *out = (char *)o;
+    return n;
+}
+
+bool utf8_validate_naive(const char *s, size_t len) {
+    const uint8_t *p = (const uint8_t *)s, *end = p + len;
+    uint32_t cp;
+    while (p < end) {
+        size_t n = decode_utf8(p, end, &cp);
+        if (n == 0) {
+            return false;
+        }
+        p += n;
+    }
+    return true;
+}
+
+// the bytes other than the continuations 80..BF
+size_t utf8_count_naive(const char *s, size_t len) {
+    size_t count = 0;
+    for (size_t i = 0; i < len; i++) {
+        count += (int8_t)s[i] > -65;
+    }
+    return count;
+}
+
+// Decode the sequences starting before stop. Return NULL for invalid UTF-8.
+static inline const uint8_t* utf8_to_utf16_scalar(uint16_t **out, const uint8_t *p,
+                                                  const uint8_t *stop, const uint8_t *end) {
+    uint32_t cp;
+    while (p < stop) {
+        size_t n = decode_utf8(p, end, &cp);
+        if (n == 0) {
+            return NULL;
+        }
+        *out = put_utf16(*out, cp);
+        p += n;
+    }
+    return p;
+}
+
+static inline const uint16_t* utf16_to_utf8_scalar(char **out, const uint16_t *p,
+                                                   const uint16_t *stop, const uint16_t *end) {
+    while (p < stop) {
+        size_t n = encode_utf16(p, end, out);
+        if (n == 0) {
+            return NULL;
+        }
+        p += n;
+    }
+    return p;
+}
+
+int64_t utf8_to_utf16_naive(uint16_t *dst, const char *src, size_t len) {
+    const uint8_t *p = (const uint8_t *)src, *end = p + len;
+    uint16_t *out = dst;
+    return utf8_to_utf16_scalar(&out, p, end, end) ? out - dst : -1;
+}
+
+int64_t utf16_to_utf8_naive(char *dst, const uint16_t *src, size_t len) {
+    char *out = dst;
+    return utf16_to_utf8_scalar(&out, src, src + len, src + len) ? out - dst : -1;
+}
+
+// the lead bytes the last 3 bytes of a block leave open: a lead of 2 bytes in
+// the last byte, of 3 in the last two, of 4 in the last three
+static const uint8_t incomplete_max[64] = {
+    [0 ... 60] = 0xFF, [61] = 0xEF, [62] = 0xDF, [63] = 0xBF,
+};
+
+TARGET_SSE4_2
+static inline __m128i utf8_errors_sse(__m128i in, __m128i prev) {
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    __m128i prev1 = _mm_alignr_epi8(in, prev, 15);
+    __m128i sc = _mm_and_si128(
+        _mm_and_si128(
+            _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)byte1_high),
+                             _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble)),
+            _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)byte1_low), _mm_and_si128(prev1, nibble))),
+        _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)byte2_high),
+                         _mm_and_si128(_mm_srli_epi16(in, 4), nibble)));
+    // the top bit is set after a lead of 3 bytes 2 back or of 4 bytes 3 back
+    __m128i must23 = _mm_or_si128(_mm_subs_epu8(_mm_alignr_epi8(in, prev, 14), _mm_set1_epi8((char)(0xE0 - 0x80))),
+                                  _mm_subs_epu8(_mm_alignr_epi8(in, prev, 13), _mm_set1_epi8((char)(0xF0 - 0x80))));
+    return _mm_xor_si128(_mm_and_si128(must23, _mm_set1_epi8((char)0x80)), sc);
+}
+
+// The blocks all ASCII skip the lookups and only check that the block before
+// them did not end in a lead byte. The tail is padded with NULs, ASCII too.
+TARGET_SSE4_2
+bool utf8_validate_sse(const char *s, size_t len) {
+    const __m128i max = _mm_loadu_si128((const __m128i *)(incomplete_max + 48));
+    __m128i error = _mm_setzero_si128(), prev = _mm_setzero_si128(), incomplete = _mm_setzero_si128();
+    for (size_t i = 0; i < len; i += 16) {
+        __m128i in = load_tail_si128(s + i, len - i, 0);
+        if (_mm_movemask_epi8(in) == 0) {
+            error = _mm_or_si128(error, incomplete);
+        } else {
+            error = _mm_or_si128(error, utf8_errors_sse(in, prev));
+            incomplete = _mm_subs_epu8(in, max);
+        }
+        prev = in;
+    }
+    error = _mm_or_si128(error, incomplete);
+    return _mm_testz_si128(error, error);
+}
+
+TARGET_AVX2
+static inline __m256i utf8_errors_avx2(__m256i in, __m256i prev) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    // the 16 bytes before each lane
+    __m256i before = _mm256_permute2x128_si256(prev, in, 0x21);
+    __m256i prev1 = _mm256_alignr_epi8(in, before, 15);
+    __m256i sc = _mm256_and_si256(
+        _mm256_and_si256(
+            _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)byte1_high)),
+                                _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble)),
+            _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)byte1_low)),
+                                _mm256_and_si256(prev1, nibble))),
+        _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)byte2_high)),
+                            _mm256_and_si256(_mm256_srli_epi16(in, 4), nibble)));
+    __m256i must23 = _mm256_or_si256(
+        _mm256_subs_epu8(_mm256_alignr_epi8(in, before, 14), _mm256_set1_epi8((char)(0xE0 - 0x80))),
+        _mm256_subs_epu8(_mm256_alignr_epi8(in, before, 13), _mm256_set1_epi8((char)(0xF0 - 0x80))));
+    return _mm256_xor_si256(_mm256_and_si256(must23, _mm256_set1_epi8((char)0x80)), sc);
+}
+
+TARGET_AVX2
+bool utf8_validate_avx2(const char *s, size_t len) {
+    const __m256i max = _mm256_loadu_si256((const __m256i *)(incomplete_max + 32));
+    __m256i error = _mm256_setzero_si256(), prev = _mm256_setzero_si256(), incomplete = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i < len; i += 32) {
+        __m256i in;
+        if (len - i >= 32) {
+            in = _mm256_loadu_si256((const __m256i *)(s + i));
+        } else {
+            char buf[32] = {0};
+            memcpy(buf, s + i, len - i);
+            in = _mm256_loadu_si256((const __m256i *)buf);
+        }
+        if (_mm256_movemask_epi8(in) == 0) {
+            error = _mm256_or_si256(error, incomplete);
+        } else {
+            error = _mm256_or_si256(error, utf8_errors_avx2(in, prev));
+            incomplete = _mm256_subs_epu8(in, max);
+        }
+        prev = in;
+    }
+    error = _mm256_or_si256(error, incomplete);
+    return _mm256_testz_si256(error, error);
+}
+
+TARGET_AVX512
+static inline __m512i utf8_errors_avx512(__m512i in, __m512i prev) {
+    const __m512i nibble = _mm512_set1_epi8(0x0F);
+    __m512i before = _mm512_permutex2var_epi64(prev, _mm512_setr_epi64(6, 7, 8, 9, 10, 11, 12, 13), in);
+    __m512i prev1 = _mm512_alignr_epi8(in, before, 15);
+    __m512i sc = _mm512_and_si512(
+        _mm512_and_si512(
+            _mm512_shuffle_epi8(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)byte1_high)),
+                                _mm512_and_si512(_mm512_srli_epi16(prev1, 4), nibble)),
+            _mm512_shuffle_epi8(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)byte1_low)),
+                                _mm512_and_si512(prev1, nibble))),
+        _mm512_shuffle_epi8(_mm512_broadcast_i32x4(_mm_loadu_si128((const __m128i *)byte2_high)),
+                            _mm512_and_si512(_mm512_srli_epi16(in, 4), nibble)));
+    __m512i must23 = _mm512_or_si512(
+        _mm512_subs_epu8(_mm512_alignr_epi8(in, before, 14), _mm512_set1_epi8((char)(0xE0 - 0x80))),
+        _mm512_subs_epu8(_mm512_alignr_epi8(in, before, 13), _mm512_set1_epi8((char)(0xF0 - 0x80))));
+    return _mm512_ternarylogic_epi32(must23, _mm512_set1_epi8((char)0x80), sc, 0x6A);   // (a & b) ^ c
+}
+
+TARGET_AVX512
+bool utf8_validate_avx512(const char *s, size_t len) {
+    const __m512i max = _mm512_loadu_si512(incomplete_max);
+    __m512i error = _mm512_setzero_si512(), prev = _mm512_setzero_si512(), incomplete = _mm512_setzero_si512();
+    for (size_t i = 0; i < len; i += 64) {
+        __m512i in = len - i >= 64 ? _mm512_loadu_si512(s + i)
+                                   : _mm512_maskz_loadu_epi8(_bzhi_u64(~0ull, len - i), s + i);
+        if (_mm512_movepi8_mask(in) == 0) {
+            error = _mm512_or_si512(error, incomplete);
+        } else {
+            error = _mm512_or_si512(error, utf8_errors_avx512(in, prev));
+            incomplete = _mm512_subs_epu8(in, max);
+        }
+        prev = in;
+    }
+    error = _mm512_or_si512(error, incomplete);
+    return _mm512_test_epi8_mask(error, error) == 0;
+}
+
+#undef TOO_SHORT
+#undef TOO_LONG
+#undef OVERLONG_3
+#undef TOO_LARGE
+#undef SURROGATE
+#undef OVERLONG_2
+#undef TOO_LARGE_1000
+#undef OVERLONG_4
+#undef TWO_CONTS
+#undef CARRY
+
+// the tail is padded with continuations, which are not counted
+TARGET_SSE4_2
+size_t utf8_count_sse(const char *s, size_t len) {
+    size_t count = 0;
+    for (size_t i = 0; i < len; i += 16) {
+        __m128i x = load_tail_si128(s + i, len - i, (char)0x80);
+        count += _mm_popcnt_u32((uint32_t)_mm_movemask_epi8(_mm_cmpgt_epi8(x, _mm_set1_epi8(-65))));
+    }
+    return count;
+}
+
+TARGET_AVX2
+size_t utf8_count_avx2(const char *s, size_t len) {
+    size_t count = 0, i = 0;
+    for (; i + 32 <= len; i += 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)(s + i));
+        count += _mm_popcnt_u32((uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(x, _mm256_set1_epi8(-65))));
+    }
+    return count + utf8_count_sse(s + i, len - i);
+}
+
+TARGET_AVX512
+size_t utf8_count_avx512(const char *s, size_t len) {
+    size_t count = 0;
+    for (size_t i = 0; i < len; i += 64) {
+        __mmask64 k = len - i >= 64 ? ~0ull : _bzhi_u64(~0ull, len - i);
+        __m512i x = _mm512_maskz_loadu_epi8(k, s + i);
+        count += _mm_popcnt_u64(_mm512_mask_cmpgt_epi8_mask(k, x, _mm512_set1_epi8(-65)));
+    }
+    return count;
+}
+
+// Transcoding: the blocks all ASCII are widened or narrowed in registers,
+// the others decoded one code point at a time up to the end of the block.
+TARGET_SSE4_2
+int64_t utf8_to_utf16_sse(uint16_t *dst, const char *src, size_t len) {
+    const uint8_t *p = (const uint8_t *)src, *end = p + len;
+    uint16_t *out = dst;
+    while (end - p >= 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)p);
+        if (_mm_movemask_epi8(x) == 0) {
+            _mm_storeu_si128((__m128i *)out, _mm_cvtepu8_epi16(x));
+            _mm_storeu_si128((__m128i *)(out + 8), _mm_cvtepu8_epi16(_mm_srli_si128(x, 8)));
+            out += 16;
+            p += 16;
+        } else if ((p = utf8_to_utf16_scalar(&out, p, p + 16, end)) == NULL) {
+            return -1;
+        }
+    }
+    return utf8_to_utf16_scalar(&out, p, end, end) ? out - dst : -1;
+}
+
+TARGET_AVX2
+int64_t utf8_to_utf16_avx2(uint16_t *dst, const char *src, size_t len) {
+    const uint8_t *p = (const uint8_t *)src, *end = p + len;
+    uint16_t *out = dst;
+    while (end - p >= 32) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)p);
+        if (_mm256_movemask_epi8(x) == 0) {
+            _mm256_storeu_si256((__m256i *)out, _mm256_cvtepu8_epi16(_mm256_castsi256_si128(x)));
+            _mm256_storeu_si256((__m256i *)(out + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(x, 1)));
+            out += 32;
+            p += 32;
+        } else if ((p = utf8_to_utf16_scalar(&out, p, p + 32, end)) == NULL) {
+            return -1;
+        }
+    }
+    return utf8_to_utf16_scalar(&out, p, end, end) ? out - dst : -1;
+}
+
+TARGET_SSE4_2
+int64_t utf16_to_utf8_sse(char *dst, const uint16_t *src, size_t len) {
+    const uint16_t *p = src, *end = src + len;
+    char *out = dst;
+    while (end - p >= 8) {
+        __m128i x = _mm_loadu_si128((const __m128i *)p);
+        if (_mm_testz_si128(x, _mm_set1_epi16((short)0xFF80))) {
+            _mm_storel_epi64((__m128i *)out, _mm_packus_epi16(x, x));
+            out += 8;
+            p += 8;
+        } else if ((p = utf16_to_utf8_scalar(&out, p, p + 8, end)) == NULL) {
+            return -1;
+        }
+    }
+    return utf16_to_utf8_scalar(&out, p, end, end) ? out - dst : -1;
+}
+
+TARGET_AVX2
+int64_t utf16_to_utf8_avx2(char *dst, const uint16_t *src, size_t len) {
+    const uint16_t *p = src, *end = src + len;
+    char *out = dst;
+    while (end - p >= 16) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)p);
+        if (_mm256_testz_si256(x, _mm256_set1_epi16((short)0xFF80))) {
+            __m128i bytes = _mm_packus_epi16(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+            _mm_storeu_si128((__m128i *)out, bytes);
+            out += 16;
+            p += 16;
+        } else if ((p = utf16_to_utf8_scalar(&out, p, p + 16, end)) == NULL) {
+            return -1;
+        }
+    }
+    return utf16_to_utf8_scalar(&out, p, end, end) ? out - dst : -1;
+}
+
+// AVX-512 decodes 16 code points per step in 32-bit lanes: VBMI2 compresses
+// the offsets of the lead bytes, VBMI gathers the 4 bytes from each lead
+// into its lane, and after the decode the units or bytes each lane needs
+// are compressed together. The input is validated first, the decode assumes
+// well-formed sequences.
+TARGET_AVX512_VBMI_VBMI2
+static inline __m512i decode_lanes_avx512(__m512i quad) {
+    const __m512i low6 = _mm512_set1_epi32(0x3F);
+    __m512i b0 = _mm512_and_si512(quad, _mm512_set1_epi32(0xFF));
+    __m512i c1 = _mm512_and_si512(_mm512_srli_epi32(quad, 8), low6);
+    __m512i c2 = _mm512_and_si512(_mm512_srli_epi32(quad, 16), low6);
+    __m512i c3 = _mm512_and_si512(_mm512_srli_epi32(quad, 24), low6);
+    __mmask16 two   = _mm512_cmpge_epu32_mask(b0, _mm512_set1_epi32(0xC0));
+    __mmask16 three = _mm512_cmpge_epu32_mask(b0, _mm512_set1_epi32(0xE0));
+    __mmask16 four  = _mm512_cmpge_epu32_mask(b0, _mm512_set1_epi32(0xF0));
+    __m512i cp2 = _mm512_or_si512(_mm512_slli_epi32(_mm512_and_si512(b0, _mm512_set1_epi32(0x1F)), 6), c1);
+    __m512i cp3 = _mm512_or_si512(_mm512_slli_epi32(_mm512_and_si512(b0, _mm512_set1_epi32(0x0F)), 12),
+                                  _mm512_or_si512(_mm512_slli_epi32(c1, 6), c2));
+    __m512i cp4 = _mm512_or_si512(_mm512_slli_epi32(_mm512_and_si512(b0, _mm512_set1_epi32(0x07)), 18),
+                                  _mm512_or_si512(_mm512_slli_epi32(c1, 12),
+                                                  _mm512_or_si512(_mm512_slli_epi32(c2, 6), c3)));
+    __m512i cp = _mm512_mask_blend_epi32(two, b0, cp2);
+    cp = _mm512_mask_blend_epi32(three, cp, cp3);
+    return _mm512_mask_blend_epi32(four, cp, cp4);
+}
+
+TARGET_AVX512_VBMI_VBMI2
+int64_t utf8_to_utf16_avx512(uint16_t *dst, const char *src, size_t len) {
+    if (!utf8_validate_avx512(src, len)) {
+        return -1;
+    }
+    const uint8_t *p = (const uint8_t *)src, *end = p + len;
+    uint16_t *out = dst;
+    const __m512i iota = _mm512_set_epi8(
+        63, 62, 61, 60, 59, 58, 57, 56, 55, 54, 53, 52, 51, 50, 49, 48,
+        47, 46, 45, 44, 43, 42, 41, 40, 39, 38, 37, 36, 35, 34, 33, 32,
+        31, 30, 29, 28, 27, 26, 25, 24, 23, 22, 21, 20, 19, 18, 17, 16,
+        15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    while (end - p >= 64) {
+        __m512i in = _mm512_loadu_si512(p);
+        if (_mm512_movepi8_mask(in) == 0) {
+            _mm512_storeu_si512(out, _mm512_cvtepu8_epi16(_mm512_castsi512_si256(in)));
+            _mm512_storeu_si512(out + 32, _mm512_cvtepu8_epi16(_mm512_extracti64x4_epi64(in, 1)));
+            out += 64;
+            p += 64;
+            continue;
+        }
+        // the sequences from a lead in the first 61 bytes end in the block
+        uint64_t leads = _mm512_cmpgt_epi8_mask(in, _mm512_set1_epi8(-65));
+        uint64_t first = leads & ((1ull << 61) - 1);
+        __m512i offsets = _mm512_maskz_compress_epi8(first, iota);
+        int count = (int)_mm_popcnt_u64(first);
+        size_t next;
+        if (count > 16) {
+            count = 16;
+            next = (size_t)(uint8_t)_mm_extract_epi8(_mm512_extracti32x4_epi32(offsets, 1), 0);
+        } else {
+            uint64_t rest = leads & ~((1ull << 61) - 1);
+            next = rest ? (size_t)__builtin_ctzll(rest) : 64;
+        }
+        __m512i idx = _mm512_add_epi32(_mm512_mullo_epi32(_mm512_cvtepu8_epi32(_mm512_castsi512_si128(offsets)),
+                                                          _mm512_set1_epi32(0x01010101)),
+                                       _mm512_set1_epi32(0x03020100));
+        __m512i cp = decode_lanes_avx512(_mm512_permutexvar_epi8(idx, in));
+        // a surrogate pair in the two halves of the lanes past U+FFFF
+        __mmask16 lanes = (__mmask16)_bzhi_u32(0xFFFF, count);
+        __mmask16 pair = _mm512_mask_cmpge_epu32_mask(lanes, cp, _mm512_set1_epi32(0x10000));
+        __m512i v = _mm512_sub_epi32(cp, _mm512_set1_epi32(0x10000));
+        __m512i hi = _mm512_or_si512(_mm512_srli_epi32(v, 10), _mm512_set1_epi32(0xD800));
+        __m512i lo = _mm512_or_si512(_mm512_and_si512(v, _mm512_set1_epi32(0x3FF)), _mm512_set1_epi32(0xDC00));
+        cp = _mm512_mask_or_epi32(cp, pair, hi, _mm512_slli_epi32(lo, 16));
+        __mmask32 keep = _pdep_u32(lanes, 0x55555555) | _pdep_u32(pair, 0xAAAAAAAA);
+        int units = _mm_popcnt_u32(keep);
+        _mm512_mask_storeu_epi16(out, _bzhi_u32(~0u, units), _mm512_maskz_compress_epi16(keep, cp));
+        out += units;
+        p += next;
+    }
+    utf8_to_utf16_scalar(&out, p, end, end);
+    return out - dst;
+}
+
+TARGET_AVX512_VBMI2
+int64_t utf16_to_utf8_avx512(char *dst, const uint16_t *src, size_t len) {
+    const uint16_t *p = src, *end = src + len;
+    char *out = dst;
+    while (end - p >= 32) {
+        __m512i x = _mm512_loadu_si512(p);
+        if (_mm512_test_epi16_mask(x, _mm512_set1_epi16((short)0xFF80)) == 0) {
+            _mm256_storeu_si256((__m256i *)out, _mm512_cvtepi16_epi8(x));
+            out += 32;
+            p += 32;
+            continue;
+        }
+        // the surrogates go through the scalar code
+        __m512i hi5 = _mm512_and_si512(x, _mm512_set1_epi16((short)0xF800));
+        if (_mm512_cmpeq_epi16_mask(hi5, _mm512_set1_epi16((short)0xD800)) != 0) {
+            if ((p = utf16_to_utf8_scalar(&out, p, p + 32, end)) == NULL) {
+                return -1;
+            }
+            continue;
+        }
+        for (int half = 0; half < 2; half++) {
+            __m512i cp = _mm512_cvtepu16_epi32(half ? _mm512_extracti64x4_epi64(x, 1) : _mm512_castsi512_si256(x));
+            __mmask16 two   = _mm512_cmpge_epu32_mask(cp, _mm512_set1_epi32(0x80));
+            __mmask16 three = _mm512_cmpge_epu32_mask(cp, _mm512_set1_epi32(0x800));
+            __m512i c0 = _mm512_and_si512(cp, _mm512_set1_epi32(0x3F));
+            __m512i c1 = _mm512_and_si512(_mm512_srli_epi32(cp, 6), _mm512_set1_epi32(0x3F));
+            // lead | cont << 8, then lead | cont << 8 | cont << 16
+            __m512i enc2 = _mm512_or_si512(_mm512_or_si512(_mm512_srli_epi32(cp, 6), _mm512_set1_epi32(0x80C0)),
+                                           _mm512_slli_epi32(c0, 8));
+            __m512i enc3 = _mm512_or_si512(
+                _mm512_or_si512(_mm512_srli_epi32(cp, 12), _mm512_set1_epi32(0x8080E0)),
+                _mm512_or_si512(_mm512_slli_epi32(c1, 8), _mm512_slli_epi32(c0, 16)));
+            __m512i enc = _mm512_mask_blend_epi32(two, cp, enc2);
+            enc = _mm512_mask_blend_epi32(three, enc, enc3);
+            __mmask64 keep = _pdep_u64(0xFFFF, 0x1111111111111111ull) | _pdep_u64(two, 0x2222222222222222ull)
+                           | _pdep_u64(three, 0x4444444444444444ull);
+            int n = (int)_mm_popcnt_u64(keep);
+            _mm512_mask_storeu_epi8(out, _bzhi_u64(~0ull, n), _mm512_maskz_compress_epi8(keep, enc));
+            out += n;
+        }
+        p += 32;
+    }
+    return utf16_to_utf8_scalar(&out, p, end, end) ? out - dst : -1;
+}
@@ -0,0 +1,199 @@
+#include <cerrno>
+#include <cinttypes>
+#include <clocale>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "test_util.h"
+
+using atou64_t = size_t (*)(const char *str, size_t len, uint64_t *val);
+using atoi64_t = size_t (*)(const char *str, size_t len, int64_t *val);
+using atof_t   = size_t (*)(const char *str, size_t len, double *val);
+
+// digits with runs of leading zeros, then a byte that ends the number
+static std::string gen_digits(std::mt19937_64& gen) {
+    std::string s(gen() % 4 == 0 ? gen() % 20 : 0, '0');
+    size_t n = 1 + gen() % 24;
+    for (size_t i = 0; i < n; i++) {
+        s += (char)('0' + gen() % 10);
+    }
+    return s;
+}
+
+static std::string gen_suffix(std::mt19937_64& gen) {
+    const char *suffixes[] = {"", ",", "\n", " 12", "a", "-", ".", ":9"};
+    return suffixes[gen() % (sizeof(suffixes) / sizeof(suffixes[0]))];
+}
+
+// the value of strtoull/strtoll, and the length consumed, 0 on ERANGE
+template <typename T, typename F>
+static size_t expect_strto(const std::string& s, F strto, T *val) {
+    char *end;
+    errno = 0;
+    *val = (T)strto(s.c_str(), &end, 10);
+    return errno == ERANGE ? 0 : end - s.c_str();
+}
+
+// the number ends at the last byte before a PROT_NONE page
+template <typename T>
+static void test_page_end(size_t (*f)(const char *str, size_t len, T *val)) {
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    char *mem = (char *)mmap(nullptr, 2 * page, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(mem, MAP_FAILED);
+    mprotect(mem + page, page, PROT_NONE);
+    char *end = mem + page;
+    for (size_t len = 1; len <= 19; len++) {
+        memset(end - len, '7', len);
+        T v;
+        EXPECT_EQ(f(end - len, len, &v), len);
+    }
+    munmap(mem, 2 * page);
+}
+
+static void test_atou64(atou64_t atou64) {
+    std::vector<std::string> tests = {
+        "", "x", "0", "9", "10", "99999999", "100000000", "18446744073709551615",
+        "18446744073709551616", "99999999999999999999", "000000000000000000000000018446744073709551615",
+        "1234567890123456", "12345678901234567", "4294967296,", "-1", "+1", " 1",
+    };
+    std::mt19937_64 gen(42);
+    for (int round = 0; round < 20000; round++) {
+        tests.push_back(gen_digits(gen) + gen_suffix(gen));
+    }
+    for (const auto& s : tests) {
+        uint64_t val = 0, want = 0;
+        size_t n = atou64(s.data(), s.size(), &val);
+        size_t want_n = s.empty() || !isdigit((unsigned char)s[0]) ? 0 : expect_strto(s, strtoull, &want);
+        ASSERT_EQ(n, want_n) << s;
+        if (n > 0) {
+            EXPECT_EQ(val, want) << s;
+        }
+    }
+    test_page_end(atou64);
+}
+
+static void test_atoi64(atoi64_t atoi64) {
+    std::vector<std::string> tests = {
+        "", "-", "+", "-0", "+0", "9223372036854775807", "9223372036854775808",
+        "-9223372036854775808", "-9223372036854775809", "-00009223372036854775808", "+12x",
+    };
+    std::mt19937_64 gen(42);
+    for (int round = 0; round < 20000; round++) {
+        const char *signs[] = {"", "-", "+"};
+        tests.push_back(signs[gen() % 3] + gen_digits(gen) + gen_suffix(gen));
+    }
+    for (const auto& s : tests) {
+        int64_t val = 0, want = 0;
+        size_t n = atoi64(s.data(), s.size(), &val);
+        size_t want_n = expect_strto(s, strtoll, &want);
+        if (s.empty() || s[0] == ' ') want_n = 0;
+        ASSERT_EQ(n, want_n) << s;
+        if (n > 0) {
+            EXPECT_EQ(val, want) << s;
+        }
+    }
+}
+
+// decimal numbers around the edges of doubles: long mantissas, halfway
+// cases, subnormals, overflow, and printed random doubles
+static std::vector<std::string> atof_cases() {
+    std::vector<std::string> tests = {
+        "", ".", "-", "+.", "e5", ".e1", "0", "-0", "0.0", "1", "1.", ".5", "1e", "1e+", "1e-5x",
+        "1.5E3", "9007199254740992", "9007199254740993", "9007199254740993.0000000001",
+        "2.2250738585072011e-308", "2.2250738585072014e-308", "4.9406564584124654e-324",
+        "2.4703282292062327e-324", "2.4703282292062328e-324", "1e-400", "1.7976931348623157e308",
+        "1.7976931348623158e308", "1.7976931348623159e308", "1e309", "1e99999999999",
+        "0.000000000000000000000000000000000000000000001e45", "123456789012345678901234567890",
+        "3.14159265358979323846264338327950288419716939937510", "7.038531e-26",
+        "1448997445238699", "0.1", "0.2", "0.3", "1e23", "8.98846567431158e307",
+    };
+    // past the significant digits kept for strtod: a 1 far after a halfway
+    // case rounds up, all zeros to even
+    std::string zeros(1000, '0');
+    tests.push_back("9007199254740993" + zeros + "1e-1001");
+    tests.push_back("9007199254740993" + zeros + "e-1000");
+    tests.push_back("2.4703282292062327208828439643411068618252990130716238" + zeros + "1e-324");
+    tests.push_back("0." + zeros + zeros + "17976931348623157e2309");
+    tests.push_back("1" + zeros + "." + zeros + "1");
+    std::mt19937_64 gen(42);
+    char buf[64];
+    for (int round = 0; round < 200; round++) {
+        std::string s;
+        for (size_t k = 0, n = 700 + gen() % 200; k < n; k++) s += (char)('0' + gen() % 10);
+        tests.push_back(s + "e-" + std::to_string(gen() % 1100));
+    }
+    for (int round = 0; round < 20000; round++) {
+        uint64_t bits = gen();
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        if (d != d || d - d != 0) continue;
+        snprintf(buf, sizeof(buf), "%.*g", (int)(1 + gen() % 17), d);
+        tests.push_back(buf);
+    }
+    for (int round = 0; round < 20000; round++) {
+        const char *signs[] = {"", "-", "+"};
+        std::string s = signs[gen() % 3] + gen_digits(gen);
+        if (gen() % 2) s += "." + gen_digits(gen);
+        if (gen() % 2) s += (gen() % 2 ? "e" : "E") + std::string(signs[gen() % 3]) + std::to_string(gen() % 700);
+        tests.push_back(s + gen_suffix(gen));
+    }
+    return tests;
+}
+
+static void test_atof(atof_t atof) {
+    for (const auto& s : atof_cases()) {
+        double val = 0;
+        char *end;
+        double want = strtod(s.c_str(), &end);
+        size_t n = atof(s.data(), s.size(), &val);
+        ASSERT_EQ(n, (size_t)(end - s.c_str())) << s;
+        if (n > 0) {
+            EXPECT_EQ(memcmp(&val, &want, sizeof(val)), 0) << s << " " << val << " " << want;
+        }
+    }
+    test_page_end(atof);
+}
+
+// the decimal point of atof is '.' whatever LC_NUMERIC says, on the strtod
+// path too
+TEST(atof, Locale) {
+    std::string saved = setlocale(LC_NUMERIC, nullptr);
+    const char *comma = nullptr;
+    for (const char *name : {"de_DE.UTF-8", "fr_FR.UTF-8"}) {
+        if (comma == nullptr && setlocale(LC_NUMERIC, name) != nullptr) comma = name;
+    }
+    if (comma == nullptr) {
+        GTEST_SKIP() << "no locale with a decimal comma";
+    }
+    for (const char *s : {"0.5", "9007199254740993.0000000001", "3.14159265358979323846264338327950288419716939937510"}) {
+        double val = 0;
+        EXPECT_EQ(simdstr_atof(s, strlen(s), &val), strlen(s)) << s;
+        setlocale(LC_NUMERIC, "C");
+        EXPECT_EQ(val, strtod(s, nullptr)) << s;
+        setlocale(LC_NUMERIC, comma);
+    }
+    setlocale(LC_NUMERIC, saved.c_str());
+}
+
+ADD_ISA_TEST(atou64, naive, NAIVE);
+ADD_ISA_TEST(atou64, sse, SSE4_2);
+ADD_ISA_TEST(atoi64, naive, NAIVE);
+ADD_ISA_TEST(atoi64, sse, SSE4_2);
+ADD_ISA_TEST(atof, naive, NAIVE);
+ADD_ISA_TEST(atof, sse, SSE4_2);
+
+TEST(atoi, Dispatch) {
+    for_each_isa([] {
+        test_atou64(simdstr_atou64);
+        test_atoi64(simdstr_atoi64);
+        test_atof(simdstr_atof);
+    });
+}
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "test_util.h"
+
+using base64_encode_t = size_t (*)(char *dst, const char *src, size_t len, simdstr_base64_t alphabet);
+using base64_decode_t = int64_t (*)(char *dst, const char *src, size_t len, simdstr_base64_t alphabet,
+                                    size_t *error_at);
+
+static const std::string std_chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+static const std::string url_chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+static std::string encode(base64_encode_t enc, const std::string& s, simdstr_base64_t alphabet) {
+    std::vector<char> out(4 * ((s.size() + 2) / 3) + 1);
+    size_t n = enc(out.data(), s.data(), s.size(), alphabet);
+    return std::string(out.data(), n);
+}
+
+// the result, or "<invalid at N>"
+static std::string decode(base64_decode_t dec, const std::string& s, simdstr_base64_t alphabet) {
+    std::vector<char> out((s.size() + 3) / 4 * 3 + 1);
+    size_t  err = ~(size_t)0;
+    int64_t n = dec(out.data(), s.data(), s.size(), alphabet, &err);
+    return n < 0 ? "<invalid at " + std::to_string(err) + ">" : std::string(out.data(), n);
+}
+
+static void test_base64_encode(base64_encode_t enc) {
+    // the test vectors of RFC 4648
+    const std::pair<std::string, std::string> rfc[] = {
+        {"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"}, {"foob", "Zm9vYg=="},
+        {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"},
+    };
+    for (const auto& t : rfc) {
+        EXPECT_EQ(encode(enc, t.first, SIMDSTR_BASE64_STD), t.second) << t.first;
+    }
+    EXPECT_EQ(encode(enc, "fo", SIMDSTR_BASE64_URL), "Zm8");
+    EXPECT_EQ(encode(enc, "\xFB\xFF\xBF", SIMDSTR_BASE64_STD), "+/+/");
+    EXPECT_EQ(encode(enc, "\xFB\xFF\xBF", SIMDSTR_BASE64_URL), "-_-_");
+    std::mt19937 gen(42);
+    for (size_t len = 0; len <= 400; len++) {
+        std::string s = gen_bytes(len, gen);
+        for (auto alphabet : {SIMDSTR_BASE64_STD, SIMDSTR_BASE64_URL}) {
+            ASSERT_EQ(encode(enc, s, alphabet), encode(base64_encode_naive, s, alphabet)) << len;
+        }
+    }
+}
+
+static void test_base64_decode(base64_decode_t dec) {
+    std::mt19937 gen(42);
+    for (size_t len = 0; len <= 400; len++) {
+        std::string s = gen_bytes(len, gen);
+        for (auto alphabet : {SIMDSTR_BASE64_STD, SIMDSTR_BASE64_URL}) {
+            std::string e = encode(base64_encode_naive, s, alphabet);
+            ASSERT_EQ(decode(dec, e, alphabet), s) << len;
+            // a set bit past the last byte of the last quantum
+            if (len % 3 != 0) {
+                const std::string chars = alphabet == SIMDSTR_BASE64_STD ? std_chars : url_chars;
+                size_t last = e.find('=') == std::string::npos ? e.size() - 1 : e.find('=') - 1;
+                std::string b = e;
+                b[last] = chars[chars.find(b[last]) | 1];
+                ASSERT_EQ(decode(dec, b, alphabet), "<invalid at " + std::to_string(last) + ">") << len;
+            }
+            // the standard alphabet needs the padding
+            if (alphabet == SIMDSTR_BASE64_STD && len % 3 != 0) {
+                std::string b = e.substr(0, e.find('='));
+                ASSERT_EQ(decode(dec, b, alphabet), "<invalid at " + std::to_string(b.size() / 4 * 4) + ">") << len;
+            }
+            // a byte out of the alphabet, at a random position of the blocks
+            if (!e.empty()) {
+                size_t at = gen() % std::min(e.size(), e.find('='));
+                for (char bad : {'=', '*', '\n', '\x80', '\xFF', alphabet == SIMDSTR_BASE64_STD ? '_' : '/'}) {
+                    // but the padding
+                    if (bad == '=' && alphabet == SIMDSTR_BASE64_STD && at + 2 >= e.size()) continue;
+                    std::string b = e;
+                    b[at] = bad;
+                    ASSERT_EQ(decode(dec, b, alphabet), "<invalid at " + std::to_string(at) + ">") << len << " " << at;
+                }
+            }
+        }
+    }
+    // only the canonical encoding: the padding ends a multiple of 4 bytes and
+    // is not optional, a last group of 1 byte is not a byte, and the bits past
+    // the last byte are 0
+    const std::pair<std::string, std::string> cases[] = {
+        {"Zg==", "f"}, {"Zg=", "<invalid at 2>"}, {"Zg", "<invalid at 0>"}, {"Zm8=", "fo"}, {"Z===", "<invalid at 1>"},
+        {"Z", "<invalid at 0>"}, {"Zm9vY", "<invalid at 4>"}, {"====", "<invalid at 0>"}, {"Zg==Zg==", "<invalid at 2>"},
+        {"Zh==", "<invalid at 1>"}, {"Zm9=", "<invalid at 2>"}, {"QR==", "<invalid at 1>"}, {"Zm9vZm8", "<invalid at 4>"},
+    };
+    for (const auto& t : cases) {
+        EXPECT_EQ(decode(dec, t.first, SIMDSTR_BASE64_STD), t.second) << t.first;
+    }
+    // the URL alphabet has no padding
+    const std::pair<std::string, std::string> url_cases[] = {
+        {"Zg", "f"}, {"Zm8", "fo"}, {"Zg==", "<invalid at 2>"}, {"Zm8=", "<invalid at 3>"}, {"Z", "<invalid at 0>"},
+        {"Zh", "<invalid at 1>"}, {"Zm9", "<invalid at 2>"}, {"QR", "<invalid at 1>"},
+    };
+    for (const auto& t : url_cases) {
+        EXPECT_EQ(decode(dec, t.first, SIMDSTR_BASE64_URL), t.second) << t.first;
+    }
+    EXPECT_EQ(decode(dec, "", SIMDSTR_BASE64_STD), "");
+    EXPECT_EQ(decode(dec, "+/+/", SIMDSTR_BASE64_STD), "\xFB\xFF\xBF");
+    EXPECT_EQ(decode(dec, "-_-_", SIMDSTR_BASE64_URL), "\xFB\xFF\xBF");
+    EXPECT_EQ(decode(dec, "-_-_", SIMDSTR_BASE64_STD), "<invalid at 0>");
+    EXPECT_EQ(decode(dec, "+/+/", SIMDSTR_BASE64_URL), "<invalid at 0>");
+    // the first of two errors, and error_at may be NULL
+    std::string e = encode(base64_encode_naive, gen_bytes(300, gen), SIMDSTR_BASE64_STD);
+    e[250] = '!';
+    e[70] = '!';
+    EXPECT_EQ(decode(dec, e, SIMDSTR_BASE64_STD), "<invalid at 70>");
+    std::vector<char> out(e.size());
+    EXPECT_EQ(dec(out.data(), e.data(), e.size(), SIMDSTR_BASE64_STD, nullptr), -1);
+}
+
+ADD_ISA_TEST(base64_encode, naive, NAIVE);
+ADD_ISA_TEST(base64_encode, sse, SSE4_2);
+ADD_ISA_TEST(base64_encode, avx2, AVX2);
+ADD_VBMI_TEST(base64_encode, SIMDSTR_CPU_AVX512VBMI);
+ADD_ISA_TEST(base64_decode, naive, NAIVE);
+ADD_ISA_TEST(base64_decode, sse, SSE4_2);
+ADD_ISA_TEST(base64_decode, avx2, AVX2);
+ADD_VBMI_TEST(base64_decode, SIMDSTR_CPU_AVX512VBMI);
+
+TEST(base64, Dispatch) {
+    for_each_isa([] {
+        test_base64_encode(simdstr_base64_encode);
+        test_base64_decode(simdstr_base64_decode);
+    });
+}
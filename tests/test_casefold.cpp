@@ -0,0 +1,97 @@
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "test_util.h"
+
+using casefold_t = size_t (*)(char *dst, const char *src, size_t len);
+
+static std::string utf8_of(uint32_t cp) {
+    std::string s;
+    if (cp < 0x80) {
+        s += (char)cp;
+    } else if (cp < 0x800) {
+        s += (char)(0xC0 | cp >> 6);
+        s += (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        s += (char)(0xE0 | cp >> 12);
+        s += (char)(0x80 | (cp >> 6 & 0x3F));
+        s += (char)(0x80 | (cp & 0x3F));
+    } else {
+        s += (char)(0xF0 | cp >> 18);
+        s += (char)(0x80 | (cp >> 12 & 0x3F));
+        s += (char)(0x80 | (cp >> 6 & 0x3F));
+        s += (char)(0x80 | (cp & 0x3F));
+    }
+    return s;
+}
+
+// about len bytes of ASCII with runs of Latin, Greek, Cyrillic, the wide
+// cased blocks and some invalid bytes
+static std::string gen_text(size_t len, std::mt19937& gen) {
+    const uint32_t lo[] = {0x20, 0xC0, 0x370, 0x400, 0x1E00, 0x2100, 0x10400};
+    const uint32_t hi[] = {0x7E, 0x24F, 0x3FF, 0x4FF, 0x1FFF, 0x2C7F, 0x1044F};
+    std::string s;
+    while (s.size() < len) {
+        int cls = gen() % 8;
+        size_t run = 1 + gen() % 40;
+        for (size_t i = 0; i < run; i++) {
+            if (cls == 7) {
+                s += (char)(0x80 + gen() % 0x80);
+            } else {
+                uint32_t cp = lo[cls] + gen() % (hi[cls] - lo[cls] + 1);
+                s += utf8_of(cp >= 0xD800 && cp < 0xE000 ? 'x' : cp);
+            }
+        }
+    }
+    return s;
+}
+
+static std::string fold(casefold_t casefold, const std::string& s) {
+    std::vector<char> out(3 * s.size() + 1);
+    size_t n = casefold(out.data(), s.data(), s.size());
+    return std::string(out.data(), n);
+}
+
+static void test_casefold_utf8(casefold_t casefold) {
+    const std::pair<std::string, std::string> tests[] = {
+        {"", ""}, {"Hello, World!", "hello, world!"}, {"@[`{", "@[`{"},
+        {u8"ПРИВЕТ, Мир!", u8"привет, мир!"}, {u8"ΣΊΣΥΦΟΣ ς", u8"σίσυφοσ σ"},
+        {u8"Straße ẞ", "strasse ss"}, {u8"İ", "i\xCC\x87"}, {u8"ΐ", "\xCE\xB9\xCC\x88\xCC\x81"},
+        {u8"K", "k"}, {u8"\U00010400", u8"\U00010428"}, {u8"ᾼ", u8"αι"}, {u8"ﬃ", "ffi"}, {u8"ſſ", "ss"},
+        {u8"中文 ÉCOLE", u8"中文 école"},
+        {"\xFF" "A", "\xFF" "a"}, {"\xC3", "\xC3"}, {"\xC3" "A", "\xC3" "a"}, {"\xED\xA0\x80", "\xED\xA0\x80"},
+    };
+    for (const auto& t : tests) {
+        EXPECT_EQ(fold(casefold, t.first), t.second) << t.first;
+    }
+    // the cases around the block boundaries, ASCII then a sequence across them
+    for (size_t at = 0; at < 130; at++) {
+        std::string s(at, 'Q');
+        s += u8"Ж";
+        s += std::string(70, 'Z');
+        std::string want(at, 'q');
+        want += u8"ж";
+        want += std::string(70, 'z');
+        ASSERT_EQ(fold(casefold, s), want) << at;
+    }
+    std::mt19937 gen(2);
+    for (size_t len = 0; len <= 400; len++) {
+        for (int round = 0; round < 5; round++) {
+            std::string s = gen_text(len, gen);
+            ASSERT_EQ(fold(casefold, s), fold(casefold_utf8_naive, s)) << len;
+        }
+    }
+}
+
+ADD_ISA_TEST(casefold_utf8, naive, NAIVE);
+ADD_ISA_TEST(casefold_utf8, sse, SSE4_2);
+ADD_ISA_TEST(casefold_utf8, avx2, AVX2);
+ADD_ISA_TEST(casefold_utf8, avx512, AVX512);
+
+TEST(casefold, Dispatch) {
+    for_each_isa([] {
+        test_casefold_utf8(simdstr_casefold_utf8);
+    });
+}
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "test_util.h"
+
+using find_t  = char* (*)(const simdstr_charset_t *cs, const char *s, size_t len);
+using count_t = size_t (*)(const simdstr_charset_t *cs, const char *s, size_t len);
+
+// count random bytes, duplicates included
+static std::string gen_set(size_t count, std::mt19937& gen) {
+    std::string set(count, '\0');
+    for (auto& c : set) c = (char)(gen() % 256);
+    return set;
+}
+
+// len bytes mostly from the set, or mostly out of it
+static std::string gen_text(const std::string& set, size_t len, bool in, std::mt19937& gen) {
+    std::string s(len, '\0');
+    for (auto& c : s) {
+        bool pick = set.empty() ? false : (gen() % 16 != 0) == in;
+        c = pick ? set[gen() % set.size()] : (char)(gen() % 256);
+    }
+    return s;
+}
+
+static const char* expect_find(const std::string& set, const std::string& s, bool in) {
+    size_t pos = in ? s.find_first_of(set) : s.find_first_not_of(set);
+    return pos == std::string::npos ? nullptr : s.data() + pos;
+}
+
+// the sets of JSON whitespace, CSV, URL reserved and HTML escapes, then
+// random sets of every size class, the large ones take two table pairs
+static std::vector<std::string> charsets(std::mt19937& gen) {
+    std::vector<std::string> sets = {"", " \t\n\r", ",\"\n\r", ":/?#[]@!$&'()*+,;=", "<>&\"'",
+                                     std::string("\0\x80\xFF", 3)};
+    for (size_t count : {1, 2, 4, 8, 9, 16, 17, 32, 64, 100, 128, 200, 256, 512}) {
+        sets.push_back(gen_set(count, gen));
+    }
+    std::string all(256, '\0');
+    for (int i = 0; i < 256; i++) all[i] = (char)i;
+    sets.push_back(all);
+    return sets;
+}
+
+static void test_find(find_t find, bool in) {
+    std::mt19937 gen(42);
+    for (const auto& set : charsets(gen)) {
+        simdstr_charset_t cs;
+        simdstr_charset_init(&cs, set.data(), set.size());
+        for (size_t len = 0; len <= 200; len++) {
+            std::string s = gen_text(set, len, !in, gen);
+            ASSERT_EQ(find(&cs, s.data(), len), expect_find(set, s, in)) << set.size() << " " << len;
+        }
+        // one match at every position around the blocks
+        for (size_t len = 1; len <= 131; len++) {
+            std::string s = gen_text(set, len, !in, gen);
+            s.back() = set.empty() ? 'x' : set[gen() % set.size()];
+            ASSERT_EQ(find(&cs, s.data(), len), expect_find(set, s, in)) << set.size() << " " << len;
+        }
+    }
+}
+
+static void test_find_first_of(find_t find) {
+    test_find(find, true);
+}
+
+static void test_find_first_not_of(find_t find) {
+    test_find(find, false);
+}
+
+static void test_count_of(count_t count) {
+    std::mt19937 gen(42);
+    for (const auto& set : charsets(gen)) {
+        simdstr_charset_t cs;
+        simdstr_charset_init(&cs, set.data(), set.size());
+        for (size_t len = 0; len <= 300; len++) {
+            std::string s = gen_text(set, len, gen() % 2, gen);
+            size_t expect = std::count_if(s.begin(), s.end(), [&](char c) {
+                return set.find(c) != std::string::npos;
+            });
+            ASSERT_EQ(count(&cs, s.data(), len), expect) << set.size() << " " << len;
+        }
+    }
+}
+
+ADD_ISA_TEST(find_first_of, naive, NAIVE);
+ADD_ISA_TEST(find_first_of, sse, SSE4_2);
+ADD_ISA_TEST(find_first_of, avx2, AVX2);
+ADD_ISA_TEST(find_first_of, avx512, AVX512);
+ADD_ISA_TEST(find_first_not_of, naive, NAIVE);
+ADD_ISA_TEST(find_first_not_of, sse, SSE4_2);
+ADD_ISA_TEST(find_first_not_of, avx2, AVX2);
+ADD_ISA_TEST(find_first_not_of, avx512, AVX512);
+ADD_ISA_TEST(count_of, naive, NAIVE);
+ADD_ISA_TEST(count_of, sse, SSE4_2);
+ADD_ISA_TEST(count_of, avx2, AVX2);
+ADD_ISA_TEST(count_of, avx512, AVX512);
+
+TEST(charset, Tables) {
+    simdstr_charset_t cs;
+    simdstr_charset_init(&cs, " \t\n\r", 4);
+    EXPECT_EQ(cs.ntables, 1);
+    // 16 high nibbles with distinct rows
+    std::string set;
+    for (int h = 0; h < 16; h++) {
+        for (int l = 0; l <= h; l++) set += (char)(h << 4 | l);
+    }
+    simdstr_charset_init(&cs, set.data(), set.size());
+    EXPECT_EQ(cs.ntables, 2);
+}
+
+TEST(charset, Dispatch) {
+    for_each_isa([] {
+        test_find_first_of(simdstr_find_first_of);
+        test_find_first_not_of(simdstr_find_first_not_of);
+        test_count_of(simdstr_count_of);
+        simdstr_charset_t cs;
+        simdstr_charset_init(&cs, " \t", 2);
+        EXPECT_EQ(simdstr_span(&cs, " \t x", 4), 3u);
+        EXPECT_EQ(simdstr_span(&cs, "  ", 2), 2u);
+        EXPECT_EQ(simdstr_span(&cs, "", 0), 0u);
+    });
+}
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "test_util.h"
+
+using crc32c_t = uint32_t (*)(uint32_t crc, const char *s, size_t len);
+using hash64_t = uint64_t (*)(const char *s, size_t len, uint64_t seed);
+using hash64_batch_t = void (*)(const simdstr_slice_t *src, size_t count, uint64_t seed, uint64_t *out);
+
+// the lengths around the lanes, the blocks and the stripes of the kernels
+static std::vector<size_t> long_lengths() {
+    std::vector<size_t> lens;
+    for (size_t base : {3 * 256, 3 * 8192, 1024, 2048}) {
+        for (size_t d = 0; d < 3; d++) {
+            lens.push_back(base - d);
+            lens.push_back(base + 1 + d);
+        }
+    }
+    for (size_t len : {64 * 17 + 5, 5000, 3 * 8192 * 2 + 3 * 256 + 13, 100000}) {
+        lens.push_back(len);
+    }
+    return lens;
+}
+
+static void test_crc32c(crc32c_t crc32c) {
+    // the check values of RFC 3720
+    EXPECT_EQ(crc32c(0, "123456789", 9), 0xE3069283u);
+    EXPECT_EQ(crc32c(0, std::string(32, '\0').data(), 32), 0x8A9136AAu);
+    EXPECT_EQ(crc32c(0, std::string(32, '\xFF').data(), 32), 0x62A8AB43u);
+    EXPECT_EQ(crc32c(0, "", 0), 0u);
+    std::mt19937 gen(42);
+    std::vector<size_t> lens = long_lengths();
+    for (size_t len = 0; len <= 300; len++) lens.push_back(len);
+    for (size_t len : lens) {
+        std::string s = gen_bytes(len + 7, gen);
+        // at every alignment
+        size_t off = len % 8;
+        uint32_t want = crc32c_naive(0, s.data() + off, len);
+        ASSERT_EQ(crc32c(0, s.data() + off, len), want) << len;
+        // chained over two calls
+        size_t cut = len / 3;
+        ASSERT_EQ(crc32c(crc32c(0, s.data() + off, cut), s.data() + off + cut, len - cut), want) << len;
+    }
+}
+
+static void test_hash64(hash64_t hash64) {
+    std::mt19937 gen(42);
+    std::vector<size_t> lens = long_lengths();
+    for (size_t len = 0; len <= 300; len++) lens.push_back(len);
+    for (size_t len : lens) {
+        std::string s = gen_bytes(len, gen);
+        for (uint64_t seed : {0ull, 1ull, 0x123456789ABCDEFull, ~0ull}) {
+            ASSERT_EQ(hash64(s.data(), len, seed), hash64_naive(s.data(), len, seed)) << len << " " << seed;
+        }
+    }
+}
+
+static void test_hash64_batch(hash64_batch_t batch) {
+    std::mt19937 gen(42);
+    for (size_t count = 0; count <= 40; count++) {
+        // mostly keys of 16 bytes or less, some groups with a long one
+        std::vector<std::string> keys(count);
+        for (auto& k : keys) k = gen_bytes(gen() % 8 == 0 ? gen() % 300 : gen() % 17, gen);
+        std::vector<simdstr_slice_t> src(count);
+        for (size_t i = 0; i < count; i++) src[i] = {keys[i].data(), keys[i].size()};
+        std::vector<uint64_t> out(count);
+        batch(src.data(), count, 7, out.data());
+        for (size_t i = 0; i < count; i++) {
+            ASSERT_EQ(out[i], hash64_naive(keys[i].data(), keys[i].size(), 7)) << count << " " << i;
+        }
+    }
+}
+
+ADD_ISA_TEST(crc32c, naive, NAIVE);
+ADD_ISA_TEST(crc32c, sse, SSE4_2);
+ADD_ISA_TEST(hash64, naive, NAIVE);
+ADD_ISA_TEST(hash64, sse, SSE4_2);
+ADD_ISA_TEST(hash64, avx2, AVX2);
+ADD_ISA_TEST(hash64, avx512, AVX512);
+ADD_ISA_TEST(hash64_batch, naive, NAIVE);
+ADD_ISA_TEST(hash64_batch, sse, SSE4_2);
+ADD_ISA_TEST(hash64_batch, avx2, AVX2);
+ADD_ISA_TEST(hash64_batch, avx512, AVX512);
+
+// The avalanche test of SMHasher on a subset of the input bits: flipping one
+// bit of the key flips every bit of the hash with a probability close to 1/2.
+TEST(hash64, Avalanche) {
+    const int rounds = 4000;
+    std::mt19937 gen(1);
+    for (size_t len : {2, 3, 4, 7, 8, 9, 12, 16, 17, 24, 32, 33, 64, 100, 128, 129, 200, 1024, 1500}) {
+        // every bit of the short keys, 64 random ones and the last byte of the long ones
+        std::vector<size_t> bits;
+        for (size_t b = 0; b < 8 * len; b++) {
+            if (len <= 16 || b >= 8 * (len - 1) || gen() % (8 * len) < 64) bits.push_back(b);
+        }
+        std::vector<int> flips(bits.size() * 64);
+        for (int r = 0; r < rounds; r++) {
+            std::string s = gen_bytes(len, gen);
+            uint64_t h = hash64_naive(s.data(), len, 0);
+            for (size_t i = 0; i < bits.size(); i++) {
+                s[bits[i] / 8] ^= (char)(1 << bits[i] % 8);
+                uint64_t d = h ^ hash64_naive(s.data(), len, 0);
+                s[bits[i] / 8] ^= (char)(1 << bits[i] % 8);
+                for (int o = 0; o < 64; o++) flips[i * 64 + o] += d >> o & 1;
+            }
+        }
+        double worst = 0;
+        for (int f : flips) worst = std::max(worst, std::abs((double)f / rounds - 0.5));
+        EXPECT_LT(worst, 0.05) << len;
+    }
+}
+
+// no collision over the keys of up to 2 bytes, the 32-byte keys of 1 or 2
+// set bits (the Sparse test of SMHasher) and the seeds of one key
+TEST(hash64, Collisions) {
+    std::unordered_set<uint64_t> seen;
+    size_t keys = 0;
+    std::string s;
+    for (int len = 0; len <= 2; len++) {
+        for (int v = 0; v < 1 << (8 * len); v++) {
+            s.assign(len, '\0');
+            for (int i = 0; i < len; i++) s[i] = (char)(v >> (8 * i));
+            seen.insert(hash64_naive(s.data(), len, 0));
+            keys++;
+        }
+    }
+    for (size_t len : {32, 200}) {
+        for (size_t a = 0; a < 8 * len; a++) {
+            for (size_t b = a; b < 8 * len; b++) {
+                s.assign(len, '\0');
+                s[a / 8] ^= (char)(1 << a % 8);
+                if (b != a) s[b / 8] ^= (char)(1 << b % 8);
+                seen.insert(hash64_naive(s.data(), len, 0));
+                keys++;
+            }
+        }
+    }
+    for (uint64_t seed = 0; seed < 10000; seed++) {
+        seen.insert(hash64_naive("key", 3, seed));
+        keys++;
+    }
+    EXPECT_EQ(seen.size(), keys);
+}
+
+TEST(hash, Dispatch) {
+    for_each_isa([] {
+        test_crc32c(simdstr_crc32c);
+        test_hash64(simdstr_hash64);
+        test_hash64_batch(simdstr_hash64_batch);
+    });
+}
@@ -0,0 +1,73 @@
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "test_util.h"
+
+using hex_encode_t = size_t (*)(char *dst, const char *src, size_t len);
+using hex_decode_t = int64_t (*)(char *dst, const char *src, size_t len, size_t *error_at);
+
+static std::string hex_decode(hex_decode_t dec, const std::string& s) {
+    std::vector<char> out(s.size() / 2 + 1);
+    size_t  err = ~(size_t)0;
+    int64_t n = dec(out.data(), s.data(), s.size(), &err);
+    return n < 0 ? "<invalid at " + std::to_string(err) + ">" : std::string(out.data(), n);
+}
+
+static void test_hex_encode(hex_encode_t enc) {
+    std::mt19937 gen(42);
+    for (size_t len = 0; len <= 300; len++) {
+        std::string s = gen_bytes(len, gen);
+        std::string want;
+        for (unsigned char c : s) {
+            want += "0123456789abcdef"[c >> 4];
+            want += "0123456789abcdef"[c & 15];
+        }
+        std::vector<char> out(2 * len + 1, '#');
+        ASSERT_EQ(enc(out.data(), s.data(), len), 2 * len);
+        ASSERT_EQ(std::string(out.data(), 2 * len), want) << len;
+        ASSERT_EQ(out[2 * len], '#') << len;
+    }
+}
+
+static void test_hex_decode(hex_decode_t dec) {
+    std::mt19937 gen(42);
+    for (size_t len = 0; len <= 300; len++) {
+        std::string s = gen_bytes(len, gen);
+        std::string h(2 * len, '\0');
+        hex_encode_naive(&h[0], s.data(), len);
+        ASSERT_EQ(hex_decode(dec, h), s) << len;
+        // in uppercase
+        for (auto& c : h) c = (char)toupper(c);
+        ASSERT_EQ(hex_decode(dec, h), s) << len;
+        if (len > 0) {
+            size_t at = gen() % h.size();
+            for (char bad : {'g', 'G', '/', ':', '@', '`', ' ', '\0', '\xB0'}) {
+                std::string b = h;
+                b[at] = bad;
+                ASSERT_EQ(hex_decode(dec, b), "<invalid at " + std::to_string(at) + ">") << len << " " << at;
+            }
+            ASSERT_EQ(hex_decode(dec, h.substr(1)), "<invalid at " + std::to_string(h.size() - 2) + ">") << len;
+        }
+    }
+    EXPECT_EQ(hex_decode(dec, "00fFaA9"), "<invalid at 6>");
+    EXPECT_EQ(hex_decode(dec, "0x12"), "<invalid at 1>");
+    EXPECT_EQ(hex_decode(dec, "DEADbeef"), "\xDE\xAD\xBE\xEF");
+}
+
+ADD_ISA_TEST(hex_encode, naive, NAIVE);
+ADD_ISA_TEST(hex_encode, sse, SSE4_2);
+ADD_ISA_TEST(hex_encode, avx2, AVX2);
+ADD_ISA_TEST(hex_encode, avx512, AVX512);
+ADD_ISA_TEST(hex_decode, naive, NAIVE);
+ADD_ISA_TEST(hex_decode, sse, SSE4_2);
+ADD_ISA_TEST(hex_decode, avx2, AVX2);
+ADD_ISA_TEST(hex_decode, avx512, AVX512);
+
+TEST(hex, Dispatch) {
+    for_each_isa([] {
+        test_hex_encode(simdstr_hex_encode);
+        test_hex_decode(simdstr_hex_decode);
+    });
+}
@@ -0,0 +1,144 @@
+#include <cinttypes>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "test_util.h"
+
+using u64toa_t = size_t (*)(uint64_t val, char *out);
+using u64toa_batch_t = size_t (*)(const uint64_t *vals, size_t count, char *out, size_t *lens);
+using i64toa_batch_t = size_t (*)(const int64_t *vals, size_t count, char *out, size_t *lens);
+
+static std::string expect_u64(uint64_t v) {
+    char buf[32];
+    return std::string(buf, snprintf(buf, sizeof(buf), "%" PRIu64, v));
+}
+
+static std::string expect_i64(int64_t v) {
+    char buf[32];
+    return std::string(buf, snprintf(buf, sizeof(buf), "%" PRId64, v));
+}
+
+// every power of 10 with its neighbours, the type limits, and random values
+// of every bit length
+static std::vector<uint64_t> boundaries() {
+    std::vector<uint64_t> vals = {0, UINT32_MAX, (uint64_t)UINT32_MAX + 1, (uint64_t)INT64_MAX,
+                                  (uint64_t)INT64_MAX + 1, UINT64_MAX - 1, UINT64_MAX};
+    uint64_t p = 1;
+    for (int k = 0; k < 20; k++, p *= 10) {
+        for (uint64_t v : {p - 1, p, p + 1, 2 * p - 1, 9 * p + (p - 1)}) {
+            vals.push_back(v);
+        }
+    }
+    std::mt19937_64 gen(42);
+    for (int bits = 1; bits <= 64; bits++) {
+        for (int round = 0; round < 50; round++) {
+            vals.push_back(gen() >> (64 - bits));
+        }
+    }
+    return vals;
+}
+
+static void test_u64toa(u64toa_t u64toa) {
+    char out[SIMDSTR_ITOA_BUF];
+    for (uint64_t v = 0; v < 200000; v++) {
+        size_t n = u64toa(v, out);
+        ASSERT_EQ(std::string(out, n), expect_u64(v));
+    }
+    for (uint64_t v = 99990000; v < 100010000; v++) {
+        size_t n = u64toa(v, out);
+        ASSERT_EQ(std::string(out, n), expect_u64(v));
+    }
+    for (uint64_t v : boundaries()) {
+        size_t n = u64toa(v, out);
+        EXPECT_EQ(std::string(out, n), expect_u64(v));
+    }
+}
+
+static std::vector<int64_t> signed_of(const std::vector<uint64_t>& vals) {
+    std::vector<int64_t> out;
+    for (uint64_t v : vals) {
+        out.push_back((int64_t)v);
+        out.push_back(-(int64_t)(v >> 1));
+    }
+    out.push_back(INT64_MIN);
+    out.push_back(INT64_MIN + 1);
+    out.push_back(-1);
+    return out;
+}
+
+// columns of every length up to 40 from shuffled values, back to back with
+// the lengths
+static void test_u64toa_batch(u64toa_batch_t u64toa_batch) {
+    std::vector<uint64_t> vals = boundaries();
+    std::mt19937 gen(7);
+    for (size_t count = 0; count <= 40; count++) {
+        for (int round = 0; round < 20; round++) {
+            std::vector<uint64_t> col(count);
+            std::string expected;
+            for (auto& v : col) {
+                v = vals[gen() % vals.size()];
+                expected += expect_u64(v);
+            }
+            std::vector<char> out(20 * count + SIMDSTR_ITOA_BUF);
+            std::vector<size_t> lens(count);
+            size_t n = u64toa_batch(col.data(), count, out.data(), lens.data());
+            ASSERT_EQ(std::string(out.data(), n), expected) << count;
+            for (size_t i = 0; i < count; i++) {
+                EXPECT_EQ(lens[i], expect_u64(col[i]).size()) << col[i];
+            }
+            EXPECT_EQ(u64toa_batch(col.data(), count, out.data(), nullptr), n);
+        }
+    }
+}
+
+static void test_i64toa_batch(i64toa_batch_t i64toa_batch) {
+    std::vector<int64_t> vals = signed_of(boundaries());
+    std::mt19937 gen(7);
+    for (size_t count = 0; count <= 40; count++) {
+        for (int round = 0; round < 20; round++) {
+            std::vector<int64_t> col(count);
+            std::string expected;
+            for (auto& v : col) {
+                v = vals[gen() % vals.size()];
+                expected += expect_i64(v);
+            }
+            std::vector<char> out(20 * count + SIMDSTR_ITOA_BUF);
+            std::vector<size_t> lens(count);
+            size_t n = i64toa_batch(col.data(), count, out.data(), lens.data());
+            ASSERT_EQ(std::string(out.data(), n), expected) << count;
+            for (size_t i = 0; i < count; i++) {
+                EXPECT_EQ(lens[i], expect_i64(col[i]).size()) << col[i];
+            }
+        }
+    }
+}
+
+ADD_ISA_TEST(u64toa, naive, NAIVE);
+ADD_ISA_TEST(u64toa, sse, SSE4_2);
+ADD_ISA_TEST(u64toa_batch, naive, NAIVE);
+ADD_ISA_TEST(u64toa_batch, sse, SSE4_2);
+ADD_ISA_TEST(u64toa_batch, avx2, AVX2);
+ADD_ISA_TEST(i64toa_batch, naive, NAIVE);
+ADD_ISA_TEST(i64toa_batch, sse, SSE4_2);
+ADD_ISA_TEST(i64toa_batch, avx2, AVX2);
+
+TEST(itoa, Dispatch) {
+    for_each_isa([] {
+        char out[SIMDSTR_ITOA_BUF];
+        for (uint64_t v : boundaries()) {
+            size_t n = simdstr_u64toa(v, out);
+            EXPECT_EQ(std::string(out, n), expect_u64(v));
+            n = simdstr_u32toa((uint32_t)v, out);
+            EXPECT_EQ(std::string(out, n), expect_u64((uint32_t)v));
+        }
+        for (int64_t v : signed_of(boundaries())) {
+            size_t n = simdstr_i64toa(v, out);
+            EXPECT_EQ(std::string(out, n), expect_i64(v));
+        }
+        test_u64toa_batch(simdstr_u64toa_batch);
+        test_i64toa_batch(simdstr_i64toa_batch);
+    });
+}
@@ -0,0 +1,86 @@
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "test_util.h"
+
+using json_index_t = int64_t (*)(const char *json, size_t len, uint32_t *index);
+
+static std::vector<uint32_t> run(json_index_t json_index, const std::string& json, int64_t *n) {
+    std::vector<uint32_t> index(json.size() + 1);
+    *n = json_index(json.data(), json.size(), index.data());
+    index.resize(*n > 0 ? *n : 0);
+    return index;
+}
+
+// JSON-like text: values, strings with escapes and backslash runs, and the
+// structural characters inside strings.
+static std::string gen_json(size_t len, std::mt19937& gen) {
+    const char *pieces[] = {"{", "}", "[", "]", ":", ",", " ", "\n", "\"key\"", "123",
+                            "\"a,b:{}\"", "\"\\\"\"", "\"\\\\\"", "\\", "\"", "\"\xc3\xa9\"", "true"};
+    std::string s;
+    while (s.size() < len) {
+        s += pieces[gen() % (sizeof(pieces) / sizeof(pieces[0]))];
+    }
+    s.resize(len);
+    return s;
+}
+
+static void test_json_index(json_index_t json_index) {
+    struct JsonCase {
+        std::string json;
+        std::vector<uint32_t> expected;
+    };
+    std::vector<JsonCase> tests = {
+        JsonCase{"", {}},
+        JsonCase{"123", {}},
+        JsonCase{R"({"a":1})", {0, 1, 3, 4, 6}},
+        JsonCase{R"([1, "x,y", {}])", {0, 2, 4, 8, 9, 11, 12, 13}},
+        JsonCase{R"({"a\"b":[]})", {0, 1, 6, 7, 8, 9, 10}},
+        JsonCase{R"(["\\", ":"])", {0, 1, 4, 5, 7, 9, 10}},
+    };
+    for (const auto& test : tests) {
+        int64_t n;
+        EXPECT_EQ(run(json_index, test.json, &n), test.expected) << test.json;
+        EXPECT_EQ(n, (int64_t)test.expected.size()) << test.json;
+    }
+
+    // a string left open
+    for (const char *json : {"\"", "{\"a", "[\"\\\"]", "\"a\"\""}) {
+        int64_t n;
+        run(json_index, json, &n);
+        EXPECT_EQ(n, -1) << json;
+    }
+
+    // backslash runs and strings across the 64-byte blocks
+    for (size_t run_len = 0; run_len <= 130; run_len++) {
+        std::string json = "[\"" + std::string(run_len, '\\') + "\",1]";
+        int64_t n, want;
+        std::vector<uint32_t> expected = run(json_index_naive, json, &want);
+        EXPECT_EQ(run(json_index, json, &n), expected) << run_len;
+        EXPECT_EQ(n, want) << run_len;
+    }
+
+    std::mt19937 gen(42);
+    for (size_t len = 0; len <= 300; len++) {
+        for (int round = 0; round < 10; round++) {
+            std::string json = gen_json(len, gen);
+            int64_t n, want;
+            std::vector<uint32_t> expected = run(json_index_naive, json, &want);
+            ASSERT_EQ(run(json_index, json, &n), expected) << json;
+            EXPECT_EQ(n, want) << json;
+        }
+    }
+}
+
+ADD_ISA_TEST(json_index, naive, NAIVE);
+ADD_ISA_TEST(json_index, sse, SSE4_2);
+ADD_ISA_TEST(json_index, avx2, AVX2);
+ADD_ISA_TEST(json_index, avx512, AVX512);
+
+TEST(json_index, Dispatch) {
+    for_each_isa([] {
+        test_json_index(simdstr_json_index);
+    });
+}
@@ -0,0 +1,170 @@
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "test_util.h"
+
+using memchr_t  = char* (*)(const char *s, int c, size_t len);
+using memrchr_t = char* (*)(const char *s, int c, size_t len);
+using memchr2_t = char* (*)(const char *s, int c1, int c2, size_t len);
+using memchr3_t = char* (*)(const char *s, int c1, int c2, int c3, size_t len);
+using count_byte_t = size_t (*)(const char *s, int c, size_t len);
+using newline_index_t = size_t (*)(const char *s, size_t len, uint64_t base, uint64_t *offsets);
+
+// the lengths around the blocks and the unrolled iterations of the kernels
+static std::vector<size_t> lengths() {
+    std::vector<size_t> lens;
+    for (size_t len = 0; len <= 300; len++) lens.push_back(len);
+    for (size_t len : {511, 512, 513, 1000, 4095, 4096, 4097, 63 * 128 + 5, 70000}) lens.push_back(len);
+    return lens;
+}
+
+// len bytes of 'a' to 'd' with needles at random positions, and bytes past
+// the end that would match
+static std::string gen_text(size_t len, int needles, std::mt19937& gen) {
+    std::string s(len + 64, 'x');
+    for (size_t i = 0; i < len; i++) s[i] = (char)('a' + gen() % 4);
+    for (int k = 0; k < needles && len > 0; k++) {
+        s[gen() % len] = "xyz\xFF"[gen() % 4];
+    }
+    return s;
+}
+
+static void test_memchr(memchr_t f) {
+    std::mt19937 gen(42);
+    for (size_t len : lengths()) {
+        for (int needles : {0, 1, 3}) {
+            std::string s = gen_text(len, needles, gen);
+            for (char c : {'x', 'y', '\xFF'}) {
+                ASSERT_EQ(f(s.data(), c, len), (char *)memchr(s.data(), c, len)) << len << " " << c;
+            }
+        }
+    }
+    // every position of the one needle, after an offset
+    for (size_t off = 0; off < 4; off++) {
+        std::string s(600, 'a');
+        for (size_t at = 0; at < 512; at++) {
+            s[off + at] = '\n';
+            ASSERT_EQ(f(s.data() + off, '\n', 512), s.data() + off + at) << at;
+            s[off + at] = 'a';
+        }
+    }
+    // c converts to unsigned char as in memchr
+    const char *abc = "abc";
+    EXPECT_EQ(f(abc, 'b' + 256, 3), abc + 1);
+}
+
+static void test_memrchr(memrchr_t f) {
+    std::mt19937 gen(42);
+    for (size_t len : lengths()) {
+        for (int needles : {0, 1, 3}) {
+            std::string s = gen_text(len, needles, gen);
+            for (char c : {'x', 'y', '\xFF'}) {
+                ASSERT_EQ(f(s.data(), c, len), memrchr_naive(s.data(), c, len)) << len << " " << c;
+            }
+        }
+    }
+    std::string s(600, 'a');
+    for (size_t at = 0; at < 512; at++) {
+        s[at] = '\n';
+        s[0] = '\n';
+        ASSERT_EQ(f(s.data(), '\n', 512), s.data() + at) << at;
+        s[at] = 'a';
+    }
+}
+
+static void test_memchr2(memchr2_t f) {
+    std::mt19937 gen(42);
+    for (size_t len : lengths()) {
+        for (int needles : {0, 1, 3}) {
+            std::string s = gen_text(len, needles, gen);
+            ASSERT_EQ(f(s.data(), 'y', 'z', len), memchr2_naive(s.data(), 'y', 'z', len)) << len;
+            ASSERT_EQ(f(s.data(), '\xFF', 'x', len), memchr2_naive(s.data(), '\xFF', 'x', len)) << len;
+        }
+    }
+}
+
+static void test_memchr3(memchr3_t f) {
+    std::mt19937 gen(42);
+    for (size_t len : lengths()) {
+        for (int needles : {0, 1, 3}) {
+            std::string s = gen_text(len, needles, gen);
+            ASSERT_EQ(f(s.data(), 'y', 'z', '\xFF', len), memchr3_naive(s.data(), 'y', 'z', '\xFF', len)) << len;
+            ASSERT_EQ(f(s.data(), 'q', 'r', 'x', len), memchr3_naive(s.data(), 'q', 'r', 'x', len)) << len;
+        }
+    }
+}
+
+static void test_count_byte(count_byte_t f) {
+    std::mt19937 gen(42);
+    for (size_t len : lengths()) {
+        for (int needles : {0, 1, 3}) {
+            std::string s = gen_text(len, needles, gen);
+            for (char c : {'a', 'x', '\xFF'}) {
+                ASSERT_EQ(f(s.data(), c, len), count_byte_naive(s.data(), c, len)) << len << " " << c;
+            }
+        }
+    }
+    // every byte a match, past the wrap of a byte lane
+    std::string s(100000, '\n');
+    EXPECT_EQ(f(s.data(), '\n', s.size()), s.size());
+}
+
+static void test_newline_index(newline_index_t f) {
+    std::mt19937 gen(42);
+    for (size_t len : lengths()) {
+        for (int lines : {0, 1, 3, (int)len / 8, (int)len}) {
+            std::string s(len + 64, '\n');
+            for (size_t i = 0; i < len; i++) s[i] = 'a';
+            for (int k = 0; k < lines && len > 0; k++) s[gen() % len] = '\n';
+            std::vector<uint64_t> want;
+            for (size_t i = 0; i < len; i++) {
+                if (s[i] == '\n') want.push_back(1000 + i);
+            }
+            // one slot more, left alone
+            std::vector<uint64_t> got(want.size() + 1, 7);
+            ASSERT_EQ(f(s.data(), len, 1000, got.data()), want.size()) << len;
+            ASSERT_EQ(got.back(), 7u) << len;
+            got.pop_back();
+            ASSERT_EQ(got, want) << len;
+        }
+    }
+}
+
+ADD_ISA_TEST(memchr, naive, NAIVE);
+ADD_ISA_TEST(memchr, sse, SSE4_2);
+ADD_ISA_TEST(memchr, avx2, AVX2);
+ADD_ISA_TEST(memchr, avx512, AVX512);
+ADD_ISA_TEST(memrchr, naive, NAIVE);
+ADD_ISA_TEST(memrchr, sse, SSE4_2);
+ADD_ISA_TEST(memrchr, avx2, AVX2);
+ADD_ISA_TEST(memrchr, avx512, AVX512);
+ADD_ISA_TEST(memchr2, naive, NAIVE);
+ADD_ISA_TEST(memchr2, sse, SSE4_2);
+ADD_ISA_TEST(memchr2, avx2, AVX2);
+ADD_ISA_TEST(memchr2, avx512, AVX512);
+ADD_ISA_TEST(memchr3, naive, NAIVE);
+ADD_ISA_TEST(memchr3, sse, SSE4_2);
+ADD_ISA_TEST(memchr3, avx2, AVX2);
+ADD_ISA_TEST(memchr3, avx512, AVX512);
+ADD_ISA_TEST(count_byte, naive, NAIVE);
+ADD_ISA_TEST(count_byte, sse, SSE4_2);
+ADD_ISA_TEST(count_byte, avx2, AVX2);
+ADD_ISA_TEST(count_byte, avx512, AVX512);
+ADD_ISA_TEST(newline_index, naive, NAIVE);
+ADD_ISA_TEST(newline_index, sse, SSE4_2);
+ADD_ISA_TEST(newline_index, avx2, AVX2);
+ADD_ISA_TEST(newline_index, avx512, AVX512);
+
+TEST(memchr, Dispatch) {
+    for_each_isa([] {
+        test_memchr(simdstr_memchr);
+        test_memrchr(simdstr_memrchr);
+        test_memchr2(simdstr_memchr2);
+        test_memchr3(simdstr_memchr3);
+        test_count_byte(simdstr_count_byte);
+        test_newline_index(simdstr_newline_index);
+    });
+}
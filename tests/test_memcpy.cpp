@@ -0,0 +1,93 @@
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "test_util.h"
+
+using memcpy_t  = char* (*)(char *dst, const char *src, size_t len);
+using memmove_t = char* (*)(char *dst, const char *src, size_t len);
+
+// the lengths around every size class and the unrolled iterations
+static std::vector<size_t> lengths() {
+    std::vector<size_t> lens;
+    for (size_t len = 0; len <= 600; len++) lens.push_back(len);
+    for (size_t len : {1023, 1024, 1025, 2047, 2048, 2049, 4095, 4096, 4097, 65536 + 77}) lens.push_back(len);
+    return lens;
+}
+
+// at every alignment of dst and of src, the bytes around dst left alone
+static void test_copy_aligns(memcpy_t f) {
+    std::mt19937 gen(42);
+    for (size_t len : lengths()) {
+        for (size_t src_off : {0, 1, 7, 32, 63}) {
+            for (size_t dst_off : {0, 3, 16, 33}) {
+                std::string src = gen_bytes(len + 64, gen);
+                std::string dst(len + 128, '\xAA');
+                std::string want = dst;
+                memcpy(&want[64 + dst_off], &src[src_off], len);
+                ASSERT_EQ(f(&dst[64 + dst_off], &src[src_off], len), &dst[64 + dst_off]);
+                ASSERT_EQ(dst, want) << len << " " << src_off << " " << dst_off;
+            }
+        }
+    }
+}
+
+static void test_memcpy(memcpy_t f) {
+    test_copy_aligns(f);
+}
+
+// dst at every shift around src within one buffer, in both directions
+static void test_memmove(memmove_t f) {
+    test_copy_aligns(f);
+    std::mt19937 gen(42);
+    for (size_t len : lengths()) {
+        for (long shift : {-300L, -129L, -64L, -33L, -1L, 0L, 1L, 17L, 64L, 65L, 255L, 300L}) {
+            std::string buf = gen_bytes(len + 700, gen);
+            std::string want = buf;
+            memmove(&want[350 + shift], &want[350], len);
+            ASSERT_EQ(f(&buf[350 + shift], &buf[350], len), &buf[350 + shift]);
+            ASSERT_EQ(buf, want) << len << " " << shift;
+        }
+    }
+}
+
+ADD_ISA_TEST(memcpy, naive, NAIVE);
+ADD_ISA_TEST(memcpy, sse, SSE4_2);
+ADD_ISA_TEST(memcpy, avx2, AVX2);
+ADD_ISA_TEST(memcpy, avx512, AVX512);
+ADD_ISA_TEST(memmove, naive, NAIVE);
+ADD_ISA_TEST(memmove, sse, SSE4_2);
+ADD_ISA_TEST(memmove, avx2, AVX2);
+ADD_ISA_TEST(memmove, avx512, AVX512);
+
+// the rep movsb threshold follows the level set last
+TEST(memcpy, Thresholds) {
+    for_each_isa([] {
+        simdstr_isa_t isa = simdstr_isa();
+        size_t movsb, nt;
+        simdstr_copy_thresholds(&movsb, &nt);
+        EXPECT_LT(movsb, nt);
+        if (simdstr_cpu_features() & SIMDSTR_CPU_ERMS) {
+            EXPECT_EQ(movsb, isa == SIMDSTR_ISA_AVX512 ? 8192u : isa == SIMDSTR_ISA_AVX2 ? 4096u : 2048u) << isa;
+        } else {
+            EXPECT_EQ(movsb, SIZE_MAX);
+        }
+    });
+}
+
+// the rep movsb and the non-temporal copies at small sizes, and each one
+// alone
+TEST(memcpy, Dispatch) {
+    for_each_isa([] {
+        size_t movsb, nt;
+        simdstr_copy_thresholds(&movsb, &nt);
+        const size_t thresholds[][2] = {{movsb, nt}, {300, 1024}, {SIZE_MAX, 300}, {300, SIZE_MAX}};
+        for (const auto& t : thresholds) {
+            simdstr_set_copy_thresholds(t[0], t[1]);
+            test_memcpy(simdstr_memcpy);
+            test_memmove(simdstr_memmove);
+        }
+    });
+}
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+extern "C" {
+    #include  "naivestr.h"
+    #include  "simdstr.h"
+}
+
+TEST(memcmpeq_parallel, Basic) {
+    size_t len = 8 * SIMDSTR_PARALLEL_MIN + 123;
+    std::string s1(len, 'x');
+    std::string s2 = s1;
+    for (int nthreads : {0, 1, 2, 4, 7}) {
+        EXPECT_TRUE(memcmpeq_parallel(s1.data(), s2.data(), len, nthreads));
+        // mismatches at the edges of the input and of the chunks
+        for (size_t pos : {(size_t)0, (size_t)1, len / 2, (size_t)(256 * 1024 - 1),
+                           (size_t)(256 * 1024), len - 1}) {
+            s2[pos] = 'y';
+            EXPECT_FALSE(memcmpeq_parallel(s1.data(), s2.data(), len, nthreads)) << pos;
+            EXPECT_TRUE(memcmpeq_parallel(s1.data(), s2.data(), pos, nthreads)) << pos;
+            s2[pos] = 'x';
+        }
+    }
+    // below the threshold
+    EXPECT_TRUE(memcmpeq_parallel("abc", "abd", 2, 0));
+    EXPECT_FALSE(memcmpeq_parallel("abc", "abd", 3, 0));
+}
+
+TEST(sum_parallel, Basic) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dis(-1.0, 1.0);
+    size_t len = 3 * SIMDSTR_PARALLEL_MIN + 7;
+    std::vector<float> vec(len);
+
+    // integral values are summed exactly in any order
+    for (size_t i = 0; i < len; i++) vec[i] = (float)(i % 5);
+    EXPECT_EQ(sum_parallel(vec.data(), len, 0), sum_naive(vec.data(), len));
+    EXPECT_EQ(sum_parallel(vec.data(), 100, 0), sum_naive(vec.data(), 100));
+
+    // the same result for any number of threads
+    for (auto& v : vec) v = dis(gen);
+    float expected = sum_parallel(vec.data(), len, 1);
+    for (int nthreads : {0, 2, 3, 8}) {
+        EXPECT_EQ(sum_parallel(vec.data(), len, nthreads), expected) << nthreads;
+    }
+}
+
+TEST(count_byte_parallel, Basic) {
+    std::mt19937 gen(42);
+    size_t len = 5 * SIMDSTR_PARALLEL_MIN + 11;
+    std::string s(len, 'a');
+    for (size_t i = 0; i < len / 50; i++) s[gen() % len] = '\n';
+    size_t expected = count_byte_naive(s.data(), '\n', len);
+    for (int nthreads : {0, 1, 2, 3, 8}) {
+        EXPECT_EQ(count_byte_parallel(s.data(), '\n', len, nthreads), expected) << nthreads;
+    }
+    EXPECT_EQ(count_byte_parallel(s.data(), '\n', 1000, 0), count_byte_naive(s.data(), '\n', 1000));
+}
+
+// the lines upper-cased and cut to their first 5 bytes, lengths 0 included
+static size_t upper5(char *dst, const char *line, size_t len, void *ctx) {
+    size_t n = len < 5 ? len : 5;
+    simdstr_toupper(dst, line, n);
+    ++*(std::atomic<size_t> *)ctx;
+    return n;
+}
+
+static std::string expect_upper5(const std::string& s) {
+    std::string out;
+    size_t i = 0;
+    while (i < s.size()) {
+        size_t end = s.find('\n', i);
+        std::string line = s.substr(i, end == std::string::npos ? std::string::npos : end - i);
+        for (size_t k = 0; k < line.size() && k < 5; k++) out += (char)toupper(line[k]);
+        if (end == std::string::npos) break;
+        out += '\n';
+        i = end + 1;
+    }
+    return out;
+}
+
+static std::string map_upper5(const std::string& s, int nthreads, size_t *lines) {
+    std::vector<char> out(s.size() + 1);
+    std::atomic<size_t> n(0);
+    int64_t w = map_lines_parallel(out.data(), s.data(), s.size(), upper5, &n, nthreads);
+    *lines = n;
+    return w < 0 ? "<failed>" : std::string(out.data(), w);
+}
+
+TEST(map_lines_parallel, Basic) {
+    std::mt19937 gen(42);
+    for (size_t len : {(size_t)0, (size_t)1, (size_t)100, (size_t)(3 * SIMDSTR_PARALLEL_MIN + 5)}) {
+        // lines of 0 to 200 bytes, with and without a last newline
+        std::string s(len, 'a');
+        for (auto& c : s) c = gen() % 100 == 0 ? '\n' : (char)('a' + gen() % 26);
+        for (bool last_nl : {false, true}) {
+            if (len > 0) s.back() = last_nl ? '\n' : 'z';
+            std::string expected = expect_upper5(s);
+            size_t nlines = std::count(s.begin(), s.end(), '\n') + (len > 0 && !last_nl);
+            for (int nthreads : {0, 1, 2, 3, 8}) {
+                size_t lines;
+                ASSERT_EQ(map_upper5(s, nthreads, &lines), expected) << len << " " << nthreads;
+                ASSERT_EQ(lines, nlines) << len << " " << nthreads;
+            }
+        }
+    }
+    // one line longer than the ranges, and only newlines
+    size_t lines;
+    std::string s(3 * SIMDSTR_PARALLEL_MIN, 'x');
+    s[10] = '\n';
+    EXPECT_EQ(map_upper5(s, 4, &lines), "XXXXX\nXXXXX");
+    std::string nl(2 * SIMDSTR_PARALLEL_MIN, '\n');
+    EXPECT_EQ(map_upper5(nl, 4, &lines), nl);
+    EXPECT_EQ(lines, nl.size());
+}
+
+TEST(map_lines_file, Basic) {
+    char in_path[] = "/tmp/simdstr_linesXXXXXX";
+    int  fd = mkstemp(in_path);
+    ASSERT_GE(fd, 0);
+    std::mt19937 gen(42);
+    std::string s(2 * SIMDSTR_PARALLEL_MIN + 77, 'a');
+    for (auto& c : s) c = gen() % 40 == 0 ? '\n' : (char)('a' + gen() % 26);
+    ASSERT_EQ(write(fd, s.data(), s.size()), (ssize_t)s.size());
+    close(fd);
+    std::string out_path = std::string(in_path) + ".out";
+    std::atomic<size_t> n(0);
+    std::string expected = expect_upper5(s);
+    ASSERT_EQ(map_lines_file(in_path, out_path.c_str(), upper5, &n, 0), (int64_t)expected.size());
+    std::ifstream f(out_path, std::ios::binary);
+    std::string got((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(got, expected);
+    // the input is not its own output, and a missing input fails
+    EXPECT_EQ(map_lines_file(in_path, in_path, upper5, &n, 0), -1);
+    EXPECT_EQ(errno, EINVAL);
+    EXPECT_EQ(map_lines_file("/nonexistent/in", out_path.c_str(), upper5, &n, 0), -1);
+    // an empty input
+    std::ofstream(in_path, std::ios::trunc);
+    EXPECT_EQ(map_lines_file(in_path, out_path.c_str(), upper5, &n, 0), 0);
+    unlink(in_path);
+    unlink(out_path.c_str());
+}
@@ -0,0 +1,129 @@
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "test_util.h"
+
+using unquote_t = int64_t (*)(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+using quote_t   = size_t (*)(char *dst, const char *src, size_t len, simdstr_escape_t mode);
+
+// the quote of bench/bm_str.cpp, and its JSON escapes of the control bytes
+static std::string expect_quote(const std::string& s, simdstr_escape_t mode) {
+    std::string temp = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            temp += '\\';
+            temp += c;
+        } else if (mode == SIMDSTR_ESCAPE_JSON && (unsigned char)c < 0x20) {
+            const char *esc[] = {"\\b", "\\t", "\\n", nullptr, "\\f", "\\r"};
+            if (c >= '\b' && c <= '\r' && esc[c - '\b'] != nullptr) {
+                temp += esc[c - '\b'];
+            } else {
+                char buf[8];
+                snprintf(buf, sizeof(buf), "\\u%04x", c);
+                temp += buf;
+            }
+        } else {
+            temp += c;
+        }
+    }
+    return temp + "\"";
+}
+
+// len bytes with the escape sites dense, sparse or absent
+static std::string gen_text(size_t len, int density, std::mt19937& gen) {
+    const char special[] = {'"', '\\', '\n', '\0', '\x1F', '\t'};
+    std::string s(len, '\0');
+    for (auto& c : s) {
+        c = density > 0 && (int)(gen() % 64) < density ? special[gen() % 6] : (char)(0x20 + gen() % 0xE0);
+    }
+    return s;
+}
+
+static std::string quote(quote_t q, const std::string& s, simdstr_escape_t mode) {
+    std::vector<char> out(6 * s.size() + 2);
+    size_t n = q(out.data(), s.data(), s.size(), mode);
+    return std::string(out.data(), n);
+}
+
+// the result, or "<invalid>"
+static std::string unquote(unquote_t uq, const std::string& s, simdstr_escape_t mode) {
+    std::vector<char> out(s.size() + 1);
+    int64_t n = uq(out.data(), s.data(), s.size(), mode);
+    return n < 0 ? "<invalid>" : std::string(out.data(), n);
+}
+
+static void test_quote(quote_t q) {
+    std::mt19937 gen(42);
+    for (auto mode : {SIMDSTR_ESCAPE_QUOTES, SIMDSTR_ESCAPE_JSON}) {
+        for (int density : {0, 1, 8, 64}) {
+            for (size_t len = 0; len <= 300; len++) {
+                std::string s = gen_text(len, density, gen);
+                ASSERT_EQ(quote(q, s, mode), expect_quote(s, mode)) << mode << " " << len;
+            }
+        }
+    }
+    EXPECT_EQ(quote(q, std::string("a\"b\\c\n\x01\x7F", 8), SIMDSTR_ESCAPE_JSON), "\"a\\\"b\\\\c\\n\\u0001\x7F\"");
+    EXPECT_EQ(quote(q, "a\"b\\c\n", SIMDSTR_ESCAPE_QUOTES), "\"a\\\"b\\\\c\n\"");
+}
+
+static void test_unquote(unquote_t uq) {
+    std::mt19937 gen(42);
+    for (auto mode : {SIMDSTR_ESCAPE_QUOTES, SIMDSTR_ESCAPE_JSON}) {
+        for (int density : {0, 1, 8, 64}) {
+            for (size_t len = 0; len <= 300; len++) {
+                std::string s = gen_text(len, density, gen);
+                std::string q = expect_quote(s, mode);
+                ASSERT_EQ(unquote(uq, q, mode), s) << mode << " " << len;
+                ASSERT_EQ(unquote(uq, q + "tail\"", mode), s) << mode << " " << len;
+                ASSERT_EQ(unquote(uq, q.substr(0, q.size() - 1), mode), "<invalid>") << mode << " " << len;
+            }
+        }
+    }
+    // the QUOTES grammar is the one of qstrlen, invalid inputs included
+    const char alphabet[] = {'a', '"', '\\', 'n', 'u'};
+    for (size_t len = 1; len <= 150; len++) {
+        for (int round = 0; round < 20; round++) {
+            std::string s = "\"";
+            for (size_t i = 1; i < len; i++) s += alphabet[gen() % (round < 10 ? 5 : 1 + round % 4)];
+            int64_t want = simdstr_qstrlen(s.data(), s.size());
+            std::vector<char> out(len);
+            ASSERT_EQ(uq(out.data(), s.data(), len, SIMDSTR_ESCAPE_QUOTES), want) << s;
+            ASSERT_EQ(unquote(uq, s, SIMDSTR_ESCAPE_JSON), unquote(unquote_naive, s, SIMDSTR_ESCAPE_JSON)) << s;
+        }
+    }
+    const std::pair<std::string, std::string> json[] = {
+        {"\"\"", ""}, {"\"a\\/b\\b\\f\\n\\r\\t\"", "a/b\b\f\n\r\t"}, {"\"\\u0041\\u00e9\\u20AC\"", u8"Aé€"},
+        {"\"\\ud83d\\ude00!\"", u8"😀!"}, {"\"\\u0000\"", std::string(1, '\0')},
+        {"\"\\udc00\"", "<invalid>"}, {"\"\\ud800\"", "<invalid>"}, {"\"\\ud800\\u0041\"", "<invalid>"},
+        {"\"\\ud800x\\udc00\"", "<invalid>"}, {"\"\\u12g4\"", "<invalid>"}, {"\"\\u12", "<invalid>"},
+        {"\"\\x\"", "<invalid>"}, {"\"\\", "<invalid>"}, {"x\"\"", "<invalid>"}, {"", "<invalid>"},
+    };
+    for (const auto& t : json) {
+        EXPECT_EQ(unquote(uq, t.first, SIMDSTR_ESCAPE_JSON), t.second) << t.first;
+    }
+    EXPECT_EQ(unquote(uq, "\"a\\nb\"", SIMDSTR_ESCAPE_QUOTES), "<invalid>");
+    // an escape across the block boundaries
+    for (size_t at = 0; at < 130; at++) {
+        std::string s = "\"" + std::string(at, 'x') + "\\u00e9" + std::string(70, 'y') + "\"";
+        ASSERT_EQ(unquote(uq, s, SIMDSTR_ESCAPE_JSON), std::string(at, 'x') + u8"é" + std::string(70, 'y')) << at;
+    }
+}
+
+ADD_ISA_TEST(unquote, naive, NAIVE);
+ADD_ISA_TEST(unquote, sse, SSE4_2);
+ADD_ISA_TEST(unquote, avx2, AVX2);
+ADD_ISA_TEST(unquote, avx512, AVX512);
+ADD_ISA_TEST(quote, naive, NAIVE);
+ADD_ISA_TEST(quote, sse, SSE4_2);
+ADD_ISA_TEST(quote, avx2, AVX2);
+ADD_ISA_TEST(quote, avx512, AVX512);
+
+TEST(quote, Dispatch) {
+    for_each_isa([] {
+        test_unquote(simdstr_unquote);
+        test_quote(simdstr_quote);
+    });
+}
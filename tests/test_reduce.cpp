@@ -0,0 +1,220 @@
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+extern "C" {
+    #include  "naivestr.h"
+}
+#include "test_util.h"
+
+using sum_t = float (*)(const float *vec, size_t len);
+using dot_t = float (*)(const float *a, const float *b, size_t len);
+
+static const double u = std::ldexp(1.0, -24);
+
+// sum|x|, and the exact sum up to the rounding of a long double Neumaier sum
+static void exact_sum(const std::vector<double>& terms, long double *sum, double *abs_sum) {
+    long double s = 0, c = 0;
+    double a = 0;
+    for (double x : terms) {
+        long double t = s + x;
+        c += std::fabs((double)s) >= std::fabs(x) ? (s - t) + x : (x - t) + s;
+        s = t;
+        a += std::fabs(x);
+    }
+    *sum = s + c;
+    *abs_sum = a;
+}
+
+// The error bounds of simdstr_reduce_t for n terms.
+static double bound(simdstr_reduce_t mode, size_t n, long double sum, double abs_sum) {
+    double s = std::fabs((double)sum);
+    switch (mode) {
+    case SIMDSTR_REDUCE_COMPENSATED:
+        return 2 * u * s + (n * u) * (n * u) * abs_sum;
+    case SIMDSTR_REDUCE_REPRODUCIBLE:
+        return u * s + n * std::ldexp(1.0, -53) * abs_sum;
+    default:
+        return n * u * abs_sum;
+    }
+}
+
+// the terms cancel: large values of both signs hide the small ones
+static std::vector<float> ill_conditioned(size_t len, std::mt19937& gen) {
+    std::uniform_real_distribution<float> dis(-1.0, 1.0);
+    std::vector<float> vec(len);
+    for (size_t i = 0; i < len; i++) {
+        vec[i] = std::ldexp(dis(gen), (int)(gen() % 40) - 20);
+    }
+    return vec;
+}
+
+static void check_sum(sum_t sum, simdstr_reduce_t mode) {
+    std::mt19937 gen(42);
+    for (size_t len = 0; len <= 300; len++) {
+        std::vector<float> vec = ill_conditioned(len, gen);
+        std::vector<double> terms(vec.begin(), vec.end());
+        long double exact;
+        double abs_sum;
+        exact_sum(terms, &exact, &abs_sum);
+        double err = std::fabs((double)(sum(vec.data(), len) - exact));
+        EXPECT_LE(err, bound(mode, len, exact, abs_sum)) << "len " << len;
+    }
+    // a large sum that the float lanes of the fast mode cannot hold
+    std::vector<float> vec = ill_conditioned(200000, gen);
+    std::vector<double> terms(vec.begin(), vec.end());
+    long double exact;
+    double abs_sum;
+    exact_sum(terms, &exact, &abs_sum);
+    double err = std::fabs((double)(sum(vec.data(), vec.size()) - exact));
+    EXPECT_LE(err, bound(mode, vec.size(), exact, abs_sum));
+}
+
+static void check_dot(dot_t dot, simdstr_reduce_t mode) {
+    std::mt19937 gen(7);
+    for (size_t len : {0, 1, 3, 4, 15, 16, 17, 31, 32, 33, 63, 64, 65, 100, 1000, 100000}) {
+        std::vector<float> a = ill_conditioned(len, gen);
+        std::vector<float> b = ill_conditioned(len, gen);
+        std::vector<double> terms(len);
+        for (size_t i = 0; i < len; i++) terms[i] = (double)a[i] * b[i];
+        long double exact;
+        double abs_sum;
+        exact_sum(terms, &exact, &abs_sum);
+        double err = std::fabs((double)(dot(a.data(), b.data(), len) - exact));
+        // the products are rounded once more in the fast mode
+        EXPECT_LE(err, bound(mode, len + 1, exact, abs_sum)) << "len " << len;
+    }
+}
+
+static void check_minmax(sum_t min, sum_t max) {
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<float> dis(-100.0, 100.0);
+    for (size_t len = 0; len <= 200; len++) {
+        std::vector<float> vec(len);
+        for (auto& v : vec) v = dis(gen);
+        if (len > 2) vec[gen() % len] = NAN;
+        EXPECT_EQ(min(vec.data(), len), min_naive(vec.data(), len)) << "len " << len;
+        EXPECT_EQ(max(vec.data(), len), max_naive(vec.data(), len)) << "len " << len;
+    }
+    EXPECT_EQ(min(nullptr, 0), INFINITY);
+    EXPECT_EQ(max(nullptr, 0), -INFINITY);
+    float all_nan[5] = {NAN, NAN, NAN, NAN, NAN};
+    EXPECT_EQ(min(all_nan, 5), INFINITY);
+}
+
+// the reproducible kernels match the scalar ones bit for bit
+static void check_repro(sum_t sum, dot_t dot) {
+    std::mt19937 gen(42);
+    for (size_t len : {0, 1, 15, 16, 17, 100, 1000, SIMDSTR_REDUCE_BLOCK - 1,
+                       SIMDSTR_REDUCE_BLOCK, 3 * SIMDSTR_REDUCE_BLOCK + 5}) {
+        std::vector<float> a = ill_conditioned(len, gen);
+        std::vector<float> b = ill_conditioned(len, gen);
+        float got = sum(a.data(), len), want = sum_repro_naive(a.data(), len);
+        EXPECT_EQ(std::memcmp(&got, &want, sizeof(float)), 0) << "len " << len;
+        got  = dot(a.data(), b.data(), len);
+        want = dot_repro_naive(a.data(), b.data(), len);
+        EXPECT_EQ(std::memcmp(&got, &want, sizeof(float)), 0) << "len " << len;
+    }
+}
+
+static void test_sum_fast(sum_t f)  { check_sum(f, SIMDSTR_REDUCE_FAST); }
+static void test_sum_kahan(sum_t f) { check_sum(f, SIMDSTR_REDUCE_COMPENSATED); }
+static void test_sum_repro(sum_t f) { check_sum(f, SIMDSTR_REDUCE_REPRODUCIBLE); }
+static void test_dot_fast(dot_t f)  { check_dot(f, SIMDSTR_REDUCE_FAST); }
+static void test_dot_kahan(dot_t f) { check_dot(f, SIMDSTR_REDUCE_COMPENSATED); }
+static void test_dot_repro(dot_t f) { check_dot(f, SIMDSTR_REDUCE_REPRODUCIBLE); }
+
+ADD_ISA_TEST(sum_fast, sse, NAIVE);
+ADD_ISA_TEST(sum_fast, avx2, AVX2);
+ADD_ISA_TEST(sum_fast, avx512, AVX512);
+ADD_ISA_TEST(sum_kahan, naive, NAIVE);
+ADD_ISA_TEST(sum_kahan, sse, NAIVE);
+ADD_ISA_TEST(sum_kahan, avx2, AVX2);
+ADD_ISA_TEST(sum_kahan, avx512, AVX512);
+ADD_ISA_TEST(sum_repro, naive, NAIVE);
+ADD_ISA_TEST(sum_repro, sse, NAIVE);
+ADD_ISA_TEST(sum_repro, avx2, AVX2);
+ADD_ISA_TEST(sum_repro, avx512, AVX512);
+ADD_ISA_TEST(dot_fast, sse, NAIVE);
+ADD_ISA_TEST(dot_fast, avx2, AVX2);
+ADD_ISA_TEST(dot_fast, avx512, AVX512);
+ADD_ISA_TEST(dot_kahan, naive, NAIVE);
+ADD_ISA_TEST(dot_kahan, sse, NAIVE);
+ADD_ISA_TEST(dot_kahan, avx2, AVX2);
+ADD_ISA_TEST(dot_kahan, avx512, AVX512);
+ADD_ISA_TEST(dot_repro, naive, NAIVE);
+ADD_ISA_TEST(dot_repro, sse, NAIVE);
+ADD_ISA_TEST(dot_repro, avx2, AVX2);
+ADD_ISA_TEST(dot_repro, avx512, AVX512);
+
+TEST(repro, Bitwise) {
+    check_repro(sum_repro_sse, dot_repro_sse);
+    if (simdstr_cpu_isa() >= SIMDSTR_ISA_AVX2) {
+        check_repro(sum_repro_avx2, dot_repro_avx2);
+    }
+    if (simdstr_cpu_isa() >= SIMDSTR_ISA_AVX512) {
+        check_repro(sum_repro_avx512, dot_repro_avx512);
+    }
+}
+
+TEST(minmax, Basic) {
+    check_minmax(min_naive, max_naive);
+    check_minmax(min_sse, max_sse);
+    if (simdstr_cpu_isa() >= SIMDSTR_ISA_AVX2) {
+        check_minmax(min_avx2, max_avx2);
+    }
+    if (simdstr_cpu_isa() >= SIMDSTR_ISA_AVX512) {
+        check_minmax(min_avx512, max_avx512);
+    }
+}
+
+// the dispatched entry points on every ISA level of this cpu
+TEST(reduce, Dispatch) {
+    std::mt19937 gen(42);
+    std::vector<float> vec = ill_conditioned(100003, gen);
+    std::vector<float> other = ill_conditioned(vec.size(), gen);
+    float repro_sum = sum_repro_naive(vec.data(), vec.size());
+    float repro_dot = dot_repro_naive(vec.data(), other.data(), vec.size());
+    for_each_isa([&] {
+        check_sum([](const float *v, size_t n) {
+            return simdstr_reduce_sum(v, n, SIMDSTR_REDUCE_FAST); }, SIMDSTR_REDUCE_FAST);
+        check_sum([](const float *v, size_t n) {
+            return simdstr_reduce_sum(v, n, SIMDSTR_REDUCE_COMPENSATED); }, SIMDSTR_REDUCE_COMPENSATED);
+        check_dot([](const float *a, const float *b, size_t n) {
+            return simdstr_reduce_dot(a, b, n, SIMDSTR_REDUCE_FAST); }, SIMDSTR_REDUCE_FAST);
+        check_dot([](const float *a, const float *b, size_t n) {
+            return simdstr_reduce_dot(a, b, n, SIMDSTR_REDUCE_COMPENSATED); }, SIMDSTR_REDUCE_COMPENSATED);
+        for (simdstr_reduce_t mode : {SIMDSTR_REDUCE_FAST, SIMDSTR_REDUCE_COMPENSATED,
+                                      SIMDSTR_REDUCE_REPRODUCIBLE}) {
+            float sum = simdstr_reduce_sum(vec.data(), vec.size(), mode);
+            EXPECT_FLOAT_EQ(simdstr_reduce_mean(vec.data(), vec.size(), mode),
+                            (float)((double)sum / vec.size()));
+        }
+        EXPECT_EQ(simdstr_reduce_sum(vec.data(), vec.size(), SIMDSTR_REDUCE_REPRODUCIBLE), repro_sum);
+        EXPECT_EQ(simdstr_reduce_dot(vec.data(), other.data(), vec.size(), SIMDSTR_REDUCE_REPRODUCIBLE),
+                  repro_dot);
+        EXPECT_EQ(simdstr_reduce_min(vec.data(), vec.size()), min_naive(vec.data(), vec.size()));
+        EXPECT_EQ(simdstr_reduce_max(vec.data(), vec.size()), max_naive(vec.data(), vec.size()));
+    });
+    EXPECT_TRUE(std::isnan(simdstr_reduce_mean(vec.data(), 0, SIMDSTR_REDUCE_FAST)));
+}
+
+// the same bits for any number of threads
+TEST(reduce_sum_parallel, Reproducible) {
+    std::mt19937 gen(42);
+    std::vector<float> vec = ill_conditioned(5 * SIMDSTR_REDUCE_BLOCK + 17, gen);
+    float expected = sum_repro_naive(vec.data(), vec.size());
+    for (int nthreads : {0, 1, 2, 3, 8}) {
+        EXPECT_EQ(reduce_sum_parallel(vec.data(), vec.size(), SIMDSTR_REDUCE_REPRODUCIBLE, nthreads),
+                  expected) << nthreads;
+    }
+    for (simdstr_reduce_t mode : {SIMDSTR_REDUCE_FAST, SIMDSTR_REDUCE_COMPENSATED}) {
+        float one = reduce_sum_parallel(vec.data(), vec.size(), mode, 1);
+        for (int nthreads : {0, 2, 3}) {
+            EXPECT_EQ(reduce_sum_parallel(vec.data(), vec.size(), mode, nthreads), one) << nthreads;
+        }
+    }
+}
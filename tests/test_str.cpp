@@ -1,8 +1,12 @@
 #include <cctype>
 #include <cstring>
+#include <functional>
+#include <memory>
 #include <random>
 #include <string>
 #include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 extern "C" {
     #include  "naivestr.h"
@@ -10,10 +14,19 @@ extern "C" {
 }
 
 using memcmpeq_t = bool  (*)(const char *s1, const char *s2, size_t len);
+using mismatch_t = size_t (*)(const char *s1, const char *s2, size_t len);
+using memcmp3_t  = int   (*)(const char *s1, const char *s2, size_t len);
 using tolower_t  = char* (*)(char *dst, const char *src, size_t len);
-using compact_t  = int   (*)(char *dst, const char *src, size_t len);
-using qstrlen_t  = int   (*)(const char *src, size_t len);
+using toupper_t  = char* (*)(char *dst, const char *src, size_t len);
+using inplace_t  = char* (*)(char *s, size_t len);
+using compact_t  = std::function<int(char *dst, const char *src, size_t len)>;
+using qstrlen_t  = std::function<int(const char *src, size_t len)>;
+using qstrlen_update_t = bool (*)(simdstr_qstrlen_state_t *st, const char *src, size_t len);
 using strstr_t   = char* (*)(const char *str, size_t n, const char *substr, size_t sn);
+using tolower_batch_t  = void (*)(char *const *dst, const simdstr_slice_t *src, size_t count);
+using memcmpeq_batch_t = void (*)(const simdstr_slice_t *s1, const simdstr_slice_t *s2,
+                                  size_t count, bool *out);
+using qstrlen_batch_t  = void (*)(const simdstr_slice_t *src, size_t count, int *out);
 
 static std::string repeat(const std::string s, int n) {
     std::ostringstream os;
@@ -45,7 +58,103 @@ void test_memcmpeq(memcmpeq_t memcmpeq) {
     }
 }
 
-void test_tolower(tolower_t tolower) {
+void test_memcaseeq(memcmpeq_t memcaseeq) {
+    const struct {
+        std::string s1, s2;
+        bool expected;
+    } tests[] = {
+        {"", "", true},
+        {"Content-Type", "content-type", true},
+        {"CONTENT-LENGTH", "content-type", false},
+        {"@[\\]^_", "`{|}~\x7f", false},
+        {"\xC0\xC9", "\xE0\xE9", false},
+        {"\xC0\xC9", "\xC0\xC9", true},
+        {std::string(1024, 'x'), std::string(1023, 'X') + 'x', true},
+        {std::string(1024, 'x'), std::string(1023, 'X') + 'y', false},
+    };
+    for (const auto& test : tests) {
+        EXPECT_EQ(memcaseeq(test.s1.data(), test.s2.data(), test.s1.size()), test.expected)
+            << test.s1 << "_" << test.s2;
+    }
+    // every pair of bytes at the end of a short, a block and a tail input
+    for (size_t len : {1, 33, 70}) {
+        std::string s1(len, 'k'), s2(len, 'K');
+        for (int a = 0; a < 256; a++) {
+            for (int b = 0; b < 256; b++) {
+                s1[len - 1] = (char)a;
+                s2[len - 1] = (char)b;
+                ASSERT_EQ(memcaseeq(s1.data(), s2.data(), len), memcaseeq_naive(s1.data(), s2.data(), len))
+                    << len << " " << a << " " << b;
+            }
+        }
+    }
+    // a difference at every position of every length around the blocks
+    for (size_t len = 0; len <= 131; len++) {
+        std::string s1(len, 'q'), s2(len, 'Q');
+        EXPECT_TRUE(memcaseeq(s1.data(), s2.data(), len));
+        for (size_t pos = 0; pos < len; pos++) {
+            s2[pos] = 'r';
+            EXPECT_FALSE(memcaseeq(s1.data(), s2.data(), len)) << len << " " << pos;
+            s2[pos] = 'Q';
+        }
+    }
+}
+
+// a mismatch at every position of every length around the 16/32/64-byte blocks
+void test_mismatch(mismatch_t mismatch) {
+    for (size_t len = 0; len <= 131; len++) {
+        std::string s1(len, 'x');
+        std::string s2 = s1;
+        EXPECT_EQ(mismatch(s1.data(), s2.data(), len), len);
+        for (size_t pos = 0; pos < len; pos++) {
+            s2[pos] = 'y';
+            EXPECT_EQ(mismatch(s1.data(), s2.data(), len), pos) << "len " << len;
+            // a second mismatch after the first one
+            s2[len - 1] = 'z';
+            EXPECT_EQ(mismatch(s1.data(), s2.data(), len), pos) << "len " << len;
+            s2[pos] = s2[len - 1] = 'x';
+        }
+    }
+}
+
+static int sign(int x) {
+    return (x > 0) - (x < 0);
+}
+
+void test_memcmp3(memcmp3_t memcmp3) {
+    for (size_t len = 0; len <= 131; len++) {
+        std::string s1(len, 'x');
+        std::string s2 = s1;
+        EXPECT_EQ(memcmp3(s1.data(), s2.data(), len), 0);
+        for (size_t pos = 0; pos < len; pos++) {
+            // the bytes compare unsigned, 0x80 is above 'x'
+            for (char c : {'a', 'z', '\x80', '\xff'}) {
+                s2[pos] = c;
+                int want = sign(std::memcmp(s1.data(), s2.data(), len));
+                EXPECT_EQ(sign(memcmp3(s1.data(), s2.data(), len)), want) << "len " << len;
+                EXPECT_EQ(sign(memcmp3(s2.data(), s1.data(), len)), -want) << "len " << len;
+            }
+            s2[pos] = 'x';
+        }
+    }
+}
+
+using convcase_t = std::function<char*(char *dst, const char *src, size_t len)>;
+
+// random bytes of every length around the 16/32/64-byte blocks
+static void check_convcase_lengths(convcase_t convcase, tolower_t expected) {
+    std::mt19937 gen(42);
+    for (size_t len = 0; len <= 200; len++) {
+        std::string src(len, '\0');
+        for (auto& c : src) c = (char)gen();
+        std::string got(len, '\0'), want(len, '\0');
+        convcase(&got[0], src.data(), len);
+        expected(&want[0], src.data(), len);
+        EXPECT_EQ(got, want) << "len " << len;
+    }
+}
+
+static void check_tolower(convcase_t tolower) {
     struct TolowerCase {
         std::string src;
         std::string expected;
@@ -55,6 +164,7 @@ void test_tolower(tolower_t tolower) {
         TolowerCase{"Hello, World!", "hello, world!"},
         TolowerCase{"12345", "12345"},
         TolowerCase{"ABCDEFGHIJKLMNOPQRSTUVWXYZ", "abcdefghijklmnopqrstuvwxyz"},
+        TolowerCase{"@[`{", "@[`{"},
         TolowerCase{"中文😁\u0432", "中文😁\u0432"},
         TolowerCase{repeat("ABCDEFGHIJKLMNOPQRSTUVWXYZ", 32),
                     repeat("abcdefghijklmnopqrstuvwxyz", 32)},
@@ -70,6 +180,53 @@ void test_tolower(tolower_t tolower) {
         EXPECT_EQ(got, test.expected) << test.src;
         delete[] dst;
     }
+    check_convcase_lengths(tolower, tolower_naive);
+}
+
+static void check_toupper(convcase_t toupper) {
+    struct ToupperCase {
+        std::string src;
+        std::string expected;
+    };
+    std::vector<ToupperCase> tests = {
+        ToupperCase{"", ""},
+        ToupperCase{"Hello, World!", "HELLO, WORLD!"},
+        ToupperCase{"abcdefghijklmnopqrstuvwxyz", "ABCDEFGHIJKLMNOPQRSTUVWXYZ"},
+        ToupperCase{"@[`{", "@[`{"},
+        ToupperCase{"中文😁\u0432", "中文😁\u0432"},
+        ToupperCase{std::string(1024, 'x') + "中文😁\u0432", std::string(1024, 'X') + "中文😁\u0432"},
+    };
+
+    for (const auto& test : tests) {
+        std::string got(test.src.size(), '\0');
+        toupper(&got[0], test.src.data(), test.src.size());
+        EXPECT_EQ(got, test.expected) << test.src;
+    }
+    check_convcase_lengths(toupper, toupper_naive);
+}
+
+// run an in-place kernel on a copy of src
+static convcase_t copy_then(inplace_t inplace) {
+    return [inplace](char *dst, const char *src, size_t len) {
+        std::memcpy(dst, src, len);
+        return inplace(dst, len);
+    };
+}
+
+void test_tolower(tolower_t tolower) {
+    check_tolower(tolower);
+}
+
+void test_toupper(toupper_t toupper) {
+    check_toupper(toupper);
+}
+
+void test_tolower_inplace(inplace_t tolower_inplace) {
+    check_tolower(copy_then(tolower_inplace));
+}
+
+void test_toupper_inplace(inplace_t toupper_inplace) {
+    check_toupper(copy_then(toupper_inplace));
 }
 
 void test_compact(compact_t compact) {
@@ -101,6 +258,28 @@ void test_compact(compact_t compact) {
         EXPECT_EQ(got_len, test.expected_len) << test.src;
         delete[] dst;
     }
+
+    // every length around the blocks, with sparse to dense whitespace
+    std::mt19937 gen(42);
+    const char spaces[] = " \t\r\n";
+    for (int density : {0, 5, 50, 95, 100}) {
+        for (size_t len = 0; len <= 200; len++) {
+            std::string src(len, '\0');
+            for (auto& c : src) {
+                c = (int)(gen() % 100) < density ? spaces[gen() % 4] : (char)gen();
+            }
+            std::string got(len, '\0'), want(len, '\0');
+            int got_len  = compact(&got[0], src.data(), len);
+            int want_len = compact_naive(&want[0], src.data(), len);
+            ASSERT_EQ(got_len, want_len) << "len " << len << " density " << density;
+            EXPECT_EQ(got.substr(0, got_len), want.substr(0, want_len));
+
+            // in place
+            std::string inplace = src;
+            EXPECT_EQ(compact(&inplace[0], inplace.data(), len), want_len);
+            EXPECT_EQ(inplace.substr(0, want_len), want.substr(0, want_len));
+        }
+    }
 }
 
 void test_qstrlen(qstrlen_t qstrlen) {
@@ -138,6 +317,20 @@ void test_qstrlen(qstrlen_t qstrlen) {
         int result = qstrlen(test.src.data(), test.src.size());
         EXPECT_EQ(result, test.expected) << test.src;
     }
+
+    // backslash runs and quotes across the 64-byte blocks
+    std::mt19937 gen(42);
+    const char alphabet[] = "\\\\\"ax";
+    for (int round = 0; round < 2000; round++) {
+        std::string src = "\"";
+        size_t len = gen() % 300;
+        for (size_t i = 0; i < len; i++) src += alphabet[gen() % 5];
+        EXPECT_EQ(qstrlen(src.data(), src.size()), qstrlen_naive(src.data(), src.size())) << src;
+    }
+    for (size_t run = 0; run <= 130; run++) {
+        std::string src = "\"" + std::string(run, '\\') + "\"abc\"";
+        EXPECT_EQ(qstrlen(src.data(), src.size()), qstrlen_naive(src.data(), src.size())) << src;
+    }
 }
 
 void test_strstr(strstr_t strstr) {
@@ -163,6 +356,235 @@ void test_strstr(strstr_t strstr) {
         const char* expect = test.subpos >=0 ? test.str.data() + test.subpos : nullptr;
         EXPECT_EQ(result, expect) << test.str << "_" << test.subpos;
     }
+
+    // short to long needles over a small alphabet, periodic needles included
+    std::mt19937 gen(42);
+    for (int round = 0; round < 3000; round++) {
+        size_t n  = gen() % 400;
+        size_t sn = 1 + gen() % (round % 3 == 0 ? 8 : 100);
+        int alpha = 2 + gen() % 3;
+        std::string str(n, '\0'), substr(sn, '\0');
+        for (auto& c : str) c = 'a' + gen() % alpha;
+        for (auto& c : substr) c = 'a' + gen() % alpha;
+        if (n >= sn && gen() % 2) {
+            str.replace(gen() % (n - sn + 1), sn, substr);
+        }
+        size_t pos = str.find(substr);
+        const char* expect = sn > n ? str.data()
+            : pos == std::string::npos ? nullptr : str.data() + pos;
+        char* result = strstr(str.data(), n, substr.data(), sn);
+        EXPECT_EQ(result, expect) << str << "_" << substr;
+    }
+
+    // worst cases of the candidate filter stay linear
+    std::string haystack = repeat("ab", 1 << 16);
+    for (size_t sn : {3, 16, 31, 32, 33, 64, 256}) {
+        std::string needle = repeat("ab", sn / 2) + "c";
+        EXPECT_EQ(strstr(haystack.data(), haystack.size(), needle.data(), needle.size()), nullptr);
+        needle = repeat("ab", sn / 2) + "b";
+        EXPECT_EQ(strstr(haystack.data(), haystack.size(), needle.data(), needle.size()), nullptr);
+    }
+}
+
+void test_strcasestr(strstr_t strcasestr) {
+    const struct {
+        std::string str, substr;
+        int subpos;
+    } tests[] = {
+        {"", "", 0},
+        {"hello", "", 0},
+        {"Hello", "h", 0},
+        {"heLLo", "ll", 2},
+        {"hello", "O", 4},
+        {"HTTP/1.1 200 OK\r\nContent-Length: 5", "content-length", 17},
+        {"hello", "world", -1},
+        {"a@b", "A`", -1},
+        {"x[y{", "{", 3},
+        {std::string(1024, 'X'), "xx", 0},
+        {std::string(1024, 'X'), "xXy", -1},
+    };
+    for (const auto& test : tests) {
+        char* result = strcasestr(test.str.data(), test.str.size(), test.substr.data(), test.substr.size());
+        const char* expect = test.subpos >= 0 ? test.str.data() + test.subpos : nullptr;
+        EXPECT_EQ(result, expect) << test.str << "_" << test.substr;
+    }
+
+    // short to long needles over a small alphabet of both cases and the
+    // bytes one bit 5 away from the letters
+    std::mt19937 gen(42);
+    const char alphabet[] = "aAbB@`cC";
+    for (int round = 0; round < 3000; round++) {
+        size_t n  = gen() % 400;
+        size_t sn = 1 + gen() % (round % 3 == 0 ? 8 : 100);
+        int alpha = 2 + gen() % 7;
+        std::string str(n, '\0'), substr(sn, '\0');
+        for (auto& c : str) c = alphabet[gen() % alpha];
+        for (auto& c : substr) c = alphabet[gen() % alpha];
+        if (n >= sn && gen() % 2) {
+            std::string flipped = substr;
+            for (auto& c : flipped) c = std::isalpha(c) && gen() % 2 ? c ^ 0x20 : c;
+            str.replace(gen() % (n - sn + 1), sn, flipped);
+        }
+        char* result = strcasestr(str.data(), n, substr.data(), sn);
+        EXPECT_EQ(result, strcasestr_naive(str.data(), n, substr.data(), sn)) << str << "_" << substr;
+    }
+
+    // worst cases of the candidate filter stay linear
+    std::string haystack = repeat("aB", 1 << 16);
+    for (size_t sn : {3, 16, 31, 32, 33, 64, 256}) {
+        std::string needle = repeat("Ab", sn / 2) + "c";
+        EXPECT_EQ(strcasestr(haystack.data(), haystack.size(), needle.data(), needle.size()), nullptr);
+        needle = repeat("Ab", sn / 2) + "B";
+        EXPECT_EQ(strcasestr(haystack.data(), haystack.size(), needle.data(), needle.size()), nullptr);
+    }
+}
+
+// The chunkings of len bytes: two chunks split at every position, and chunks
+// of every size.
+static std::vector<std::vector<size_t>> chunkings(size_t len) {
+    std::vector<std::vector<size_t>> out;
+    for (size_t i = 0; i <= len; i++) {
+        out.push_back({i, len - i});
+    }
+    for (size_t k = 1; k < len; k++) {
+        std::vector<size_t> sizes(len / k, k);
+        if (len % k) sizes.push_back(len % k);
+        out.push_back(sizes);
+    }
+    return out;
+}
+
+// qstrlen through the update kernel, every chunking must agree with the
+// result of one chunk.
+static qstrlen_t chunked(qstrlen_update_t update) {
+    return [update](const char *src, size_t len) {
+        auto run = [update, src](const std::vector<size_t>& sizes) {
+            simdstr_qstrlen_state_t st;
+            simdstr_qstrlen_init(&st);
+            size_t off = 0;
+            for (size_t n : sizes) {
+                update(&st, src + off, n);
+                off += n;
+            }
+            return simdstr_qstrlen_final(&st);
+        };
+        int whole = run({len});
+        for (const auto& sizes : chunkings(len)) {
+            EXPECT_EQ(run(sizes), whole) << std::string(src, len) << " first chunk " << sizes[0];
+        }
+        return whole;
+    };
+}
+
+// the dispatched streaming compact, same check on a copy of src (dst may be src)
+static int compact_chunked(char *dst, const char *src, size_t len) {
+    auto run = [](char *dst, const char *src, const std::vector<size_t>& sizes) {
+        simdstr_compact_state_t st;
+        simdstr_compact_init(&st, dst);
+        size_t off = 0;
+        for (size_t n : sizes) {
+            simdstr_compact_update(&st, src + off, n);
+            off += n;
+        }
+        return st.len;
+    };
+    std::string copy(src, len), want(len, '\0');
+    size_t want_len = run(&want[0], copy.data(), {len});
+    for (const auto& sizes : chunkings(len)) {
+        std::string got(len, '\0');
+        size_t got_len = run(&got[0], copy.data(), sizes);
+        EXPECT_EQ(got.substr(0, got_len), want.substr(0, want_len)) << copy;
+    }
+    return (int)run(dst, src, {len / 2, len - len / 2});
+}
+
+void test_qstrlen_update(qstrlen_update_t update) {
+    test_qstrlen(chunked(update));
+}
+
+// Strings of 0 to 150 bytes, mostly short, quoted with escapes and with the
+// letters of both cases. Short ones only have at most 33 bytes, every group
+// of them takes the grouped path of the kernels.
+static std::vector<std::string> gen_batch(size_t count, std::mt19937& gen, bool short_only = false) {
+    const std::string chars = "aZ\\\"x";
+    std::vector<std::string> strs(count);
+    for (auto& s : strs) {
+        s.resize(short_only ? gen() % 34 : gen() % 4 == 0 ? gen() % 151 : gen() % 41);
+        for (auto& c : s) c = chars[gen() % chars.size()];
+        if (!s.empty() && gen() % 4 != 0) s[0] = '"';
+    }
+    return strs;
+}
+
+static std::vector<simdstr_slice_t> slices(const std::vector<std::string>& strs) {
+    std::vector<simdstr_slice_t> out;
+    for (const auto& s : strs) out.push_back(simdstr_slice_t{s.data(), s.size()});
+    return out;
+}
+
+// the batch sizes cover the groups of the kernels and their remainders
+void test_tolower_batch(tolower_batch_t tolower_batch) {
+    std::mt19937 gen(42);
+    for (size_t n = 0; n <= 81; n++) {
+        size_t count = n % 41;
+        std::vector<std::string> strs = gen_batch(count, gen, n > 40);
+        std::vector<simdstr_slice_t> src = slices(strs);
+        std::vector<std::string> got(strs);
+        std::vector<char *> dst;
+        for (auto& s : got) dst.push_back(&s[0]);
+        tolower_batch(dst.data(), src.data(), count);
+        for (size_t i = 0; i < count; i++) {
+            std::string expected(strs[i].size(), '\0');
+            tolower_naive(&expected[0], strs[i].data(), strs[i].size());
+            EXPECT_EQ(got[i], expected) << count << " " << i;
+        }
+        // in place
+        dst.clear();
+        for (auto& s : strs) dst.push_back(&s[0]);
+        tolower_batch(dst.data(), src.data(), count);
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_EQ(strs[i], got[i]) << count << " " << i;
+        }
+    }
+}
+
+void test_memcmpeq_batch(memcmpeq_batch_t memcmpeq_batch) {
+    std::mt19937 gen(42);
+    for (size_t n = 0; n <= 81; n++) {
+        size_t count = n % 41;
+        std::vector<std::string> strs1 = gen_batch(count, gen, n > 40);
+        std::vector<std::string> strs2(strs1);
+        for (auto& s : strs2) {
+            switch (gen() % 3) {
+            case 0:
+                if (!s.empty()) s[gen() % s.size()] ^= 1;
+                break;
+            case 1:
+                s.resize(gen() % (n > 40 ? 34 : 151), 'a');
+                break;
+            }
+        }
+        std::vector<simdstr_slice_t> s1 = slices(strs1), s2 = slices(strs2);
+        std::unique_ptr<bool[]> out(new bool[count + 1]);
+        memcmpeq_batch(s1.data(), s2.data(), count, out.get());
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_EQ(out[i], strs1[i] == strs2[i]) << count << " " << i;
+        }
+    }
+}
+
+void test_qstrlen_batch(qstrlen_batch_t qstrlen_batch) {
+    std::mt19937 gen(42);
+    for (size_t n = 0; n <= 81; n++) {
+        size_t count = n % 41;
+        std::vector<std::string> strs = gen_batch(count, gen, n > 40);
+        std::vector<simdstr_slice_t> src = slices(strs);
+        std::vector<int> out(count + 1);
+        qstrlen_batch(src.data(), count, out.data());
+        for (size_t i = 0; i < count; i++) {
+            EXPECT_EQ(out[i], qstrlen_naive(strs[i].data(), strs[i].size())) << strs[i];
+        }
+    }
 }
 
 #define ADD_TEST(func, arch) \
@@ -170,22 +592,258 @@ void test_strstr(strstr_t strstr) {
         test_##func(func##_##arch); \
     }
 
+// skip the kernels the running cpu cannot execute
+#define ADD_ISA_TEST(func, arch, isa)                   \
+    TEST(func##_##arch, Basic) {                        \
+        if (simdstr_cpu_isa() < SIMDSTR_ISA_##isa) {    \
+            GTEST_SKIP() << #isa " is not supported";   \
+        }                                               \
+        test_##func(func##_##arch);                     \
+    }
+
 ADD_TEST(memcmpeq, naive);
 ADD_TEST(memcmpeq, sse);
-ADD_TEST(memcmpeq, sse4_2);
-ADD_TEST(memcmpeq, sse4_2_fast);
-ADD_TEST(memcmpeq, avx2);
-#if __AVX512F__ &&  __AVX512BW__
-ADD_TEST(memcmpeq, avx512);
-#endif
+ADD_ISA_TEST(memcmpeq, sse4_2, SSE4_2);
+ADD_ISA_TEST(memcmpeq, sse4_2_fast, SSE4_2);
+ADD_ISA_TEST(memcmpeq, avx2, AVX2);
+ADD_ISA_TEST(memcmpeq, avx512, AVX512);
 ADD_TEST(memcmpeq, autovec);
+ADD_TEST(mismatch, naive);
+ADD_TEST(mismatch, sse);
+ADD_ISA_TEST(mismatch, avx2, AVX2);
+ADD_ISA_TEST(mismatch, avx512, AVX512);
+ADD_TEST(memcmp3, naive);
+ADD_TEST(memcmp3, sse);
+ADD_ISA_TEST(memcmp3, avx2, AVX2);
+ADD_ISA_TEST(memcmp3, avx512, AVX512);
+ADD_TEST(memcaseeq, naive);
+ADD_TEST(memcaseeq, sse);
+ADD_ISA_TEST(memcaseeq, avx2, AVX2);
+ADD_ISA_TEST(memcaseeq, avx512, AVX512);
 
 ADD_TEST(tolower, naive);
+ADD_TEST(tolower, sse);
+ADD_ISA_TEST(tolower, avx2, AVX2);
+ADD_ISA_TEST(tolower, avx512, AVX512);
+ADD_TEST(tolower_inplace, sse);
+ADD_ISA_TEST(tolower_inplace, avx2, AVX2);
+ADD_ISA_TEST(tolower_inplace, avx512, AVX512);
+ADD_TEST(toupper, naive);
+ADD_TEST(toupper, sse);
+ADD_ISA_TEST(toupper, avx2, AVX2);
+ADD_ISA_TEST(toupper, avx512, AVX512);
+ADD_TEST(toupper_inplace, sse);
+ADD_ISA_TEST(toupper_inplace, avx2, AVX2);
+ADD_ISA_TEST(toupper_inplace, avx512, AVX512);
 ADD_TEST(compact, naive);
+ADD_ISA_TEST(compact, sse, SSE4_2);
+ADD_ISA_TEST(compact, avx2, AVX2);
+
+TEST(compact_avx512, Basic) {
+    if (simdstr_cpu_isa() < SIMDSTR_ISA_AVX512 ||
+        !(simdstr_cpu_features() & SIMDSTR_CPU_AVX512VBMI2)) {
+        GTEST_SKIP() << "AVX512_VBMI2 is not supported";
+    }
+    test_compact(compact_avx512);
+}
 ADD_TEST(qstrlen, naive);
+ADD_ISA_TEST(qstrlen, sse, SSE4_2);
+ADD_ISA_TEST(qstrlen, avx2, AVX2);
+ADD_ISA_TEST(qstrlen, avx512, AVX512);
+ADD_TEST(qstrlen_update, naive);
+ADD_ISA_TEST(qstrlen_update, sse, SSE4_2);
+ADD_ISA_TEST(qstrlen_update, avx2, AVX2);
+ADD_ISA_TEST(qstrlen_update, avx512, AVX512);
+ADD_TEST(tolower_batch, naive);
+ADD_TEST(tolower_batch, sse);
+ADD_ISA_TEST(tolower_batch, avx2, AVX2);
+ADD_ISA_TEST(tolower_batch, avx512, AVX512);
+ADD_TEST(memcmpeq_batch, naive);
+ADD_TEST(memcmpeq_batch, sse);
+ADD_ISA_TEST(memcmpeq_batch, avx2, AVX2);
+ADD_ISA_TEST(memcmpeq_batch, avx512, AVX512);
+ADD_TEST(qstrlen_batch, naive);
+ADD_ISA_TEST(qstrlen_batch, sse, SSE4_2);
+ADD_ISA_TEST(qstrlen_batch, avx2, AVX2);
+ADD_ISA_TEST(qstrlen_batch, avx512, AVX512);
 ADD_TEST(strstr, naive);
+ADD_ISA_TEST(strstr, sse, SSE4_2);
+ADD_ISA_TEST(strstr, avx2, AVX2);
+ADD_ISA_TEST(strstr, avx512, AVX512);
+ADD_TEST(strcasestr, naive);
+ADD_ISA_TEST(strcasestr, sse, SSE4_2);
+ADD_ISA_TEST(strcasestr, avx2, AVX2);
+ADD_ISA_TEST(strcasestr, avx512, AVX512);
+
+#undef ADD_ISA_TEST
+#undef ADD_TEST
+
+// Run the dispatched entry points on every ISA level of this cpu.
+class Dispatch : public ::testing::TestWithParam<simdstr_isa_t> {
+protected:
+    void SetUp() override {
+        saved_ = simdstr_isa();
+        if (!simdstr_set_isa(GetParam())) {
+            GTEST_SKIP() << simdstr_isa_name(GetParam()) << " is not supported";
+        }
+    }
+    void TearDown() override { simdstr_set_isa(saved_); }
+
+private:
+    simdstr_isa_t saved_;
+};
+
+TEST_P(Dispatch, Kernels) {
+    EXPECT_EQ(simdstr_isa(), GetParam());
+
+    // integral values are summed exactly in any order
+    std::vector<float> vec(1000);
+    for (size_t i = 0; i < vec.size(); i++) vec[i] = (float)(i % 7);
+    EXPECT_EQ(simdstr_sum(vec.data(), vec.size()), sum_naive(vec.data(), vec.size()));
 
-// TODO: add test for simd functions
-// ADD_TEST(tolower, simd);
+    test_memcmpeq(simdstr_memcmpeq);
+    test_mismatch(simdstr_mismatch);
+    test_memcmp3(simdstr_memcmp3);
+    test_memcaseeq(simdstr_memcaseeq);
+    test_tolower(simdstr_tolower);
+    test_toupper(simdstr_toupper);
+    test_tolower_inplace([](char *s, size_t len) { return simdstr_tolower(s, s, len); });
+    test_toupper_inplace([](char *s, size_t len) { return simdstr_toupper(s, s, len); });
+    test_compact(simdstr_compact);
+    test_qstrlen(simdstr_qstrlen);
+    test_strstr(simdstr_strstr);
+    test_strcasestr(simdstr_strcasestr);
+    test_qstrlen(chunked(simdstr_qstrlen_update));
+    test_compact(compact_chunked);
+    test_tolower_batch(simdstr_tolower_batch);
+    test_memcmpeq_batch(simdstr_memcmpeq_batch);
+    test_qstrlen_batch(simdstr_qstrlen_batch);
+}
+
+// Two pages, the second one PROT_NONE: an input ending at the first one
+// faults if a kernel reads past its last byte.
+class PageEnd {
+public:
+    PageEnd() {
+        page_ = (size_t)sysconf(_SC_PAGESIZE);
+        mem_ = (char *)mmap(nullptr, 2 * page_, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        EXPECT_NE(mem_, MAP_FAILED);
+        mprotect(mem_ + page_, page_, PROT_NONE);
+    }
+    ~PageEnd() { munmap(mem_, 2 * page_); }
+    // len bytes of s ending at the guard page
+    char* put(const std::string& s) {
+        return (char *)std::memcpy(mem_ + page_ - s.size(), s.data(), s.size());
+    }
+
+private:
+    size_t page_;
+    char  *mem_;
+};
+
+TEST_P(Dispatch, PageEnd) {
+    PageEnd a, b;
+    std::mt19937 gen(42);
+    const std::string chars = "aZ \\\"x\t\n";
+    for (size_t len = 0; len <= 64; len++) {
+        std::string s(len, ' ');
+        for (auto& c : s) c = chars[gen() % chars.size()];
+        std::string t = s;
+        if (len > 0) t[gen() % len] ^= 1;
+        const char *s1 = a.put(s), *s2 = b.put(t);
+        EXPECT_EQ(simdstr_memcmpeq(s1, s2, len), memcmpeq_naive(s1, s2, len)) << len;
+        EXPECT_EQ(simdstr_mismatch(s1, s2, len), mismatch_naive(s1, s2, len)) << len;
+        EXPECT_EQ(sign(simdstr_memcmp3(s1, s2, len)), sign(memcmp3_naive(s1, s2, len))) << len;
+        EXPECT_EQ(simdstr_memcaseeq(s1, s2, len), memcaseeq_naive(s1, s2, len)) << len;
+        char dst[64], expected[64];
+        tolower_naive(expected, s1, len);
+        simdstr_tolower(dst, s1, len);
+        EXPECT_EQ(std::string(dst, len), std::string(expected, len)) << len;
+        int n = compact_naive(expected, s1, len);
+        EXPECT_EQ(simdstr_compact(dst, s1, len), n) << len;
+        EXPECT_EQ(std::string(dst, n), std::string(expected, n)) << len;
+        EXPECT_EQ(simdstr_qstrlen(s1, len), qstrlen_naive(s1, len)) << len;
+        EXPECT_EQ(simdstr_strstr(s1, len, "Zx", 2), strstr_naive(s1, len, "Zx", 2)) << len;
+        EXPECT_EQ(simdstr_strcasestr(s1, len, "zX", 2), strcasestr_naive(s1, len, "zX", 2)) << len;
+        EXPECT_EQ(simdstr_memchr(s1, 'x', len), memchr_naive(s1, 'x', len)) << len;
+        EXPECT_EQ(simdstr_memrchr(s1, 'x', len), memrchr_naive(s1, 'x', len)) << len;
+        EXPECT_EQ(simdstr_memchr3(s1, 'Z', '\t', '\\', len), memchr3_naive(s1, 'Z', '\t', '\\', len)) << len;
+        EXPECT_EQ(simdstr_count_byte(s1, ' ', len), count_byte_naive(s1, ' ', len)) << len;
+        uint64_t offsets[64], expected_offsets[64];
+        size_t   nl = newline_index_naive(s1, len, 0, expected_offsets);
+        EXPECT_EQ(simdstr_newline_index(s1, len, 0, offsets), nl) << len;
+        EXPECT_EQ(std::vector<uint64_t>(offsets, offsets + nl),
+                  std::vector<uint64_t>(expected_offsets, expected_offsets + nl)) << len;
+        EXPECT_EQ(simdstr_crc32c(0, s1, len), crc32c_naive(0, s1, len)) << len;
+        EXPECT_EQ(simdstr_hash64(s1, len, 1), hash64_naive(s1, len, 1)) << len;
+        const simdstr_slice_t keys[4] = {{s1, len}, {s2, len}, {s1 + len / 2, len - len / 2}, {s2 + len / 3, len - len / 3}};
+        uint64_t hashes[4];
+        simdstr_hash64_batch(keys, 4, 1, hashes);
+        for (int k = 0; k < 4; k++) {
+            EXPECT_EQ(hashes[k], hash64_naive(keys[k].ptr, keys[k].len, 1)) << len;
+        }
+        // a group of the batch kernels, every string at the guard page
+        int qlens[4];
+        bool eqs[4];
+        simdstr_qstrlen_batch(keys, 4, qlens);
+        simdstr_memcmpeq_batch(keys, keys, 4, eqs);
+        for (int k = 0; k < 4; k++) {
+            EXPECT_EQ(qlens[k], qstrlen_naive(keys[k].ptr, keys[k].len)) << len;
+            EXPECT_TRUE(eqs[k]) << len;
+        }
+        char lowered[4][64];
+        char *const lowered_dst[4] = {lowered[0], lowered[1], lowered[2], lowered[3]};
+        simdstr_tolower_batch(lowered_dst, keys, 4);
+        for (int k = 0; k < 4; k++) {
+            tolower_naive(expected, keys[k].ptr, keys[k].len);
+            EXPECT_EQ(std::string(lowered[k], keys[k].len), std::string(expected, keys[k].len)) << len;
+        }
+
+        std::vector<float> vec(len / 4);
+        for (size_t i = 0; i < vec.size(); i++) vec[i] = (float)(i % 7);
+        std::string bytes((const char *)vec.data(), vec.size() * sizeof(float));
+        const float *v = (const float *)a.put(bytes);
+        EXPECT_EQ(simdstr_sum(v, vec.size()), sum_naive(v, vec.size())) << len;
+        EXPECT_EQ(sum_sse(v, vec.size()), sum_naive(v, vec.size())) << len;
+        if (GetParam() >= SIMDSTR_ISA_AVX2) {
+            EXPECT_EQ(sum_simd(v, vec.size()), sum_naive(v, vec.size())) << len;
+            EXPECT_EQ(sum_simd_fast(v, vec.size()), sum_naive(v, vec.size())) << len;
+        }
+        if (GetParam() >= SIMDSTR_ISA_AVX512) {
+            EXPECT_EQ(sum_avx512(v, vec.size()), sum_naive(v, vec.size())) << len;
+        }
+        for (simdstr_reduce_t mode : {SIMDSTR_REDUCE_FAST, SIMDSTR_REDUCE_COMPENSATED,
+                                      SIMDSTR_REDUCE_REPRODUCIBLE}) {
+            EXPECT_EQ(simdstr_reduce_sum(v, vec.size(), mode), sum_naive(v, vec.size())) << len;
+        }
+    }
+}
 
-#undef ADD_TEST
\ No newline at end of file
+INSTANTIATE_TEST_SUITE_P(Isa, Dispatch,
+    ::testing::Values(SIMDSTR_ISA_NAIVE, SIMDSTR_ISA_SSE4_2, SIMDSTR_ISA_AVX2, SIMDSTR_ISA_AVX512),
+    [](const ::testing::TestParamInfo<simdstr_isa_t>& info) {
+        return std::string(simdstr_isa_name(info.param));
+    });
+
+TEST(DispatchIsa, Names) {
+    for (int i = SIMDSTR_ISA_NAIVE; i <= SIMDSTR_ISA_AVX512; i++) {
+        simdstr_isa_t isa = (simdstr_isa_t)i;
+        EXPECT_EQ(simdstr_isa_from_name(simdstr_isa_name(isa)), i);
+    }
+    EXPECT_EQ(simdstr_isa_from_name("avx1024"), -1);
+    EXPECT_LE(simdstr_isa(), simdstr_cpu_isa());
+    EXPECT_FALSE(simdstr_set_isa((simdstr_isa_t)(SIMDSTR_ISA_AVX512 + 1)));
+}
+
+// the library is loaded again in a child that re-executes the test binary
+TEST(DispatchIsa, EnvOverride) {
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    simdstr_isa_t cpu = simdstr_cpu_isa();
+    setenv("SIMDSTR_ISA", "avx1024", 1);
+    EXPECT_EXIT(exit(simdstr_isa() == cpu ? 0 : 1), ::testing::ExitedWithCode(0),
+                "unknown SIMDSTR_ISA=avx1024");
+    setenv("SIMDSTR_ISA", "naive", 1);
+    EXPECT_EXIT(exit(simdstr_isa() == SIMDSTR_ISA_NAIVE ? 0 : 1), ::testing::ExitedWithCode(0), "");
+    unsetenv("SIMDSTR_ISA");
+}
@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+extern "C" {
+    #include  "simdstr.h"
+}
+
+using Match = std::pair<size_t, size_t>;
+
+static bool collect(size_t id, size_t offset, void *ctx) {
+    static_cast<std::vector<Match>*>(ctx)->emplace_back(id, offset);
+    return true;
+}
+
+// every occurrence of every pattern, sorted by pattern then offset
+static std::vector<Match> find_all(const std::vector<std::string>& patterns, const std::string& str) {
+    std::vector<Match> matches;
+    for (size_t id = 0; id < patterns.size(); id++) {
+        for (size_t pos = str.find(patterns[id]); pos != std::string::npos;
+             pos = str.find(patterns[id], pos + 1)) {
+            matches.emplace_back(id, pos);
+        }
+    }
+    std::sort(matches.begin(), matches.end());
+    return matches;
+}
+
+static std::vector<Match> scan(const std::vector<std::string>& patterns, const std::string& str) {
+    std::vector<const char*> ptrs;
+    std::vector<size_t> lens;
+    for (const auto& p : patterns) {
+        ptrs.push_back(p.data());
+        lens.push_back(p.size());
+    }
+    strstr_multi_t *m = strstr_multi_new(ptrs.data(), lens.data(), patterns.size());
+    EXPECT_NE(m, nullptr);
+    std::vector<Match> matches;
+    size_t n = strstr_multi_scan(m, str.data(), str.size(), collect, &matches);
+    EXPECT_EQ(n, matches.size());
+    strstr_multi_free(m);
+    std::sort(matches.begin(), matches.end());
+    return matches;
+}
+
+static std::string random_string(std::mt19937& gen, size_t len, int alpha) {
+    std::string s(len, '\0');
+    for (auto& c : s) c = 'a' + gen() % alpha;
+    return s;
+}
+
+// Run the scan on every ISA level of this cpu.
+class StrstrMulti : public ::testing::TestWithParam<simdstr_isa_t> {
+protected:
+    void SetUp() override {
+        saved_ = simdstr_isa();
+        if (!simdstr_set_isa(GetParam())) {
+            GTEST_SKIP() << simdstr_isa_name(GetParam()) << " is not supported";
+        }
+    }
+    void TearDown() override { simdstr_set_isa(saved_); }
+
+private:
+    simdstr_isa_t saved_;
+};
+
+TEST_P(StrstrMulti, Basic) {
+    std::string str = "GET /index.html HTTP/1.1 error: timeout, warning: retry, error";
+    std::vector<std::string> patterns = {"error", "warning", "timeout", "fatal", "e", "or"};
+    EXPECT_EQ(scan(patterns, str), find_all(patterns, str));
+
+    // duplicated and overlapping patterns
+    patterns = {"aa", "aa", "a", "aaa"};
+    str = std::string(100, 'a');
+    EXPECT_EQ(scan(patterns, str), find_all(patterns, str));
+
+    // bytes of the whole range
+    patterns = {std::string("\0\xff", 2), "\x80\x7f", std::string(1, '\0')};
+    str = std::string("x\0\xff\x80\x7f\0", 6);
+    EXPECT_EQ(scan(patterns, str), find_all(patterns, str));
+}
+
+TEST_P(StrstrMulti, Random) {
+    std::mt19937 gen(42);
+    // small sets on Teddy, the larger ones on Aho-Corasick
+    for (size_t count : {1, 2, 8, 32, 33, 64, 300}) {
+        for (int round = 0; round < 20; round++) {
+            int alpha = 2 + gen() % 8;
+            std::vector<std::string> patterns;
+            for (size_t i = 0; i < count; i++) {
+                patterns.push_back(random_string(gen, 1 + gen() % 8, alpha));
+            }
+            std::string str = random_string(gen, gen() % 500, alpha);
+            EXPECT_EQ(scan(patterns, str), find_all(patterns, str)) << count << " patterns";
+        }
+    }
+}
+
+TEST_P(StrstrMulti, Stop) {
+    std::vector<std::string> patterns = {"ab", "b"};
+    std::string str(1000, '\0');
+    for (size_t i = 0; i < str.size(); i++) str[i] = "ab"[i % 2];
+    const char *ptrs[] = {patterns[0].data(), patterns[1].data()};
+    size_t lens[] = {2, 1};
+    strstr_multi_t *m = strstr_multi_new(ptrs, lens, 2);
+    size_t seen = 0;
+    auto stop_at_3 = [](size_t, size_t, void *ctx) {
+        return ++*static_cast<size_t*>(ctx) < 3;
+    };
+    EXPECT_EQ(strstr_multi_scan(m, str.data(), str.size(), stop_at_3, &seen), 3u);
+    strstr_multi_free(m);
+}
+
+INSTANTIATE_TEST_SUITE_P(Isa, StrstrMulti,
+    ::testing::Values(SIMDSTR_ISA_NAIVE, SIMDSTR_ISA_SSE4_2, SIMDSTR_ISA_AVX2, SIMDSTR_ISA_AVX512),
+    [](const ::testing::TestParamInfo<simdstr_isa_t>& info) {
+        return std::string(simdstr_isa_name(info.param));
+    });
+
+TEST(StrstrMultiNew, Invalid) {
+    const char *ptrs[] = {"abc", ""};
+    size_t lens[] = {3, 0};
+    EXPECT_EQ(strstr_multi_new(ptrs, lens, 0), nullptr);
+    EXPECT_EQ(strstr_multi_new(ptrs, lens, 2), nullptr);
+}
@@ -0,0 +1,190 @@
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "test_util.h"
+
+using validate_t = bool (*)(const char *s, size_t len);
+using count_t    = size_t (*)(const char *s, size_t len);
+using to_utf16_t = int64_t (*)(uint16_t *dst, const char *src, size_t len);
+using to_utf8_t  = int64_t (*)(char *dst, const uint16_t *src, size_t len);
+
+static std::string utf8_of(uint32_t cp) {
+    std::string s;
+    if (cp < 0x80) {
+        s += (char)cp;
+    } else if (cp < 0x800) {
+        s += (char)(0xC0 | cp >> 6);
+        s += (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        s += (char)(0xE0 | cp >> 12);
+        s += (char)(0x80 | (cp >> 6 & 0x3F));
+        s += (char)(0x80 | (cp & 0x3F));
+    } else {
+        s += (char)(0xF0 | cp >> 18);
+        s += (char)(0x80 | (cp >> 12 & 0x3F));
+        s += (char)(0x80 | (cp >> 6 & 0x3F));
+        s += (char)(0x80 | (cp & 0x3F));
+    }
+    return s;
+}
+
+// valid UTF-8 of about len bytes, ASCII with runs of Latin, CJK and emoji
+static std::string gen_utf8(size_t len, std::mt19937& gen) {
+    const uint32_t lo[] = {0x20, 0x80, 0x800, 0xE000, 0x10000};
+    const uint32_t hi[] = {0x7F, 0x7FF, 0xD7FF, 0xFFFF, 0x10FFFF};
+    std::string s;
+    while (s.size() < len) {
+        int cls = gen() % 5;
+        size_t run = 1 + gen() % 20;
+        for (size_t i = 0; i < run; i++) {
+            s += utf8_of(lo[cls] + gen() % (hi[cls] - lo[cls] + 1));
+        }
+    }
+    return s;
+}
+
+static void test_utf8_validate(validate_t validate) {
+    const std::pair<std::string, bool> tests[] = {
+        {"", true}, {"abc", true}, {"\xC3\xA9", true}, {"\xE4\xB8\xAD\xE6\x96\x87", true},
+        {"\xF0\x9F\x98\x81", true}, {"\xF4\x8F\xBF\xBF", true}, {"\xEF\xBF\xBF", true},
+        {"\xED\x9F\xBF", true}, {"\xEE\x80\x80", true},
+        {"\x80", false}, {"\xBF", false}, {"\xC0\x80", false}, {"\xC1\xBF", false},
+        {"\xC2", false}, {"\xC2\x41", false}, {"\xE0\x80\x80", false}, {"\xE0\x9F\xBF", false},
+        {"\xED\xA0\x80", false}, {"\xED\xBF\xBF", false}, {"\xF0\x80\x80\x80", false},
+        {"\xF0\x8F\xBF\xBF", false}, {"\xF4\x90\x80\x80", false}, {"\xF5\x80\x80\x80", false},
+        {"\xFF", false}, {"\xFE", false}, {"\xE4\xB8", false}, {"\xF0\x9F\x98", false},
+        {"\xC3\xA9\xA9", false}, {"\xF0\x9F\x98\x81\x81", false},
+    };
+    for (const auto& test : tests) {
+        const std::string& s = test.first;
+        bool valid = test.second;
+        EXPECT_EQ(validate(s.data(), s.size()), valid) << testing::PrintToString(s);
+        // across the block boundaries, at the end and followed by more text
+        for (size_t pad : {15, 31, 63, 64, 100}) {
+            std::mt19937 gen(pad);
+            std::string t = std::string(pad, 'a') + s;
+            EXPECT_EQ(validate(t.data(), t.size()), valid) << pad << testing::PrintToString(s);
+            t = gen_utf8(pad, gen) + s + "abc";
+            EXPECT_EQ(validate(t.data(), t.size()), valid) << pad << testing::PrintToString(s);
+        }
+    }
+
+    // valid text, then one byte changed
+    std::mt19937 gen(42);
+    for (size_t len = 0; len <= 300; len++) {
+        for (int round = 0; round < 10; round++) {
+            std::string s = gen_utf8(len, gen);
+            ASSERT_TRUE(validate(s.data(), s.size())) << len;
+            if (s.empty()) {
+                continue;
+            }
+            std::string t = s;
+            t[gen() % t.size()] = (char)gen();
+            ASSERT_EQ(validate(t.data(), t.size()), utf8_validate_naive(t.data(), t.size()))
+                << testing::PrintToString(t);
+            t.resize(gen() % t.size());
+            ASSERT_EQ(validate(t.data(), t.size()), utf8_validate_naive(t.data(), t.size()))
+                << testing::PrintToString(t);
+        }
+    }
+}
+
+static void test_utf8_count(count_t count) {
+    std::mt19937 gen(42);
+    for (size_t len = 0; len <= 300; len++) {
+        std::string s = gen_utf8(len, gen);
+        ASSERT_EQ(count(s.data(), s.size()), utf8_count_naive(s.data(), s.size())) << len;
+    }
+}
+
+static std::vector<uint16_t> utf16_of(const std::string& s) {
+    std::vector<uint16_t> out(s.size());
+    int64_t n = utf8_to_utf16_naive(out.data(), s.data(), s.size());
+    out.resize(n < 0 ? 0 : n);
+    return out;
+}
+
+static void test_utf8_to_utf16(to_utf16_t to_utf16) {
+    std::mt19937 gen(42);
+    for (size_t len = 0; len <= 400; len++) {
+        for (int round = 0; round < 5; round++) {
+            std::string s = gen_utf8(len, gen);
+            std::vector<uint16_t> out(s.size());
+            int64_t n = to_utf16(out.data(), s.data(), s.size());
+            out.resize(n < 0 ? 0 : n);
+            ASSERT_EQ(out, utf16_of(s)) << len;
+            if (s.empty()) {
+                continue;
+            }
+            // an error anywhere
+            std::string t = s;
+            t[gen() % t.size()] = (char)(0x80 | gen());
+            std::vector<uint16_t> bad(t.size());
+            bool valid = utf8_validate_naive(t.data(), t.size());
+            n = to_utf16(bad.data(), t.data(), t.size());
+            ASSERT_EQ(n >= 0, valid) << testing::PrintToString(t);
+            if (valid) {
+                bad.resize(n);
+                ASSERT_EQ(bad, utf16_of(t));
+            }
+        }
+    }
+}
+
+static void test_utf16_to_utf8(to_utf8_t to_utf8) {
+    std::mt19937 gen(42);
+    for (size_t len = 0; len <= 400; len++) {
+        for (int round = 0; round < 5; round++) {
+            std::string s = gen_utf8(len, gen);
+            std::vector<uint16_t> units = utf16_of(s);
+            std::vector<char> out(3 * units.size());
+            int64_t n = to_utf8(out.data(), units.data(), units.size());
+            ASSERT_EQ(std::string(out.data(), n < 0 ? 0 : n), s) << len;
+            if (units.empty()) {
+                continue;
+            }
+            // an unpaired surrogate
+            size_t at = gen() % units.size();
+            units[at] = (uint16_t)(0xD800 + gen() % 0x800);
+            std::vector<char> want(3 * units.size());
+            int64_t want_n = utf16_to_utf8_naive(want.data(), units.data(), units.size());
+            n = to_utf8(out.data(), units.data(), units.size());
+            ASSERT_EQ(n, want_n);
+            if (n >= 0) {
+                ASSERT_EQ(std::string(out.data(), n), std::string(want.data(), n));
+            }
+        }
+    }
+    const uint16_t lone[][2] = {{0xD800, 'a'}, {0xDC00, 'a'}, {'a', 0xD800}, {0xDBFF, 0xDBFF}};
+    for (const auto& u : lone) {
+        char out[8];
+        EXPECT_EQ(to_utf8(out, u, 2), -1);
+    }
+}
+
+ADD_ISA_TEST(utf8_validate, naive, NAIVE);
+ADD_ISA_TEST(utf8_validate, sse, SSE4_2);
+ADD_ISA_TEST(utf8_validate, avx2, AVX2);
+ADD_ISA_TEST(utf8_validate, avx512, AVX512);
+ADD_ISA_TEST(utf8_count, sse, SSE4_2);
+ADD_ISA_TEST(utf8_count, avx2, AVX2);
+ADD_ISA_TEST(utf8_count, avx512, AVX512);
+ADD_ISA_TEST(utf8_to_utf16, naive, NAIVE);
+ADD_ISA_TEST(utf8_to_utf16, sse, SSE4_2);
+ADD_ISA_TEST(utf8_to_utf16, avx2, AVX2);
+ADD_VBMI_TEST(utf8_to_utf16, SIMDSTR_CPU_AVX512VBMI | SIMDSTR_CPU_AVX512VBMI2);
+ADD_ISA_TEST(utf16_to_utf8, naive, NAIVE);
+ADD_ISA_TEST(utf16_to_utf8, sse, SSE4_2);
+ADD_ISA_TEST(utf16_to_utf8, avx2, AVX2);
+ADD_VBMI_TEST(utf16_to_utf8, SIMDSTR_CPU_AVX512VBMI2);
+
+TEST(utf8, Dispatch) {
+    for_each_isa([] {
+        test_utf8_validate(simdstr_utf8_validate);
+        test_utf8_count(simdstr_utf8_count);
+        test_utf8_to_utf16(simdstr_utf8_to_utf16);
+        test_utf16_to_utf8(simdstr_utf16_to_utf8);
+    });
+}
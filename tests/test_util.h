@@ -0,0 +1,47 @@
+#pragma once
+
+#include <random>
+#include <string>
+#include <gtest/gtest.h>
+
+extern "C" {
+    #include  "simdstr.h"
+}
+
+// len random bytes
+inline std::string gen_bytes(size_t len, std::mt19937& gen) {
+    std::string s(len, '\0');
+    for (auto& c : s) c = (char)gen();
+    return s;
+}
+
+// the kernel func_arch through test_func, skipped below the level isa
+#define ADD_ISA_TEST(func, arch, isa)                   \
+    TEST(func##_##arch, Basic) {                        \
+        if (simdstr_cpu_isa() < SIMDSTR_ISA_##isa) {    \
+            GTEST_SKIP() << #isa " is not supported";   \
+        }                                               \
+        test_##func(func##_##arch);                     \
+    }
+
+// the AVX-512 kernel func_avx512 that also needs the cpu features, the VBMI
+// extensions
+#define ADD_VBMI_TEST(func, features)                                  \
+    TEST(func##_avx512, Basic) {                                       \
+        if (simdstr_cpu_isa() < SIMDSTR_ISA_AVX512                     \
+            || (simdstr_cpu_features() & (features)) != (features)) {  \
+            GTEST_SKIP() << "AVX512 VBMI is not supported";            \
+        }                                                              \
+        test_##func(func##_avx512);                                    \
+    }
+
+// f at every level the cpu supports, the level is restored after
+template <typename F>
+void for_each_isa(F f) {
+    simdstr_isa_t saved = simdstr_isa();
+    for (int i = SIMDSTR_ISA_NAIVE; i <= simdstr_cpu_isa(); i++) {
+        simdstr_set_isa((simdstr_isa_t)i);
+        f();
+    }
+    simdstr_set_isa(saved);
+}